@@ -279,6 +279,14 @@ void ArrayDriver::Read(ReadRequest request, ReadChunkReceiver receiver) {
                                        Arena* arena) {
       return GetTransformedArrayNDIterable(self->data_, chunk_transform, arena);
     }
+
+    bool operator()(ReadChunk::ReadArray,
+                    IndexTransformView<> /*chunk_transform*/,
+                    SharedOffsetArray<const void>& /*array*/) {
+      // Note: Since the backing array for this driver may be modified by
+      // subsequent writes, it can't be shared with the reader.
+      return false;
+    }
   };
   // Cancellation does not make sense since there is only a single call to
   // `set_value` which occurs immediately after `set_starting`.
@@ -359,6 +359,17 @@ TEST(FromArrayTest, CopyDataTypeConversion) {
   EXPECT_EQ(dest, tensorstore::MakeArray<int64_t>({1, 2, 3}));
 }
 
+TEST(FromArrayTest, CopyCannotTakeSourceData) {
+  auto source = tensorstore::MakeArray<int>({1, 2, 3});
+  auto dest = tensorstore::AllocateArray<int>({3});
+  auto write_result = tensorstore::Copy(tensorstore::FromArray(source),
+                                        tensorstore::FromArray(dest),
+                                        tensorstore::can_take_source_data);
+  EXPECT_THAT(write_result.copy_future.result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            "can_take_source_data is not supported by Copy"));
+}
+
 TEST(FromArrayTest, CopyInvalidDataTypeConversion) {
   tensorstore::SharedArray<void> source =
       tensorstore::MakeArray<int32_t>({1, 2, 3});
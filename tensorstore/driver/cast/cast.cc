@@ -310,6 +310,13 @@ struct ReadChunkImpl {
     return GetConvertedInputNDIterable(std::move(iterable), self->target_dtype_,
                                        self->input_conversion_);
   }
+
+  bool operator()(ReadChunk::ReadArray,
+                  IndexTransformView<> /*chunk_transform*/,
+                  SharedOffsetArray<const void>& /*array*/) {
+    // The data type conversion always requires a copy.
+    return false;
+  }
 };
 
 // Implementation of `tensorstore::internal::WriteChunk::Impl` Poly
@@ -28,6 +28,7 @@
 
 #include "absl/functional/function_ref.h"
 #include "absl/status/status.h"
+#include "tensorstore/array.h"
 #include "tensorstore/index_space/index_transform.h"
 #include "tensorstore/index_space/transformed_array.h"
 #include "tensorstore/internal/arena.h"
@@ -44,6 +45,7 @@ namespace internal {
 
 struct ReadChunk {
   struct BeginRead {};
+  struct ReadArray {};
   using Impl = poly::Poly<
       sizeof(void*) * 2,
       /*Copyable=*/true,  //
@@ -69,7 +71,23 @@ struct ReadChunk {
       /// \returns An NDIterable with a shape of
       ///     `chunk_transform.input_shape()`.
       Result<NDIterable::Ptr>(BeginRead, IndexTransform<> chunk_transform,
-                              Arena* arena)>;
+                              Arena* arena),
+
+      /// Returns a view of immutable data directly, if supported.
+      ///
+      /// No locks are held when this function is called.  The returned array
+      /// shares ownership of the underlying data and must remain valid, and
+      /// unmodified, for as long as references to it are held.
+      ///
+      /// \param chunk_transform Transform with a range that is a subset of
+      ///     `transform`.
+      /// \param array[out] Set on success to an array with a domain of
+      ///     `chunk_transform.domain()`.
+      /// \returns `true` if `ReadArray` is supported and `array` has been set,
+      ///     `false` otherwise, in which case the caller must fall back to
+      ///     `BeginRead`.
+      bool(ReadArray, IndexTransformView<> chunk_transform,
+           SharedOffsetArray<const void>& array)>;
 
   /// Type-erased chunk implementation.  In the case of the chunks produced by
   /// `ChunkCache::Read`, for example, the contained object holds a
@@ -696,6 +696,13 @@ struct BufferedReadChunkImpl {
         propagated.input_downsample_factors, state_->self_->downsample_method_,
         chunk_transform.input_rank(), arena);
   }
+
+  bool operator()(internal::ReadChunk::ReadArray,
+                  IndexTransformView<> /*chunk_transform*/,
+                  SharedOffsetArray<const void>& /*array*/) const {
+    // Downsampled values are computed on the fly.
+    return false;
+  }
 };
 
 /// Returns an identity transform from `base_domain.rank()` to `request_rank`,
@@ -812,6 +819,13 @@ struct IndependentReadChunkImpl {
         propagated.input_downsample_factors, state_->self_->downsample_method_,
         chunk_transform.input_rank(), arena);
   }
+
+  bool operator()(internal::ReadChunk::ReadArray,
+                  IndexTransformView<> /*chunk_transform*/,
+                  SharedOffsetArray<const void>& /*array*/) {
+    // Downsampled values are computed on the fly.
+    return false;
+  }
 };
 
 /// Attempts to emit a `ReadChunk` from the base driver independently.
@@ -14,6 +14,9 @@
 
 #include "tensorstore/driver/driver.h"
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <utility>
 #include <vector>
 
@@ -21,24 +24,36 @@
 #include <gtest/gtest.h>
 #include "absl/status/status.h"
 #include "tensorstore/array.h"
+#include "tensorstore/contiguous_layout.h"
 #include "tensorstore/data_type.h"
+#include "tensorstore/data_type_conversion.h"
+#include "tensorstore/driver/chunk.h"
 #include "tensorstore/driver/driver_handle.h"
+#include "tensorstore/driver/read.h"
 #include "tensorstore/driver/write.h"
 #include "tensorstore/index.h"
 #include "tensorstore/index_space/index_transform.h"
+#include "tensorstore/internal/arena.h"
+#include "tensorstore/internal/lock_collection.h"
+#include "tensorstore/internal/nditerable.h"
+#include "tensorstore/internal/nditerable_transformed_array.h"
+#include "tensorstore/internal/thread/thread_pool.h"
 #include "tensorstore/open_mode.h"
 #include "tensorstore/progress.h"
 #include "tensorstore/util/execution/any_receiver.h"
 #include "tensorstore/util/execution/execution.h"
 #include "tensorstore/util/executor.h"
 #include "tensorstore/util/garbage_collection/garbage_collection.h"
+#include "tensorstore/util/result.h"
 #include "tensorstore/util/status_testutil.h"
 
 namespace {
 
 using ::tensorstore::AnyFlowReceiver;
+using ::tensorstore::Index;
 using ::tensorstore::MatchesStatus;
 using ::tensorstore::WriteProgress;
+using ::tensorstore::internal::CopyReadChunkParallel;
 using ::tensorstore::internal::DriverWrite;
 using ::tensorstore::internal::DriverWriteOptions;
 
@@ -86,4 +101,57 @@ TEST(WriteTest, ChunkError) {
             write_result.commit_future.status());
 }
 
+// `ReadChunk::Impl` that reads from an array.
+struct ArrayReadChunkImpl {
+  tensorstore::SharedArray<const void> array;
+
+  absl::Status operator()(tensorstore::internal::LockCollection&) {
+    return absl::OkStatus();
+  }
+
+  tensorstore::Result<tensorstore::internal::NDIterable::Ptr> operator()(
+      tensorstore::internal::ReadChunk::BeginRead,
+      tensorstore::IndexTransform<> chunk_transform,
+      tensorstore::internal::Arena* arena) {
+    return tensorstore::internal::GetTransformedArrayNDIterable(
+        array, chunk_transform, arena);
+  }
+
+  bool operator()(tensorstore::internal::ReadChunk::ReadArray,
+                  tensorstore::IndexTransformView<> /*chunk_transform*/,
+                  tensorstore::SharedOffsetArray<const void>& /*array*/) {
+    return false;
+  }
+};
+
+TEST(CopyReadChunkParallelTest, Basic) {
+  auto executor = tensorstore::internal::DetachedThreadPool(4);
+  for (auto shape : {std::vector<Index>{100, 37}, std::vector<Index>{1, 1, 50},
+                     std::vector<Index>{3, 1000}}) {
+    auto source = tensorstore::AllocateArray<int32_t>(shape);
+    for (Index i = 0; i < source.num_elements(); ++i) {
+      source.data()[i] = static_cast<int32_t>(i);
+    }
+    tensorstore::internal::ReadChunk::Impl chunk =
+        ArrayReadChunkImpl{source};
+    auto converter = tensorstore::internal::GetDataTypeConverter(
+        source.dtype(), source.dtype());
+    for (size_t max_parallelism : {1, 4, 64}) {
+      for (Index min_bytes_per_task : {1, 256, 1 << 30}) {
+        SCOPED_TRACE(::testing::Message()
+                     << "shape.size()=" << shape.size()
+                     << ", max_parallelism=" << max_parallelism
+                     << ", min_bytes_per_task=" << min_bytes_per_task);
+        auto target = tensorstore::AllocateArray<int32_t>(
+            shape, tensorstore::c_order, tensorstore::value_init);
+        TENSORSTORE_EXPECT_OK(CopyReadChunkParallel(
+            executor, max_parallelism, min_bytes_per_task, chunk,
+            tensorstore::IdentityTransform(source.domain()), converter,
+            target));
+        EXPECT_EQ(source, target);
+      }
+    }
+  }
+}
+
 }  // namespace
@@ -1192,6 +1192,12 @@ ReadChunk MakeArrayBackedReadChunk(TransformedArray<Shared<const void>> data) {
                                        Arena* arena) {
       return GetTransformedArrayNDIterable({data, chunk_transform}, arena);
     }
+
+    bool operator()(ReadChunk::ReadArray,
+                    IndexTransformView<> /*chunk_transform*/,
+                    SharedOffsetArray<const void>& /*array*/) {
+      return false;
+    }
   };
   ReadChunk chunk;
   chunk.impl = ReadChunkImpl{data.element_pointer()};
@@ -39,6 +39,7 @@ namespace internal_image_driver {
 namespace {
 
 using ::tensorstore::internal_image::AvifReader;
+using ::tensorstore::internal_image::AvifReaderOptions;
 using ::tensorstore::internal_image::AvifWriter;
 using ::tensorstore::internal_image::AvifWriterOptions;
 using ::tensorstore::internal_image::ImageInfo;
@@ -82,10 +83,13 @@ struct AvifSpecialization : public AvifWriterOptions {
     return buffer;
   }
 
-  Result<SharedArray<uint8_t, 3>> DecodeImage(absl::Cord value) {
+  Result<SharedArray<uint8_t, 3>> DecodeImage(
+      absl::Cord value, const DecodeConcurrency& concurrency) {
     riegeli::CordReader<> buffer_reader(&value);
     AvifReader reader;
-    TENSORSTORE_RETURN_IF_ERROR(reader.Initialize(&buffer_reader));
+    AvifReaderOptions options;
+    options.max_threads = static_cast<int>(concurrency.max_parallelism);
+    TENSORSTORE_RETURN_IF_ERROR(reader.Initialize(&buffer_reader, options));
     ImageInfo info = reader.GetImageInfo();
     if (info.dtype != dtype_v<uint8_t>) {
       return absl::UnimplementedError(
@@ -95,9 +99,10 @@ struct AvifSpecialization : public AvifWriterOptions {
                                       static_cast<Index>(info.width),
                                       static_cast<Index>(info.num_components)};
     SharedArray<uint8_t, 3> array_yxc = AllocateArray<uint8_t>(shape_yxc);
-    TENSORSTORE_RETURN_IF_ERROR(reader.Decode(tensorstore::span(
-        reinterpret_cast<unsigned char*>(array_yxc.data()),
-        array_yxc.num_elements() * array_yxc.dtype().size())));
+    TENSORSTORE_RETURN_IF_ERROR(reader.Decode(
+        tensorstore::span(reinterpret_cast<unsigned char*>(array_yxc.data()),
+                          array_yxc.num_elements() * array_yxc.dtype().size()),
+        options));
     return array_yxc;
   }
 };
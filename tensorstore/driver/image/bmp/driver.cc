@@ -52,7 +52,8 @@ struct BmpSpecialization {
     return absl::UnimplementedError("\"bmp\" driver does not support writing");
   }
 
-  Result<SharedArray<uint8_t, 3>> DecodeImage(absl::Cord value) {
+  Result<SharedArray<uint8_t, 3>> DecodeImage(
+      absl::Cord value, const DecodeConcurrency& concurrency) {
     riegeli::CordReader buffer_reader(&value);
     BmpReader reader;
     TENSORSTORE_RETURN_IF_ERROR(reader.Initialize(&buffer_reader));
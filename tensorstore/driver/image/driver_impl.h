@@ -22,6 +22,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <thread>  // NOLINT
 #include <utility>
 
 #include "absl/status/status.h"
@@ -42,6 +43,7 @@
 #include "tensorstore/index_space/index_domain.h"
 #include "tensorstore/index_space/index_domain_builder.h"
 #include "tensorstore/index_space/index_transform.h"
+#include "tensorstore/index_space/transformed_array.h"
 #include "tensorstore/internal/arena.h"
 #include "tensorstore/internal/cache/async_cache.h"
 #include "tensorstore/internal/cache/async_initialized_cache_mixin.h"
@@ -81,6 +83,13 @@ namespace tensorstore {
 namespace internal_image_driver {
 namespace {
 
+/// Concurrency available to `Specialization::DecodeImage` for decoding a
+/// single image.
+struct DecodeConcurrency {
+  Executor executor;
+  size_t max_parallelism = 1;
+};
+
 template <typename Specialization>
 class ImageDriverSpec
     : public internal::RegisteredDriverSpec<ImageDriverSpec<Specialization>,
@@ -219,11 +228,16 @@ class ImageCache : public internal::KvsBackedCache<ImageCache<Specialization>,
         execution::set_error(receiver, absl::NotFoundError(""));
         return;
       }
-      auto options = GetOwningCache(*this).specialization_;
-      GetOwningCache(*this).executor()(
+      auto& cache = GetOwningCache(*this);
+      auto options = cache.specialization_;
+      DecodeConcurrency concurrency{cache.executor(),
+                                    cache.max_decode_parallelism()};
+      cache.executor()(
           [value = *std::move(value), receiver = std::move(receiver),
-           options = std::move(options)]() mutable {
-            auto decode_result = options.DecodeImage(std::move(value));
+           options = std::move(options),
+           concurrency = std::move(concurrency)]() mutable {
+            auto decode_result =
+                options.DecodeImage(std::move(value), concurrency);
             if (!decode_result.ok()) {
               execution::set_error(receiver, decode_result.status());
             } else {
@@ -268,6 +282,13 @@ class ImageCache : public internal::KvsBackedCache<ImageCache<Specialization>,
 
   const Executor& executor() { return data_copy_concurrency_->executor; }
 
+  // Returns the number of threads of the `data_copy_concurrency` pool, which
+  // bounds the parallelism used to decode a single image.
+  size_t max_decode_parallelism() {
+    if (data_copy_concurrency_->spec) return *data_copy_concurrency_->spec;
+    return std::max(size_t(1), size_t(std::thread::hardware_concurrency()));
+  }
+
   Context::Resource<internal::DataCopyConcurrencyResource>
       data_copy_concurrency_;
   Context::Resource<internal::CachePoolResource> cache_pool_;
@@ -530,6 +551,27 @@ struct ReadChunkImpl {
     return internal::GetTransformedArrayNDIterable(*lock.data(),
                                                    chunk_transform, arena);
   }
+
+  bool operator()(internal::ReadChunk::ReadArray,
+                  IndexTransformView<> chunk_transform,
+                  SharedOffsetArray<const void>& array) const {
+    // The decoded image is immutable, and may therefore be shared directly.
+    SharedArray<const void> data;
+    {
+      LockType lock{*entry};
+      assert(lock.data());
+      data = *lock.data();
+    }
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto transformed,
+        MakeTransformedArray(std::move(data),
+                             IndexTransform<>(chunk_transform)),
+        false);
+    TENSORSTORE_ASSIGN_OR_RETURN(array,
+                                 TryConvertToArray(std::move(transformed)),
+                                 false);
+    return true;
+  }
 };
 
 template <typename Specialization>
@@ -38,6 +38,7 @@ namespace {
 
 using ::tensorstore::internal_image::ImageInfo;
 using ::tensorstore::internal_image::JpegReader;
+using ::tensorstore::internal_image::JpegReaderOptions;
 using ::tensorstore::internal_image::JpegWriter;
 using ::tensorstore::internal_image::JpegWriterOptions;
 
@@ -76,7 +77,8 @@ struct JpegSpecialization : public JpegWriterOptions {
     return buffer;
   }
 
-  Result<SharedArray<uint8_t, 3>> DecodeImage(absl::Cord value) {
+  Result<SharedArray<uint8_t, 3>> DecodeImage(
+      absl::Cord value, const DecodeConcurrency& concurrency) {
     riegeli::CordReader<> buffer_reader(&value);
     JpegReader reader;
     TENSORSTORE_RETURN_IF_ERROR(reader.Initialize(&buffer_reader));
@@ -85,9 +87,13 @@ struct JpegSpecialization : public JpegWriterOptions {
                                       static_cast<Index>(info.width),
                                       static_cast<Index>(info.num_components)};
     SharedArray<uint8_t, 3> array_yxc = AllocateArray<uint8_t>(shape_yxc);
-    TENSORSTORE_RETURN_IF_ERROR(reader.Decode(tensorstore::span(
-        reinterpret_cast<unsigned char*>(array_yxc.data()),
-        array_yxc.num_elements() * array_yxc.dtype().size())));
+    JpegReaderOptions options;
+    options.executor = concurrency.executor;
+    options.max_parallelism = concurrency.max_parallelism;
+    TENSORSTORE_RETURN_IF_ERROR(reader.Decode(
+        tensorstore::span(reinterpret_cast<unsigned char*>(array_yxc.data()),
+                          array_yxc.num_elements() * array_yxc.dtype().size()),
+        options));
     return array_yxc;
   }
 };
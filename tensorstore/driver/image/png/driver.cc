@@ -76,7 +76,8 @@ struct PngSpecialization : public PngWriterOptions {
     return buffer;
   }
 
-  Result<SharedArray<uint8_t, 3>> DecodeImage(absl::Cord value) {
+  Result<SharedArray<uint8_t, 3>> DecodeImage(
+      absl::Cord value, const DecodeConcurrency& concurrency) {
     riegeli::CordReader<> buffer_reader(&value);
     PngReader reader;
     TENSORSTORE_RETURN_IF_ERROR(reader.Initialize(&buffer_reader));
@@ -0,0 +1,713 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+///
+/// The "tiff_chunked" driver exposes a tiled or stripped TIFF file as a chunked
+/// array.  Unlike the "tiff" driver, which decodes the entire image into a
+/// single cache entry, each tile (or strip) is a separate chunk cache entry
+/// that is fetched from the kvstore with a byte range request, so that only
+/// the parts of the file needed by a read are transferred.
+///
+/// The image file directories are parsed when the driver is opened.  Each
+/// subsequent tile read is conditioned on the storage generation observed at
+/// that time, so that a modification of the file is reported as an error
+/// rather than silently mixing data from different versions.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/array.h"
+#include "tensorstore/box.h"
+#include "tensorstore/chunk_layout.h"
+#include "tensorstore/codec_spec.h"
+#include "tensorstore/context.h"
+#include "tensorstore/contiguous_layout.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/driver/chunk_cache_driver.h"
+#include "tensorstore/driver/driver.h"
+#include "tensorstore/driver/driver_handle.h"
+#include "tensorstore/driver/driver_spec.h"
+#include "tensorstore/driver/registry.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_interval.h"
+#include "tensorstore/index_space/index_domain.h"
+#include "tensorstore/index_space/index_domain_builder.h"
+#include "tensorstore/index_space/index_transform.h"
+#include "tensorstore/internal/async_write_array.h"
+#include "tensorstore/internal/cache/async_cache.h"
+#include "tensorstore/internal/cache/cache.h"
+#include "tensorstore/internal/cache/cache_pool_resource.h"
+#include "tensorstore/internal/cache/chunk_cache.h"
+#include "tensorstore/internal/cache_key/cache_key.h"
+#include "tensorstore/internal/cache_key/std_optional.h"  // IWYU pragma: keep
+#include "tensorstore/internal/chunk_grid_specification.h"
+#include "tensorstore/internal/data_copy_concurrency_resource.h"
+#include "tensorstore/internal/image/tiff_directory.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/internal/json_binding/staleness_bound.h"  // IWYU pragma: keep
+#include "tensorstore/internal/json_binding/std_optional.h"  // IWYU pragma: keep
+#include "tensorstore/internal/memory.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/driver.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/open_mode.h"
+#include "tensorstore/rank.h"
+#include "tensorstore/schema.h"
+#include "tensorstore/serialization/absl_time.h"  // IWYU pragma: keep
+#include "tensorstore/serialization/std_optional.h"  // IWYU pragma: keep
+#include "tensorstore/staleness_bound.h"
+#include "tensorstore/transaction.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/garbage_collection/fwd.h"  // IWYU pragma: keep
+#include "tensorstore/util/quote_string.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace internal_image_driver {
+namespace {
+
+namespace jb = tensorstore::internal_json_binding;
+
+using ::tensorstore::internal_image::DecodeTiffChunk;
+using ::tensorstore::internal_image::TiffDirectory;
+using ::tensorstore::internal_image::TiffDirectoryParser;
+
+// Minimum number of bytes requested when reading the TIFF header or an image
+// file directory.  Directories (and their out-of-line values) are typically
+// stored contiguously, so a single speculative read usually suffices for all
+// of the directories of a file.
+constexpr uint64_t kMetadataReadSize = 64 * 1024;
+
+// Layout of the pages of a TIFF file exposed by the driver.
+struct TiffMetadata {
+  bool big_endian = false;
+
+  // Storage generation of the file from which the directories were parsed.
+  StorageGeneration generation;
+
+  // Selected pages; all have the same geometry and sample format.
+  std::vector<TiffDirectory> pages;
+
+  // Indicates whether the array has a leading "page" dimension.
+  bool has_page_dimension = false;
+
+  DataType dtype() const { return pages[0].dtype(); }
+  DimensionIndex rank() const { return has_page_dimension ? 4 : 3; }
+};
+
+using TiffMetadataPtr = std::shared_ptr<const TiffMetadata>;
+
+// Returns an error if `a` and `b` cannot be stacked into a single array.
+absl::Status ValidateCompatiblePages(const TiffDirectory& a,
+                                     const TiffDirectory& b) {
+  if (a.width != b.width || a.height != b.height ||
+      a.samples_per_pixel != b.samples_per_pixel ||
+      a.bits_per_sample != b.bits_per_sample ||
+      a.sample_format != b.sample_format ||
+      a.planar_configuration != b.planar_configuration ||
+      a.chunk_width != b.chunk_width || a.chunk_height != b.chunk_height) {
+    return absl::InvalidArgumentError(
+        "TIFF pages have differing layouts; \"page\" must be specified");
+  }
+  return absl::OkStatus();
+}
+
+// Selects the pages exposed by the driver from the parsed directories.
+Result<TiffMetadataPtr> GetTiffMetadata(const TiffDirectoryParser& parser,
+                                        StorageGeneration generation,
+                                        std::optional<int> page) {
+  auto metadata = std::make_shared<TiffMetadata>();
+  metadata->big_endian = parser.big_endian();
+  metadata->generation = std::move(generation);
+  const auto& directories = parser.directories();
+  if (page) {
+    if (*page < 0 || *page >= static_cast<int>(directories.size())) {
+      return absl::InvalidArgumentError(tensorstore::StrCat(
+          "page ", *page, " is out of range; TIFF file has ",
+          directories.size(), " pages"));
+    }
+    metadata->pages.push_back(directories[*page]);
+  } else {
+    // Reduced-resolution pages, such as thumbnails, are not part of the
+    // stack.
+    for (const auto& directory : directories) {
+      if (directory.is_reduced_resolution()) continue;
+      if (!metadata->pages.empty()) {
+        TENSORSTORE_RETURN_IF_ERROR(
+            ValidateCompatiblePages(metadata->pages[0], directory));
+      }
+      metadata->pages.push_back(directory);
+    }
+    if (metadata->pages.empty()) {
+      return absl::DataLossError("TIFF file contains no full-resolution pages");
+    }
+    metadata->has_page_dimension = true;
+  }
+  if (!metadata->dtype().valid()) {
+    const auto& directory = metadata->pages[0];
+    return absl::UnimplementedError(tensorstore::StrCat(
+        "TIFF sample format ", directory.sample_format, " with ",
+        directory.bits_per_sample, " bits per sample is not supported"));
+  }
+  return metadata;
+}
+
+// Asynchronously reads the image file directories of a TIFF file.
+struct TiffMetadataReader
+    : public internal::AtomicReferenceCount<TiffMetadataReader> {
+  kvstore::DriverPtr kvstore_driver;
+  std::string path;
+  absl::Time staleness_bound;
+  std::optional<int> page;
+  Executor executor;
+  Promise<TiffMetadataPtr> promise;
+
+  TiffDirectoryParser parser;
+  StorageGeneration generation;
+
+  // Set once a speculative read extends past the end of the file, after which
+  // only the exact ranges needed by the parser are requested.
+  bool exact_reads = false;
+
+  void Continue() {
+    if (!promise.result_needed()) return;
+    auto needed = parser.Parse();
+    if (!needed.ok()) {
+      promise.SetResult(std::move(needed).status());
+      return;
+    }
+    if (!*needed) {
+      promise.SetResult(GetTiffMetadata(parser, generation, page));
+      return;
+    }
+    IssueRead(**needed);
+  }
+
+  void IssueRead(TiffDirectoryParser::ByteRange range) {
+    const uint64_t size =
+        exact_reads ? range.size : std::max(range.size, kMetadataReadSize);
+    kvstore::ReadOptions options;
+    options.staleness_bound = staleness_bound;
+    options.generation_conditions.if_equal = generation;
+    options.byte_range = OptionalByteRangeRequest::Range(
+        range.offset, range.offset + size);
+    kvstore_driver->Read(path, std::move(options))
+        .ExecuteWhenReady([self = internal::IntrusivePtr<TiffMetadataReader>(
+                               this),
+                           range](ReadyFuture<kvstore::ReadResult> future) {
+          auto& r = future.result();
+          if (!r.ok()) {
+            if (!self->exact_reads && absl::IsOutOfRange(r.status())) {
+              self->exact_reads = true;
+              self->IssueRead(range);
+              return;
+            }
+            self->promise.SetResult(r.status());
+            return;
+          }
+          if (r->not_found()) {
+            self->promise.SetResult(absl::NotFoundError(tensorstore::StrCat(
+                "TIFF file ", tensorstore::QuoteString(self->path),
+                " not found")));
+            return;
+          }
+          if (r->aborted()) {
+            self->promise.SetResult(absl::AbortedError(tensorstore::StrCat(
+                "TIFF file ", tensorstore::QuoteString(self->path),
+                " was modified while reading its directories")));
+            return;
+          }
+          self->generation = r->stamp.generation;
+          self->parser.AddData(range.offset, r->value);
+          Executor executor = self->executor;
+          executor([self = std::move(self)] { self->Continue(); });
+        });
+  }
+};
+
+Future<TiffMetadataPtr> ReadTiffMetadata(kvstore::DriverPtr kvstore_driver,
+                                         std::string path,
+                                         absl::Time staleness_bound,
+                                         std::optional<int> page,
+                                         Executor executor) {
+  auto [promise, future] = PromiseFuturePair<TiffMetadataPtr>::Make();
+  auto reader = internal::MakeIntrusivePtr<TiffMetadataReader>();
+  reader->kvstore_driver = std::move(kvstore_driver);
+  reader->path = std::move(path);
+  reader->staleness_bound = staleness_bound;
+  reader->page = page;
+  reader->executor = std::move(executor);
+  reader->promise = std::move(promise);
+  reader->Continue();
+  return std::move(future);
+}
+
+class TiffChunkCache : public internal::ConcreteChunkCache {
+  using Base = internal::ConcreteChunkCache;
+
+ public:
+  using Base::Base;
+
+  template <typename EntryOrNode>
+  void DoRead(EntryOrNode& node, AsyncCacheReadRequest request);
+
+  class Entry : public internal::ChunkCache::Entry {
+   public:
+    using OwningCache = TiffChunkCache;
+    using internal::ChunkCache::Entry::Entry;
+    void DoRead(AsyncCacheReadRequest request) override {
+      GetOwningCache(*this).DoRead(*this, std::move(request));
+    }
+  };
+  class TransactionNode : public internal::ChunkCache::TransactionNode {
+   public:
+    using OwningCache = TiffChunkCache;
+    using internal::ChunkCache::TransactionNode::TransactionNode;
+    void DoRead(AsyncCacheReadRequest request) override {
+      GetOwningCache(*this).DoRead(*this, std::move(request));
+    }
+  };
+  Entry* DoAllocateEntry() final { return new Entry; }
+  size_t DoGetSizeofEntry() final { return sizeof(Entry); }
+  TransactionNode* DoAllocateTransactionNode(
+      internal::AsyncCache::Entry& entry) final {
+    return new TransactionNode(static_cast<Entry&>(entry));
+  }
+
+  TiffMetadataPtr metadata_;
+  kvstore::DriverPtr kvstore_driver_;
+  std::string path_;
+  std::optional<int> page_;
+  Context::Resource<internal::DataCopyConcurrencyResource>
+      data_copy_concurrency_;
+  Context::Resource<internal::CachePoolResource> cache_pool_;
+};
+
+template <typename EntryOrNode>
+void TiffChunkCache::DoRead(EntryOrNode& node, AsyncCacheReadRequest request) {
+  auto& entry = GetOwningEntry(node);
+  auto& cache = GetOwningCache(entry);
+  const TiffMetadata& metadata = *cache.metadata_;
+  span<const Index> cell_indices = entry.cell_indices();
+  size_t page = 0;
+  if (metadata.has_page_dimension) {
+    page = static_cast<size_t>(cell_indices[0]);
+    cell_indices = cell_indices.subspan(1);
+  }
+  const TiffDirectory& directory = metadata.pages[page];
+  const uint32_t row = cell_indices[0];
+  const uint32_t col = cell_indices[1];
+  const uint32_t plane = cell_indices[2];
+  const size_t chunk_index = directory.GetChunkIndex(plane, row, col);
+  const uint64_t offset = directory.chunk_offsets[chunk_index];
+  const uint64_t byte_count = directory.chunk_byte_counts[chunk_index];
+  if (byte_count == 0) {
+    // Sparse TIFF files leave unwritten tiles empty; they read as the fill
+    // value for as long as the directories remain valid.
+    node.ReadSuccess({{}, {metadata.generation, absl::InfiniteFuture()}});
+    return;
+  }
+
+  kvstore::ReadOptions options;
+  options.staleness_bound = request.staleness_bound;
+  options.batch = std::move(request.batch);
+  options.generation_conditions.if_equal = metadata.generation;
+  {
+    ReadLock<ReadData> lock{node};
+    options.generation_conditions.if_not_equal = lock.stamp().generation;
+  }
+  options.byte_range =
+      OptionalByteRangeRequest::Range(offset, offset + byte_count);
+  cache.kvstore_driver_->Read(cache.path_, std::move(options))
+      .ExecuteWhenReady([&node, row](ReadyFuture<kvstore::ReadResult> future) {
+        auto& r = future.result();
+        if (!r.ok()) {
+          node.ReadError(r.status());
+          return;
+        }
+        auto& cache = GetOwningCache(node);
+        if (r->aborted()) {
+          ReadState read_state;
+          {
+            ReadLock<ReadData> lock{node};
+            read_state = lock.read_state();
+          }
+          if (r->stamp.generation != cache.metadata_->generation ||
+              read_state.stamp.generation != cache.metadata_->generation) {
+            node.ReadError(absl::FailedPreconditionError(tensorstore::StrCat(
+                "TIFF file ", tensorstore::QuoteString(cache.path_),
+                " was modified after it was opened")));
+            return;
+          }
+          // Existing cached tile is still current.
+          read_state.stamp.time = r->stamp.time;
+          node.ReadSuccess(std::move(read_state));
+          return;
+        }
+        if (!r->has_value()) {
+          node.ReadError(absl::NotFoundError(tensorstore::StrCat(
+              "TIFF file ", tensorstore::QuoteString(cache.path_),
+              " not found")));
+          return;
+        }
+        cache.executor()([&node, row, value = r->value,
+                          stamp = r->stamp]() mutable {
+          auto& entry = GetOwningEntry(node);
+          auto& cache = GetOwningCache(entry);
+          const TiffMetadata& metadata = *cache.metadata_;
+          const auto& component_spec = cache.grid().components.front();
+          const TiffDirectory& directory =
+              metadata.pages[metadata.has_page_dimension
+                                 ? entry.cell_indices()[0]
+                                 : 0];
+          // The final strip of a stripped image may hold fewer rows.
+          const uint32_t num_rows = std::min<uint32_t>(
+              directory.chunk_height,
+              directory.height - row * directory.chunk_height);
+          auto full_array =
+              AllocateArray(component_spec.shape(), c_order, value_init,
+                            component_spec.dtype());
+          const size_t row_bytes = static_cast<size_t>(directory.chunk_width) *
+                                   directory.samples_per_chunk() *
+                                   full_array.dtype().size();
+          auto status = DecodeTiffChunk(
+              directory, metadata.big_endian, value, num_rows,
+              span(static_cast<unsigned char*>(full_array.data()),
+                   row_bytes * num_rows));
+          if (!status.ok()) {
+            node.ReadError(tensorstore::MaybeAnnotateStatus(
+                std::move(status),
+                tensorstore::StrCat("Error decoding TIFF chunk ",
+                                    cache.grid().GetCellDomain(
+                                        0, entry.cell_indices()))));
+            return;
+          }
+          auto read_data =
+              tensorstore::internal::make_shared_for_overwrite<ReadData[]>(1);
+          read_data.get()[0] = std::move(full_array);
+          node.ReadSuccess({std::move(read_data), std::move(stamp)});
+        });
+      });
+}
+
+class TiffChunkedDriverSpec
+    : public internal::RegisteredDriverSpec<TiffChunkedDriverSpec,
+                                            /*Parent=*/internal::DriverSpec> {
+ public:
+  constexpr static const char id[] = "tiff_chunked";
+
+  kvstore::Spec store;
+  Context::Resource<internal::DataCopyConcurrencyResource>
+      data_copy_concurrency;
+  Context::Resource<internal::CachePoolResource> cache_pool;
+  StalenessBound data_staleness;
+  std::optional<int> page;
+
+  constexpr static auto ApplyMembers = [](auto& x, auto f) {
+    return f(internal::BaseCast<internal::DriverSpec>(x), x.store,
+             x.data_copy_concurrency, x.cache_pool, x.data_staleness, x.page);
+  };
+
+  absl::Status ValidateSchema() {
+    TENSORSTORE_RETURN_IF_ERROR(
+        schema.Set(RankConstraint{page.has_value() ? 3 : 4}));
+    if (schema.codec().valid()) {
+      return absl::InvalidArgumentError(
+          "codec not supported by \"tiff_chunked\" driver");
+    }
+    if (schema.fill_value().valid()) {
+      return absl::InvalidArgumentError(
+          "fill_value not supported by \"tiff_chunked\" driver");
+    }
+    if (schema.dimension_units().valid()) {
+      return absl::InvalidArgumentError(
+          "dimension_units not supported by \"tiff_chunked\" driver");
+    }
+    if (auto domain = schema.domain(); domain.valid()) {
+      if (!std::all_of(domain.origin().begin(), domain.origin().end(),
+                       [](auto x) { return x == 0; })) {
+        return absl::InvalidArgumentError("image domain must have 0-origin");
+      }
+    }
+    return absl::OkStatus();
+  }
+
+  constexpr static auto default_json_binder = jb::Sequence(
+      jb::Member(
+          internal::DataCopyConcurrencyResource::id,
+          jb::Projection<&TiffChunkedDriverSpec::data_copy_concurrency>()),
+      jb::Member(internal::CachePoolResource::id,
+                 jb::Projection<&TiffChunkedDriverSpec::cache_pool>()),
+      jb::Projection<&TiffChunkedDriverSpec::store>(
+          jb::KvStoreSpecAndPathJsonBinder),
+      jb::Member("recheck_cached_data",
+                 jb::Projection<&TiffChunkedDriverSpec::data_staleness>(
+                     jb::DefaultValue([](auto* obj) {
+                       obj->bounded_by_open_time = true;
+                     }))),
+      jb::Member("page", jb::Projection<&TiffChunkedDriverSpec::page>()),
+      jb::Initialize([](auto* obj) -> absl::Status {
+        return obj->ValidateSchema();
+      }));
+
+  absl::Status ApplyOptions(SpecOptions&& options) override {
+    // The directories are stored in the same file as the data, so they are
+    // revalidated according to the maximum of the requested bounds.
+    if (options.recheck_cached_data.specified()) {
+      data_staleness = StalenessBound(options.recheck_cached_data);
+    }
+    if (options.recheck_cached_metadata.specified()) {
+      StalenessBound bound(options.recheck_cached_metadata);
+      if (!options.recheck_cached_data.specified() ||
+          bound.time > data_staleness.time) {
+        data_staleness = std::move(bound);
+      }
+    }
+    if (options.kvstore.valid()) {
+      if (store.valid()) {
+        return absl::InvalidArgumentError("\"kvstore\" is already specified");
+      }
+      store = std::move(options.kvstore);
+    }
+    TENSORSTORE_RETURN_IF_ERROR(schema.Set(static_cast<Schema&&>(options)));
+    return ValidateSchema();
+  }
+
+  kvstore::Spec GetKvstore() const override { return store; }
+
+  OpenMode open_mode() const override { return OpenMode::open; }
+
+  Future<internal::Driver::Handle> Open(
+      internal::DriverOpenRequest request) const override;
+
+  Result<internal::Driver::Handle> MakeDriverHandle(
+      kvstore::DriverPtr kvstore_driver, TiffMetadataPtr metadata,
+      internal::OpenTransactionPtr transaction,
+      StalenessBound data_staleness_bound) const;
+};
+
+class TiffChunkedDriver;
+using TiffChunkedDriverBase = internal::RegisteredDriver<
+    TiffChunkedDriver,
+    internal::ChunkGridSpecificationDriver<
+        TiffChunkCache,
+        internal::ChunkCacheReadWriteDriverMixin<TiffChunkedDriver,
+                                                 internal::Driver>>>;
+
+class TiffChunkedDriver : public TiffChunkedDriverBase {
+  using Base = TiffChunkedDriverBase;
+
+ public:
+  using Base::Base;
+
+  Result<internal::TransformedDriverSpec> GetBoundSpec(
+      internal::OpenTransactionPtr transaction,
+      IndexTransformView<> transform) override;
+
+  Result<CodecSpec> GetCodec() override { return CodecSpec{}; }
+
+  Result<SharedArray<const void>> GetFillValue(
+      IndexTransformView<> transform) override {
+    return {std::in_place};
+  }
+
+  Result<ChunkLayout> GetChunkLayout(IndexTransformView<> transform) override {
+    return internal::GetChunkLayoutFromGrid(cache()->grid().components[0]) |
+           transform;
+  }
+
+  KvStore GetKvstore(const Transaction& transaction) override {
+    auto& cache = *this->cache();
+    return KvStore(cache.kvstore_driver_, cache.path_, transaction);
+  }
+
+  /// Missing (sparse) tiles read as zero.
+  bool fill_missing_data_reads() const { return true; }
+
+  bool store_data_equal_to_fill_value() const { return false; }
+};
+
+Result<internal::TransformedDriverSpec> TiffChunkedDriver::GetBoundSpec(
+    internal::OpenTransactionPtr transaction, IndexTransformView<> transform) {
+  auto driver_spec = internal::DriverSpec::Make<TiffChunkedDriverSpec>();
+  driver_spec->context_binding_state_ = ContextBindingState::bound;
+  auto& cache = *this->cache();
+  TENSORSTORE_ASSIGN_OR_RETURN(driver_spec->store.driver,
+                               cache.kvstore_driver_->GetBoundSpec());
+  driver_spec->store.path = cache.path_;
+  driver_spec->data_copy_concurrency = cache.data_copy_concurrency_;
+  driver_spec->cache_pool = cache.cache_pool_;
+  driver_spec->data_staleness = this->data_staleness_bound();
+  driver_spec->page = cache.page_;
+  TENSORSTORE_RETURN_IF_ERROR(
+      driver_spec->schema.Set(RankConstraint{this->rank()}));
+  TENSORSTORE_RETURN_IF_ERROR(driver_spec->schema.Set(dtype()));
+  internal::TransformedDriverSpec spec;
+  spec.transform = transform;
+  spec.driver_spec = std::move(driver_spec);
+  return spec;
+}
+
+Result<internal::Driver::Handle> TiffChunkedDriverSpec::MakeDriverHandle(
+    kvstore::DriverPtr kvstore_driver, TiffMetadataPtr metadata,
+    internal::OpenTransactionPtr transaction,
+    StalenessBound data_staleness_bound) const {
+  const TiffDirectory& directory = metadata->pages[0];
+  const DataType dtype = metadata->dtype();
+  if (schema.dtype().valid() && schema.dtype() != dtype) {
+    return absl::FailedPreconditionError(tensorstore::StrCat(
+        "dtype from TIFF file (", dtype, ") does not match dtype in schema (",
+        schema.dtype(), ")"));
+  }
+
+  // Array dimensions are (page, y, x, c), or (y, x, c) if a single page was
+  // selected.  The chunk grid follows the TIFF tiles (or strips) and, for
+  // planar images, the sample planes.
+  const DimensionIndex rank = metadata->rank();
+  const DimensionIndex yxc = rank - 3;
+  Box<> bounds(rank);
+  std::vector<Index> chunk_shape(rank);
+  if (metadata->has_page_dimension) {
+    bounds[0] = IndexInterval::UncheckedSized(0, metadata->pages.size());
+    chunk_shape[0] = 1;
+  }
+  bounds[yxc] = IndexInterval::UncheckedSized(0, directory.height);
+  bounds[yxc + 1] = IndexInterval::UncheckedSized(0, directory.width);
+  bounds[yxc + 2] =
+      IndexInterval::UncheckedSized(0, directory.samples_per_pixel);
+  chunk_shape[yxc] = directory.chunk_height;
+  chunk_shape[yxc + 1] = directory.chunk_width;
+  chunk_shape[yxc + 2] = directory.samples_per_chunk();
+
+  auto transform = IdentityTransform(bounds);
+  if (auto schema_domain = schema.domain(); schema_domain.valid()) {
+    TENSORSTORE_RETURN_IF_ERROR(
+        MergeIndexDomains(schema_domain, transform.domain()),
+        tensorstore::MaybeAnnotateStatus(
+            _, "Mismatch between schema domain and TIFF file"));
+  }
+
+  std::string cache_identifier;
+  internal::EncodeCacheKey(&cache_identifier, kvstore_driver, store.path,
+                           page, data_copy_concurrency,
+                           metadata->generation.value);
+  auto cache = internal::GetCache<TiffChunkCache>(
+      cache_pool->get(), cache_identifier, [&] {
+        // Missing tiles read as zero, which is also the value used by the
+        // chunk cache for portions of edge tiles outside the image.
+        auto fill_value =
+            BroadcastArray(AllocateArray(/*shape=*/span<const Index>{}, c_order,
+                                         value_init, dtype),
+                           BoxView<>(rank))
+                .value();
+        internal::ChunkGridSpecification::ComponentList components;
+        components.emplace_back(
+            internal::AsyncWriteArray::Spec{std::move(fill_value), bounds},
+            std::move(chunk_shape));
+        auto cache = std::make_unique<TiffChunkCache>(
+            internal::ChunkGridSpecification(std::move(components)),
+            data_copy_concurrency->executor);
+        cache->metadata_ = metadata;
+        cache->kvstore_driver_ = kvstore_driver;
+        cache->path_ = store.path;
+        cache->page_ = page;
+        cache->data_copy_concurrency_ = data_copy_concurrency;
+        cache->cache_pool_ = cache_pool;
+        return cache;
+      });
+
+  internal::Driver::Handle handle;
+  handle.transaction =
+      internal::TransactionState::ToTransaction(std::move(transaction));
+  handle.transform = std::move(transform);
+  handle.driver = internal::MakeReadWritePtr<TiffChunkedDriver>(
+      ReadWriteMode::read,
+      TiffChunkedDriver::Initializer{std::move(cache), /*component_index=*/0,
+                                     std::move(data_staleness_bound)});
+  return handle;
+}
+
+Future<internal::Driver::Handle> TiffChunkedDriverSpec::Open(
+    internal::DriverOpenRequest request) const {
+  if ((request.read_write_mode & ReadWriteMode::write) ==
+      ReadWriteMode::write) {
+    return absl::InvalidArgumentError("only reading is supported");
+  }
+  if (!store.valid()) {
+    return absl::InvalidArgumentError("\"kvstore\" must be specified");
+  }
+  auto data_staleness_bound = data_staleness.BoundAtOpen(absl::Now());
+  return PromiseFuturePair<internal::Driver::Handle>::LinkValue(
+             [spec = internal::IntrusivePtr<const TiffChunkedDriverSpec>(this),
+              data_staleness_bound,
+              transaction = std::move(request.transaction)](
+                 Promise<internal::Driver::Handle> promise,
+                 ReadyFuture<kvstore::DriverPtr> future) mutable {
+               auto kvstore_driver = *future.result();
+               auto metadata_future = ReadTiffMetadata(
+                   kvstore_driver, spec->store.path, data_staleness_bound.time,
+                   spec->page, spec->data_copy_concurrency->executor);
+               LinkValue(
+                   [spec = std::move(spec),
+                    kvstore_driver = std::move(kvstore_driver),
+                    data_staleness_bound,
+                    transaction = std::move(transaction)](
+                       Promise<internal::Driver::Handle> promise,
+                       ReadyFuture<TiffMetadataPtr> future) mutable {
+                     promise.SetResult(spec->MakeDriverHandle(
+                         std::move(kvstore_driver), *future.result(),
+                         std::move(transaction),
+                         std::move(data_staleness_bound)));
+                   },
+                   std::move(promise), std::move(metadata_future));
+             },
+             kvstore::Open(store.driver))
+      .future;
+}
+
+const internal::DriverRegistration<TiffChunkedDriverSpec>
+    tiff_chunked_driver_registration;
+
+}  // namespace
+}  // namespace internal_image_driver
+
+namespace garbage_collection {
+template <>
+struct GarbageCollection<internal_image_driver::TiffChunkedDriver> {
+  static constexpr bool required() { return false; }
+};
+}  // namespace garbage_collection
+}  // namespace tensorstore
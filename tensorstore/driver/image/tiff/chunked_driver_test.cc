@@ -0,0 +1,261 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// Tests of the "tiff_chunked" driver.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/array.h"
+#include "tensorstore/context.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_space/dim_expression.h"
+#include "tensorstore/internal/testing/json_gtest.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/memory/memory_key_value_store.h"
+#include "tensorstore/kvstore/mock_kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/open.h"
+#include "tensorstore/open_mode.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::Context;
+using ::tensorstore::dtype_v;
+using ::tensorstore::Index;
+using ::tensorstore::JsonSubValuesMatch;
+using ::tensorstore::MatchesStatus;
+
+constexpr uint32_t kWidth = 20;
+constexpr uint32_t kHeight = 12;
+constexpr uint32_t kTileSize = 16;
+constexpr uint32_t kNumPages = 2;
+
+uint16_t ExpectedValue(Index page, Index y, Index x) {
+  return static_cast<uint16_t>(page * 1000 + y * kWidth + x);
+}
+
+void AppendLE(std::string& out, uint32_t value, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+}
+
+// Returns a little-endian TIFF file with `kNumPages` uncompressed, tiled,
+// single-sample `uint16` pages, followed by a reduced-resolution page which
+// is excluded from the page stack.  The offsets of the tiles of each page are
+// appended to `tile_offsets`.
+std::string MakeTiledTiff(std::vector<uint32_t>& tile_offsets) {
+  const uint32_t tiles_across = (kWidth + kTileSize - 1) / kTileSize;
+  const uint32_t tiles_down = (kHeight + kTileSize - 1) / kTileSize;
+  const uint32_t tile_bytes = kTileSize * kTileSize * 2;
+
+  std::string file = "II";
+  AppendLE(file, 42, 2);
+  AppendLE(file, 0, 4);
+  size_t next_ifd_pos = 4;
+
+  for (uint32_t page = 0; page <= kNumPages; ++page) {
+    const bool thumbnail = (page == kNumPages);
+    // Tile data.
+    std::vector<uint32_t> offsets, byte_counts;
+    for (uint32_t ty = 0; ty < tiles_down; ++ty) {
+      for (uint32_t tx = 0; tx < tiles_across; ++tx) {
+        offsets.push_back(file.size());
+        tile_offsets.push_back(file.size());
+        byte_counts.push_back(tile_bytes);
+        for (uint32_t y = 0; y < kTileSize; ++y) {
+          for (uint32_t x = 0; x < kTileSize; ++x) {
+            const uint32_t iy = ty * kTileSize + y, ix = tx * kTileSize + x;
+            AppendLE(file,
+                     (iy < kHeight && ix < kWidth && !thumbnail)
+                         ? ExpectedValue(page, iy, ix)
+                         : 0,
+                     2);
+          }
+        }
+      }
+    }
+    // Out-of-line tile offsets and byte counts.
+    const uint32_t offsets_pos = file.size();
+    for (uint32_t v : offsets) AppendLE(file, v, 4);
+    const uint32_t byte_counts_pos = file.size();
+    for (uint32_t v : byte_counts) AppendLE(file, v, 4);
+
+    // Directory.
+    struct Entry {
+      uint16_t tag, type;
+      uint32_t count, value;
+    };
+    const Entry entries[] = {
+        {254, 4, 1, thumbnail ? 1u : 0u},  // NewSubfileType
+        {256, 4, 1, kWidth},               // ImageWidth
+        {257, 4, 1, kHeight},              // ImageLength
+        {258, 3, 1, 16},                   // BitsPerSample
+        {259, 3, 1, 1},                    // Compression
+        {262, 3, 1, 1},                    // PhotometricInterpretation
+        {277, 3, 1, 1},                    // SamplesPerPixel
+        {322, 4, 1, kTileSize},            // TileWidth
+        {323, 4, 1, kTileSize},            // TileLength
+        {324, 4, static_cast<uint32_t>(offsets.size()), offsets_pos},
+        {325, 4, static_cast<uint32_t>(byte_counts.size()), byte_counts_pos},
+        {339, 3, 1, 1},  // SampleFormat
+    };
+    const uint32_t ifd_offset = file.size();
+    for (size_t i = 0; i < 4; ++i) {
+      file[next_ifd_pos + i] =
+          static_cast<char>((ifd_offset >> (8 * i)) & 0xff);
+    }
+    AppendLE(file, std::size(entries), 2);
+    for (const auto& entry : entries) {
+      AppendLE(file, entry.tag, 2);
+      AppendLE(file, entry.type, 2);
+      AppendLE(file, entry.count, 4);
+      if (entry.count == 1 && entry.type == 3) {
+        AppendLE(file, entry.value, 2);
+        AppendLE(file, 0, 2);
+      } else {
+        // Either a single LONG value or the offset of out-of-line values.
+        AppendLE(file, entry.value, 4);
+      }
+    }
+    next_ifd_pos = file.size();
+    AppendLE(file, 0, 4);
+  }
+  return file;
+}
+
+class TiffChunkedDriverTest : public ::testing::Test {
+ protected:
+  Context context = Context::Default();
+  tensorstore::internal::MockKeyValueStore::MockPtr mock_kvstore =
+      *context.GetResource<tensorstore::internal::MockKeyValueStoreResource>()
+           .value();
+  tensorstore::kvstore::DriverPtr memory_store =
+      tensorstore::GetMemoryKeyValueStore();
+  std::vector<uint32_t> tile_offsets;
+
+ public:
+  TiffChunkedDriverTest() {
+    mock_kvstore->forward_to = memory_store;
+    mock_kvstore->log_requests = true;
+    TENSORSTORE_CHECK_OK(tensorstore::kvstore::Write(
+                             tensorstore::KvStore(memory_store), "a.tif",
+                             absl::Cord(MakeTiledTiff(tile_offsets)))
+                             .result());
+  }
+
+  ::nlohmann::json Spec() {
+    return {
+        {"driver", "tiff_chunked"},
+        {"kvstore", {{"driver", "mock_key_value_store"}, {"path", "a.tif"}}},
+    };
+  }
+};
+
+TEST_F(TiffChunkedDriverTest, OpenAllPages) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      tensorstore::Open(Spec(), context, tensorstore::ReadWriteMode::read)
+          .result());
+  EXPECT_EQ(dtype_v<uint16_t>, store.dtype());
+  EXPECT_THAT(store.domain().shape(),
+              ::testing::ElementsAre(kNumPages, kHeight, kWidth, 1));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto layout, store.chunk_layout());
+  EXPECT_THAT(layout.read_chunk_shape(),
+              ::testing::ElementsAre(1, kTileSize, kTileSize, 1));
+}
+
+TEST_F(TiffChunkedDriverTest, ReadSingleTile) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      tensorstore::Open(Spec(), context, tensorstore::ReadWriteMode::read)
+          .result());
+  mock_kvstore->request_log.pop_all();
+
+  // Reads only the second tile of the second page.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto array,
+      tensorstore::Read(store | tensorstore::Dims(0).IndexSlice(1) |
+                        tensorstore::Dims(0, 1, 2).HalfOpenInterval(
+                            {2, 17, 0}, {5, 19, 1}))
+          .result());
+  auto* data = static_cast<const uint16_t*>(array.data());
+  for (Index y = 2; y < 5; ++y) {
+    for (Index x = 17; x < 19; ++x) {
+      EXPECT_EQ(ExpectedValue(1, y, x), data[(y - 2) * 2 + (x - 17)])
+          << "y=" << y << ", x=" << x;
+    }
+  }
+  const uint32_t tile_offset = tile_offsets[3];
+  EXPECT_THAT(mock_kvstore->request_log.pop_all(),
+              ::testing::ElementsAre(JsonSubValuesMatch({
+                  {"/type", "read"},
+                  {"/key", "a.tif"},
+                  {"/byte_range_inclusive_min", tile_offset},
+                  {"/byte_range_exclusive_max",
+                   tile_offset + kTileSize * kTileSize * 2},
+              })));
+}
+
+TEST_F(TiffChunkedDriverTest, ReadPage) {
+  auto spec = Spec();
+  spec["page"] = 1;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      tensorstore::Open(spec, context, tensorstore::ReadWriteMode::read)
+          .result());
+  EXPECT_THAT(store.domain().shape(),
+              ::testing::ElementsAre(kHeight, kWidth, 1));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto array,
+                                   tensorstore::Read(store).result());
+  auto* data = static_cast<const uint16_t*>(array.data());
+  for (Index y = 0; y < kHeight; ++y) {
+    for (Index x = 0; x < kWidth; ++x) {
+      EXPECT_EQ(ExpectedValue(1, y, x), data[y * kWidth + x])
+          << "y=" << y << ", x=" << x;
+    }
+  }
+}
+
+TEST_F(TiffChunkedDriverTest, InvalidPage) {
+  auto spec = Spec();
+  spec["page"] = 5;
+  EXPECT_THAT(
+      tensorstore::Open(spec, context, tensorstore::ReadWriteMode::read)
+          .result(),
+      MatchesStatus(absl::StatusCode::kInvalidArgument, ".*out of range.*"));
+}
+
+TEST_F(TiffChunkedDriverTest, WriteNotSupported) {
+  EXPECT_THAT(tensorstore::Open(Spec(), context,
+                                tensorstore::ReadWriteMode::read_write)
+                  .result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            ".*only reading is supported.*"));
+}
+
+}  // namespace
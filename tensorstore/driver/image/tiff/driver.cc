@@ -92,7 +92,8 @@ struct TiffSpecialization : public TiffReadOptions {
     return output;
   }
 
-  Result<SharedArray<uint8_t, 3>> DecodeImage(absl::Cord value) {
+  Result<SharedArray<uint8_t, 3>> DecodeImage(
+      absl::Cord value, const DecodeConcurrency& concurrency) {
     SharedArray<uint8_t, 3> array_yxc;
     auto status = [&]() -> absl::Status {
       riegeli::CordReader<> buffer_reader(&value);
@@ -38,6 +38,7 @@ namespace {
 
 using ::tensorstore::internal_image::ImageInfo;
 using ::tensorstore::internal_image::WebPReader;
+using ::tensorstore::internal_image::WebPReaderOptions;
 using ::tensorstore::internal_image::WebPWriter;
 using ::tensorstore::internal_image::WebPWriterOptions;
 
@@ -80,7 +81,8 @@ struct WebPSpecialization : public WebPWriterOptions {
     return buffer;
   }
 
-  Result<SharedArray<uint8_t, 3>> DecodeImage(absl::Cord value) {
+  Result<SharedArray<uint8_t, 3>> DecodeImage(
+      absl::Cord value, const DecodeConcurrency& concurrency) {
     riegeli::CordReader<> buffer_reader(&value);
     WebPReader reader;
     TENSORSTORE_RETURN_IF_ERROR(reader.Initialize(&buffer_reader));
@@ -93,9 +95,12 @@ struct WebPSpecialization : public WebPWriterOptions {
                                       static_cast<Index>(info.width),
                                       static_cast<Index>(info.num_components)};
     SharedArray<uint8_t, 3> array_yxc = AllocateArray<uint8_t>(shape_yxc);
-    TENSORSTORE_RETURN_IF_ERROR(reader.Decode(tensorstore::span(
-        reinterpret_cast<unsigned char*>(array_yxc.data()),
-        array_yxc.num_elements() * array_yxc.dtype().size())));
+    WebPReaderOptions options;
+    options.use_threads = concurrency.max_parallelism > 1;
+    TENSORSTORE_RETURN_IF_ERROR(reader.Decode(
+        tensorstore::span(reinterpret_cast<unsigned char*>(array_yxc.data()),
+                          array_yxc.num_elements() * array_yxc.dtype().size()),
+        options));
     return array_yxc;
   }
 };
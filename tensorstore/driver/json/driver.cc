@@ -438,6 +438,14 @@ struct ReadChunkImpl {
                                                 sub_value),
         std::move(chunk_transform), arena);
   }
+
+  bool operator()(ReadChunk::ReadArray,
+                  IndexTransformView<> /*chunk_transform*/,
+                  SharedOffsetArray<const void>& /*array*/) const {
+    // The chunk consists of a single JSON value, so there is nothing to be
+    // gained by avoiding the copy.
+    return false;
+  }
 };
 
 /// TensorStore Driver ReadChunk implementation for the case of a transactional
@@ -488,6 +496,13 @@ struct ReadChunkTransactionImpl {
     return GetTransformedArrayNDIterable(std::move(value), chunk_transform,
                                          arena);
   }
+
+  bool operator()(ReadChunk::ReadArray,
+                  IndexTransformView<> /*chunk_transform*/,
+                  SharedOffsetArray<const void>& /*array*/) {
+    // The value is computed from uncommitted changes on each read.
+    return false;
+  }
 };
 
 void JsonDriver::Read(ReadRequest request, ReadChunkReceiver receiver) {
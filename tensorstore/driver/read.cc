@@ -14,12 +14,21 @@
 
 #include "tensorstore/driver/read.h"
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
 #include <atomic>
 #include <memory>
+#include <thread>  // NOLINT
 #include <type_traits>
 #include <utility>
+#include <vector>
 
+#include "absl/base/call_once.h"
 #include "absl/status/status.h"
+#include "absl/strings/str_format.h"
+#include "absl/synchronization/mutex.h"
 #include "tensorstore/array.h"
 #include "tensorstore/batch.h"
 #include "tensorstore/box.h"
@@ -32,6 +41,7 @@
 #include "tensorstore/driver/driver_handle.h"
 #include "tensorstore/index.h"
 #include "tensorstore/index_space/alignment.h"
+#include "tensorstore/index_space/dim_expression.h"
 #include "tensorstore/index_space/index_transform.h"
 #include "tensorstore/index_space/transformed_array.h"
 #include "tensorstore/internal/intrusive_ptr.h"
@@ -43,6 +53,7 @@
 #include "tensorstore/internal/nditerable_transformed_array.h"
 #include "tensorstore/internal/nditerable_util.h"
 #include "tensorstore/internal/tagged_ptr.h"
+#include "tensorstore/internal/thread/parallel_for.h"
 #include "tensorstore/internal/tracing/operation_trace_span.h"
 #include "tensorstore/open_mode.h"
 #include "tensorstore/progress.h"
@@ -57,6 +68,7 @@
 #include "tensorstore/util/extents.h"
 #include "tensorstore/util/future.h"
 #include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
 #include "tensorstore/util/status.h"
 
 namespace tensorstore {
@@ -64,6 +76,17 @@ namespace internal {
 
 namespace {
 
+/// Minimum number of bytes copied by each concurrent sub-box copy of a single
+/// chunk.  Chunks smaller than twice this size are copied by a single thread.
+constexpr Index kMinParallelCopyBytesPerTask = 8 * 1024 * 1024;
+
+/// Returns the maximum number of threads used to copy a single chunk.
+size_t GetMaxChunkCopyParallelism() {
+  static const size_t max_parallelism =
+      std::max(size_t(1), size_t(std::thread::hardware_concurrency()));
+  return max_parallelism;
+}
+
 /// Local state for the asynchronous operation initiated by the two `DriverRead`
 /// overloads.
 ///
@@ -86,7 +109,11 @@ namespace {
 ///
 /// 4. For each `ReadChunk` received, `ReadChunkReceiver` invokes `ReadChunkOp`
 ///    using `executor` to copy the data from the `ReadChunk` to the appropriate
-///    portion of the `target` array.
+///    portion of the `target` array.  When reading into a new read-only array
+///    with `can_reference_cached_data`, a single chunk that covers the entire
+///    domain may instead be returned directly as a view obtained from
+///    `ReadChunk::ReadArray`; in that case, the `target` array, which is
+///    allocated only once a chunk must be copied, is never allocated.
 ///
 /// 5. Once all work has finished (either because all chunks were processed
 ///    successfully, an error occurred, or all references to the future
@@ -110,8 +137,41 @@ struct ReadState
   Promise<PromiseValue> promise;
   std::atomic<Index> copied_elements{0};
   Index total_elements;
+  /// Indicates that the promise result may be set to a view of the chunk data
+  /// rather than `target`, if a single chunk covers the entire domain.  Only
+  /// used if `PromiseValue` is `SharedOffsetArray<const void>`, since the
+  /// cached data must not be modified.
+  bool reference_cached_data = false;
+  /// Parameters of the new `target` array, only used when reading into a new
+  /// array.  If `reference_cached_data` is `true`, allocation of `target` is
+  /// deferred to `AllocateTarget`.
+  Box<> target_domain;
+  DataType target_dtype;
+  ContiguousLayoutOrder target_layout_order = c_order;
+  absl::once_flag allocate_target_once;
+  SharedOffsetArray<void> deferred_target;
   internal_tracing::OperationTraceSpan tspan{"tensorstore.Read"};
 
+  ~ReadState() {
+    if constexpr (!std::is_void_v<PromiseValue>) {
+      // Has no effect if an error, or a view of the chunk data, has already
+      // been set.
+      if (deferred_target.valid()) {
+        SetDeferredResult(promise, std::move(deferred_target));
+      }
+    }
+  }
+
+  /// Allocates the deferred `target` array upon the first chunk that must be
+  /// copied.
+  void AllocateTarget() {
+    absl::call_once(allocate_target_once, [&] {
+      deferred_target = AllocateArray(target_domain, target_layout_order,
+                                      default_init, target_dtype);
+      target = deferred_target;
+    });
+  }
+
   void SetError(absl::Status error) {
     SetDeferredResult(promise, std::move(error));
   }
@@ -131,21 +191,64 @@ struct ReadChunkOp {
   ReadChunk chunk;
   IndexTransform<> cell_transform;
   void operator()() {
+    if constexpr (std::is_same_v<PromiseValue,
+                                 SharedOffsetArray<const void>>) {
+      if (state->reference_cached_data) {
+        if (TryReadArray()) return;
+        state->AllocateTarget();
+      }
+    }
     // Map the portion of the target array that corresponds to this chunk to
     // the index space expected by the chunk.
     TENSORSTORE_ASSIGN_OR_RETURN(
         auto target,
         ApplyIndexTransform(std::move(cell_transform), state->target),
         state->SetError(_));
-    absl::Status copy_status =
-        internal::CopyReadChunk(chunk.impl, std::move(chunk.transform),
-                                state->data_type_conversion, target);
+    // Large chunks are split across the executor, since otherwise a read that
+    // intersects a single chunk is copied by a single thread.
+    absl::Status copy_status = internal::CopyReadChunkParallel(
+        state->executor, GetMaxChunkCopyParallelism(),
+        kMinParallelCopyBytesPerTask, chunk.impl, std::move(chunk.transform),
+        state->data_type_conversion, target);
     if (copy_status.ok()) {
       state->UpdateProgress(ProductOfExtents(target.shape()));
     } else {
       state->SetError(std::move(copy_status));
     }
   }
+
+  /// Attempts to set the result to a view of the chunk data, which is possible
+  /// only if this chunk covers the entire domain and no data type conversion
+  /// is required.  In that case, the newly-allocated `target` array is unused.
+  bool TryReadArray() {
+    if ((state->data_type_conversion.flags &
+         DataTypeConversionFlags::kCanReinterpretCast) ==
+        DataTypeConversionFlags{}) {
+      return false;
+    }
+    if (cell_transform.domain().num_elements() != state->total_elements) {
+      return false;
+    }
+    // Map the target domain back to the chunk.
+    auto inverse_cell_transform = InverseTransform(cell_transform);
+    if (!inverse_cell_transform.ok()) return false;
+    auto chunk_transform =
+        ComposeTransforms(chunk.transform, *inverse_cell_transform);
+    if (!chunk_transform.ok()) return false;
+    SharedOffsetArray<const void> array;
+    if (!chunk.impl(ReadChunk::ReadArray{}, *chunk_transform, array) ||
+        array.domain() != state->target_domain) {
+      return false;
+    }
+    state->UpdateProgress(array.num_elements());
+    SetDeferredResult(
+        state->promise,
+        SharedOffsetArray<const void>(
+            SharedElementPointer<const void>(array.pointer(),
+                                             state->target_dtype),
+            array.layout()));
+    return true;
+  }
 };
 
 /// FlowReceiver used by the two `DriverRead` overloads to copy data from chunks
@@ -200,12 +303,13 @@ struct DriverReadIntoExistingInitiateOp {
 
 /// Callback used by `DriverRead` to initiate a read into a new array once the
 /// source transform bounds have been resolved.
+template <typename PromiseValue>
 struct DriverReadIntoNewInitiateOp {
-  using State = ReadState<SharedOffsetArray<void>>;
+  using State = ReadState<PromiseValue>;
   IntrusivePtr<State> state;
   DataType target_dtype;
   ContiguousLayoutOrder target_layout_order;
-  void operator()(Promise<SharedOffsetArray<void>> promise,
+  void operator()(Promise<PromiseValue> promise,
                   ReadyFuture<IndexTransform<>> source_transform_future) {
     IndexTransform<> source_transform =
         std::move(source_transform_future.value());
@@ -216,12 +320,18 @@ struct DriverReadIntoNewInitiateOp {
       return;
     }
 
-    auto array = AllocateArray(source_transform.domain().box(),
-                               target_layout_order, default_init, target_dtype);
-    auto& r = promise.raw_result() = std::move(array);
-    state->target = *r;
-    state->promise = std::move(promise);
+    state->target_domain = source_transform.domain().box();
+    state->target_dtype = target_dtype;
+    state->target_layout_order = target_layout_order;
     state->total_elements = source_transform.input_domain().num_elements();
+    if (state->total_elements == 0) state->reference_cached_data = false;
+    if (!state->reference_cached_data) {
+      auto array = AllocateArray(state->target_domain, target_layout_order,
+                                 default_init, target_dtype);
+      state->target = array;
+      promise.raw_result() = std::move(array);
+    }
+    state->promise = std::move(promise);
 
     // Initiate the read on the driver.
     auto source_driver = std::move(state->source_driver);
@@ -229,96 +339,201 @@ struct DriverReadIntoNewInitiateOp {
     request.transaction = std::move(state->source_transaction);
     request.batch = std::move(state->source_batch);
     request.transform = std::move(source_transform);
-    source_driver->Read(
-        std::move(request),
-        ReadChunkReceiver<SharedOffsetArray<void>>{std::move(state)});
+    source_driver->Read(std::move(request),
+                        ReadChunkReceiver<PromiseValue>{std::move(state)});
   }
 };
 
-}  // namespace
-
-Future<void> DriverRead(Executor executor, DriverHandle source,
-                        TransformedSharedArray<void> target,
-                        DriverReadOptions options) {
+/// Implementation of `DriverReadIntoNewArray` and
+/// `DriverReadIntoNewConstArray`.
+template <typename PromiseValue>
+Future<PromiseValue> DriverReadIntoNewArrayImpl(
+    Executor executor, DriverHandle source, DriverReadIntoNewOptions options,
+    bool reference_cached_data) {
   TENSORSTORE_RETURN_IF_ERROR(
       internal::ValidateSupportsRead(source.driver.read_write_mode()));
-  using State = ReadState<void>;
+  using State = ReadState<PromiseValue>;
   IntrusivePtr<State> state(new State);
-  state->executor = executor;
   TENSORSTORE_ASSIGN_OR_RETURN(
       state->data_type_conversion,
-      GetDataTypeConverterOrError(source.driver->dtype(), target.dtype(),
-                                  options.data_type_conversion_flags));
+      GetDataTypeConverterOrError(source.driver->dtype(),
+                                  options.target_dtype));
+  state->executor = executor;
   state->source_driver = std::move(source.driver);
   TENSORSTORE_ASSIGN_OR_RETURN(
       state->source_transaction,
       internal::AcquireOpenTransactionPtrOrError(source.transaction));
   state->source_batch = std::move(options.batch);
-  state->target = std::move(target);
-  state->alignment_options = options.alignment_options;
   state->read_progress_function = std::move(options.progress_function);
-  auto pair = PromiseFuturePair<void>::Make(MakeResult());
+  state->reference_cached_data = reference_cached_data;
+  auto pair = PromiseFuturePair<PromiseValue>::Make();
 
   // Resolve the bounds for `source.transform`.
   Driver::ResolveBoundsRequest request;
   request.transaction = state->source_transaction;
   request.transform = std::move(source.transform);
   request.options.Set(fix_resizable_bounds).IgnoreError();
+
   auto transform_future =
       state->source_driver->ResolveBounds(std::move(request));
 
   // Initiate the read once the bounds have been resolved.
   LinkValue(WithExecutor(std::move(executor),
-                         DriverReadIntoExistingInitiateOp{std::move(state)}),
+                         DriverReadIntoNewInitiateOp<PromiseValue>{
+                             std::move(state), options.target_dtype,
+                             options.layout_order}),
             std::move(pair.promise), std::move(transform_future));
   return std::move(pair.future);
 }
 
-Future<void> DriverRead(DriverHandle source,
-                        TransformedSharedArray<void> target,
-                        ReadOptions options) {
-  auto executor = source.driver->data_copy_executor();
-  return internal::DriverRead(std::move(executor), std::move(source),
-                              std::move(target), {std::move(options)});
-}
+/// Combines the progress of the individual regions of a `DriverReadMany`
+/// operation into a single progress function.
+struct ReadManyProgressState
+    : public internal::AtomicReferenceCount<ReadManyProgressState> {
+  absl::Mutex mutex;
+  std::vector<ReadProgress> region_progress ABSL_GUARDED_BY(mutex);
+  ReadProgress total ABSL_GUARDED_BY(mutex){0, 0};
+  // Number of updates applied to `total`.
+  uint64_t num_updates ABSL_GUARDED_BY(mutex) = 0;
+
+  // Serializes invocations of `function`.
+  absl::Mutex function_mutex;
+  // Value of `num_updates` corresponding to the last total passed to
+  // `function`.
+  uint64_t last_delivered_update ABSL_GUARDED_BY(function_mutex) = 0;
+  ReadProgressFunction::Function function;
+
+  void Update(size_t region, ReadProgress progress) {
+    ReadProgress new_total;
+    uint64_t update;
+    {
+      absl::MutexLock lock(&mutex);
+      auto& prev = region_progress[region];
+      total.total_elements += progress.total_elements - prev.total_elements;
+      total.copied_elements += progress.copied_elements - prev.copied_elements;
+      prev = progress;
+      new_total = total;
+      update = ++num_updates;
+    }
+    // `mutex` is not held while invoking `function`, such that other regions
+    // can record progress in the meantime.  A concurrent update may have
+    // already delivered a newer total, in which case `new_total` is dropped
+    // such that the reported progress never goes backwards.
+    absl::MutexLock lock(&function_mutex);
+    if (update < last_delivered_update) return;
+    last_delivered_update = update;
+    function(new_total);
+  }
+};
 
-Future<SharedOffsetArray<void>> DriverReadIntoNewArray(
-    Executor executor, DriverHandle source, DriverReadIntoNewOptions options) {
+}  // namespace
+
+Future<void> DriverRead(Executor executor, DriverHandle source,
+                        TransformedSharedArray<void> target,
+                        DriverReadOptions options) {
   TENSORSTORE_RETURN_IF_ERROR(
       internal::ValidateSupportsRead(source.driver.read_write_mode()));
-  using State = ReadState<SharedOffsetArray<void>>;
+  using State = ReadState<void>;
   IntrusivePtr<State> state(new State);
+  state->executor = executor;
   TENSORSTORE_ASSIGN_OR_RETURN(
       state->data_type_conversion,
-      GetDataTypeConverterOrError(source.driver->dtype(),
-                                  options.target_dtype));
-  state->executor = executor;
+      GetDataTypeConverterOrError(source.driver->dtype(), target.dtype(),
+                                  options.data_type_conversion_flags));
   state->source_driver = std::move(source.driver);
   TENSORSTORE_ASSIGN_OR_RETURN(
       state->source_transaction,
       internal::AcquireOpenTransactionPtrOrError(source.transaction));
   state->source_batch = std::move(options.batch);
+  state->target = std::move(target);
+  state->alignment_options = options.alignment_options;
   state->read_progress_function = std::move(options.progress_function);
-  auto pair = PromiseFuturePair<SharedOffsetArray<void>>::Make();
+  auto pair = PromiseFuturePair<void>::Make(MakeResult());
 
   // Resolve the bounds for `source.transform`.
   Driver::ResolveBoundsRequest request;
   request.transaction = state->source_transaction;
   request.transform = std::move(source.transform);
   request.options.Set(fix_resizable_bounds).IgnoreError();
-
   auto transform_future =
       state->source_driver->ResolveBounds(std::move(request));
 
   // Initiate the read once the bounds have been resolved.
   LinkValue(WithExecutor(std::move(executor),
-                         DriverReadIntoNewInitiateOp{std::move(state),
-                                                     options.target_dtype,
-                                                     options.layout_order}),
+                         DriverReadIntoExistingInitiateOp{std::move(state)}),
             std::move(pair.promise), std::move(transform_future));
   return std::move(pair.future);
 }
 
+Future<void> DriverRead(DriverHandle source,
+                        TransformedSharedArray<void> target,
+                        ReadOptions options) {
+  auto executor = source.driver->data_copy_executor();
+  return internal::DriverRead(std::move(executor), std::move(source),
+                              std::move(target), {std::move(options)});
+}
+
+Future<void> DriverReadMany(DriverHandle source,
+                            span<const IndexTransform<>> source_transforms,
+                            span<const TransformedSharedArray<void>> targets,
+                            ReadOptions options) {
+  if (source_transforms.size() != targets.size()) {
+    return absl::InvalidArgumentError(absl::StrFormat(
+        "Number of source transforms (%d) does not match number of "
+        "targets (%d)",
+        source_transforms.size(), targets.size()));
+  }
+  // Compose all of the transforms before issuing any reads, such that an
+  // invalid region does not leave the other reads running.
+  std::vector<IndexTransform<>> region_transforms;
+  region_transforms.reserve(source_transforms.size());
+  for (const auto& transform : source_transforms) {
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto region_transform, ComposeTransforms(source.transform, transform));
+    region_transforms.push_back(std::move(region_transform));
+  }
+  // Reads of the same chunk within a batch are coalesced, so issuing all of
+  // the regions as part of one batch ensures each chunk is fetched once.
+  Batch batch = options.batch ? std::move(options.batch) : Batch::New();
+  IntrusivePtr<ReadManyProgressState> progress_state;
+  if (options.progress_function.value) {
+    progress_state.reset(new ReadManyProgressState);
+    progress_state->region_progress.resize(targets.size(), ReadProgress{0, 0});
+    progress_state->function = std::move(options.progress_function.value);
+  }
+  std::vector<Future<void>> futures;
+  futures.reserve(targets.size());
+  for (size_t i = 0; i < targets.size(); ++i) {
+    DriverHandle region_source{source.driver,
+                               std::move(region_transforms[i]),
+                               source.transaction};
+    ReadOptions region_options;
+    region_options.batch = batch;
+    region_options.alignment_options = options.alignment_options;
+    if (progress_state) {
+      region_options.progress_function = ReadProgressFunction{
+          [progress_state, i](ReadProgress progress) {
+            progress_state->Update(i, progress);
+          }};
+    }
+    futures.push_back(internal::DriverRead(std::move(region_source),
+                                           targets[i],
+                                           std::move(region_options)));
+  }
+  // Submits the batch, unless it was specified by the caller, once the
+  // pending reads release their references.
+  batch.Release();
+  return WaitAllFuture(span(futures));
+}
+
+Future<SharedOffsetArray<void>> DriverReadIntoNewArray(
+    Executor executor, DriverHandle source, DriverReadIntoNewOptions options) {
+  // The returned array is mutable, so it must never alias cached data.
+  return DriverReadIntoNewArrayImpl<SharedOffsetArray<void>>(
+      std::move(executor), std::move(source), std::move(options),
+      /*reference_cached_data=*/false);
+}
+
 Future<SharedOffsetArray<void>> DriverReadIntoNewArray(
     DriverHandle source, ReadIntoNewArrayOptions options) {
   auto dtype = source.driver->dtype();
@@ -327,6 +542,23 @@ Future<SharedOffsetArray<void>> DriverReadIntoNewArray(
       std::move(executor), std::move(source), {std::move(options), dtype});
 }
 
+Future<SharedOffsetArray<const void>> DriverReadIntoNewConstArray(
+    Executor executor, DriverHandle source, DriverReadIntoNewOptions options) {
+  const bool reference_cached_data =
+      options.cached_data_reference_permission == can_reference_cached_data;
+  return DriverReadIntoNewArrayImpl<SharedOffsetArray<const void>>(
+      std::move(executor), std::move(source), std::move(options),
+      reference_cached_data);
+}
+
+Future<SharedOffsetArray<const void>> DriverReadIntoNewConstArray(
+    DriverHandle source, ReadIntoNewArrayOptions options) {
+  auto dtype = source.driver->dtype();
+  auto executor = source.driver->data_copy_executor();
+  return internal::DriverReadIntoNewConstArray(
+      std::move(executor), std::move(source), {std::move(options), dtype});
+}
+
 absl::Status CopyReadChunk(
     ReadChunk::Impl& chunk, IndexTransform<> chunk_transform,
     const DataTypeConversionLookupResult& chunk_conversion,
@@ -362,5 +594,55 @@ absl::Status CopyReadChunk(ReadChunk::Impl& chunk,
                        std::move(target));
 }
 
+absl::Status CopyReadChunkParallel(
+    const Executor& executor, size_t max_parallelism, Index min_bytes_per_task,
+    ReadChunk::Impl& chunk, IndexTransform<> chunk_transform,
+    const DataTypeConversionLookupResult& chunk_conversion,
+    TransformedArray<void, dynamic_rank, view> target) {
+  const auto domain = target.domain();
+  DimensionIndex split_dim = 0;
+  while (split_dim < domain.rank() && domain[split_dim].size() <= 1) {
+    ++split_dim;
+  }
+  Index num_tasks = 1;
+  if (split_dim < domain.rank() && max_parallelism > 1) {
+    const Index num_bytes = domain.num_elements() * target.dtype().size();
+    num_tasks = std::min({static_cast<Index>(max_parallelism),
+                          num_bytes / std::max(Index(1), min_bytes_per_task),
+                          domain[split_dim].size()});
+  }
+  if (num_tasks <= 1) {
+    return CopyReadChunk(chunk, std::move(chunk_transform), chunk_conversion,
+                         std::move(target));
+  }
+
+  // Splits `domain[split_dim]` into `num_tasks` nearly equal intervals.
+  const Index origin = domain[split_dim].inclusive_min();
+  const Index size = domain[split_dim].size();
+  const auto get_task_begin = [&](Index task) {
+    return origin + (size / num_tasks) * task +
+           std::min(task, size % num_tasks);
+  };
+  std::vector<absl::Status> status(num_tasks);
+  ParallelFor(executor, num_tasks, num_tasks, [&](size_t task) {
+    auto slice = tensorstore::Dims(split_dim).HalfOpenInterval(
+        get_task_begin(task), get_task_begin(task + 1));
+    status[task] = [&]() -> absl::Status {
+      TENSORSTORE_ASSIGN_OR_RETURN(auto task_chunk_transform,
+                                   chunk_transform | slice);
+      TENSORSTORE_ASSIGN_OR_RETURN(auto task_target, target | slice);
+      // Each task uses its own copy of `chunk`, since `Impl` objects are not
+      // required to support concurrent calls.
+      ReadChunk::Impl task_chunk = chunk;
+      return CopyReadChunk(task_chunk, std::move(task_chunk_transform),
+                           chunk_conversion, task_target);
+    }();
+  });
+  for (auto& task_status : status) {
+    if (!task_status.ok()) return std::move(task_status);
+  }
+  return absl::OkStatus();
+}
+
 }  // namespace internal
 }  // namespace tensorstore
@@ -15,6 +15,8 @@
 #ifndef TENSORSTORE_DRIVER_READ_H_
 #define TENSORSTORE_DRIVER_READ_H_
 
+#include <stddef.h>
+
 #include "absl/status/status.h"
 #include "tensorstore/array.h"
 #include "tensorstore/container_kind.h"
@@ -22,6 +24,7 @@
 #include "tensorstore/data_type.h"
 #include "tensorstore/driver/chunk.h"
 #include "tensorstore/driver/driver_handle.h"
+#include "tensorstore/index.h"
 #include "tensorstore/index_space/alignment.h"
 #include "tensorstore/index_space/index_transform.h"
 #include "tensorstore/index_space/transformed_array.h"
@@ -30,6 +33,7 @@
 #include "tensorstore/read_write_options.h"
 #include "tensorstore/util/executor.h"
 #include "tensorstore/util/future.h"
+#include "tensorstore/util/span.h"
 
 namespace tensorstore {
 namespace internal {
@@ -70,6 +74,33 @@ Future<void> DriverRead(DriverHandle source,
                         TransformedSharedArray<void> target,
                         ReadOptions options);
 
+/// Copies multiple regions of a TensorStore driver to separate arrays.
+///
+/// Equivalent to calling `DriverRead` for each region, except that all of the
+/// reads are issued as part of a single batch, such that a chunk that is
+/// needed by more than one region is only fetched once.  If `options.batch`
+/// is `no_batch`, a new batch is created and submitted once all of the reads
+/// have been issued; otherwise, the reads are added to the specified batch.
+///
+/// If specified, `options.progress_function` is invoked with the combined
+/// progress of all of the regions.
+///
+/// \param source Source TensorStore.
+/// \param source_transforms Transform for each region, composed with
+///     `source.transform`.
+/// \param targets Destination array for each region.  Must have the same
+///     length as `source_transforms`.
+/// \param options Specifies optional progress function and batch.
+/// \returns A future that becomes ready when all of the regions have been
+///     copied or an error occurs.  The `targets` arrays must remain valid until
+///     the returned future becomes ready.
+/// \error `absl::StatusCode::kInvalidArgument` if `source_transforms` and
+///     `targets` have different lengths.
+Future<void> DriverReadMany(DriverHandle source,
+                            span<const IndexTransform<>> source_transforms,
+                            span<const TransformedSharedArray<void>> targets,
+                            ReadOptions options);
+
 /// Copies data from a TensorStore driver to a newly-allocated array.
 ///
 /// \param executor Executor to use for copying data.
@@ -85,6 +116,18 @@ Future<SharedOffsetArray<void>> DriverReadIntoNewArray(
 Future<SharedOffsetArray<void>> DriverReadIntoNewArray(
     DriverHandle source, ReadIntoNewArrayOptions options);
 
+/// Same as `DriverReadIntoNewArray`, but returns a read-only array.
+///
+/// Unlike `DriverReadIntoNewArray`, which always allocates a new array, honors
+/// `options.cached_data_reference_permission`: if equal to
+/// `can_reference_cached_data`, the returned array may be a view of immutable
+/// cached chunk data.
+Future<SharedOffsetArray<const void>> DriverReadIntoNewConstArray(
+    Executor executor, DriverHandle source, DriverReadIntoNewOptions options);
+
+Future<SharedOffsetArray<const void>> DriverReadIntoNewConstArray(
+    DriverHandle source, ReadIntoNewArrayOptions options);
+
 /// Copies `chunk` transformed by `chunk_transform` to `target`.
 absl::Status CopyReadChunk(
     ReadChunk::Impl& chunk, IndexTransform<> chunk_transform,
@@ -95,6 +138,22 @@ absl::Status CopyReadChunk(ReadChunk::Impl& chunk,
                            IndexTransform<> chunk_transform,
                            TransformedArray<void, dynamic_rank, view> target);
 
+/// Same as the first `CopyReadChunk` overload, but splits the copy into
+/// sub-boxes along the outermost non-singleton dimension of `target` that are
+/// copied concurrently using `executor`.
+///
+/// \param executor Executor used to copy the sub-boxes.  The calling thread
+///     also copies sub-boxes.
+/// \param max_parallelism Maximum number of sub-boxes.
+/// \param min_bytes_per_task Minimum number of bytes of `target` in each
+///     sub-box.  If `target` is smaller than twice this amount, it is copied by
+///     the calling thread as a single box.
+absl::Status CopyReadChunkParallel(
+    const Executor& executor, size_t max_parallelism, Index min_bytes_per_task,
+    ReadChunk::Impl& chunk, IndexTransform<> chunk_transform,
+    const DataTypeConversionLookupResult& chunk_conversion,
+    TransformedArray<void, dynamic_rank, view> target);
+
 }  // namespace internal
 }  // namespace tensorstore
 
@@ -0,0 +1,135 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// This benchmarks reading many small, overlapping regions of a zarr3 array
+// with a loop of `tensorstore::Read` calls compared to a single
+// `tensorstore::ReadMany` call.  Caching is disabled, such that each `Read`
+// call fetches and decodes all of the chunks that it needs, while `ReadMany`
+// fetches each chunk once.
+//
+// BM_ReadLoop/<num_regions>
+// BM_ReadMany/<num_regions>
+//
+// num_regions:
+//
+//   Number of `kRegionSize^2` regions read in each iteration.  The regions are
+//   placed at scattered positions within the `kNumChunks^2` chunks of the
+//   array, such that most chunks are needed by several regions.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+#include "tensorstore/array.h"
+#include "tensorstore/context.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_space/dim_expression.h"
+#include "tensorstore/index_space/index_transform.h"
+#include "tensorstore/index_space/transformed_array.h"
+#include "tensorstore/open.h"
+#include "tensorstore/open_mode.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+
+namespace {
+
+using ::tensorstore::Dims;
+using ::tensorstore::Index;
+using ::tensorstore::IndexTransform;
+
+static constexpr Index kChunkSize = 64;
+static constexpr Index kNumChunks = 4;
+static constexpr Index kRegionSize = 16;
+
+struct ReadManyBenchmark {
+  tensorstore::TensorStore<uint8_t> store;
+  std::vector<IndexTransform<>> transforms;
+  std::vector<tensorstore::SharedArray<uint8_t>> arrays;
+  std::vector<tensorstore::TransformedSharedArray<void>> targets;
+
+  explicit ReadManyBenchmark(Index num_regions) {
+    TENSORSTORE_CHECK_OK_AND_ASSIGN(
+        auto context,
+        tensorstore::Context::FromJson(
+            {{"cache_pool", {{"total_bytes_limit", 0}}}}));
+    ::nlohmann::json spec{
+        {"driver", "zarr3"},
+        {"kvstore", {{"driver", "memory"}}},
+        {"metadata",
+         {{"shape", {kChunkSize * kNumChunks, kChunkSize * kNumChunks}},
+          {"chunk_grid",
+           {{"name", "regular"},
+            {"configuration", {{"chunk_shape", {kChunkSize, kChunkSize}}}}}},
+          {"data_type", "uint8"}}},
+    };
+    TENSORSTORE_CHECK_OK_AND_ASSIGN(
+        store, tensorstore::Open<uint8_t>(spec, context,
+                                          tensorstore::OpenMode::create)
+                   .result());
+    TENSORSTORE_CHECK_OK(
+        tensorstore::Write(tensorstore::MakeScalarArray<uint8_t>(1), store)
+            .result());
+
+    const Index max_origin = kChunkSize * kNumChunks - kRegionSize;
+    Index origin = 0;
+    for (Index i = 0; i < num_regions; ++i) {
+      // Visit the regions in a scattered order.
+      origin = (origin + 7919) % (max_origin * max_origin);
+      TENSORSTORE_CHECK_OK_AND_ASSIGN(
+          auto transform,
+          tensorstore::IdentityTransform(store.domain()) |
+              Dims(0, 1).SizedInterval(
+                  {origin / max_origin, origin % max_origin},
+                  {kRegionSize, kRegionSize}));
+      transforms.push_back(std::move(transform));
+      arrays.push_back(
+          tensorstore::AllocateArray<uint8_t>({kRegionSize, kRegionSize}));
+      targets.push_back(arrays.back());
+    }
+  }
+};
+
+void BM_ReadLoop(benchmark::State& state) {
+  ReadManyBenchmark benchmark(state.range(0));
+  for (auto s : state) {
+    for (size_t i = 0; i < benchmark.arrays.size(); ++i) {
+      TENSORSTORE_CHECK_OK(
+          tensorstore::Read(benchmark.store | benchmark.transforms[i],
+                            benchmark.arrays[i])
+              .result());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_ReadMany(benchmark::State& state) {
+  ReadManyBenchmark benchmark(state.range(0));
+  for (auto s : state) {
+    TENSORSTORE_CHECK_OK(tensorstore::ReadMany(benchmark.store,
+                                               benchmark.transforms,
+                                               benchmark.targets)
+                             .result());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_ReadLoop)->Arg(16)->Arg(256)->UseRealTime();
+BENCHMARK(BM_ReadMany)->Arg(16)->Arg(256)->UseRealTime();
+
+}  // namespace
@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <list>
 #include <numeric>
 #include <optional>
 #include <string_view>
@@ -25,12 +26,16 @@
 #include <utility>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/functional/function_ref.h"
 #include "absl/hash/hash.h"
-#include "absl/log/absl_log.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_format.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "tensorstore/box.h"
 #include "tensorstore/context.h"
 #include "tensorstore/data_type.h"
@@ -49,6 +54,7 @@
 #include "tensorstore/index_space/index_transform.h"
 #include "tensorstore/index_space/internal/propagate_bounds.h"
 #include "tensorstore/index_space/internal/transform_rep.h"
+#include "tensorstore/internal/box_rtree.h"
 #include "tensorstore/internal/concurrency_resource.h"
 #include "tensorstore/internal/data_copy_concurrency_resource.h"
 #include "tensorstore/internal/grid_partition_iterator.h"
@@ -58,6 +64,8 @@
 #include "tensorstore/internal/json_binding/staleness_bound.h"  // IWYU pragma: keep
 #include "tensorstore/internal/json_binding/std_array.h"  // IWYU pragma: keep
 #include "tensorstore/internal/meta/type_traits.h"
+#include "tensorstore/internal/metrics/histogram.h"
+#include "tensorstore/internal/metrics/metadata.h"
 #include "tensorstore/internal/tagged_ptr.h"
 #include "tensorstore/open_mode.h"
 #include "tensorstore/open_options.h"
@@ -85,6 +93,7 @@ namespace tensorstore {
 namespace internal_stack {
 namespace {
 
+using ::tensorstore::internal::BoxRTree;
 using ::tensorstore::internal::DataCopyConcurrencyResource;
 using ::tensorstore::internal::IntrusivePtr;
 using ::tensorstore::internal::IrregularGrid;
@@ -149,6 +158,112 @@ struct StackLayer {
 
 namespace jb = tensorstore::internal_json_binding;
 
+/// Maximum number of opened layer driver handles retained by each
+/// `StackDriver`.  Drivers opened from the same context share their underlying
+/// caches, so each retained handle is small.
+constexpr size_t kOpenLayerCacheCapacity = 16384;
+
+/// Maximum age of an opened layer driver handle retained by each
+/// `StackDriver`, after which the layer is opened again such that changes to
+/// its metadata, e.g. due to a resize or re-creation, are observed.
+constexpr absl::Duration kOpenLayerCacheMaxAge = absl::Minutes(1);
+
+auto& stack_layers_visited =
+    internal_metrics::Histogram<internal_metrics::DefaultBucketer>::New(
+        "/tensorstore/driver/stack/layers_visited",
+        internal_metrics::MetricMetadata(
+            "Histogram of the number of layers visited per \"stack\" driver "
+            "read or write request."));
+
+/// Bounded LRU cache of driver handles for layers specified by a `DriverSpec`
+/// and opened on demand, keyed by layer index and read/write mode.
+///
+/// Only non-transactional opens are cached: a layer opened within a
+/// transaction is bound to that transaction, so transactional requests always
+/// open the layer anew.  Failed opens are not retained, handles older than
+/// `max_age` are replaced, and `Invalidate` drops a handle for which a read or
+/// write failed.
+class OpenLayerCache {
+ public:
+  using Key = std::pair<size_t, ReadWriteMode>;
+
+  explicit OpenLayerCache(size_t capacity, absl::Duration max_age)
+      : capacity_(capacity), max_age_(max_age) {}
+
+  /// Returns the cached handle for `key`, or otherwise calls `open` and caches
+  /// the result.
+  Future<internal::Driver::Handle> GetOrOpen(
+      Key key, absl::FunctionRef<Future<internal::Driver::Handle>()> open) {
+    {
+      absl::MutexLock lock(&mutex_);
+      if (auto it = entries_.find(key); it != entries_.end()) {
+        auto& entry = it->second;
+        if (!entry.future.ready() ||
+            (entry.future.status().ok() &&
+             absl::Now() - entry.open_time <= max_age_)) {
+          lru_.splice(lru_.begin(), lru_, entry.lru_it);
+          return entry.future;
+        }
+        // Retry layers which previously failed to open, and re-open stale
+        // layers.
+        Erase(it);
+      }
+    }
+    // Open without holding the lock, since binding the spec may be expensive.
+    const absl::Time open_time = absl::Now();
+    auto future = open();
+    absl::MutexLock lock(&mutex_);
+    auto [it, inserted] = entries_.try_emplace(key);
+    if (!inserted) {
+      // Opened concurrently by another request.
+      return it->second.future;
+    }
+    it->second.future = future;
+    it->second.open_time = open_time;
+    it->second.lru_it = lru_.insert(lru_.begin(), key);
+    while (entries_.size() > capacity_) {
+      entries_.erase(lru_.back());
+      lru_.pop_back();
+    }
+    return future;
+  }
+
+  /// Removes the cached handle for `key` if it refers to `driver`, such that
+  /// the next request opens the layer again.
+  void Invalidate(Key key, const internal::Driver* driver) {
+    absl::MutexLock lock(&mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) return;
+    auto& future = it->second.future;
+    if (!future.ready() || !future.status().ok() ||
+        future.value().driver.get() != driver) {
+      // Not yet opened, or already replaced by a newer handle.
+      return;
+    }
+    Erase(it);
+  }
+
+ private:
+  struct Entry {
+    Future<internal::Driver::Handle> future;
+    absl::Time open_time;
+    std::list<Key>::iterator lru_it;
+  };
+
+  void Erase(absl::flat_hash_map<Key, Entry>::iterator it)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    lru_.erase(it->second.lru_it);
+    entries_.erase(it);
+  }
+
+  const size_t capacity_;
+  const absl::Duration max_age_;
+  absl::Mutex mutex_;
+  // Most recently used keys are at the front.
+  std::list<Key> lru_ ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_map<Key, Entry> entries_ ABSL_GUARDED_BY(mutex_);
+};
+
 /// Used to index individual cells
 struct Cell {
   std::vector<Index> points;
@@ -497,9 +612,23 @@ class StackDriver
 
   void Write(WriteRequest request, WriteChunkReceiver receiver) override;
 
-  absl::Status InitializeGridIndices(
+  absl::Status InitializeLayerIndex(
       tensorstore::span<const IndexDomain<>> domains);
 
+  /// Opens the layer `layer_i`, which must be specified by a driver spec.
+  Future<internal::Driver::Handle> OpenLayer(
+      size_t layer_i, ReadWriteMode read_write_mode,
+      internal::OpenTransactionPtr transaction);
+
+  /// Called when a read or write of layer `layer_i` using `driver` failed.
+  /// If `driver` was opened by `OpenLayer`, the layer is opened again by the
+  /// next request, since the failure may be due to the layer having been
+  /// modified since it was opened.
+  void InvalidateOpenLayer(size_t layer_i, ReadWriteMode read_write_mode,
+                           const internal::Driver* driver) {
+    open_layer_cache_.Invalidate({layer_i, read_write_mode}, driver);
+  }
+
   constexpr static auto ApplyMembers = [](auto&& x, auto f) {
     // Exclude `context_binding_state_` because it is handled specially.
     return f(x.dtype_, x.data_copy_concurrency_, x.layers_, x.dimension_units_,
@@ -511,9 +640,15 @@ class StackDriver
   std::vector<StackLayer> layers_;
   DimensionUnitsVector dimension_units_;
   IndexDomain<> layer_domain_;
-  IrregularGrid grid_;
 
-  absl::flat_hash_map<Cell, size_t, CellHash, CellEq> grid_to_layer_;
+  // Effective bounds of each layer, indexed by layer.
+  std::vector<Box<>> layer_bounds_;
+
+  // Spatial index over `layer_bounds_`.
+  BoxRTree layer_index_;
+
+  OpenLayerCache open_layer_cache_{kOpenLayerCacheCapacity,
+                                   kOpenLayerCacheMaxAge};
 };
 
 Result<internal::Driver::Handle> MakeStackDriverHandle(
@@ -524,7 +659,7 @@ Result<internal::Driver::Handle> MakeStackDriverHandle(
   TENSORSTORE_ASSIGN_OR_RETURN(
       driver->layer_domain_,
       internal_stack::GetCombinedDomain(schema, layer_domains));
-  TENSORSTORE_RETURN_IF_ERROR(driver->InitializeGridIndices(layer_domains));
+  TENSORSTORE_RETURN_IF_ERROR(driver->InitializeLayerIndex(layer_domains));
   auto transform = IdentityTransform(driver->layer_domain_);
   driver->dimension_units_ =
       internal_stack::GetDimensionUnits<StackLayer>(schema, driver->layers_)
@@ -562,51 +697,40 @@ Future<internal::Driver::Handle> StackDriverSpec::Open(
       schema);
 }
 
-/// The mechanism used here is to construct an irregular grid based on
-/// each layer's effective transform, and then, for each of those grid
-/// points, store the layer associated with the bounding rectangle.
-///
-/// If this becomes a problem, we may want to consider constructing
-/// an R-tree variant using the layer MBRs to restrict the query space,
-/// then applying a similar gridding decomposition to the read transforms.
-absl::Status StackDriver::InitializeGridIndices(
+/// Layers are indexed by an R-tree over their effective bounds.  Each request
+/// queries the tree for the layers which intersect its output range, and then
+/// constructs an irregular grid over just those layers (see `OpenLayerOp`), so
+/// that the cost of mapping a request to layers is independent of the total
+/// number of layers.
+absl::Status StackDriver::InitializeLayerIndex(
     tensorstore::span<const IndexDomain<>> domains) {
   assert(domains.size() == layers_.size());
-  grid_ =
-      IrregularGrid::Make(layers_.empty() ? tensorstore::span(&layer_domain_, 1)
-                                          : tensorstore::span(domains));
-
-  Index start[kMaxRank];
-  Index shape[kMaxRank];
-  const DimensionIndex rank = grid_.rank();
-  for (size_t layer_i = 0; layer_i < domains.size(); layer_i++) {
-    auto& d = domains[layer_i];
-    for (DimensionIndex dim = 0; dim < rank; dim++) {
-      start[dim] = grid_(dim, d[dim].inclusive_min(), nullptr);
-      shape[dim] = 1 + grid_(dim, d[dim].inclusive_max(), nullptr) - start[dim];
-    }
-    // Set the mapping for all irregular grid cell covered by this layer
-    // to point to this layer.
-    IterateOverIndexRange<>(
-        BoxView<>(rank, start, shape),
-        [layer_i, this](tensorstore::span<const Index> key) {
-          grid_to_layer_[key] = layer_i;
-        });
+  layer_bounds_.clear();
+  layer_bounds_.reserve(domains.size());
+  for (const auto& d : domains) {
+    layer_bounds_.emplace_back(d.box());
   }
-
-#if !defined(NDEBUG)
-  // Log the missing cells.
-  IterateOverIndexRange<>(
-      grid_.shape(), [this](tensorstore::span<const Index> key) {
-        if (auto it = grid_to_layer_.find(key); it == grid_to_layer_.end()) {
-          ABSL_LOG(INFO) << "\"stack\" driver missing grid cell: " << key;
-        }
-      });
-#endif
-
+  std::vector<BoxView<>> boxes(layer_bounds_.begin(), layer_bounds_.end());
+  layer_index_ = BoxRTree(boxes);
   return absl::OkStatus();
 }
 
+Future<internal::Driver::Handle> StackDriver::OpenLayer(
+    size_t layer_i, ReadWriteMode read_write_mode,
+    internal::OpenTransactionPtr transaction) {
+  const auto& layer = layers_[layer_i];
+  assert(!layer.is_open());
+  auto open = [&] {
+    internal::DriverOpenRequest request;
+    request.transaction = transaction;
+    request.read_write_mode = read_write_mode;
+    return internal::OpenDriver(layer.GetTransformedDriverSpec(),
+                                std::move(request));
+  };
+  if (transaction) return open();
+  return open_layer_cache_.GetOrOpen({layer_i, read_write_mode}, open);
+}
+
 Result<TransformedDriverSpec> StackDriver::GetBoundSpec(
     internal::OpenTransactionPtr transaction, IndexTransformView<> transform) {
   auto driver_spec = internal::DriverSpec::Make<StackDriverSpec>();
@@ -661,7 +785,8 @@ Future<IndexTransform<>> StackDriver::ResolveBounds(
 
 template <typename StateType>
 absl::Status ComposeAndDispatchOperation(
-    StateType& state, const internal::DriverHandle& driver_handle,
+    StateType& state, size_t layer_i,
+    const internal::DriverHandle& driver_handle,
     IndexTransform<> cell_transform) {
   TENSORSTORE_RETURN_IF_ERROR(internal::ValidateSupportsModes(
       driver_handle.driver.read_write_mode(), StateType::kMode));
@@ -674,7 +799,7 @@ absl::Status ComposeAndDispatchOperation(
       auto b_transform,
       ComposeTransforms(driver_handle.transform, std::move(a_transform)));
 
-  state.Dispatch(driver_handle, std::move(b_transform),
+  state.Dispatch(layer_i, driver_handle, std::move(b_transform),
                  std::move(cell_transform));
   return absl::OkStatus();
 }
@@ -693,7 +818,7 @@ struct AfterOpenOp {
     // After opening the layer, issue reads to each of the grid cells.
     for (auto& cell_transform : cells) {
       TENSORSTORE_RETURN_IF_ERROR(ComposeAndDispatchOperation(
-          *state, f.value(), std::move(cell_transform)));
+          *state, layer_id, f.value(), std::move(cell_transform)));
     }
     return absl::OkStatus();
   }
@@ -712,57 +837,125 @@ struct AfterOpenOp {
 // grid cells which are not backed by a layer, and then opens each layer and
 // and initiates OpType (one of LayerReadOp/LayerWriteOp) for each layer's
 // cells.
+//
+// Only the layers which intersect the output range of the request, as
+// determined by `StackDriver::layer_index_`, are considered.
 template <typename StateType>
 struct OpenLayerOp {
   OpenLayerOp(IntrusivePtr<StateType> state)
       : state(std::move(state)),
-        grid_output_dimensions(this->state->self->grid_.rank()) {
+        grid_output_dimensions(this->state->self->rank()) {
     std::iota(grid_output_dimensions.begin(), grid_output_dimensions.end(),
               DimensionIndex{0});
   }
 
   IntrusivePtr<StateType> state;
   std::vector<DimensionIndex> grid_output_dimensions;
+  absl::flat_hash_map<size_t, std::vector<IndexTransform<>>> layers_to_load;
+
+  // Dispatches the operation for `cell_transform` to layer `layer_i`, or
+  // defers it until the layer is opened.
+  absl::Status DispatchToLayer(size_t layer_i,
+                               IndexTransform<> cell_transform) {
+    const auto& layer = state->self->layers_[layer_i];
+    if (!layer.driver) {
+      layers_to_load[layer_i].emplace_back(std::move(cell_transform));
+      return absl::OkStatus();
+    }
+    // Layer is already open, dispatch operation directly.
+    TENSORSTORE_RETURN_IF_ERROR(
+        ComposeAndDispatchOperation(
+            *state, layer_i, layer.GetDriverHandle(state->request.transaction),
+            std::move(cell_transform)),
+        tensorstore::MaybeAnnotateStatus(
+            _, absl::StrFormat("Layer %d", layer_i)));
+    return absl::OkStatus();
+  }
 
-  void operator()() {
+  absl::Status PartitionByLayer() {
     auto* self = state->self.get();
+    const DimensionIndex rank = self->rank();
+    Box<dynamic_rank(kMaxRank)> bounds(rank);
+    TENSORSTORE_RETURN_IF_ERROR(
+        GetOutputRange(state->request.transform, bounds));
+
+    const std::vector<size_t> candidates =
+        self->layer_index_.FindIntersecting(bounds);
+    stack_layers_visited.Observe(candidates.size());
+
+    // Later layers take precedence, so if the last intersecting layer covers
+    // the entire request, no partitioning is required.
+    if (!candidates.empty() &&
+        Contains(self->layer_bounds_[candidates.back()], bounds)) {
+      return DispatchToLayer(
+          candidates.back(),
+          IdentityTransform(state->request.transform.domain()));
+    }
 
-    absl::flat_hash_map<size_t, std::vector<IndexTransform<>>> layers_to_load;
-
-    auto status = [&]() -> absl::Status {
-      internal_grid_partition::PartitionIndexTransformIterator iterator(
-          grid_output_dimensions, self->grid_, state->request.transform);
-      TENSORSTORE_RETURN_IF_ERROR(iterator.Init());
-
-      while (!iterator.AtEnd()) {
-        auto it =
-            self->grid_to_layer_.find(iterator.output_grid_cell_indices());
-        if (it != self->grid_to_layer_.end()) {
-          const size_t layer_i = it->second;
-          const auto& layer = self->layers_[layer_i];
-          if (layer.driver) {
-            // Layer is already open, dispatch operation directly.
-            TENSORSTORE_RETURN_IF_ERROR(
-                ComposeAndDispatchOperation(
-                    *state, layer.GetDriverHandle(state->request.transaction),
-                    iterator.cell_transform()),
-                tensorstore::MaybeAnnotateStatus(
-                    _, absl::StrFormat("Layer %d", layer_i)));
-          } else {
-            layers_to_load[it->second].emplace_back(iterator.cell_transform());
-          }
-        } else {
-          // This cell is not backed by a layer, so report an error.
-          auto origin =
-              self->grid_.cell_origin(iterator.output_grid_cell_indices());
-          return absl::InvalidArgumentError(tensorstore::StrCat(
-              "Cell with origin=", tensorstore::span(origin),
-              " missing layer mapping in \"stack\" driver"));
-        }
-        iterator.Advance();
+    // Construct an irregular grid over the intersecting layers, clipped to the
+    // request bounds, and map each grid cell to the last layer covering it.
+    std::vector<Box<>> clipped;
+    clipped.reserve(candidates.size() + 1);
+    for (size_t layer_i : candidates) {
+      clipped.emplace_back(rank);
+      for (DimensionIndex dim = 0; dim < rank; ++dim) {
+        clipped.back()[dim] =
+            Intersect(self->layer_bounds_[layer_i][dim], bounds[dim]);
       }
-      return absl::OkStatus();
-    }();
+    }
+    // Include the request bounds so that the grid is never empty.
+    clipped.emplace_back(bounds);
+    std::vector<std::vector<Index>> points(rank);
+    for (const auto& box : clipped) {
+      for (DimensionIndex dim = 0; dim < rank; ++dim) {
+        points[dim].push_back(box[dim].inclusive_min());
+        points[dim].push_back(box[dim].exclusive_max());
+      }
+    }
+    IrregularGrid grid(std::move(points));
+
+    absl::flat_hash_map<Cell, size_t, CellHash, CellEq> grid_to_layer;
+    Index start[kMaxRank];
+    Index shape[kMaxRank];
+    for (size_t i = 0; i < candidates.size(); ++i) {
+      const auto& box = clipped[i];
+      for (DimensionIndex dim = 0; dim < rank; ++dim) {
+        start[dim] = grid(dim, box[dim].inclusive_min(), nullptr);
+        shape[dim] =
+            1 + grid(dim, box[dim].inclusive_max(), nullptr) - start[dim];
+      }
+      // Set the mapping for all irregular grid cell covered by this layer
+      // to point to this layer.
+      IterateOverIndexRange<>(
+          BoxView<>(rank, start, shape),
+          [&, layer_i = candidates[i]](tensorstore::span<const Index> key) {
+            grid_to_layer[key] = layer_i;
+          });
+    }
+
+    internal_grid_partition::PartitionIndexTransformIterator iterator(
+        grid_output_dimensions, grid, state->request.transform);
+    TENSORSTORE_RETURN_IF_ERROR(iterator.Init());
+
+    while (!iterator.AtEnd()) {
+      auto it = grid_to_layer.find(iterator.output_grid_cell_indices());
+      if (it == grid_to_layer.end()) {
+        // This cell is not backed by a layer, so report an error.
+        auto origin = grid.cell_origin(iterator.output_grid_cell_indices());
+        return absl::InvalidArgumentError(tensorstore::StrCat(
+            "Cell with origin=", tensorstore::span(origin),
+            " missing layer mapping in \"stack\" driver"));
+      }
+      TENSORSTORE_RETURN_IF_ERROR(
+          DispatchToLayer(it->second, iterator.cell_transform()));
+      iterator.Advance();
+    }
+    return absl::OkStatus();
+  }
+
+  void operator()() {
+    auto* self = state->self.get();
+    auto status = PartitionByLayer();
     if (!status.ok()) {
       state->SetError(status);
       return;
@@ -772,16 +965,12 @@ struct OpenLayerOp {
     // transforms.
     for (auto& kv : layers_to_load) {
       const size_t layer_i = kv.first;
-      const auto& layer = self->layers_[layer_i];
-      internal::DriverOpenRequest request;
-      request.transaction = state->request.transaction;
-      request.read_write_mode = StateType::kMode;
       Link(WithExecutor(
                self->data_copy_executor(),
                AfterOpenOp<StateType>{state, layer_i, std::move(kv.second)}),
            state->promise,
-           internal::OpenDriver(layer.GetTransformedDriverSpec(),
-                                std::move(request)));
+           self->OpenLayer(layer_i, StateType::kMode,
+                           state->request.transaction));
     }
   }
 };
@@ -800,13 +989,25 @@ struct ReadOrWriteState : public internal::ChunkOperationState<ChunkType> {
   using State = ReadOrWriteState<ChunkType>;
   using ForwardingReceiver = internal::ForwardingChunkOperationReceiver<State>;
 
+  // Forwards to the state, and additionally invalidates the opened layer on
+  // error.
+  struct LayerReceiver : public ForwardingReceiver {
+    size_t layer_i;
+    const internal::Driver* driver;
+
+    void set_error(absl::Status error) {
+      this->state->self->InvalidateOpenLayer(layer_i, kMode, driver);
+      ForwardingReceiver::set_error(std::move(error));
+    }
+  };
+
   using Base::Base;
 
   IntrusivePtr<StackDriver> self;
   RequestType request;
 
   // Initiate the read of an individual transform; dispatched by AfterOpenOp
-  void Dispatch(const internal::Driver::Handle& h,
+  void Dispatch(size_t layer_i, const internal::Driver::Handle& h,
                 IndexTransform<> composed_transform,
                 IndexTransform<> cell_transform) {
     auto sub_request = this->request;
@@ -821,8 +1022,10 @@ struct ReadOrWriteState : public internal::ChunkOperationState<ChunkType> {
     }();
 
     (h.driver.get()->*method)(std::move(sub_request),
-                              ForwardingReceiver{IntrusivePtr<State>(this),
-                                                 std::move(cell_transform)});
+                              LayerReceiver{{IntrusivePtr<State>(this),
+                                             std::move(cell_transform)},
+                                            layer_i,
+                                            h.driver.get()});
   }
 
   static void Start(
@@ -264,6 +264,42 @@ TEST(StackDriverTest, ReadSparse) {
   }
 }
 
+TEST(StackDriverTest, ReadManyLayers) {
+  ::nlohmann::json::array_t layers;
+  for (int i = 0; i < 100; ++i) {
+    layers.push_back(GetRank1Length4ArrayDriver(4 * i));
+  }
+  // Overlaps the boundary between layers 10 and 11.
+  layers.push_back(GetRank1Length4ArrayDriver(42));
+  ::nlohmann::json json_spec{
+      {"driver", "stack"},
+      {"layers", std::move(layers)},
+  };
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store,
+                                   tensorstore::Open(json_spec).result());
+
+  // Contained within a single layer.
+  {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto array,
+        tensorstore::Read<tensorstore::zero_origin>(
+            store | tensorstore::AllDims().SizedInterval({201}, {3}))
+            .result());
+    EXPECT_THAT(array, MatchesArray<int32_t>({2, 3, 4}));
+  }
+
+  // Spans several layers, where the last layer takes precedence.
+  {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto array,
+        tensorstore::Read<tensorstore::zero_origin>(
+            store | tensorstore::AllDims().SizedInterval({38}, {10}))
+            .result());
+    EXPECT_THAT(array, MatchesArray<int32_t>({3, 4, 1, 2, 1, 2, 3, 4, 3, 4}));
+  }
+}
+
 TEST(StackDriverTest, NoLayers) {
   TENSORSTORE_ASSERT_OK_AND_ASSIGN(
       auto spec, tensorstore::Spec::FromJson(
@@ -375,6 +411,109 @@ TEST(StackDriverTest, ReadWriteNonExistingLayers) {
                             ".*Error opening \"n5\" driver: .*"));
 }
 
+TEST(StackDriverTest, ReadAfterLayersCreated) {
+  ::nlohmann::json json_spec{
+      {"driver", "stack"},
+      {"layers", ::nlohmann::json::array_t({GetRank1Length4N5Driver(-3),
+                                            GetRank1Length4N5Driver(0)})},
+  };
+  auto context = tensorstore::Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, tensorstore::Open(json_spec, context).result());
+
+  EXPECT_THAT(tensorstore::Read<tensorstore::zero_origin>(store).result(),
+              MatchesStatus(absl::StatusCode::kNotFound,
+                            ".*Error opening \"n5\" driver: .*"));
+
+  // Failed layer opens are not retained, so the layers are found once they
+  // have been created.
+  for (int inclusive_min : {-3, 0}) {
+    TENSORSTORE_ASSERT_OK(tensorstore::Open(
+                              GetRank1Length4N5Driver(inclusive_min), context,
+                              OpenMode::create)
+                              .result());
+  }
+  EXPECT_THAT(tensorstore::Read(store).result(),
+              ::testing::Optional(tensorstore::MakeOffsetArray<int32_t>(
+                  {-3}, {0, 0, 0, 0, 0, 0, 0})));
+}
+
+TEST(StackDriverTest, ReopenLayerAfterReadError) {
+  auto context = tensorstore::Context::Default();
+  auto layer_spec = GetRank1Length4N5Driver(0);
+  layer_spec["metadata"].erase("blockSize");
+  const auto create_layer = [&](Index block_size,
+                                tensorstore::SharedArray<int32_t> data) {
+    auto spec = layer_spec;
+    spec["metadata"]["blockSize"] = {block_size};
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto layer,
+        tensorstore::Open(spec, context,
+                          OpenMode::create | OpenMode::delete_existing)
+            .result());
+    TENSORSTORE_ASSERT_OK(tensorstore::Write(data, layer).result());
+  };
+  create_layer(2, tensorstore::MakeArray<int32_t>({1, 2, 3, 4}));
+
+  ::nlohmann::json json_spec{
+      {"driver", "stack"},
+      {"layers", ::nlohmann::json::array_t({layer_spec})},
+  };
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, tensorstore::Open(json_spec, context).result());
+  EXPECT_THAT(
+      tensorstore::Read(store).result(),
+      ::testing::Optional(tensorstore::MakeArray<int32_t>({1, 2, 3, 4})));
+
+  // Re-create the layer with a larger block size.  The cached layer handle
+  // still uses the previous block size, and fails to decode the new chunk.
+  create_layer(4, tensorstore::MakeArray<int32_t>({5, 6, 7, 8}));
+  EXPECT_FALSE(tensorstore::Read(store).result().ok());
+
+  // The failed read invalidated the cached handle, so the layer is re-opened.
+  EXPECT_THAT(
+      tensorstore::Read(store).result(),
+      ::testing::Optional(tensorstore::MakeArray<int32_t>({5, 6, 7, 8})));
+}
+
+TEST(StackDriverTest, ReadWriteTransactionWithOpenedLayers) {
+  ::nlohmann::json json_spec{
+      {"driver", "stack"},
+      {"layers", ::nlohmann::json::array_t({GetRank1Length4N5Driver(-3),
+                                            GetRank1Length4N5Driver(0)})},
+  };
+  auto context = tensorstore::Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      tensorstore::Open(json_spec, context, OpenMode::open_or_create).result());
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Write(
+          tensorstore::MakeOffsetArray<int32_t>({-3}, {1, 2, 3, 4, 5, 6, 7}),
+          store)
+          .result());
+
+  // Layers opened by the non-transactional operations above must not be used
+  // for transactional operations.
+  tensorstore::Transaction txn(tensorstore::isolated);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto txn_store, store | txn);
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Write(
+          tensorstore::MakeOffsetArray<int32_t>({-3}, {7, 6, 5, 4, 3, 2, 1}),
+          txn_store)
+          .result());
+  EXPECT_THAT(tensorstore::Read(txn_store).result(),
+              ::testing::Optional(tensorstore::MakeOffsetArray<int32_t>(
+                  {-3}, {7, 6, 5, 4, 3, 2, 1})));
+  EXPECT_THAT(tensorstore::Read(store).result(),
+              ::testing::Optional(tensorstore::MakeOffsetArray<int32_t>(
+                  {-3}, {1, 2, 3, 4, 5, 6, 7})));
+
+  TENSORSTORE_ASSERT_OK(txn.CommitAsync().result());
+  EXPECT_THAT(tensorstore::Read(store).result(),
+              ::testing::Optional(tensorstore::MakeOffsetArray<int32_t>(
+                  {-3}, {7, 6, 5, 4, 3, 2, 1})));
+}
+
 TEST(StackDriverTest, Schema_MismatchedDtype) {
   auto a = GetRank1Length4N5Driver(0);
   a["dtype"] = "int64";
@@ -0,0 +1,103 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// This benchmarks small reads from a "stack" driver composed of many zarr3
+// layers, each specified by a `Spec` and opened on demand.
+//
+// BM_ReadLayer/<num_layers>
+//
+// num_layers:
+//
+//   Number of `kLayerSize^2` layers stacked along dimension 0.  Each iteration
+//   reads a `kReadSize^2` region from a single layer, visiting the layers in a
+//   scattered order.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "absl/strings/str_cat.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/array.h"
+#include "tensorstore/context.h"
+#include "tensorstore/contiguous_layout.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_space/dim_expression.h"
+#include "tensorstore/open_mode.h"
+#include "tensorstore/spec.h"
+#include "tensorstore/stack.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+
+namespace {
+
+using ::tensorstore::Dims;
+using ::tensorstore::Index;
+using ::tensorstore::Spec;
+
+static constexpr Index kLayerSize = 16;
+static constexpr Index kReadSize = 8;
+
+void BM_ReadLayer(benchmark::State& state) {
+  const Index num_layers = state.range(0);
+  auto context = tensorstore::Context::Default();
+
+  std::vector<Spec> layers;
+  layers.reserve(num_layers);
+  for (Index i = 0; i < num_layers; ++i) {
+    TENSORSTORE_CHECK_OK_AND_ASSIGN(
+        auto spec,
+        Spec::FromJson({
+            {"driver", "zarr3"},
+            {"kvstore",
+             {{"driver", "memory"}, {"path", absl::StrCat("layer_", i, "/")}}},
+            {"schema",
+             {{"dtype", "uint8"},
+              {"domain", {{"shape", {kLayerSize, kLayerSize}}}}}},
+        }));
+    layers.push_back(std::move(spec));
+  }
+  TENSORSTORE_CHECK_OK_AND_ASSIGN(
+      auto store,
+      tensorstore::Stack(layers, 0, context,
+                         tensorstore::OpenMode::open_or_create));
+
+  // Create all of the layers.
+  TENSORSTORE_CHECK_OK(
+      tensorstore::Write(tensorstore::MakeScalarArray<uint8_t>(1), store)
+          .result());
+
+  auto target = tensorstore::AllocateArray<uint8_t>({kReadSize, kReadSize});
+  Index layer = 0;
+  for (auto s : state) {
+    // Visit the layers in a scattered order.
+    layer = (layer + 7919) % num_layers;
+    TENSORSTORE_CHECK_OK(
+        tensorstore::Read(store | Dims(0).IndexSlice(layer) |
+                              Dims(0, 1).SizedInterval({0, 0},
+                                                       {kReadSize, kReadSize}),
+                          target)
+            .result());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_ReadLayer)->Arg(100)->Arg(1000)->Arg(10000)->UseRealTime();
+
+}  // namespace
@@ -14,6 +14,7 @@
 
 #include "tensorstore/driver/write.h"
 
+#include <algorithm>
 #include <atomic>
 #include <memory>
 #include <utility>
@@ -28,6 +29,7 @@
 #include "tensorstore/index_space/alignment.h"
 #include "tensorstore/index_space/index_transform.h"
 #include "tensorstore/index_space/transformed_array.h"
+#include "tensorstore/internal/integer_overflow.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/lock_collection.h"
 #include "tensorstore/internal/meta/type_traits.h"
@@ -40,8 +42,10 @@
 #include "tensorstore/internal/tracing/operation_trace_span.h"
 #include "tensorstore/open_mode.h"
 #include "tensorstore/progress.h"
+#include "tensorstore/rank.h"
 #include "tensorstore/read_write_options.h"
 #include "tensorstore/resize_options.h"
+#include "tensorstore/strided_layout.h"
 #include "tensorstore/transaction.h"
 #include "tensorstore/util/element_pointer.h"
 #include "tensorstore/util/execution/any_receiver.h"
@@ -248,6 +252,38 @@ struct WriteChunkReceiver {
   }
 };
 
+/// Returns `true` if every position in the domain of `source` refers to a
+/// distinct element.
+///
+/// Conservatively returns `false` if `source` cannot be converted to a strided
+/// array, or if, with dimensions ordered by stride magnitude, some stride is
+/// less than the byte extent of the preceding dimension.  In particular, this
+/// is the case for sources broadcast by `AlignTransformTo`, which have a zero
+/// byte stride.
+bool HasDistinctElements(const TransformedArray<Shared<const void>>& source) {
+  auto array = TryConvertToArray(source);
+  if (!array.ok()) return false;
+  std::pair<Index, Index> dims[kMaxRank];
+  DimensionIndex num_dims = 0;
+  for (DimensionIndex i = 0; i < array->rank(); ++i) {
+    const Index size = array->shape()[i];
+    if (size == 0) return true;
+    if (size == 1) continue;
+    const Index byte_stride = array->byte_strides()[i];
+    dims[num_dims++] = {byte_stride < 0 ? -byte_stride : byte_stride, size};
+  }
+  std::sort(dims, dims + num_dims);
+  Index min_byte_stride = array->dtype().size();
+  for (DimensionIndex i = 0; i < num_dims; ++i) {
+    auto [byte_stride, size] = dims[i];
+    if (byte_stride < min_byte_stride) return false;
+    if (internal::MulOverflow(byte_stride, size, &min_byte_stride)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 /// Callback used by `DriverWrite` to initiate the write once the target
 /// transform bounds have been resolved.
 struct DriverWriteInitiateOp {
@@ -262,6 +298,14 @@ struct DriverWriteInitiateOp {
         AlignTransformTo(std::move(state->source.transform()),
                          target_transform.domain(), state->alignment_options),
         static_cast<void>(promise.SetResult(_)));
+    if (state->source_data_reference_restriction == can_take_source_data &&
+        !HasDistinctElements(state->source)) {
+      // Chunks that take ownership of the source data may modify it in place,
+      // which is only valid if no element is shared by multiple positions.
+      // This must be checked after alignment, which may broadcast `source`.
+      state->source_data_reference_restriction =
+          can_reference_source_data_indefinitely;
+    }
     state->commit_state->total_elements =
         target_transform.domain().num_elements();
     state->copy_promise = std::move(promise);
@@ -293,9 +337,9 @@ WriteFutures DriverWrite(Executor executor,
   TENSORSTORE_ASSIGN_OR_RETURN(
       state->target_transaction,
       internal::AcquireOpenTransactionPtrOrError(target.transaction));
-  state->source = std::move(source);
   state->source_data_reference_restriction =
       options.source_data_reference_restriction;
+  state->source = std::move(source);
   state->alignment_options = options.alignment_options;
   state->commit_state->write_progress_function =
       std::move(options.progress_function);
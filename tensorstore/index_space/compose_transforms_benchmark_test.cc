@@ -0,0 +1,96 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "tensorstore/index.h"
+#include "tensorstore/index_space/index_transform.h"
+#include "tensorstore/index_space/index_transform_builder.h"
+#include "tensorstore/util/status.h"
+
+namespace {
+
+using ::tensorstore::Index;
+using ::tensorstore::IndexTransform;
+using ::tensorstore::IndexTransformBuilder;
+
+// Transform from a labeled 3-d domain to a translated base, representative of
+// a driver transform.
+IndexTransform<> MakeDriverTransform() {
+  return IndexTransformBuilder<>(3, 3)
+      .input_origin({0, 0, 0})
+      .input_shape({1000, 1000, 1000})
+      .input_labels({"x", "y", "z"})
+      .output_single_input_dimension(0, 5, 1, 0)
+      .output_single_input_dimension(1, 6, 1, 1)
+      .output_single_input_dimension(2, 7, 1, 2)
+      .Finalize()
+      .value();
+}
+
+// Transform selecting a small box, representative of a slicing expression for
+// a tiny read.
+IndexTransform<> MakeSliceTransform(Index offset) {
+  return IndexTransformBuilder<>(3, 3)
+      .input_origin({offset, 20, 30})
+      .input_shape({2, 2, 2})
+      .input_labels({"x", "y", "z"})
+      .output_identity_transform()
+      .Finalize()
+      .value();
+}
+
+// Composes without caching, as for every call prior to the composition cache.
+void BM_ComposeTransforms(benchmark::State& state) {
+  auto b_to_c = MakeDriverTransform();
+  auto a_to_b = MakeSliceTransform(10);
+  for (auto _ : state) {
+    auto a_to_c = tensorstore::ComposeTransforms(b_to_c, a_to_b);
+    benchmark::DoNotOptimize(a_to_c);
+  }
+}
+BENCHMARK(BM_ComposeTransforms);
+
+// Applies the same slicing transform repeatedly, which hits the cache.
+void BM_ApplyTransformRepeated(benchmark::State& state) {
+  auto b_to_c = MakeDriverTransform();
+  auto a_to_b = MakeSliceTransform(10);
+  for (auto _ : state) {
+    auto a_to_c = a_to_b(b_to_c);
+    benchmark::DoNotOptimize(a_to_c);
+  }
+}
+BENCHMARK(BM_ApplyTransformRepeated);
+
+// Applies `state.range(0)` distinct slicing transforms in turn, which misses
+// the cache once the number exceeds its capacity.
+void BM_ApplyTransformDistinct(benchmark::State& state) {
+  auto b_to_c = MakeDriverTransform();
+  std::vector<IndexTransform<>> a_to_b;
+  for (Index i = 0; i < state.range(0); ++i) {
+    a_to_b.push_back(MakeSliceTransform(i));
+  }
+  size_t i = 0;
+  for (auto _ : state) {
+    auto a_to_c = a_to_b[i](b_to_c);
+    benchmark::DoNotOptimize(a_to_c);
+    i = (i + 1) % a_to_b.size();
+  }
+}
+BENCHMARK(BM_ApplyTransformDistinct)->Arg(4)->Arg(64);
+
+}  // namespace
@@ -19,6 +19,7 @@
 #include "tensorstore/array.h"
 #include "tensorstore/index_space/index_transform.h"
 #include "tensorstore/index_space/index_transform_builder.h"
+#include "tensorstore/util/span.h"
 #include "tensorstore/util/status.h"
 #include "tensorstore/util/status_testutil.h"
 
@@ -33,6 +34,7 @@ using ::tensorstore::IndexTransformView;
 using ::tensorstore::kMaxFiniteIndex;
 using ::tensorstore::MakeArray;
 using ::tensorstore::MatchesStatus;
+using ::tensorstore::internal_index_space::TransformAccess;
 
 TEST(ComposeTransformsTest, EmptyDomain) {
   auto b_to_c = IndexTransformBuilder<3, 2>()
@@ -305,6 +307,50 @@ TEST(ComposeTransformsTest, FunctionCallOperator) {
   EXPECT_EQ(expected_composed, ComposeTransforms(t1, t0).value());
 }
 
+/// Tests that repeated composition via the function call operator returns the
+/// cached result, and that the cached result is not modified by subsequent
+/// operations.
+TEST(ComposeTransformsTest, FunctionCallOperatorCached) {
+  const auto t0 = IndexTransformBuilder<2, 2>()
+                      .input_origin({0, 0})
+                      .input_shape({3, 4})
+                      .output_single_input_dimension(0, 10, 1, 0)
+                      .output_single_input_dimension(1, 1)
+                      .Finalize()
+                      .value();
+  const auto make_t1 = [] {
+    return IndexTransformBuilder<2, 2>()
+        .input_origin({10, 0})
+        .input_shape({5, 4})
+        .output_single_input_dimension(0, 20, 1, 0)
+        .output_single_input_dimension(1, 1)
+        .Finalize()
+        .value();
+  };
+  const auto t1 = make_t1();
+  const auto expected_composed = IndexTransformBuilder<2, 2>()
+                                     .input_origin({0, 0})
+                                     .input_shape({3, 4})
+                                     .output_single_input_dimension(0, 30, 1, 0)
+                                     .output_single_input_dimension(1, 1)
+                                     .Finalize()
+                                     .value();
+  auto composed = t0(t1).value();
+  EXPECT_EQ(expected_composed, composed);
+
+  // An equal but distinct transform hits the cache.
+  const auto composed2 = t0(make_t1()).value();
+  EXPECT_EQ(TransformAccess::rep(composed), TransformAccess::rep(composed2));
+
+  // Modifying the result does not affect the cached transform.
+  const DimensionIndex permutation[] = {1, 0};
+  const auto transposed =
+      std::move(composed).TransposeOutput(tensorstore::span(permutation));
+  EXPECT_NE(expected_composed, transposed);
+  EXPECT_EQ(expected_composed, composed2);
+  EXPECT_EQ(expected_composed, t0(t1).value());
+}
+
 /// Tests that rank-0 transforms can be composed.
 TEST(ComposeTransformsTest, RankZero) {
   auto t0 = IdentityTransform(0);
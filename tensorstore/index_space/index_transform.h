@@ -463,22 +463,28 @@ class IndexTransform {
   /// composition, but is consistent with `DimExpression::operator()`, which
   /// also effectively transforms the input space rather than the output space.
   ///
+  /// Since the same transform is commonly applied repeatedly, e.g. to a
+  /// `TensorStore`, recently composed transforms are cached per thread.
+  ///
   /// \id compose
   template <DimensionIndex NewOutputRank, ContainerKind OtherCKind>
   Result<IndexTransform<InputRank, NewOutputRank>> operator()(
       const IndexTransform<OutputRank, NewOutputRank, OtherCKind>& other)
       const {
-    return ComposeTransforms(other, *this);
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto rep, internal_index_space::ComposeTransformsCached(
+                      Access::rep(other), Access::rep(*this)));
+    return Access::Make<IndexTransform<InputRank, NewOutputRank>>(
+        std::move(rep));
   }
 
   template <ContainerKind OtherCKind>
   Result<IndexDomain<InputRank>> operator()(
       const IndexDomain<OutputRank, OtherCKind>& other) const {
     TENSORSTORE_ASSIGN_OR_RETURN(
-        auto rep, internal_index_space::ComposeTransforms(
-                      Access::rep(other),
-                      /*can_move_from_b_to_c=*/false, Access::rep(*this),
-                      /*can_move_from_a_to_b=*/false, /*domain_only=*/true));
+        auto rep, internal_index_space::ComposeTransformsCached(
+                      Access::rep(other), Access::rep(*this),
+                      /*domain_only=*/true));
     return Access::Make<IndexDomain<InputRank>>(std::move(rep));
   }
 
@@ -515,6 +521,13 @@ class IndexTransform {
     return !AreEqual(Access::rep(a), Access::rep(b));
   }
 
+  /// Computes a hash code consistent with `operator==`.
+  template <typename H>
+  friend H AbslHashValue(H h, const IndexTransform& x) {
+    return internal_index_space::HashTransformRep(std::move(h),
+                                                  Access::rep(x));
+  }
+
   /// "Pipeline" operator.
   ///
   /// In the expression `transform | func`, if `func` is a function having
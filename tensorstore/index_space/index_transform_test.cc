@@ -23,6 +23,7 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "absl/hash/hash_testing.h"
 #include "absl/status/status.h"
 #include "tensorstore/array.h"
 #include "tensorstore/container_kind.h"
@@ -223,6 +224,40 @@ TEST(IndexTransformTest, Equality) {
                 .value());
 }
 
+TEST(IndexTransformTest, Hash) {
+  EXPECT_TRUE(absl::VerifyTypeImplementsAbslHashCorrectly({
+      IndexTransform<>(),
+      IndexTransformBuilder<>(2, 3).Finalize().value(),
+      IndexTransformBuilder<>(3, 2).input_shape({2, 3, 4}).Finalize().value(),
+      IndexTransformBuilder<>(3, 2)
+          .input_origin({1, 2, 3})
+          .input_shape({3, 4, 5})
+          .Finalize()
+          .value(),
+      IndexTransformBuilder<>(3, 2)
+          .input_labels({"a", "b", "c"})
+          .Finalize()
+          .value(),
+      IndexTransformBuilder<>(3, 2).output_constant(0, 2).Finalize().value(),
+      IndexTransformBuilder<>(3, 2)
+          .output_single_input_dimension(1, 0, 2, 1)
+          .Finalize()
+          .value(),
+      IndexTransformBuilder<>(3, 2)
+          .input_origin({1, 2, 3})
+          .input_shape({2, 2, 3})
+          .output_index_array(0, 0, 1, MakeArray<Index>({{{1, 1, 1}}}))
+          .Finalize()
+          .value(),
+      IndexTransformBuilder<>(3, 2)
+          .input_origin({1, 2, 3})
+          .input_shape({2, 2, 3})
+          .output_index_array(0, 0, 1, MakeArray<Index>({{{1, 1, 2}}}))
+          .Finalize()
+          .value(),
+  }));
+}
+
 TEST(IndexTransformTest, ImplicitConversion) {
   IndexTransform<2, 2> t = IdentityTransform<2>();
   IndexTransform<> t_labeled = t;
@@ -14,11 +14,14 @@
 
 #include "tensorstore/index_space/internal/compose_transforms.h"
 
+#include <stddef.h>
+
 #include <cassert>
 #include <sstream>
 #include <string>
 #include <utility>
 
+#include "absl/hash/hash.h"
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
 #include "absl/strings/str_replace.h"
@@ -275,6 +278,48 @@ absl::Status ComposeTransformsImpl(TransformRep* b_to_c,
   return absl::OkStatus();
 }
 
+/// Number of entries in the per-thread cache used by
+/// `ComposeTransformsCached`.
+constexpr size_t kComposeTransformsCacheSize = 16;
+
+struct ComposeTransformsCacheKey {
+  TransformRep* b_to_c;
+  TransformRep* a_to_b;
+  bool domain_only;
+
+  template <typename H>
+  friend H AbslHashValue(H h, const ComposeTransformsCacheKey& key) {
+    h = H::combine(std::move(h), key.domain_only);
+    h = HashTransformRep(std::move(h), key.b_to_c);
+    return HashTransformRep(std::move(h), key.a_to_b);
+  }
+};
+
+struct ComposeTransformsCacheEntry {
+  size_t hash;
+  bool domain_only;
+  TransformRep::Ptr<> b_to_c;
+  TransformRep::Ptr<> a_to_b;
+  TransformRep::Ptr<> a_to_c;
+};
+
+/// Fixed-size cache of composed transforms, with round-robin replacement.
+struct ComposeTransformsCache {
+  ComposeTransformsCacheEntry entries[kComposeTransformsCacheSize];
+  size_t next_entry = 0;
+};
+
+bool HasIndexArrayMaps(TransformRep* rep) {
+  for (const auto& map : rep->output_index_maps().first(rep->output_rank)) {
+    if (map.method() == OutputIndexMethod::array) return true;
+  }
+  return false;
+}
+
+bool IsSameTransform(TransformRep* a, TransformRep* b) {
+  return a == b || AreEqual(a, b);
+}
+
 }  // namespace
 
 Result<TransformRep::Ptr<>> ComposeTransforms(TransformRep* b_to_c,
@@ -322,6 +367,40 @@ Result<TransformRep::Ptr<>> ComposeTransforms(TransformRep* b_to_c,
   return status;
 }
 
+Result<TransformRep::Ptr<>> ComposeTransformsCached(TransformRep* b_to_c,
+                                                    TransformRep* a_to_b,
+                                                    bool domain_only) {
+  assert(b_to_c);
+  assert(a_to_b);
+  if (HasIndexArrayMaps(b_to_c) || HasIndexArrayMaps(a_to_b)) {
+    return ComposeTransforms(b_to_c, /*can_move_from_b_to_c=*/false, a_to_b,
+                             /*can_move_from_a_to_b=*/false, domain_only);
+  }
+  thread_local ComposeTransformsCache cache;
+  const size_t hash = absl::Hash<ComposeTransformsCacheKey>{}(
+      ComposeTransformsCacheKey{b_to_c, a_to_b, domain_only});
+  for (const auto& entry : cache.entries) {
+    if (entry.a_to_c && entry.hash == hash &&
+        entry.domain_only == domain_only &&
+        IsSameTransform(entry.b_to_c.get(), b_to_c) &&
+        IsSameTransform(entry.a_to_b.get(), a_to_b)) {
+      return entry.a_to_c;
+    }
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto a_to_c,
+      ComposeTransforms(b_to_c, /*can_move_from_b_to_c=*/false, a_to_b,
+                        /*can_move_from_a_to_b=*/false, domain_only));
+  auto& entry = cache.entries[cache.next_entry];
+  cache.next_entry = (cache.next_entry + 1) % kComposeTransformsCacheSize;
+  entry.hash = hash;
+  entry.domain_only = domain_only;
+  entry.b_to_c = TransformRep::Ptr<>(b_to_c);
+  entry.a_to_b = TransformRep::Ptr<>(a_to_b);
+  entry.a_to_c = a_to_c;
+  return a_to_c;
+}
+
 Result<IndexTransform<dynamic_rank, dynamic_rank, container>> ComposeTransforms(
     IndexTransform<dynamic_rank, dynamic_rank, container> b_to_c,
     IndexTransform<dynamic_rank, dynamic_rank, container> a_to_b,
@@ -40,6 +40,21 @@ Result<TransformRep::Ptr<>> ComposeTransforms(TransformRep* b_to_c,
                                               bool can_move_from_a_to_b,
                                               bool domain_only = false);
 
+/// Same as `ComposeTransforms(b_to_c, false, a_to_b, false, domain_only)`,
+/// but memoizes the result in a small per-thread cache.
+///
+/// Interactive use commonly applies the same slicing transform to the same
+/// `TensorStore` repeatedly, and in that case this avoids allocating and
+/// computing the composed transform each time.  Only transforms without index
+/// array output index maps are cached, to bound the cost of comparing
+/// transforms and the memory retained by the cache.
+///
+/// The returned transform may be shared with the cache, and therefore must not
+/// be modified in place.
+Result<TransformRep::Ptr<>> ComposeTransformsCached(TransformRep* b_to_c,
+                                                    TransformRep* a_to_b,
+                                                    bool domain_only = false);
+
 /// Same as above, but with `IndexTransform` parameters.
 Result<IndexTransform<dynamic_rank, dynamic_rank, container>> ComposeTransforms(
     IndexTransform<dynamic_rank, dynamic_rank, container> b_to_c,
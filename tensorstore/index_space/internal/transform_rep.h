@@ -21,6 +21,7 @@
 #include <iosfwd>
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "absl/status/status.h"
 #include "tensorstore/array.h"
@@ -569,6 +570,46 @@ bool AreDomainsEqual(TransformRep* a, TransformRep* b);
 /// \param b Pointer to a transform, may be `nullptr`.
 bool AreEqual(TransformRep* a, TransformRep* b);
 
+/// Combines a hash of `rep` into the hash state `h`, consistent with
+/// `AreEqual`.
+///
+/// The contents of index arrays are not hashed, only their index ranges, such
+/// that the cost does not depend on the size of any index arrays.
+///
+/// \param h The Abseil hash state.
+/// \param rep Pointer to a transform, may be `nullptr`.
+template <typename H>
+H HashTransformRep(H h, TransformRep* rep) {
+  if (!rep) return H::combine(std::move(h), false);
+  const DimensionIndex input_rank = rep->input_rank;
+  const DimensionIndex output_rank = rep->output_rank;
+  const BoxView<> input_domain = rep->input_domain(input_rank);
+  h = H::combine(std::move(h), true, rep->input_rank, rep->output_rank,
+                 rep->implicit_lower_bounds.to_uint(),
+                 rep->implicit_upper_bounds.to_uint());
+  h = H::combine_contiguous(std::move(h), input_domain.origin().data(),
+                            input_rank);
+  h = H::combine_contiguous(std::move(h), input_domain.shape().data(),
+                            input_rank);
+  h = H::combine_contiguous(std::move(h), rep->input_labels().data(),
+                            input_rank);
+  for (const auto& map : rep->output_index_maps().first(output_rank)) {
+    h = H::combine(std::move(h), map.method(), map.offset());
+    switch (map.method()) {
+      case OutputIndexMethod::constant:
+        break;
+      case OutputIndexMethod::single_input_dimension:
+        h = H::combine(std::move(h), map.input_dimension(), map.stride());
+        break;
+      case OutputIndexMethod::array:
+        h = H::combine(std::move(h), map.stride(),
+                       map.index_array_data().index_range);
+        break;
+    }
+  }
+  return h;
+}
+
 /// Writes a string representation of `transform` to `os`.
 ///
 /// \param os The output stream.
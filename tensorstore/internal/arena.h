@@ -64,6 +64,7 @@ class Arena {
       remaining_bytes_ -= num_bytes;
     } else {
       ptr = ::operator new(num_bytes, std::align_val_t(alignment));
+      ++num_heap_allocations_;
     }
     return static_cast<T*>(ptr);
   }
@@ -88,9 +89,14 @@ class Arena {
                       std::align_val_t(alignment));
   }
 
+  /// Returns the number of allocations that did not fit in the fixed-size
+  /// buffer and were handled using `::operator new`.
+  size_t num_heap_allocations() const { return num_heap_allocations_; }
+
  private:
   tensorstore::span<unsigned char> initial_buffer_;
   size_t remaining_bytes_;
+  size_t num_heap_allocations_ = 0;
 };
 
 /// C++ standard library Allocator implementation that uses `Arena`.
@@ -72,6 +72,17 @@ TEST(ArenaTest, Large) {
   EXPECT_FALSE(Contains(buffer, vec.data()));
 }
 
+TEST(ArenaTest, NumHeapAllocations) {
+  unsigned char buffer[1024];
+  Arena arena(buffer);
+  unsigned char* ptr1 = arena.allocate(100);
+  EXPECT_EQ(0, arena.num_heap_allocations());
+  unsigned char* ptr2 = arena.allocate(2000);
+  EXPECT_EQ(1, arena.num_heap_allocations());
+  arena.deallocate(ptr1, 100);
+  arena.deallocate(ptr2, 2000);
+}
+
 TEST(ArenaTest, MultipleSmall) {
   unsigned char buffer[1024];
   Arena arena(buffer);
@@ -92,6 +92,22 @@ Result<NDIterable::Ptr> AsyncWriteArray::Spec::GetReadNDIterable(
       arena);
 }
 
+Result<SharedOffsetArray<const void>> AsyncWriteArray::Spec::GetReadArrayView(
+    SharedArrayView<const void> array, BoxView<> domain,
+    IndexTransformView<> chunk_transform) const {
+  if (!array.valid()) array = GetFillValueForDomain(domain);
+  assert(internal::RangesEqual(array.shape(), domain.shape()));
+  StridedLayoutView<dynamic_rank, offset_origin> data_layout(
+      domain, array.byte_strides());
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto transform, ComposeLayoutAndTransform(
+                          data_layout, IndexTransform<>(chunk_transform)));
+  return TryConvertToArray(TransformedArray<Shared<const void>>(
+      AddByteOffset(std::move(array.element_pointer()),
+                    -data_layout.origin_byte_offset()),
+      std::move(transform)));
+}
+
 SharedArray<void> AsyncWriteArray::Spec::AllocateArray(
     span<const Index> shape) const {
   return tensorstore::AllocateArray(shape, layout_order(), default_init,
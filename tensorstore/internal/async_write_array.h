@@ -137,6 +137,20 @@ struct AsyncWriteArray {
                                               IndexTransform<> chunk_transform,
                                               Arena* arena) const;
 
+    /// Returns a view of the specified `array`, transformed by
+    /// `chunk_transform`, that shares ownership of `array`.
+    ///
+    /// \param array The array to read. If `!array.valid()`, then the fill value
+    ///     is used instead.
+    /// \param domain The associated domain of the array.
+    /// \param chunk_transform Transform to use for reading, the output rank
+    ///     must equal `rank()`.
+    /// \error `absl::StatusCode::kInvalidArgument` if `chunk_transform`
+    ///     contains an index array map.
+    Result<SharedOffsetArray<const void>> GetReadArrayView(
+        SharedArrayView<const void> array, BoxView<> domain,
+        IndexTransformView<> chunk_transform) const;
+
     size_t EstimateReadStateSizeInBytes(
         bool valid, tensorstore::span<const Index> shape) const {
       if (!valid) return 0;
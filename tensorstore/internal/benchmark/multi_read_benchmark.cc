@@ -64,6 +64,7 @@ bazel run -c opt \
 #include "tensorstore/internal/os/file_util.h"
 #include "tensorstore/open.h"
 #include "tensorstore/open_mode.h"
+#include "tensorstore/read_write_options.h"
 #include "tensorstore/spec.h"
 #include "tensorstore/tensorstore.h"
 #include "tensorstore/util/future.h"
@@ -100,6 +101,11 @@ ABSL_FLAG(std::optional<std::string>, metrics_prefix, std::nullopt,
 
 ABSL_FLAG(int64_t, ith_spec, -1, "Start at the ith spec in the config file.");
 
+ABSL_FLAG(bool, reference_cached_data, false,
+          "Whether reads may return views of the decoded chunk data rather "
+          "than copies.  Combine with a cache_pool limit of 0 to measure "
+          "streaming reads.");
+
 namespace tensorstore {
 namespace {
 
@@ -144,6 +150,10 @@ struct ReadContinuation {
   const std::vector<tensorstore::TensorStore<>>& stores;
 
   int64_t max_in_flight = 0;
+  CachedDataReferencePermission reference_permission =
+      absl::GetFlag(FLAGS_reference_cached_data)
+          ? can_reference_cached_data
+          : cannot_reference_cached_data;
   std::atomic<int64_t> bytes_read = 0;
 
   absl::Mutex mutex;
@@ -159,7 +169,7 @@ static bool StartNextRead(tensorstore::Promise<void> promise,
                           std::shared_ptr<ReadContinuation> self,
                           size_t finish) {
   int64_t estimate = 0;
-  Future<SharedOffsetArray<void>> read_future;
+  Future<SharedOffsetArray<const void>> read_future;
 
   {
     absl::MutexLock lock(&self->mutex);
@@ -177,14 +187,15 @@ static bool StartNextRead(tensorstore::Promise<void> promise,
 
     int64_t estimate = GetBytesEstimate(ts);
     self->in_flight += estimate;
-    read_future = tensorstore::Read(ts);
+    read_future = tensorstore::ReadConst(ts, self->reference_permission);
   }
 
   // Release the mutex before calling Link; the callback may be immediately
   // invoked and deadlock otherwise.
   tensorstore::Link(
       [self = std::move(self), estimate](
-          Promise<void> a_promise, Future<SharedOffsetArray<void>> a_future) {
+          Promise<void> a_promise,
+          Future<SharedOffsetArray<const void>> a_future) {
         if (a_future.status().ok()) {
           self->bytes_read.fetch_add(a_future.value().num_elements() *
                                      a_future.value().dtype().size());
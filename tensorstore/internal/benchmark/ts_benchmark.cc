@@ -88,6 +88,30 @@ bazel run -c opt \
       }
   }'
 
+# Large single-chunk reads, in-memory, 256MB chunks read whole, which are
+# copied to the destination by multiple threads
+
+bazel run -c opt \
+  //tensorstore/internal/benchmark:ts_benchmark -- \
+  --alsologtostderr       \
+  --strategy=sequential   \
+  --total_read_bytes=-10  \
+  --total_write_bytes=-1  \
+  --chunk_bytes=268435456 \
+  --repeat_reads=16       \
+  --repeat_writes=1       \
+  --context_spec='{"cache_pool": { "total_bytes_limit": 1073741824 }}' \
+  --tensorstore_spec='{
+      "driver": "n5",
+      "kvstore": "memory://abc/",
+      "metadata": {
+           "compression": {"type": "raw"},
+           "dataType": "uint8",
+           "blockSize": [512, 512, 1024, 1],
+           "dimensions": [1024, 1024, 1024, 1]
+      }
+  }'
+
 # Quick size reference:
 
 16KB   --chunk_bytes=16384
@@ -0,0 +1,152 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/box_rtree.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+#include "absl/functional/function_ref.h"
+#include "tensorstore/box.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_interval.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal {
+namespace {
+
+// Returns twice the center of `interval`, divided so as to avoid overflow for
+// unbounded intervals.
+Index GetCenterKey(IndexInterval interval) {
+  return interval.inclusive_min() / 2 + interval.inclusive_max() / 2;
+}
+
+// Orders `order[begin, end)` using Sort-Tile-Recursive packing: the boxes are
+// sorted by their center along `dim`, split into slabs, and each slab is
+// recursively ordered along the remaining dimensions.
+void SortTileRecursive(tensorstore::span<const BoxView<>> boxes,
+                       std::vector<size_t>& order, size_t begin, size_t end,
+                       DimensionIndex dim) {
+  const DimensionIndex rank = boxes[0].rank();
+  auto first = order.begin() + begin;
+  auto last = order.begin() + end;
+  std::sort(first, last, [&](size_t a, size_t b) {
+    return GetCenterKey(boxes[a][dim]) < GetCenterKey(boxes[b][dim]);
+  });
+  const size_t count = end - begin;
+  if (dim + 1 >= rank || count <= BoxRTree::kFanout) return;
+  const size_t num_leaves = (count + BoxRTree::kFanout - 1) / BoxRTree::kFanout;
+  const size_t num_slabs = static_cast<size_t>(std::ceil(
+      std::pow(static_cast<double>(num_leaves), 1.0 / (rank - dim))));
+  const size_t slab_size =
+      BoxRTree::kFanout * ((num_leaves + num_slabs - 1) / num_slabs);
+  for (size_t slab_begin = begin; slab_begin < end; slab_begin += slab_size) {
+    SortTileRecursive(boxes, order, slab_begin,
+                      std::min(end, slab_begin + slab_size), dim + 1);
+  }
+}
+
+bool Intersects(BoxView<> a, BoxView<> b) {
+  for (DimensionIndex i = 0; i < a.rank(); ++i) {
+    if (Intersect(a[i], b[i]).empty()) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+BoxRTree::BoxRTree(tensorstore::span<const BoxView<>> boxes) {
+  if (boxes.empty()) return;
+  rank_ = boxes[0].rank();
+  order_.resize(boxes.size());
+  std::iota(order_.begin(), order_.end(), size_t{0});
+  if (rank_ > 0) {
+    SortTileRecursive(boxes, order_, 0, order_.size(), 0);
+  }
+
+  // Leaf level: the boxes themselves.
+  auto& leaves = levels_.emplace_back(2 * rank_ * boxes.size());
+  for (size_t i = 0; i < order_.size(); ++i) {
+    const BoxView<> box = boxes[order_[i]];
+    assert(box.rank() == rank_);
+    std::copy(box.origin().begin(), box.origin().end(),
+              leaves.begin() + 2 * rank_ * i);
+    std::copy(box.shape().begin(), box.shape().end(),
+              leaves.begin() + 2 * rank_ * i + rank_);
+  }
+
+  // Interior levels, until a single root node remains.
+  for (size_t num_children = boxes.size(); num_children > 1;) {
+    const size_t num_nodes = (num_children + kFanout - 1) / kFanout;
+    std::vector<Index> nodes(2 * rank_ * num_nodes);
+    const size_t child_level = levels_.size() - 1;
+    for (size_t node_i = 0; node_i < num_nodes; ++node_i) {
+      MutableBoxView<> node(rank_, &nodes[2 * rank_ * node_i],
+                            &nodes[2 * rank_ * node_i + rank_]);
+      const size_t child_end = std::min(num_children, (node_i + 1) * kFanout);
+      for (size_t child_i = node_i * kFanout; child_i < child_end; ++child_i) {
+        BoxView<> child = GetBounds(child_level, child_i);
+        for (DimensionIndex dim = 0; dim < rank_; ++dim) {
+          node[dim] = (child_i == node_i * kFanout)
+                          ? child[dim]
+                          : Hull(node[dim], child[dim]);
+        }
+      }
+    }
+    levels_.push_back(std::move(nodes));
+    num_children = num_nodes;
+  }
+}
+
+void BoxRTree::QueryNode(BoxView<> query, size_t level, size_t i,
+                         absl::FunctionRef<void(size_t)> callback) const {
+  if (!Intersects(GetBounds(level, i), query)) return;
+  if (level == 0) {
+    callback(order_[i]);
+    return;
+  }
+  const size_t num_children = levels_[level - 1].size() / (2 * rank_);
+  const size_t child_end = std::min(num_children, (i + 1) * kFanout);
+  for (size_t child_i = i * kFanout; child_i < child_end; ++child_i) {
+    QueryNode(query, level - 1, child_i, callback);
+  }
+}
+
+void BoxRTree::Query(BoxView<> query,
+                     absl::FunctionRef<void(size_t)> callback) const {
+  if (order_.empty()) return;
+  assert(query.rank() == rank_);
+  if (rank_ == 0) {
+    // All rank-0 boxes contain the single point of the index space.
+    for (size_t id : order_) callback(id);
+    return;
+  }
+  QueryNode(query, levels_.size() - 1, 0, callback);
+}
+
+std::vector<size_t> BoxRTree::FindIntersecting(BoxView<> query) const {
+  std::vector<size_t> result;
+  Query(query, [&](size_t id) { result.push_back(id); });
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+}  // namespace internal
+}  // namespace tensorstore
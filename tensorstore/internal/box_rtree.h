@@ -0,0 +1,91 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_BOX_RTREE_H_
+#define TENSORSTORE_INTERNAL_BOX_RTREE_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "absl/functional/function_ref.h"
+#include "tensorstore/box.h"
+#include "tensorstore/index.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal {
+
+/// Static R-tree over a fixed sequence of boxes of equal rank, used by the
+/// "stack" driver to find the layers intersecting a request.
+///
+/// The tree is bulk-loaded using Sort-Tile-Recursive packing, so finding the
+/// `k` boxes which intersect a query box requires visiting `O(log n + k)`
+/// nodes for typical (non-pathologically overlapping) inputs.
+class BoxRTree {
+ public:
+  /// Maximum number of children of each node.
+  constexpr static size_t kFanout = 16;
+
+  BoxRTree() = default;
+
+  /// Constructs a tree over `boxes`.  The box at position `i` is identified by
+  /// the index `i`.
+  ///
+  /// \dchecks All boxes have the same rank.
+  explicit BoxRTree(tensorstore::span<const BoxView<>> boxes);
+
+  /// The rank of the boxes.
+  DimensionIndex rank() const { return rank_; }
+
+  /// The number of boxes in the tree.
+  size_t size() const { return order_.size(); }
+
+  /// Invokes `callback(i)` for each box `i` that intersects `query`, in
+  /// unspecified order.  Empty boxes never intersect.
+  ///
+  /// \dchecks `query.rank() == rank()`
+  void Query(BoxView<> query, absl::FunctionRef<void(size_t)> callback) const;
+
+  /// Returns the identifiers of the boxes that intersect `query`, in
+  /// increasing order.
+  std::vector<size_t> FindIntersecting(BoxView<> query) const;
+
+ private:
+  // Returns the bounds of entry `i` of `level`.
+  BoxView<> GetBounds(size_t level, size_t i) const {
+    return BoxView<>(rank_, &levels_[level][2 * rank_ * i],
+                     &levels_[level][2 * rank_ * i + rank_]);
+  }
+
+  void QueryNode(BoxView<> query, size_t level, size_t i,
+                 absl::FunctionRef<void(size_t)> callback) const;
+
+  DimensionIndex rank_ = 0;
+
+  // Identifiers of the boxes, in leaf order.
+  std::vector<size_t> order_;
+
+  // `levels_[0]` holds the bounds of the boxes in leaf order, and
+  // `levels_[l]` holds the bounds of the nodes at height `l`.  Entry `i` of
+  // level `l > 0` covers entries `[i * kFanout, (i + 1) * kFanout)` of level
+  // `l - 1`.  Each entry is stored as `rank_` origin values followed by
+  // `rank_` shape values.
+  std::vector<std::vector<Index>> levels_;
+};
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_BOX_RTREE_H_
@@ -0,0 +1,118 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/box_rtree.h"
+
+#include <stddef.h>
+
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/random/random.h"
+#include "tensorstore/box.h"
+#include "tensorstore/index.h"
+
+namespace {
+
+using ::tensorstore::Box;
+using ::tensorstore::BoxView;
+using ::tensorstore::DimensionIndex;
+using ::tensorstore::Index;
+using ::tensorstore::internal::BoxRTree;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+std::vector<BoxView<>> GetViews(const std::vector<Box<>>& boxes) {
+  return std::vector<BoxView<>>(boxes.begin(), boxes.end());
+}
+
+TEST(BoxRTreeTest, Empty) {
+  BoxRTree tree;
+  EXPECT_EQ(0, tree.size());
+  EXPECT_THAT(tree.FindIntersecting(BoxView<>(0)), IsEmpty());
+  EXPECT_THAT(tree.FindIntersecting(Box<>({0, 0}, {5, 5})), IsEmpty());
+}
+
+TEST(BoxRTreeTest, Basic) {
+  std::vector<Box<>> boxes{
+      Box<>({0, 0}, {4, 4}),
+      Box<>({4, 0}, {4, 4}),
+      Box<>({2, 2}, {4, 4}),
+      Box<>({10, 10}, {0, 4}),
+  };
+  auto views = GetViews(boxes);
+  BoxRTree tree(views);
+  EXPECT_EQ(2, tree.rank());
+  EXPECT_EQ(4, tree.size());
+  EXPECT_THAT(tree.FindIntersecting(Box<>({0, 0}, {1, 1})), ElementsAre(0));
+  EXPECT_THAT(tree.FindIntersecting(Box<>({3, 3}, {2, 2})),
+              ElementsAre(0, 1, 2));
+  EXPECT_THAT(tree.FindIntersecting(Box<>({6, 0}, {2, 2})), ElementsAre(1));
+  EXPECT_THAT(tree.FindIntersecting(Box<>({8, 8}, {10, 10})), IsEmpty());
+  EXPECT_THAT(tree.FindIntersecting(BoxView<>(2)), ElementsAre(0, 1, 2));
+}
+
+TEST(BoxRTreeTest, Rank0) {
+  std::vector<Box<>> boxes{Box<>(0), Box<>(0)};
+  auto views = GetViews(boxes);
+  BoxRTree tree(views);
+  EXPECT_THAT(tree.FindIntersecting(BoxView<>(0)), ElementsAre(0, 1));
+}
+
+TEST(BoxRTreeTest, Unbounded) {
+  std::vector<Box<>> boxes{Box<>(1), Box<>({5}, {1})};
+  auto views = GetViews(boxes);
+  BoxRTree tree(views);
+  EXPECT_THAT(tree.FindIntersecting(Box<>({5}, {1})), ElementsAre(0, 1));
+  EXPECT_THAT(tree.FindIntersecting(Box<>({-100}, {1})), ElementsAre(0));
+}
+
+// Compares the tree against a linear scan for random boxes.
+TEST(BoxRTreeTest, MatchesLinearScan) {
+  absl::BitGen gen;
+  for (DimensionIndex rank = 1; rank <= 3; ++rank) {
+    std::vector<Box<>> boxes;
+    for (int i = 0; i < 1000; ++i) {
+      Box<> box(rank);
+      for (DimensionIndex dim = 0; dim < rank; ++dim) {
+        box[dim] = tensorstore::IndexInterval::UncheckedSized(
+            absl::Uniform<Index>(gen, -100, 100),
+            absl::Uniform<Index>(gen, 0, 10));
+      }
+      boxes.push_back(std::move(box));
+    }
+    auto views = GetViews(boxes);
+    BoxRTree tree(views);
+    for (int query_i = 0; query_i < 100; ++query_i) {
+      Box<> query(rank);
+      for (DimensionIndex dim = 0; dim < rank; ++dim) {
+        query[dim] = tensorstore::IndexInterval::UncheckedSized(
+            absl::Uniform<Index>(gen, -110, 110),
+            absl::Uniform<Index>(gen, 0, 30));
+      }
+      std::vector<size_t> expected;
+      for (size_t i = 0; i < boxes.size(); ++i) {
+        bool intersects = true;
+        for (DimensionIndex dim = 0; dim < rank; ++dim) {
+          if (Intersect(boxes[i][dim], query[dim]).empty()) intersects = false;
+        }
+        if (intersects) expected.push_back(i);
+      }
+      EXPECT_EQ(expected, tree.FindIntersecting(query)) << query;
+    }
+  }
+}
+
+}  // namespace
@@ -167,6 +167,26 @@ struct ReadChunkImpl {
     return grid.components[component_index].array_spec.GetReadNDIterable(
         std::move(read_array), domain, std::move(chunk_transform), arena);
   }
+
+  bool operator()(ReadChunk::ReadArray, IndexTransformView<> chunk_transform,
+                  SharedOffsetArray<const void>& array) const {
+    auto& grid = GetOwningCache(*entry).grid();
+    auto domain = grid.GetCellDomain(component_index, entry->cell_indices());
+    SharedArray<const void, dynamic_rank(kMaxRank)> read_array{
+        ChunkCache::GetReadComponent(
+            AsyncCache::ReadLock<ChunkCache::ReadData>(*entry).data(),
+            component_index)};
+    // Missing chunks are handled by `BeginRead`, which either fills in the
+    // fill value or returns an error.
+    if (!read_array.valid()) return false;
+    // The cached chunk data is immutable, and may therefore be shared.
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        array,
+        grid.components[component_index].array_spec.GetReadArrayView(
+            std::move(read_array), domain, chunk_transform),
+        false);
+    return true;
+  }
 };
 
 /// TensorStore Driver ReadChunk implementation for the chunk cache, for the
@@ -243,6 +263,13 @@ struct ReadChunkTransactionImpl {
                                        std::move(read_array), read_generation,
                                        std::move(chunk_transform), arena);
   }
+
+  bool operator()(ReadChunk::ReadArray,
+                  IndexTransformView<> /*chunk_transform*/,
+                  SharedOffsetArray<const void>& /*array*/) const {
+    // The chunk may reflect uncommitted writes, which are not immutable.
+    return false;
+  }
 };
 
 /// TensorStore Driver WriteChunk implementation for the chunk cache.
@@ -397,6 +424,9 @@ struct WriteChunkImpl {
               source_capabilities = WriteArraySourceCapabilities::
                   kImmutableAndCanRetainIndefinitely;
               break;
+            case can_take_source_data:
+              source_capabilities = WriteArraySourceCapabilities::kMutable;
+              break;
           }
           return {std::in_place, std::move(std::get<0>(info)),
                   source_capabilities};
@@ -644,6 +644,126 @@ TEST_F(ChunkCacheTest, ReadSingleComponentOneDimensionalExisting) {
   }
 }
 
+// Tests that reads into a new read-only array may return a view of the cached
+// chunk data if permitted by `can_reference_cached_data`.
+TEST_F(ChunkCacheTest, CanReferenceCachedData) {
+  // Dimension 0 is chunked with a size of 2.
+  grid = GetSimple1DGrid();
+
+  // Initialize chunk 1 in the `memory_store`.
+  SetChunk({1}, {MakeArray<int>({42, 43})});
+
+  auto cache = MakeChunkCache();
+  auto store = GetTensorStore(cache, absl::InfinitePast());
+
+  // Populate the cache with chunks 1 and 2.
+  {
+    auto read_future =
+        tensorstore::Read(store | tensorstore::Dims(0).SizedInterval(2, 4));
+    {
+      auto r = mock_store->read_requests.pop();
+      EXPECT_THAT(ParseKey(r.key), ElementsAre(1));
+      r(memory_store);
+    }
+    {
+      auto r = mock_store->read_requests.pop();
+      EXPECT_THAT(ParseKey(r.key), ElementsAre(2));
+      r(memory_store);
+    }
+    EXPECT_THAT(read_future.result(),
+                ::testing::Optional(
+                    tensorstore::MakeOffsetArray<int>({2}, {42, 43, 4, 5})));
+  }
+
+  for (bool reference_cached_data : {false, true}) {
+    SCOPED_TRACE(
+        absl::StrFormat("reference_cached_data=%d", reference_cached_data));
+    const auto read = [&](Index start, Index size) {
+      return tensorstore::ReadConst(
+                 store | tensorstore::Dims(0).SizedInterval(start, size),
+                 reference_cached_data
+                     ? tensorstore::can_reference_cached_data
+                     : tensorstore::cannot_reference_cached_data)
+          .result();
+    };
+
+    // Entire chunk 1, which is present.
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto a, read(2, 2));
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto b, read(2, 2));
+    EXPECT_EQ(tensorstore::MakeOffsetArray<int>({2}, {42, 43}), a);
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(reference_cached_data, a.data() == b.data());
+
+    // Sub-range of chunk 1.
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto c, read(3, 1));
+    EXPECT_EQ(tensorstore::MakeOffsetArray<int>({3}, {43}), c);
+    EXPECT_EQ(reference_cached_data, c.data() == b.data());
+
+    // Spans two chunks, and is always copied.
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto d, read(3, 2));
+    EXPECT_EQ(tensorstore::MakeOffsetArray<int>({3}, {43, 4}), d);
+
+    // Chunk 2 is missing, and is always copied from the fill value.
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto e, read(4, 2));
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto f, read(4, 2));
+    EXPECT_EQ(tensorstore::MakeOffsetArray<int>({4}, {4, 5}), e);
+    EXPECT_NE(e.data(), f.data());
+  }
+
+  // A mutable array is always a copy, even if referencing cached data is
+  // permitted.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto view, tensorstore::ReadConst(
+                     store | tensorstore::Dims(0).SizedInterval(2, 2),
+                     tensorstore::can_reference_cached_data)
+                     .result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto copy,
+      tensorstore::Read(store | tensorstore::Dims(0).SizedInterval(2, 2),
+                        tensorstore::can_reference_cached_data)
+          .result());
+  EXPECT_EQ(view, copy);
+  EXPECT_NE(view.data(), copy.data());
+}
+
+// Tests that with caching disabled, a chunk-aligned read that may reference
+// cached data returns the decoded chunk directly, which remains valid after the
+// cache entry is destroyed.
+TEST_F(ChunkCacheTest, CanReferenceCachedDataCacheDisabled) {
+  // Dimension 0 is chunked with a size of 2.
+  grid = GetSimple1DGrid();
+  SetChunk({1}, {MakeArray<int>({42, 43})});
+  SetChunk({2}, {MakeArray<int>({44, 45})});
+  auto cache = MakeChunkCache("", CachePool::StrongPtr{});
+  auto store = GetTensorStore(cache, absl::InfinitePast());
+
+  const auto read = [&](Index start, Index size,
+                        std::vector<std::vector<Index>> expected_keys) {
+    auto read_future = tensorstore::ReadConst(
+        store | tensorstore::Dims(0).SizedInterval(start, size),
+        tensorstore::can_reference_cached_data);
+    std::vector<std::vector<Index>> keys;
+    for (size_t i = 0; i < expected_keys.size(); ++i) {
+      auto r = mock_store->read_requests.pop();
+      keys.push_back(ParseKey(r.key));
+      r(memory_store);
+    }
+    EXPECT_THAT(keys, ::testing::UnorderedElementsAreArray(expected_keys));
+    return read_future.result();
+  };
+
+  // Each read is satisfied by a new read request, since nothing is cached.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto a, read(2, 2, {{1}}));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto b, read(2, 2, {{1}}));
+  EXPECT_EQ(tensorstore::MakeOffsetArray<int>({2}, {42, 43}), a);
+  EXPECT_EQ(a, b);
+  EXPECT_NE(a.data(), b.data());
+
+  // Spans two chunks, and is copied into a newly-allocated array.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto c, read(3, 2, {{1}, {2}}));
+  EXPECT_EQ(tensorstore::MakeOffsetArray<int>({3}, {43, 44}), c);
+}
+
 // Test reading the fill value from a two-dimensional chunk cache.
 TEST_F(ChunkCacheTest, TwoDimensional) {
   grid = ChunkGridSpecification({ChunkGridSpecification::Component{
@@ -2010,4 +2130,123 @@ TEST_F(ChunkCacheTest, CanReferenceSourceDataIndefinitely) {
   }
 }
 
+// Tests that with `can_take_source_data`, a subsequent partial write modifies
+// the source array in place, rather than a copy of it.
+TEST_F(ChunkCacheTest, CanTakeSourceData) {
+  // Dimension 0 is chunked with a size of 2.
+  grid = GetSimple1DGrid();
+  for (bool take_source_data : {false, true}) {
+    SCOPED_TRACE(absl::StrFormat("take_source_data=%d", take_source_data));
+    auto cache = MakeChunkCache();
+    Transaction transaction(tensorstore::isolated);
+    auto store = GetTensorStore(cache, {}, 0, transaction);
+    // Retained only to observe whether it is modified in place.
+    auto source = MakeArray<int>({42, 43});
+    TENSORSTORE_ASSERT_OK(
+        tensorstore::Write(
+            source, store | tensorstore::Dims(0).SizedInterval(0, 2),
+            take_source_data
+                ? tensorstore::can_take_source_data
+                : tensorstore::can_reference_source_data_indefinitely)
+            .copy_future);
+    TENSORSTORE_ASSERT_OK(
+        tensorstore::Write(tensorstore::MakeScalarArray<int>(7),
+                           store | tensorstore::Dims(0).IndexSlice(0))
+            .copy_future);
+    EXPECT_EQ(take_source_data ? 7 : 42, source(0));
+
+    auto commit_future = transaction.CommitAsync();
+    {
+      auto r = mock_store->write_requests.pop();
+      EXPECT_THAT(ParseKey(r.key), ElementsAre(0));
+      r(memory_store);
+    }
+    TENSORSTORE_EXPECT_OK(commit_future);
+    EXPECT_THAT(GetChunk({0}), ElementsAre(MakeArray<int>({7, 43})));
+  }
+}
+
+// Tests that with `can_take_source_data`, a source that is broadcast to the
+// target domain is not modified in place by a subsequent partial write, since
+// multiple positions of the chunk refer to the same source element.
+TEST_F(ChunkCacheTest, CanTakeSourceDataBroadcast) {
+  // Dimension 0 is chunked with a size of 2.
+  // Dimension 1 has a size of 2 and is not chunked.
+  grid = ChunkGridSpecification({ChunkGridSpecification::Component{
+      AsyncWriteArray::Spec{
+          MakeSequentialArray<int>(BoxView<>{{0, 0}, {10, 10}}), Box<>(2)},
+      /*chunk_shape=*/{2, 2},
+      {0}}});
+  auto cache = MakeChunkCache();
+  Transaction transaction(tensorstore::isolated);
+  auto store = GetTensorStore(cache, {}, 0, transaction);
+  // Broadcast along dimension 0 of the target.
+  auto source = MakeArray<int>({5, 6});
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Write(source,
+                         store | tensorstore::Dims(0, 1).TranslateSizedInterval(
+                                     {0, 0}, {2, 2}),
+                         tensorstore::can_take_source_data)
+          .copy_future);
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Write(tensorstore::MakeScalarArray<int>(7),
+                         store | tensorstore::Dims(0, 1).IndexSlice({0, 0}))
+          .copy_future);
+  EXPECT_EQ(MakeArray<int>({5, 6}), source);
+
+  auto commit_future = transaction.CommitAsync();
+  {
+    auto r = mock_store->write_requests.pop();
+    EXPECT_THAT(ParseKey(r.key), ElementsAre(0));
+    r(memory_store);
+  }
+  TENSORSTORE_EXPECT_OK(commit_future);
+  EXPECT_THAT(GetChunk({0}), ElementsAre(MakeArray<int>({{7, 6}, {5, 6}})));
+}
+
+// Tests that `ReadMany` fetches each chunk once, even when it is needed by
+// multiple (possibly overlapping) regions.
+TEST_F(ChunkCacheTest, ReadManyFetchesEachChunkOnce) {
+  // Dimension 0 is chunked with a size of 2.
+  grid = GetSimple1DGrid();
+  SetChunk({1}, {MakeArray<int>({42, 43})});
+  auto store = GetTensorStore();
+
+  std::vector<IndexTransform<>> transforms;
+  std::vector<SharedArray<int>> arrays;
+  std::vector<tensorstore::TransformedSharedArray<void>> targets;
+  for (auto [start, size] : {std::pair<Index, Index>{2, 2}, {3, 1}, {3, 2}}) {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto transform, tensorstore::IdentityTransform(1) |
+                            tensorstore::Dims(0).SizedInterval(start, size));
+    transforms.push_back(std::move(transform));
+    arrays.push_back(tensorstore::AllocateArray<int>({size}));
+    targets.push_back(arrays.back());
+  }
+  auto read_future = tensorstore::ReadMany(store, transforms, targets);
+  std::vector<std::vector<Index>> keys;
+  for (size_t i = 0; i < 2; ++i) {
+    auto r = mock_store->read_requests.pop();
+    keys.push_back(ParseKey(r.key));
+    r(memory_store);
+  }
+  EXPECT_THAT(keys, ::testing::UnorderedElementsAre(ElementsAre(1),
+                                                    ElementsAre(2)));
+  TENSORSTORE_EXPECT_OK(read_future);
+  EXPECT_TRUE(mock_store->read_requests.empty());
+  EXPECT_THAT(arrays,
+              ElementsAre(MakeArray<int>({42, 43}), MakeArray<int>({43}),
+                          MakeArray<int>({43, 4})));
+}
+
+TEST_F(ChunkCacheTest, ReadManyMismatchedLengths) {
+  grid = GetSimple1DGrid();
+  auto store = GetTensorStore();
+  std::vector<IndexTransform<>> transforms{tensorstore::IdentityTransform(1)};
+  EXPECT_THAT(tensorstore::ReadMany(store, transforms, {}).result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            "Number of source transforms \\(1\\) does not "
+                            "match number of targets \\(0\\)"));
+}
+
 }  // namespace
@@ -14,6 +14,10 @@
 
 #include "tensorstore/internal/compression/zlib.h"
 
+#include <stddef.h>
+
+#include <limits>
+
 #include "absl/base/optimization.h"
 #include "absl/log/absl_check.h"
 #include "absl/status/status.h"
@@ -57,12 +61,18 @@ struct DeflateOp {
 /// \param level Compression level, must be in the range [0, 9].
 /// \param use_gzip_header If `true`, use gzip header.  Otherwise, use zlib
 ///     header.
+/// \param max_output_size Maximum number of bytes to append to `*output`.
 /// \returns `absl::Status()` on success.
 /// \error `absl::StatusCode::kInvalidArgument` if decoding fails due to input
 ///     input.
+/// \error `absl::StatusCode::kResourceExhausted` if the output exceeds
+///     `max_output_size`.
 template <typename Op>
 absl::Status ProcessZlib(const absl::Cord& input, absl::Cord* output, int level,
-                         bool use_gzip_header) {
+                         bool use_gzip_header,
+                         size_t max_output_size =
+                             std::numeric_limits<size_t>::max()) {
+  const size_t initial_output_size = output->size();
   z_stream s = {};
   internal::CordStreamManager<z_stream, /*BufferSize=*/16 * 1024>
       stream_manager(s, input, output);
@@ -82,6 +92,10 @@ absl::Status ProcessZlib(const absl::Cord& input, absl::Cord* output, int level,
     const bool input_complete = stream_manager.FeedInputAndOutputBuffers();
     err = Op::Process(&s, input_complete ? Z_FINISH : Z_NO_FLUSH);
     const bool made_progress = stream_manager.HandleOutput();
+    if (output->size() - initial_output_size > max_output_size) {
+      return absl::ResourceExhaustedError(
+          "Decoded zlib-compressed data exceeds maximum size");
+    }
     if (err == Z_OK) continue;
     if (err == Z_BUF_ERROR && made_progress) continue;
     break;
@@ -114,8 +128,9 @@ void Encode(const absl::Cord& input, absl::Cord* output,
 }
 
 absl::Status Decode(const absl::Cord& input, absl::Cord* output,
-                    bool use_gzip_header) {
-  return ProcessZlib<InflateOp>(input, output, 0, use_gzip_header);
+                    bool use_gzip_header, size_t max_output_size) {
+  return ProcessZlib<InflateOp>(input, output, 0, use_gzip_header,
+                                max_output_size);
 }
 
 }  // namespace zlib
@@ -18,6 +18,10 @@
 /// \file
 /// Convenience interface to the zlib library.
 
+#include <stddef.h>
+
+#include <limits>
+
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
 
@@ -51,10 +55,16 @@ void Encode(const absl::Cord& input, absl::Cord* output,
 ///     appended.
 /// \param use_gzip_header Specifies the header type with which `input` was
 ///     encoded.
+/// \param max_output_size Maximum number of bytes to append to `*output`.
+///     Decoding stops once this is exceeded, which bounds the memory used to
+///     decode untrusted input.
 /// \returns `absl::Status()` on success.
 /// \error `absl::StatusCode::kInvalidArgument` if `input` is corrupt.
-absl::Status Decode(const absl::Cord& input, absl::Cord* output,
-                    bool use_gzip_header);
+/// \error `absl::StatusCode::kResourceExhausted` if the decoded output exceeds
+///     `max_output_size`.
+absl::Status Decode(
+    const absl::Cord& input, absl::Cord* output, bool use_gzip_header,
+    size_t max_output_size = std::numeric_limits<size_t>::max());
 
 }  // namespace zlib
 }  // namespace tensorstore
@@ -108,6 +108,36 @@ TEST_P(ZlibCompressorTest, NonDefaultLevel) {
   EXPECT_EQ(input, decode_result);
 }
 
+// Tests that decoding stops once the output exceeds `max_output_size`.
+TEST_P(ZlibCompressorTest, MaxOutputSize) {
+  const bool use_gzip_header = GetParam();
+  zlib::Options options{6, use_gzip_header};
+  // Highly compressible input, which decodes to much more than it encodes to.
+  const absl::Cord input(std::string(1024 * 1024, 'a'));
+  absl::Cord encode_result;
+  zlib::Encode(input, &encode_result, options);
+  {
+    absl::Cord decode_result;
+    TENSORSTORE_ASSERT_OK(zlib::Decode(encode_result, &decode_result,
+                                       use_gzip_header, input.size()));
+    EXPECT_EQ(input, decode_result);
+  }
+  {
+    absl::Cord decode_result;
+    EXPECT_THAT(zlib::Decode(encode_result, &decode_result, use_gzip_header,
+                             input.size() - 1),
+                MatchesStatus(absl::StatusCode::kResourceExhausted));
+  }
+  {
+    // Decoding stops well before the full output is produced.
+    absl::Cord decode_result;
+    EXPECT_THAT(zlib::Decode(encode_result, &decode_result, use_gzip_header,
+                             input.size() / 2),
+                MatchesStatus(absl::StatusCode::kResourceExhausted));
+    EXPECT_LT(decode_result.size(), input.size());
+  }
+}
+
 // Tests that decoding corrupt data gives an error.
 TEST_P(ZlibCompressorTest, DecodeCorruptData) {
   const bool use_gzip_header = GetParam();
@@ -23,6 +23,7 @@
 #include <cerrno>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <optional>
@@ -31,10 +32,14 @@
 #include <utility>
 #include <vector>
 
+#include "absl/base/no_destructor.h"
+#include "absl/base/thread_annotations.h"
 #include "absl/flags/flag.h"
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/time/clock.h"
@@ -98,6 +103,11 @@ auto& http_response_bytes =
         MetricMetadata("HTTP response bytes received",
                        internal_metrics::Units::kBytes));
 
+auto& http_response_bytes_copied = internal_metrics::Counter<int64_t>::New(
+    "/tensorstore/http/response_bytes_copied",
+    MetricMetadata("HTTP response bytes copied after being received by curl",
+                   internal_metrics::Units::kBytes));
+
 auto& http_active = internal_metrics::Gauge<int64_t>::New(
     "/tensorstore/http/active",
     MetricMetadata("HTTP requests considered active"));
@@ -126,6 +136,73 @@ uint32_t GetHttpThreads() {
                           .value_or(4u));
 }
 
+// libcurl reuses its receive buffer once the write callback returns, so each
+// response byte must be copied out of it once.  Response bodies are copied
+// into large blocks which are handed to the HttpResponseHandler as external
+// absl::Cord chunks once full, such that the handler receives a few large
+// chunks that it can retain without copying, rather than many small fragments.
+constexpr size_t kReceiveBlockSize = 256 * 1024;
+
+// A partially filled pooled block at the end of a response is copied into a
+// flat cord when it holds at most this many bytes, rather than pinning the
+// whole block for the lifetime of the response.
+constexpr size_t kMaxCopiedTailSize = 16 * 1024;
+
+// Maximum number of idle receive blocks retained for reuse.
+constexpr size_t kMaxPooledReceiveBlocks = 64;
+
+// Free list of `kReceiveBlockSize` receive blocks.
+class ReceiveBlockPool {
+ public:
+  char* Allocate() {
+    {
+      absl::MutexLock lock(&mutex_);
+      if (!free_blocks_.empty()) {
+        char* block = free_blocks_.back();
+        free_blocks_.pop_back();
+        return block;
+      }
+    }
+    return new char[kReceiveBlockSize];
+  }
+
+  void Release(char* block) {
+    {
+      absl::MutexLock lock(&mutex_);
+      if (free_blocks_.size() < kMaxPooledReceiveBlocks) {
+        free_blocks_.push_back(block);
+        return;
+      }
+    }
+    delete[] block;
+  }
+
+ private:
+  absl::Mutex mutex_;
+  std::vector<char*> free_blocks_ ABSL_GUARDED_BY(mutex_);
+};
+
+ReceiveBlockPool& GetReceiveBlockPool() {
+  static absl::NoDestructor<ReceiveBlockPool> pool;
+  return *pool;
+}
+
+// Receive blocks are either pooled blocks of `kReceiveBlockSize` bytes, or,
+// when the remaining response size is known to be smaller, exactly-sized
+// blocks which are not pooled.
+char* AllocateReceiveBlock(size_t capacity) {
+  if (capacity == kReceiveBlockSize) return GetReceiveBlockPool().Allocate();
+  return new char[capacity];
+}
+
+void ReleaseReceiveBlock(char* block, size_t capacity) {
+  if (capacity == kReceiveBlockSize) {
+    GetReceiveBlockPool().Release(block);
+  } else {
+    delete[] block;
+  }
+}
+
 struct CurlRequestState {
   std::shared_ptr<CurlHandleFactory> factory_;
   CurlHandle handle_;
@@ -135,6 +212,10 @@ struct CurlRequestState {
   size_t payload_remaining_;
   HttpResponseHandler* response_handler_ = nullptr;
   size_t response_payload_size_ = 0;
+  std::optional<size_t> response_content_length_;
+  char* receive_block_ = nullptr;
+  size_t receive_block_capacity_ = 0;
+  size_t receive_block_size_ = 0;
   bool status_set = false;
   char error_buffer_[CURL_ERROR_SIZE];
 
@@ -172,6 +253,9 @@ struct CurlRequestState {
     handle_.SetOption(CURLOPT_HEADERFUNCTION, nullptr);
     handle_.SetOption(CURLOPT_ERRORBUFFER, nullptr);
     CurlHandle::Cleanup(*factory_, std::move(handle_));
+    if (receive_block_) {
+      ReleaseReceiveBlock(receive_block_, receive_block_capacity_);
+    }
   }
 
   void Prepare(const HttpRequest& request, IssueRequestOptions options) {
@@ -286,17 +370,78 @@ struct CurlRequestState {
     return true;
   }
 
+  // Copies `data` into the current receive block, passing each block to the
+  // response handler once it is full.
+  void AppendResponseBody(std::string_view data) {
+    while (!data.empty()) {
+      if (receive_block_ == nullptr) {
+        receive_block_capacity_ = kReceiveBlockSize;
+        // The content length is only a hint; with content-encoding the
+        // decoded body may exceed it.
+        if (response_content_length_ &&
+            *response_content_length_ > response_payload_size_) {
+          receive_block_capacity_ =
+              std::min(receive_block_capacity_,
+                       *response_content_length_ - response_payload_size_);
+        }
+        receive_block_ = AllocateReceiveBlock(receive_block_capacity_);
+        receive_block_size_ = 0;
+      }
+      size_t n =
+          std::min(data.size(), receive_block_capacity_ - receive_block_size_);
+      std::memcpy(receive_block_ + receive_block_size_, data.data(), n);
+      http_response_bytes_copied.IncrementBy(n);
+      receive_block_size_ += n;
+      response_payload_size_ += n;
+      data.remove_prefix(n);
+      if (receive_block_size_ == receive_block_capacity_) {
+        FlushResponseBody();
+      }
+    }
+  }
+
+  // Passes any buffered response body data to the response handler.
+  void FlushResponseBody() {
+    if (receive_block_ == nullptr || receive_block_size_ == 0) return;
+    std::string_view data(receive_block_, receive_block_size_);
+    if (receive_block_capacity_ == kReceiveBlockSize &&
+        data.size() <= kMaxCopiedTailSize) {
+      // Small tail of a pooled block; copy it again so that the block may be
+      // reused.
+      http_response_bytes_copied.IncrementBy(data.size());
+      receive_block_size_ = 0;
+      response_handler_->OnResponseBody(absl::Cord(data));
+      return;
+    }
+    char* block = std::exchange(receive_block_, nullptr);
+    response_handler_->OnResponseBody(absl::MakeCordFromExternal(
+        data, [block, capacity = receive_block_capacity_] {
+          ReleaseReceiveBlock(block, capacity);
+        }));
+  }
+
   static size_t CurlHeaderCallback(void* contents, size_t size, size_t nmemb,
                                    void* userdata) {
     auto* self = static_cast<CurlRequestState*>(userdata);
     auto data =
         std::string_view(static_cast<char const*>(contents), size * nmemb);
+    if (absl::StartsWith(data, "HTTP/")) {
+      // Status line of a new header block, e.g. following an interim 1xx
+      // response or a redirect.  Any content length applies to the previous
+      // response.
+      self->response_content_length_ = std::nullopt;
+    }
     if (self->MaybeSetStatusAndProcess()) {
       auto* h = self->response_handler_;
-      ParseAndSetHeaders(
-          data, [h](std::string_view field_name, std::string_view field_value) {
-            h->OnResponseHeader(field_name, field_value);
-          });
+      ParseAndSetHeaders(data, [self, h](std::string_view field_name,
+                                         std::string_view field_value) {
+        size_t content_length;
+        if (absl::EqualsIgnoreCase(field_name, "content-length") &&
+            absl::SimpleAtoi(field_value, &content_length)) {
+          self->response_content_length_ = content_length;
+        }
+        h->OnResponseHeader(field_name, field_value);
+      });
       h->OnHeaderBlockDone();
     }
     return data.size();
@@ -308,12 +453,13 @@ struct CurlRequestState {
     auto data =
         std::string_view(static_cast<char const*>(contents), size * nmemb);
     if (self->MaybeSetStatusAndProcess()) {
-      self->response_payload_size_ += data.size();
-      self->response_handler_->OnResponseBody(data);
+      self->AppendResponseBody(data);
     }
     return data.size();
   }
 
+  // Copies the payload into the curl upload buffer directly from the chunks of
+  // the cord, without flattening it first.
   static size_t CurlReadCallback(void* contents, size_t size, size_t nmemb,
                                  void* userdata) {
     auto* self = static_cast<CurlRequestState*>(userdata);
@@ -477,6 +623,7 @@ void MultiTransportImpl::FinishRequest(std::unique_ptr<CurlRequestState> state,
 
   http_response_codes.Increment(state->handle_.GetResponseCode());
   assert(state->status_set);
+  state->FlushResponseBody();
   state->response_handler_->OnComplete();
 }
 
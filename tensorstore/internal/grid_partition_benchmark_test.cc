@@ -0,0 +1,78 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <random>
+
+#include <benchmark/benchmark.h>
+#include "tensorstore/array.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_space/index_transform.h"
+#include "tensorstore/index_space/index_transform_builder.h"
+#include "tensorstore/internal/grid_partition_impl.h"
+#include "tensorstore/internal/regular_grid.h"
+#include "tensorstore/util/status.h"
+
+namespace {
+
+using ::tensorstore::AllocateArray;
+using ::tensorstore::DimensionIndex;
+using ::tensorstore::Index;
+using ::tensorstore::IndexTransformBuilder;
+using ::tensorstore::internal_grid_partition::IndexTransformGridPartition;
+using ::tensorstore::internal_grid_partition::
+    PrePartitionIndexTransformOverGrid;
+using ::tensorstore::internal_grid_partition::RegularGridRef;
+
+constexpr Index kDomainSize = Index(1) << 22;
+
+// Benchmarks partitioning of a point-sampling transform, which maps each of
+// `num_points` input positions to a random point in a 3-d domain, over a
+// regular grid with cubic cells of size `cell_size`.
+//
+// With `cell_size == 1` the grid cell indices span too large a range to radix
+// sort, such that the hash map-based partitioning is used instead.
+void BM_PartitionPoints(benchmark::State& state) {
+  const Index num_points = state.range(0);
+  const Index cell_size = state.range(1);
+  std::minstd_rand gen;
+  std::uniform_int_distribution<Index> dist(0, kDomainSize - 1);
+  IndexTransformBuilder<> builder(1, 3);
+  builder.input_origin({0}).input_shape({num_points});
+  for (DimensionIndex output_dim = 0; output_dim < 3; ++output_dim) {
+    auto index_array = AllocateArray<Index>({num_points});
+    for (Index i = 0; i < num_points; ++i) {
+      index_array(i) = dist(gen);
+    }
+    builder.output_index_array(output_dim, 0, 1, index_array);
+  }
+  auto transform = builder.Finalize().value();
+  const DimensionIndex grid_output_dimensions[] = {0, 1, 2};
+  const Index grid_cell_shape[] = {cell_size, cell_size, cell_size};
+  for (auto _ : state) {
+    IndexTransformGridPartition partitioned;
+    TENSORSTORE_CHECK_OK(PrePartitionIndexTransformOverGrid(
+        transform, grid_output_dimensions, RegularGridRef{grid_cell_shape},
+        partitioned));
+    benchmark::DoNotOptimize(partitioned);
+  }
+  state.SetItemsProcessed(num_points * state.iterations());
+}
+
+BENCHMARK(BM_PartitionPoints)
+    ->ArgsProduct({{1 << 10, 1 << 16, 1 << 20}, {1, 64, 512}});
+
+}  // namespace
@@ -15,10 +15,13 @@
 #include "tensorstore/internal/grid_partition_impl.h"
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <algorithm>
 #include <cassert>
+#include <iterator>
 #include <memory>
+#include <numeric>
 #include <utility>
 #include <vector>
 
@@ -694,24 +697,135 @@ IndirectVectorMap PartitionIndexArraySetGridCellIndexVectors(
   return cells;
 }
 
+/// Number of bits of the partial grid cell indices that are sorted by each
+/// pass of `PartitionIndexArraySetGridCellIndexVectorsByRadixSort`.
+constexpr int kRadixSortDigitBits = 8;
+
+/// Maximum number of counting sort passes for which
+/// `PartitionIndexArraySetGridCellIndexVectorsByRadixSort` is used.  Beyond
+/// this, the hash map-based `PartitionIndexArraySetGridCellIndexVectors` is
+/// used instead.
+constexpr int kMaxRadixSortPasses = 8;
+
+/// Same as `PartitionIndexArraySetGridCellIndexVectors`, but sorts the
+/// positions by partial grid cell index vector using a least-significant-digit
+/// radix sort, which is considerably faster than hashing for the large number
+/// of scattered positions typical of point-sampling reads.
+///
+/// Each grid dimension is sorted by the offset of its cell index from the
+/// minimum cell index, in `kRadixSortDigitBits`-bit digits, starting from the
+/// last grid dimension.  Since each counting sort pass is stable, positions
+/// within a partition remain in increasing order, and the result is identical
+/// to that of `PartitionIndexArraySetGridCellIndexVectors`.
+///
+/// \param position_offsets[out] Non-null pointer to vector to be resized to a
+///     length of `num_positions`, where `(*position_offsets)[position_i]` is
+///     set to the offset in the sorted array of position `position_i`.
+/// \returns `false`, without modifying any of the output vectors, if the range
+///     of partial grid cell indices requires more than `kMaxRadixSortPasses`
+///     passes.
+bool PartitionIndexArraySetGridCellIndexVectorsByRadixSort(
+    const Index* temp_cell_indices, Index num_positions, Index num_grid_dims,
+    std::vector<Index>* grid_cell_indices,
+    std::vector<Index>* grid_cell_partition_offsets,
+    std::vector<Index>* position_offsets) {
+  absl::InlinedVector<Index, internal::kNumInlinedDims> min_cell_indices(
+      num_grid_dims);
+  absl::InlinedVector<int, internal::kNumInlinedDims> num_digits(
+      num_grid_dims);
+  int num_passes = 0;
+  for (Index grid_i = 0; grid_i < num_grid_dims; ++grid_i) {
+    Index min_cell_index = temp_cell_indices[grid_i];
+    Index max_cell_index = min_cell_index;
+    for (Index position_i = 1; position_i < num_positions; ++position_i) {
+      const Index cell_index =
+          temp_cell_indices[position_i * num_grid_dims + grid_i];
+      min_cell_index = std::min(min_cell_index, cell_index);
+      max_cell_index = std::max(max_cell_index, cell_index);
+    }
+    uint64_t range = static_cast<uint64_t>(max_cell_index) -
+                     static_cast<uint64_t>(min_cell_index);
+    int digits = 0;
+    for (; range != 0; range >>= kRadixSortDigitBits) ++digits;
+    min_cell_indices[grid_i] = min_cell_index;
+    num_digits[grid_i] = digits;
+    num_passes += digits;
+  }
+  if (num_passes > kMaxRadixSortPasses) return false;
+
+  // `order` holds the positions sorted by the digits processed so far, and
+  // `position_offsets` serves as the temporary buffer for each pass.
+  std::vector<Index> order(num_positions);
+  std::iota(order.begin(), order.end(), Index(0));
+  position_offsets->resize(num_positions);
+  Index counts[Index(1) << kRadixSortDigitBits];
+  for (Index grid_i = num_grid_dims - 1; grid_i >= 0; --grid_i) {
+    const uint64_t min_cell_index =
+        static_cast<uint64_t>(min_cell_indices[grid_i]);
+    for (int digit = 0; digit < num_digits[grid_i]; ++digit) {
+      const int shift = digit * kRadixSortDigitBits;
+      const auto get_digit = [&](Index position_i) {
+        return ((static_cast<uint64_t>(
+                     temp_cell_indices[position_i * num_grid_dims + grid_i]) -
+                 min_cell_index) >>
+                shift) &
+               ((uint64_t(1) << kRadixSortDigitBits) - 1);
+      };
+      std::fill(std::begin(counts), std::end(counts), Index(0));
+      for (Index position_i : order) ++counts[get_digit(position_i)];
+      Index offset = 0;
+      for (Index& count : counts) {
+        offset += std::exchange(count, offset);
+      }
+      for (Index position_i : order) {
+        (*position_offsets)[counts[get_digit(position_i)]++] = position_i;
+      }
+      order.swap(*position_offsets);
+    }
+  }
+
+  // Compute the distinct partial grid cell index vectors in sorted order, and
+  // invert the permutation `order` to obtain `position_offsets`.
+  grid_cell_indices->clear();
+  grid_cell_partition_offsets->clear();
+  const Index* prev_cell_indices = nullptr;
+  for (Index offset = 0; offset < num_positions; ++offset) {
+    const Index position_i = order[offset];
+    const Index* cur_cell_indices =
+        temp_cell_indices + position_i * num_grid_dims;
+    if (!prev_cell_indices ||
+        !std::equal(cur_cell_indices, cur_cell_indices + num_grid_dims,
+                    prev_cell_indices)) {
+      grid_cell_partition_offsets->push_back(offset);
+      grid_cell_indices->insert(grid_cell_indices->end(), cur_cell_indices,
+                                cur_cell_indices + num_grid_dims);
+      prev_cell_indices = cur_cell_indices;
+    }
+    (*position_offsets)[position_i] = offset;
+  }
+  return true;
+}
+
 /// Computes the partial input index vectors within the domain subset of
 /// `full_input_domain` specified by `input_dims`, and writes them to an array
-/// in a partitioned way according to the `cells` map.
+/// in a partitioned way according to `get_offset`.
 ///
 /// \param input_dims The list of distinct input dimensions in the subset, each
 ///     in the range `[0, full_input_domain.rank())`.
 /// \param full_input_domain The full input domain.  Only values at indices in
 ///     `input_dims` are used.
-/// \param cells An IndirectVectorMap that maps each partial grid cell,
-///     identified by a flat input position index, to the starting offset in the
-///     output array at which to write the partial input index vectors.
+/// \param get_offset Function with signature `Index (Index position_i)` that
+///     returns the row of the output array at which to write the partial input
+///     index vector for each flat input position index, called in order of
+///     increasing `position_i`.
 /// \param num_positions The product of `input_shape[d]` for `d` in
 ///     `input_dims`.
 /// \returns A newly allocated array of shape
 ///     `{num_positions, input_dims.count()}` containing the
+template <typename GetOffset>
 SharedArray<Index, 2> GenerateIndexArraySetPartitionedInputIndices(
     DimensionSet input_dims, BoxView<> full_input_domain,
-    IndirectVectorMap cells, Index num_positions) {
+    GetOffset get_offset, Index num_positions) {
   const DimensionIndex num_input_dims = input_dims.count();
   Box<dynamic_rank(internal::kNumInlinedDims)> partial_input_domain(
       num_input_dims);
@@ -728,12 +842,9 @@ SharedArray<Index, 2> GenerateIndexArraySetPartitionedInputIndices(
   Index position_i = 0;
   IterateOverIndexRange(
       partial_input_domain, [&](tensorstore::span<const Index> indices) {
-        auto it = cells.find(position_i);
-        assert(it != cells.end());
-        auto& offset = it->second;
         std::copy(indices.begin(), indices.end(),
-                  partitioned_input_indices.data() + offset * num_input_dims);
-        ++offset;
+                  partitioned_input_indices.data() +
+                      get_offset(position_i) * num_input_dims);
         ++position_i;
       });
   return partitioned_input_indices;
@@ -799,23 +910,41 @@ absl::Status FillIndexArraySetData(
   // distinct index vectors in `temp_cell_indices`, and
   // `index_array_set.grid_cell_partition_offsets`, which specifies the
   // corresponding offsets, for each of those distinct index vectors, into the
-  // `partitioned_input_indices` array that will be generated.  Also compute a
-  // map `cells` that is used to partition the partial input index vectors
-  // corresponding to each partial grid cell index vector in
-  // `temp_cell_indices`.
+  // `partitioned_input_indices` array that will be generated.  Then compute the
+  // partial input index vectors corresponding to each partial grid cell index
+  // vector in `temp_cell_indices`, and directly write them partitioned by grid
+  // cell.
+  //
+  // If the range of grid cell indices permits, a radix sort is used to
+  // directly compute the offset of each position.  Otherwise, a map `cells` is
+  // used to partition the positions.
+  const Index num_grid_dims = index_array_set.grid_dimensions.count();
+  std::vector<Index> position_offsets;
+  if (PartitionIndexArraySetGridCellIndexVectorsByRadixSort(
+          temp_cell_indices.data(), num_positions, num_grid_dims,
+          &index_array_set.grid_cell_indices,
+          &index_array_set.grid_cell_partition_offsets, &position_offsets)) {
+    index_array_set.partitioned_input_indices =
+        GenerateIndexArraySetPartitionedInputIndices(
+            index_array_set.input_dimensions, index_transform.domain().box(),
+            [&](Index position_i) { return position_offsets[position_i]; },
+            num_positions);
+    return absl::OkStatus();
+  }
+
   IndirectVectorMap cells = PartitionIndexArraySetGridCellIndexVectors(
-      temp_cell_indices.data(), num_positions,
-      index_array_set.grid_dimensions.count(),
+      temp_cell_indices.data(), num_positions, num_grid_dims,
       &index_array_set.grid_cell_indices,
       &index_array_set.grid_cell_partition_offsets);
-
-  // Compute the partial input index vectors corresponding to each partial grid
-  // cell index vector in `temp_cell_indices`, and directly write them
-  // partitioned by grid cell using the `cells` map.
   index_array_set.partitioned_input_indices =
       GenerateIndexArraySetPartitionedInputIndices(
           index_array_set.input_dimensions, index_transform.domain().box(),
-          std::move(cells), num_positions);
+          [&](Index position_i) {
+            auto it = cells.find(position_i);
+            assert(it != cells.end());
+            return it->second++;
+          },
+          num_positions);
   return absl::OkStatus();
 }
 
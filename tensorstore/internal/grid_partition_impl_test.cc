@@ -416,6 +416,76 @@ TEST(PrePartitionIndexTransformOverRegularGridTest,
   EXPECT_THAT(partitioned.strided_sets(), ElementsAre());
 }
 
+// Tests that a large number of positions with many duplicate grid cells is
+// partitioned with positions in increasing order within each grid cell.
+TEST(PrePartitionIndexTransformOverRegularGridTest, ManyPositions) {
+  constexpr Index kNumPositions = 1000;
+  constexpr Index kCellSize = 10;
+  auto index_array = tensorstore::AllocateArray<Index>({kNumPositions});
+  for (Index i = 0; i < kNumPositions; ++i) {
+    index_array(i) = (i * 7919) % kNumPositions;
+  }
+  auto transform = tensorstore::IndexTransformBuilder<>(1, 1)
+                       .input_origin({0})
+                       .input_shape({kNumPositions})
+                       .output_index_array(0, 0, 1, index_array)
+                       .Finalize()
+                       .value();
+  const DimensionIndex grid_output_dimensions[] = {0};
+  const Index grid_cell_shape[] = {kCellSize};
+  IndexTransformGridPartition partitioned;
+  TENSORSTORE_CHECK_OK(PrePartitionIndexTransformOverGrid(
+      transform, grid_output_dimensions, RegularGridRef{grid_cell_shape},
+      partitioned));
+
+  IndexTransformGridPartition::IndexArraySet expected;
+  expected.grid_dimensions = DimensionSet::FromIndices({0});
+  expected.input_dimensions = DimensionSet::FromIndices({0});
+  expected.partitioned_input_indices =
+      tensorstore::AllocateArray<Index>({kNumPositions, 1});
+  Index offset = 0;
+  for (Index cell = 0; cell < kNumPositions / kCellSize; ++cell) {
+    expected.grid_cell_indices.push_back(cell);
+    expected.grid_cell_partition_offsets.push_back(offset);
+    for (Index i = 0; i < kNumPositions; ++i) {
+      if (index_array(i) / kCellSize == cell) {
+        expected.partitioned_input_indices(offset++, 0) = i;
+      }
+    }
+  }
+  EXPECT_THAT(partitioned.index_array_sets(), ElementsAre(expected));
+}
+
+// Tests that grid cell indices spanning a range too large to radix sort are
+// correctly partitioned.
+TEST(PrePartitionIndexTransformOverRegularGridTest, LargeGridCellIndexRange) {
+  constexpr Index kA = Index(1) << 40;
+  constexpr Index kB = Index(1) << 41;
+  auto transform =
+      tensorstore::IndexTransformBuilder<>(1, 2)
+          .input_origin({0})
+          .input_shape({4})
+          .output_index_array(0, 0, 1, MakeArray<Index>({0, kA, 0, kA}))
+          .output_index_array(1, 0, 1, MakeArray<Index>({kB, 0, 0, kB}))
+          .Finalize()
+          .value();
+  const DimensionIndex grid_output_dimensions[] = {0, 1};
+  const Index grid_cell_shape[] = {1, 1};
+  IndexTransformGridPartition partitioned;
+  TENSORSTORE_CHECK_OK(PrePartitionIndexTransformOverGrid(
+      transform, grid_output_dimensions, RegularGridRef{grid_cell_shape},
+      partitioned));
+  EXPECT_THAT(
+      partitioned.index_array_sets(),
+      ElementsAre(IndexTransformGridPartition::IndexArraySet{
+          /*.grid_dimensions=*/DimensionSet::FromIndices({0, 1}),
+          /*.input_dimensions=*/DimensionSet::FromIndices({0}),
+          /*.grid_cell_indices=*/{0, 0, 0, kB, kA, 0, kA, kB},
+          /*.partitioned_input_indices=*/MakeArray<Index>({{2}, {0}, {1}, {3}}),
+          /*.grid_cell_partition_offsets=*/{0, 1, 2, 3}}));
+  EXPECT_THAT(partitioned.strided_sets(), ElementsAre());
+}
+
 // Tests that an unbounded input domain leads to an error.
 TEST(PrePartitionIndexTransformOverRegularGridTest, UnboundedDomain) {
   auto transform = tensorstore::IndexTransformBuilder<>(1, 1)
@@ -27,7 +27,6 @@
 #include "absl/log/check.h"
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
-#include "riegeli/bytes/cord_writer.h"
 #include "tensorstore/internal/http/http_header.h"
 #include "tensorstore/internal/http/http_request.h"
 #include "tensorstore/internal/http/http_response.h"
@@ -53,19 +52,18 @@ class LegacyHttpResponseHandler : public HttpResponseHandler {
   void OnResponseHeader(std::string_view field_name,
                         std::string_view field_value) override;
   void OnHeaderBlockDone() override;
-  void OnResponseBody(std::string_view data) override;
+  void OnResponseBody(absl::Cord data) override;
   void OnComplete() override;
 
  private:
   Promise<HttpResponse> promise_;
   absl::Cord data_;
-  riegeli::CordWriter<absl::Cord*> writer_;
   int32_t status_code_ = 0;
   HeaderMap headers_;
 };
 
 LegacyHttpResponseHandler::LegacyHttpResponseHandler(Promise<HttpResponse> p)
-    : promise_(std::move(p)), writer_(&data_) {}
+    : promise_(std::move(p)) {}
 
 void LegacyHttpResponseHandler::OnStatus(int32_t status_code) {
   status_code_ = status_code;
@@ -76,15 +74,12 @@ void LegacyHttpResponseHandler::OnResponseHeader(std::string_view field_name,
   headers_.CombineHeader(field_name, field_value);
 }
 
-void LegacyHttpResponseHandler::OnHeaderBlockDone() {
-  auto content_length = TryGetContentLength(headers_);
-  if (content_length) {
-    writer_.SetWriteSizeHint(*content_length);
-  }
-}
+void LegacyHttpResponseHandler::OnHeaderBlockDone() {}
 
-void LegacyHttpResponseHandler::OnResponseBody(std::string_view data) {
-  writer_.Write(data);
+void LegacyHttpResponseHandler::OnResponseBody(absl::Cord data) {
+  // Appending the cord shares the transport's receive buffers rather than
+  // copying them.
+  data_.Append(std::move(data));
 }
 
 void LegacyHttpResponseHandler::OnFailure(absl::Status status) {
@@ -94,7 +89,6 @@ void LegacyHttpResponseHandler::OnFailure(absl::Status status) {
 }
 
 void LegacyHttpResponseHandler::OnComplete() {
-  writer_.Close();
   HttpResponse response{status_code_, std::move(data_), std::move(headers_)};
   ABSL_LOG_IF(INFO, verbose.Level(1)) << response;
   promise_.SetResult(std::move(response));
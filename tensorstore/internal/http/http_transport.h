@@ -83,7 +83,11 @@ class HttpResponseHandler {
   // Invoked after a header block is fully parsed.
   virtual void OnHeaderBlockDone() = 0;
   // Raw body content is available. May be called multiple times.
-  virtual void OnResponseBody(std::string_view data) = 0;
+  //
+  // The transport may hand over ownership of its receive buffers as external
+  // chunks of `data`, so implementations should retain `data` (for example by
+  // appending it to another absl::Cord) rather than copying it.
+  virtual void OnResponseBody(absl::Cord data) = 0;
   // Request has completed with the provided http status code.
   virtual void OnComplete() = 0;
   // TODO: GetStopToken()
@@ -49,9 +49,8 @@ void ApplyResponseToHandler(const HttpResponse& response,
     handler->OnResponseHeader(kv.first, kv.second);
   }
   handler->OnHeaderBlockDone();
-  auto end = response.payload.chunk_end();
-  for (auto it = response.payload.chunk_begin(); it != end; ++it) {
-    handler->OnResponseBody(*it);
+  if (!response.payload.empty()) {
+    handler->OnResponseBody(response.payload);
   }
   handler->OnComplete();
 }
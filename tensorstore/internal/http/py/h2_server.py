@@ -188,7 +188,7 @@ class H2Protocol(asyncio.Protocol):
       self._respond_404(stream_id, request_data)
       return
 
-    response = request_data.data.getvalue()
+    response = _DATA[path].data.getvalue()
     response_headers = (
         (':status', '200'),
         ('content-type', 'text/plain'),
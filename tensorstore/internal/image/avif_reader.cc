@@ -306,7 +306,8 @@ absl::Status AvifDefaultDecode(avifDecoder* decoder,
 
 }  // namespace
 
-absl::Status AvifReader::Initialize(riegeli::Reader* reader) {
+absl::Status AvifReader::Initialize(riegeli::Reader* reader,
+                                    const AvifReaderOptions& options) {
   ABSL_CHECK(reader != nullptr);
 
   decoder_ = nullptr;
@@ -330,6 +331,7 @@ absl::Status AvifReader::Initialize(riegeli::Reader* reader) {
   // over the decoder, add that here.
   std::unique_ptr<avifDecoder, AvifDeleter> decoder(avifDecoderCreate());
   avifDecoderSetIO(decoder.get(), io);
+  decoder->maxThreads = std::max(1, options.max_threads);
 
   avifResult result = avifDecoderParse(decoder.get());
   if (result != AVIF_RESULT_OK) {
@@ -48,6 +48,11 @@ struct AvifReaderOptions {
   /// AVIF image format is YUV(A); generally assume that the input is RGB(A)
   /// Generally assume that the image source is RGB(A).
   bool convert_to_rgb = true;
+
+  /// Maximum number of threads used by the AV1 decoder.  Unlike the other
+  /// options, this must be specified to `AvifReader::Initialize`, which
+  /// decodes the image.
+  int max_threads = 1;
 };
 
 class AvifReader : public ImageReader {
@@ -60,7 +65,11 @@ class AvifReader : public ImageReader {
   AvifReader& operator=(AvifReader&& src) = default;
 
   // Initialize the decoder.
-  absl::Status Initialize(riegeli::Reader* reader) override;
+  absl::Status Initialize(riegeli::Reader* reader) override {
+    return Initialize(reader, {});
+  }
+  absl::Status Initialize(riegeli::Reader* reader,
+                          const AvifReaderOptions& options);
 
   // Returns the current ImageInfo.
   ImageInfo GetImageInfo() override;
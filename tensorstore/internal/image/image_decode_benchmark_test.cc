@@ -0,0 +1,196 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// Benchmarks of image decoding, with and without intra-image parallelism.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/log/absl_check.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/match.h"
+#include "riegeli/bytes/cord_reader.h"
+#include "riegeli/bytes/cord_writer.h"
+#include "riegeli/bytes/fd_reader.h"
+#include "riegeli/bytes/read_all.h"
+#include "tensorstore/internal/image/avif_reader.h"
+#include "tensorstore/internal/image/bmp_reader.h"
+#include "tensorstore/internal/image/image_info.h"
+#include "tensorstore/internal/image/image_reader.h"
+#include "tensorstore/internal/image/jpeg_reader.h"
+#include "tensorstore/internal/image/jpeg_writer.h"
+#include "tensorstore/internal/image/png_reader.h"
+#include "tensorstore/internal/image/tiff_reader.h"
+#include "tensorstore/internal/image/webp_reader.h"
+#include "tensorstore/internal/path.h"
+#include "tensorstore/internal/thread/thread_pool.h"
+#include "tensorstore/util/executor.h"
+
+ABSL_FLAG(std::string, tensorstore_test_data_dir, ".",
+          "Path to directory containing test data.");
+
+namespace {
+
+using ::tensorstore::internal_image::AvifReader;
+using ::tensorstore::internal_image::AvifReaderOptions;
+using ::tensorstore::internal_image::BmpReader;
+using ::tensorstore::internal_image::ImageInfo;
+using ::tensorstore::internal_image::ImageReader;
+using ::tensorstore::internal_image::JpegReader;
+using ::tensorstore::internal_image::JpegReaderOptions;
+using ::tensorstore::internal_image::JpegWriter;
+using ::tensorstore::internal_image::JpegWriterOptions;
+using ::tensorstore::internal_image::PngReader;
+using ::tensorstore::internal_image::TiffReader;
+using ::tensorstore::internal_image::WebPReader;
+
+absl::Cord ReadTestFile(const std::string& filename) {
+  absl::Cord data;
+  ABSL_CHECK_OK(riegeli::ReadAll(
+      riegeli::FdReader(tensorstore::internal::JoinPath(
+          absl::GetFlag(FLAGS_tensorstore_test_data_dir), filename)),
+      data));
+  return data;
+}
+
+std::unique_ptr<ImageReader> MakeReader(const std::string& filename) {
+  if (absl::EndsWith(filename, ".jpeg")) return std::make_unique<JpegReader>();
+  if (absl::EndsWith(filename, ".png")) return std::make_unique<PngReader>();
+  if (absl::EndsWith(filename, ".avif")) return std::make_unique<AvifReader>();
+  if (absl::EndsWith(filename, ".webp")) return std::make_unique<WebPReader>();
+  if (absl::EndsWith(filename, ".bmp")) return std::make_unique<BmpReader>();
+  return std::make_unique<TiffReader>();
+}
+
+// Decodes a file from the test data directory using the default options.
+void BM_DecodeFile(benchmark::State& state, std::string filename) {
+  const absl::Cord data = ReadTestFile(filename);
+  std::vector<unsigned char> dest;
+  for (auto s : state) {
+    riegeli::CordReader cord_reader(&data);
+    auto reader = MakeReader(filename);
+    ABSL_CHECK_OK(reader->Initialize(&cord_reader));
+    dest.resize(ImageRequiredBytes(reader->GetImageInfo()));
+    ABSL_CHECK_OK(reader->Decode(dest));
+    benchmark::DoNotOptimize(dest.data());
+  }
+  state.SetBytesProcessed(state.iterations() * dest.size());
+}
+
+BENCHMARK_CAPTURE(BM_DecodeFile, jpeg, "jpeg/D75_08b.jpeg");
+BENCHMARK_CAPTURE(BM_DecodeFile, png_08b, "png/D75_08b.png");
+BENCHMARK_CAPTURE(BM_DecodeFile, png_16b, "png/D75_16b.png");
+BENCHMARK_CAPTURE(BM_DecodeFile, avif, "avif/D75_08b.avif");
+BENCHMARK_CAPTURE(BM_DecodeFile, webp, "webp/D75_08b.webp");
+BENCHMARK_CAPTURE(BM_DecodeFile, bmp, "bmp/D75_08b.bmp");
+BENCHMARK_CAPTURE(BM_DecodeFile, tiff, "tiff/D75_08b.tiff");
+
+// Returns a large JPEG image with restart markers, created by tiling the
+// JPEG test image.
+absl::Cord MakeLargeJpeg() {
+  constexpr int kTiles = 16;
+  const absl::Cord tile_data = ReadTestFile("jpeg/D75_08b.jpeg");
+  riegeli::CordReader tile_reader(&tile_data);
+  JpegReader reader;
+  ABSL_CHECK_OK(reader.Initialize(&tile_reader));
+  const ImageInfo tile_info = reader.GetImageInfo();
+  std::vector<unsigned char> tile(ImageRequiredBytes(tile_info));
+  ABSL_CHECK_OK(reader.Decode(tile));
+
+  ImageInfo info = tile_info;
+  info.height *= kTiles;
+  info.width *= kTiles;
+  const size_t tile_row_bytes = tile_info.width * tile_info.num_components;
+  std::vector<unsigned char> image(ImageRequiredBytes(info));
+  for (size_t y = 0; y < static_cast<size_t>(info.height); ++y) {
+    for (size_t x = 0; x < kTiles; ++x) {
+      std::copy_n(tile.data() + (y % tile_info.height) * tile_row_bytes,
+                  tile_row_bytes,
+                  image.data() + (y * kTiles + x) * tile_row_bytes);
+    }
+  }
+
+  absl::Cord encoded;
+  riegeli::CordWriter cord_writer(&encoded);
+  JpegWriterOptions options;
+  options.restart_interval_rows = 1;
+  JpegWriter writer;
+  ABSL_CHECK_OK(writer.Initialize(&cord_writer, options));
+  ABSL_CHECK_OK(writer.Encode(info, image));
+  ABSL_CHECK_OK(writer.Done());
+  return encoded;
+}
+
+// Decodes a large JPEG image with up to `state.range(0)` threads.
+void BM_DecodeJpegParallel(benchmark::State& state) {
+  static const absl::Cord data = MakeLargeJpeg();
+  JpegReaderOptions options;
+  options.max_parallelism = state.range(0);
+  options.executor =
+      tensorstore::internal::DetachedThreadPool(options.max_parallelism);
+  std::vector<unsigned char> dest;
+  for (auto s : state) {
+    riegeli::CordReader cord_reader(&data);
+    JpegReader reader;
+    ABSL_CHECK_OK(reader.Initialize(&cord_reader));
+    dest.resize(ImageRequiredBytes(reader.GetImageInfo()));
+    ABSL_CHECK_OK(reader.Decode(dest, options));
+    benchmark::DoNotOptimize(dest.data());
+  }
+  state.SetBytesProcessed(state.iterations() * dest.size());
+}
+
+BENCHMARK(BM_DecodeJpegParallel)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime();
+
+// Decodes the AVIF test image with up to `state.range(0)` decoder threads.
+void BM_DecodeAvifThreads(benchmark::State& state) {
+  const absl::Cord data = ReadTestFile("avif/D75_08b.avif");
+  AvifReaderOptions options;
+  options.max_threads = state.range(0);
+  std::vector<unsigned char> dest;
+  for (auto s : state) {
+    riegeli::CordReader cord_reader(&data);
+    AvifReader reader;
+    ABSL_CHECK_OK(reader.Initialize(&cord_reader, options));
+    dest.resize(ImageRequiredBytes(reader.GetImageInfo()));
+    ABSL_CHECK_OK(reader.Decode(dest, options));
+    benchmark::DoNotOptimize(dest.data());
+  }
+  state.SetBytesProcessed(state.iterations() * dest.size());
+}
+
+BENCHMARK(BM_DecodeAvifThreads)->Arg(1)->Arg(4)->UseRealTime();
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  absl::ParseCommandLine(argc, argv);
+  ::benchmark::RunSpecifiedBenchmarks();
+  ::benchmark::Shutdown();
+  return 0;
+}
@@ -14,16 +14,28 @@
 
 #include "tensorstore/internal/image/jpeg_reader.h"
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
 #include <cassert>
 #include <csetjmp>
+#include <cstring>
 #include <memory>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "absl/log/absl_check.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_format.h"
+#include "riegeli/base/types.h"
 #include "riegeli/bytes/reader.h"
 #include "tensorstore/data_type.h"
 #include "tensorstore/internal/image/image_view.h"
+#include "tensorstore/internal/thread/parallel_for.h"
 #include "tensorstore/util/status.h"
 
 // Include libjpeg last
@@ -171,12 +183,274 @@ ImageInfo GetJpegImageInfo(::jpeg_decompress_struct* cinfo) {
   return info;
 }
 
+// Parallel decoding.
+//
+// When a sequential JPEG image contains restart markers, the entropy-coded
+// data following each marker can be decoded independently of the data that
+// precedes it.  An image whose restart intervals align with MCU rows can
+// therefore be split into horizontal bands, each of which is decoded as a
+// separate JPEG stream consisting of the original headers (with the image
+// height adjusted), the entropy-coded data of the band (with the restart
+// markers renumbered to start at 0), and an EOI marker.
+//
+// When components are subsampled vertically, fancy upsampling blends chroma
+// samples from adjacent rows, so the decoded region of each band is extended
+// by one unit above and below and the extra rows are discarded.
+
+// Images smaller than this are not worth splitting.
+constexpr size_t kMinPixelsPerBand = size_t(1) << 18;
+
+// Division of an image into bands, in units of MCU rows.
+struct JpegBandPlan {
+  size_t mcus_per_row;
+  size_t mcu_rows;
+  size_t mcu_height;     // Pixel rows per MCU row.
+  size_t rows_per_unit;  // MCU rows per restart-aligned unit.
+  size_t num_units;
+  size_t num_bands;
+  bool overlap;  // Whether bands must be decoded with one unit of context.
+
+  size_t band_begin(size_t band) const {
+    return std::min(mcu_rows, band * num_units / num_bands * rows_per_unit);
+  }
+};
+
+std::optional<JpegBandPlan> GetJpegBandPlan(
+    const ::jpeg_decompress_struct& cinfo, size_t max_parallelism) {
+  if (max_parallelism <= 1 || cinfo.progressive_mode || cinfo.arith_code ||
+      cinfo.restart_interval == 0 ||
+      cinfo.comps_in_scan != cinfo.num_components) {
+    return std::nullopt;
+  }
+  JpegBandPlan plan;
+  // A non-interleaved scan of a single-component image uses one block per
+  // MCU; otherwise the MCU spans the maximum sampling factors.
+  const bool interleaved = cinfo.comps_in_scan > 1;
+  const size_t mcu_width =
+      DCTSIZE * (interleaved ? cinfo.max_h_samp_factor : 1);
+  plan.mcu_height = DCTSIZE * (interleaved ? cinfo.max_v_samp_factor : 1);
+  plan.overlap = interleaved && cinfo.max_v_samp_factor > 1;
+  plan.mcus_per_row = (cinfo.image_width + mcu_width - 1) / mcu_width;
+  plan.mcu_rows = (cinfo.image_height + plan.mcu_height - 1) / plan.mcu_height;
+  plan.rows_per_unit =
+      cinfo.restart_interval /
+      std::gcd(plan.mcus_per_row, size_t(cinfo.restart_interval));
+  plan.num_units =
+      (plan.mcu_rows + plan.rows_per_unit - 1) / plan.rows_per_unit;
+  const size_t num_pixels =
+      size_t(cinfo.image_width) * size_t(cinfo.image_height);
+  plan.num_bands = std::min({max_parallelism, plan.num_units,
+                             num_pixels / kMinPixelsPerBand});
+  if (plan.num_bands <= 1) return std::nullopt;
+  return plan;
+}
+
+// Location of the markers of a JPEG stream needed to split it into bands.
+struct JpegMarkerLayout {
+  // Offset of the image height within the SOF segment.
+  size_t height_offset;
+  // End of the SOS segment; start of the entropy-coded data.
+  size_t header_end;
+  // Restart markers, in order.
+  struct RestartMarker {
+    size_t begin;  // Offset of the marker (excluding fill bytes).
+    size_t end;    // Offset just past the marker.
+  };
+  std::vector<RestartMarker> restart_markers;
+  // Offset of the EOI marker.
+  size_t eoi;
+};
+
+// Locates the markers of the JPEG stream `data`.  Returns `std::nullopt` if
+// the stream has an unexpected structure, in which case it is decoded as a
+// single band.
+std::optional<JpegMarkerLayout> GetJpegMarkerLayout(std::string_view data) {
+  const auto* p = reinterpret_cast<const unsigned char*>(data.data());
+  const size_t size = data.size();
+  JpegMarkerLayout layout;
+  std::optional<size_t> height_offset;
+  size_t pos = 2;  // Skip SOI.
+  while (true) {
+    if (pos + 4 > size || p[pos] != 0xFF) return std::nullopt;
+    while (pos + 4 <= size && p[pos + 1] == 0xFF) ++pos;
+    if (pos + 4 > size) return std::nullopt;
+    const unsigned char marker = p[pos + 1];
+    const size_t length = (size_t(p[pos + 2]) << 8) | p[pos + 3];
+    const size_t segment = pos + 2;
+    if (length < 2 || segment + length > size) return std::nullopt;
+    if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 &&
+        marker != 0xC8 && marker != 0xCC) {
+      if (length < 5) return std::nullopt;
+      height_offset = segment + 3;
+    }
+    pos = segment + length;
+    if (marker == 0xDA) break;  // SOS
+  }
+  if (!height_offset) return std::nullopt;
+  layout.height_offset = *height_offset;
+  layout.header_end = pos;
+  for (; pos + 1 < size; ++pos) {
+    if (p[pos] != 0xFF) continue;
+    size_t marker_pos = pos;
+    while (marker_pos + 2 < size && p[marker_pos + 1] == 0xFF) ++marker_pos;
+    const unsigned char marker = p[marker_pos + 1];
+    if (marker == 0x00) {
+      // Stuffed byte.
+      pos = marker_pos + 1;
+    } else if (marker >= 0xD0 && marker <= 0xD7) {
+      layout.restart_markers.push_back({marker_pos, marker_pos + 2});
+      pos = marker_pos + 1;
+    } else if (marker == 0xD9) {
+      layout.eoi = marker_pos;
+      return layout;
+    } else {
+      return std::nullopt;
+    }
+  }
+  return std::nullopt;
+}
+
+// Decodes the complete JPEG stream `data`, discarding the first `skip_rows`
+// rows and storing the following `num_rows` rows to `dest_view` starting at
+// `dest_row`.
+absl::Status DecodeJpegBand(std::string_view data, const ImageView& dest_view,
+                            size_t dest_row, size_t skip_rows,
+                            size_t num_rows) {
+  struct Decompressor {
+    ::jpeg_decompress_struct cinfo;
+    JpegError error;
+    bool created = false;
+    ~Decompressor() {
+      if (created) jpeg_destroy_decompress(&cinfo);
+    }
+  } d;
+  d.error.Construct(reinterpret_cast<::jpeg_common_struct*>(&d.cinfo));
+  d.cinfo.mem = nullptr;
+  d.cinfo.client_data = nullptr;
+  jpeg_create_decompress(&d.cinfo);
+  d.created = true;
+
+  const size_t row_bytes = dest_view.row_stride_bytes();
+  std::vector<JSAMPLE> skipped_row(skip_rows ? row_bytes : 0);
+  bool ok = [&]() {
+    // Setjump is problematic with C++; by convention we put it in a
+    // lambda which has no variables requiring cleanup.
+    if (setjmp(d.error.jmpbuf)) {
+      return false;
+    }
+    ::jpeg_mem_src(&d.cinfo,
+                   reinterpret_cast<const unsigned char*>(data.data()),
+                   data.size());
+    ::jpeg_read_header(&d.cinfo, /*require_image=*/1);
+    ::jpeg_start_decompress(&d.cinfo);
+    if (d.cinfo.output_height < skip_rows + num_rows ||
+        size_t(d.cinfo.output_width) * d.cinfo.output_components !=
+            row_bytes) {
+      d.error.last_error = absl::DataLossError(
+          "Cannot read JPEG; inconsistent band dimensions");
+      return false;
+    }
+    while (d.cinfo.output_scanline < skip_rows + num_rows) {
+      const size_t row = d.cinfo.output_scanline;
+      auto* output_line =
+          row < skip_rows
+              ? skipped_row.data()
+              : reinterpret_cast<JSAMPLE*>(
+                    dest_view.data_row(dest_row + row - skip_rows).data());
+      if (::jpeg_read_scanlines(&d.cinfo, &output_line, 1) != 1) {
+        d.error.last_error =
+            absl::DataLossError("Cannot read JPEG; truncated band");
+        return false;
+      }
+    }
+    return true;
+  }();
+  if (!ok) {
+    return internal::MaybeConvertStatusTo(d.error.last_error,
+                                          absl::StatusCode::kDataLoss);
+  }
+  return absl::OkStatus();
+}
+
+// Decodes the complete JPEG stream `data`, whose image has `height` rows,
+// into `dest_view` as the bands specified by `plan`.
+absl::Status DecodeJpegBands(std::string_view data, const JpegBandPlan& plan,
+                             size_t restart_interval, size_t height,
+                             const ImageView& dest_view,
+                             const JpegReaderOptions& options) {
+  auto layout = GetJpegMarkerLayout(data);
+  const size_t total_mcus = plan.mcus_per_row * plan.mcu_rows;
+  const size_t num_intervals =
+      (total_mcus + restart_interval - 1) / restart_interval;
+  if (!layout || layout->restart_markers.size() + 1 != num_intervals) {
+    return DecodeJpegBand(data, dest_view, 0, 0, height);
+  }
+
+  std::vector<absl::Status> status(plan.num_bands);
+  internal::ParallelFor(
+      options.executor, options.max_parallelism, plan.num_bands,
+      [&](size_t band) {
+        // MCU rows to store, and the possibly larger range of MCU rows to
+        // decode.
+        const size_t begin_row = plan.band_begin(band);
+        const size_t end_row = plan.band_begin(band + 1);
+        size_t decode_begin_row = begin_row, decode_end_row = end_row;
+        if (plan.overlap) {
+          if (band > 0) decode_begin_row -= plan.rows_per_unit;
+          decode_end_row =
+              std::min(plan.mcu_rows, decode_end_row + plan.rows_per_unit);
+        }
+        const size_t begin_interval =
+            decode_begin_row * plan.mcus_per_row / restart_interval;
+        const size_t end_interval = std::min(
+            num_intervals,
+            (decode_end_row * plan.mcus_per_row + restart_interval - 1) /
+                restart_interval);
+        const size_t data_begin =
+            begin_interval == 0
+                ? layout->header_end
+                : layout->restart_markers[begin_interval - 1].end;
+        const size_t data_end =
+            end_interval == num_intervals
+                ? layout->eoi
+                : layout->restart_markers[end_interval - 1].begin;
+        const size_t band_height =
+            std::min(height, decode_end_row * plan.mcu_height) -
+            decode_begin_row * plan.mcu_height;
+
+        std::string stream;
+        stream.reserve(layout->header_end + (data_end - data_begin) + 2);
+        stream.append(data.data(), layout->header_end);
+        stream[layout->height_offset] = static_cast<char>(band_height >> 8);
+        stream[layout->height_offset + 1] =
+            static_cast<char>(band_height & 0xff);
+        stream.append(data.data() + data_begin, data_end - data_begin);
+        // Renumber the restart markers within the band.
+        for (size_t i = begin_interval; i + 1 < end_interval; ++i) {
+          const size_t offset = layout->restart_markers[i].begin + 1 -
+                                data_begin + layout->header_end;
+          stream[offset] = static_cast<char>(0xD0 + (i - begin_interval) % 8);
+        }
+        stream.append("\xFF\xD9", 2);
+        const size_t dest_row = begin_row * plan.mcu_height;
+        status[band] = DecodeJpegBand(
+            stream, dest_view, dest_row,
+            (begin_row - decode_begin_row) * plan.mcu_height,
+            std::min(height, end_row * plan.mcu_height) - dest_row);
+      });
+  for (auto& s : status) {
+    TENSORSTORE_RETURN_IF_ERROR(s);
+  }
+  return absl::OkStatus();
+}
+
 }  // namespace
 
 struct JpegReader::Context {
   ::jpeg_decompress_struct cinfo_;
   JpegError error_;
   JpegSourceRiegeli riegeli_src_;
+  riegeli::Position start_pos_ = 0;
   bool created_ = false;
   bool started_ = false;
 
@@ -185,6 +459,9 @@ struct JpegReader::Context {
   absl::Status Initialize(riegeli::Reader* reader);
   absl::Status Decode(tensorstore::span<unsigned char> dest,
                       const JpegReaderOptions& options);
+  absl::Status DecodeParallel(const JpegBandPlan& plan,
+                              const ImageView& dest_view,
+                              const JpegReaderOptions& options);
 };
 
 JpegReader::Context::~Context() {
@@ -211,6 +488,7 @@ absl::Status JpegReader::Context::Initialize(riegeli::Reader* reader) {
   created_ = true;
 
   // Set up source manager.
+  start_pos_ = reader->pos();
   riegeli_src_.Construct(&cinfo_, reader);
 
   bool ok = [&]() {
@@ -254,6 +532,12 @@ absl::Status JpegReader::Context::Decode(tensorstore::span<unsigned char> dest,
   ABSL_CHECK_EQ(dest.size(), ImageRequiredBytes(info));
 
   ImageView dest_view(info, dest);
+  if (options.executor && riegeli_src_.reader->SupportsRewind()) {
+    if (auto plan = GetJpegBandPlan(cinfo_, options.max_parallelism)) {
+      return DecodeParallel(*plan, dest_view, options);
+    }
+  }
+
   bool ok = [&]() {
     // Setjump is problematic with C++; by convention we put it in a
     // lambda which has no variables requiring cleanup.
@@ -288,6 +572,30 @@ absl::Status JpegReader::Context::Decode(tensorstore::span<unsigned char> dest,
   return absl::OkStatus();
 }
 
+absl::Status JpegReader::Context::DecodeParallel(
+    const JpegBandPlan& plan, const ImageView& dest_view,
+    const JpegReaderOptions& options) {
+  // The bands are decoded from an in-memory copy of the complete stream,
+  // independently of `cinfo_`, which has only consumed the headers.
+  riegeli::Reader& reader = *riegeli_src_.reader;
+  riegeli_src_.advance_by = 0;
+  if (!reader.Seek(start_pos_)) {
+    return internal::MaybeConvertStatusTo(reader.status(),
+                                          absl::StatusCode::kDataLoss);
+  }
+  std::string data;
+  while (reader.Pull()) {
+    data.append(reader.cursor(), reader.available());
+    reader.move_cursor(reader.available());
+  }
+  if (!reader.ok()) {
+    return internal::MaybeConvertStatusTo(reader.status(),
+                                          absl::StatusCode::kDataLoss);
+  }
+  return DecodeJpegBands(data, plan, cinfo_.restart_interval,
+                         cinfo_.image_height, dest_view, options);
+}
+
 JpegReader::JpegReader() = default;
 JpegReader::~JpegReader() = default;
 JpegReader::JpegReader(JpegReader&& src) = default;
@@ -15,15 +15,32 @@
 #ifndef TENSORSTORE_INTERNAL_IMAGE_JPEG_READER_H_
 #define TENSORSTORE_INTERNAL_IMAGE_JPEG_READER_H_
 
+#include <stddef.h>
+
 #include "riegeli/bytes/reader.h"
 #include "tensorstore/internal/image/image_info.h"
 #include "tensorstore/internal/image/image_reader.h"
+#include "tensorstore/util/executor.h"
 #include "tensorstore/util/span.h"
 
 namespace tensorstore {
 namespace internal_image {
 
-struct JpegReaderOptions {};
+struct JpegReaderOptions {
+  /// Executor used to decode horizontal bands of the image concurrently.
+  ///
+  /// Parallel decoding applies only to sequential, Huffman-coded images with
+  /// restart markers in a single scan, and requires that the reader supports
+  /// random access.  For images with vertical chroma subsampling, each band
+  /// also decodes one restart-aligned unit of each neighbouring band as
+  /// context for upsampling.  Other images are decoded on the calling thread.  The
+  /// decoded pixels are identical in either case.
+  Executor executor;
+
+  /// Maximum number of bands decoded concurrently.  A value of 1 disables
+  /// parallel decoding.
+  size_t max_parallelism = 1;
+};
 
 class JpegReader : public ImageReader {
  public:
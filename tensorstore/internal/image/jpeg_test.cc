@@ -27,14 +27,18 @@
 #include "tensorstore/internal/image/image_info.h"
 #include "tensorstore/internal/image/jpeg_reader.h"
 #include "tensorstore/internal/image/jpeg_writer.h"
+#include "tensorstore/util/executor.h"
 #include "tensorstore/util/span.h"
 #include "tensorstore/util/status_testutil.h"
+#include "tensorstore/util/str_cat.h"
 
 namespace {
 
 using ::tensorstore::internal_image::ImageInfo;
 using ::tensorstore::internal_image::JpegReader;
+using ::tensorstore::internal_image::JpegReaderOptions;
 using ::tensorstore::internal_image::JpegWriter;
+using ::tensorstore::internal_image::JpegWriterOptions;
 
 TEST(JpegTest, Decode) {
   // Started the same as the png image, but very much the worse for wear after
@@ -255,6 +259,49 @@ TEST(JpegTest, EncodeDecode) {
   }
 }
 
+TEST(JpegTest, ParallelDecode) {
+  for (int num_components : {1, 3}) {
+    for (int restart_interval_rows : {0, 1, 3}) {
+      SCOPED_TRACE(tensorstore::StrCat("num_components=", num_components,
+                                       ", restart_interval_rows=",
+                                       restart_interval_rows));
+      const ImageInfo info{/*.height =*/1000, /*.width =*/1030,
+                           num_components};
+      std::vector<uint8_t> pixels(ImageRequiredBytes(info));
+      for (size_t i = 0; i < pixels.size(); ++i) {
+        pixels[i] = static_cast<uint8_t>((i * 7) ^ (i / info.width));
+      }
+      absl::Cord encoded;
+      {
+        JpegWriterOptions options;
+        options.restart_interval_rows = restart_interval_rows;
+        JpegWriter encoder;
+        riegeli::CordWriter cord_writer(&encoded);
+        ASSERT_THAT(encoder.Initialize(&cord_writer, options),
+                    ::tensorstore::IsOk());
+        ASSERT_THAT(encoder.Encode(info, pixels), ::tensorstore::IsOk());
+        ASSERT_THAT(encoder.Done(), ::tensorstore::IsOk());
+      }
+
+      auto decode = [&](const JpegReaderOptions& options) {
+        std::vector<uint8_t> decoded(pixels.size());
+        JpegReader decoder;
+        riegeli::CordReader cord_reader(&encoded);
+        EXPECT_THAT(decoder.Initialize(&cord_reader), ::tensorstore::IsOk());
+        EXPECT_THAT(decoder.Decode(decoded, options), ::tensorstore::IsOk());
+        return decoded;
+      };
+      auto expected = decode({});
+      for (size_t max_parallelism : {2, 3, 16}) {
+        JpegReaderOptions options;
+        options.executor = tensorstore::InlineExecutor{};
+        options.max_parallelism = max_parallelism;
+        EXPECT_EQ(expected, decode(options)) << max_parallelism;
+      }
+    }
+  }
+}
+
 TEST(JpegTest, NotAJpeg) {
   static constexpr unsigned char data[] = {
       0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a,  // sig
@@ -165,6 +165,12 @@ absl::Status JpegWriter::InitializeImpl(riegeli::Writer* writer,
     return absl::InvalidArgumentError(absl::StrFormat(
         "JPEG options.quality of %d exceeds bounds", options.quality));
   }
+  if (options.restart_interval_rows < 0 ||
+      options.restart_interval_rows > 65535) {
+    return absl::InvalidArgumentError(absl::StrFormat(
+        "JPEG options.restart_interval_rows of %d exceeds bounds",
+        options.restart_interval_rows));
+  }
   return absl::OkStatus();
 }
 
@@ -194,6 +200,7 @@ absl::Status JpegWriter::Encode(const ImageInfo& info,
 
     ::jpeg_set_defaults(&state.cinfo_);
     ::jpeg_set_quality(&state.cinfo_, options_.quality, /*force_baseline=*/1);
+    state.cinfo_.restart_in_rows = options_.restart_interval_rows;
     ::jpeg_start_compress(&state.cinfo_, /*write_all_tables=*/1);
     state.started_ = true;
 
@@ -31,6 +31,11 @@ struct JpegWriterOptions {
   /// recommended scale, with 0 being the worst quality (smallest file size) and
   /// 100 the best quality (largest file size).
   int quality = 75;
+
+  /// Number of MCU rows between restart markers, or 0 to omit restart
+  /// markers.  Restart markers allow `JpegReader` to decode bands of the image
+  /// in parallel, at the cost of a slight increase in file size.
+  int restart_interval_rows = 0;
 };
 
 class JpegWriter : public ImageWriter {
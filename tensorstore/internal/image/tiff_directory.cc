@@ -0,0 +1,708 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/image/tiff_directory.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_format.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/internal/compression/zlib.h"
+#include "tensorstore/internal/integer_overflow.h"
+#include "tensorstore/util/endian.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+#include "tensorstore/util/status.h"
+
+namespace tensorstore {
+namespace internal_image {
+namespace {
+
+using ByteRange = TiffDirectoryParser::ByteRange;
+
+// TIFF tags used by `TiffDirectoryParser`.
+enum TiffTag : uint16_t {
+  kNewSubfileType = 254,
+  kImageWidth = 256,
+  kImageLength = 257,
+  kBitsPerSample = 258,
+  kCompression = 259,
+  kStripOffsets = 273,
+  kSamplesPerPixel = 277,
+  kRowsPerStrip = 278,
+  kStripByteCounts = 279,
+  kPlanarConfiguration = 284,
+  kPredictor = 317,
+  kTileWidth = 322,
+  kTileLength = 323,
+  kTileOffsets = 324,
+  kTileByteCounts = 325,
+  kSampleFormat = 339,
+};
+
+// Upper bound on the number of entries in a single directory, to guard
+// against corrupt files.
+constexpr uint64_t kMaxDirectoryEntries = 1 << 16;
+
+// Upper bound on the size of the values of a single tag, to guard against
+// corrupt files requesting huge reads and allocations.  This is sufficient
+// for the strip or tile offsets of any practical image.
+constexpr uint64_t kMaxTagValueBytes = uint64_t{1} << 28;
+
+// Upper bound on the width and height of a tile.
+constexpr uint64_t kMaxTileSize = 1 << 16;
+
+// Upper bound on the decoded size of a single tile or strip, which is
+// allocated at once when reading it.
+constexpr uint64_t kMaxChunkBytes = uint64_t{1} << 30;
+
+// Maximum number of bytes by which the range returned by `Parse` may exceed
+// the bytes actually needed, in order to fetch several out-of-line values at
+// once.
+constexpr uint64_t kMaxRangeSlack = 64 * 1024;
+
+uint64_t LoadUnsigned(const char* p, size_t size, bool big_endian) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < size; ++i) {
+    const uint64_t byte =
+        static_cast<unsigned char>(p[big_endian ? i : size - 1 - i]);
+    value = (value << 8) | byte;
+  }
+  return value;
+}
+
+// Returns the size in bytes of a value of the specified TIFF field type, or 0
+// if the type is not an unsigned integer type.
+size_t GetUnsignedTypeSize(uint16_t type) {
+  switch (type) {
+    case 1:  // BYTE
+      return 1;
+    case 3:  // SHORT
+      return 2;
+    case 4:   // LONG
+    case 13:  // IFD
+      return 4;
+    case 16:  // LONG8
+    case 18:  // IFD8
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+void CopyCordToSpan(const absl::Cord& cord, unsigned char* dest, size_t size) {
+  for (auto chunk : cord.Chunks()) {
+    const size_t n = std::min(size, chunk.size());
+    std::memcpy(dest, chunk.data(), n);
+    dest += n;
+    size -= n;
+    if (size == 0) break;
+  }
+}
+
+absl::Status DecodePackBits(const absl::Cord& encoded,
+                            tensorstore::span<unsigned char> dest) {
+  std::string input(encoded);
+  size_t in = 0, out = 0;
+  while (out < dest.size() && in < input.size()) {
+    const int n = static_cast<signed char>(input[in++]);
+    if (n >= 0) {
+      const size_t count = static_cast<size_t>(n) + 1;
+      if (in + count > input.size() || out + count > dest.size()) break;
+      std::memcpy(dest.data() + out, input.data() + in, count);
+      in += count;
+      out += count;
+    } else if (n != -128) {
+      const size_t count = static_cast<size_t>(1 - n);
+      if (in >= input.size() || out + count > dest.size()) break;
+      std::memset(dest.data() + out, input[in++], count);
+      out += count;
+    }
+  }
+  if (out != dest.size()) {
+    return absl::DataLossError("Invalid PackBits-compressed TIFF data");
+  }
+  return absl::OkStatus();
+}
+
+// Decodes TIFF LZW-compressed data, which uses MSB-first code packing and
+// increases the code width one code early.
+absl::Status DecodeLzw(const absl::Cord& encoded,
+                       tensorstore::span<unsigned char> dest) {
+  constexpr int kClearCode = 256;
+  constexpr int kEndOfInformation = 257;
+  constexpr int kFirstCode = 258;
+  constexpr int kMaxCodes = 4096;
+
+  std::string input(encoded);
+  std::vector<int16_t> prefix(kMaxCodes);
+  std::vector<unsigned char> suffix(kMaxCodes);
+  std::vector<unsigned char> first(kMaxCodes);
+  std::vector<uint16_t> length(kMaxCodes);
+  for (int i = 0; i < 256; ++i) {
+    prefix[i] = -1;
+    suffix[i] = first[i] = static_cast<unsigned char>(i);
+    length[i] = 1;
+  }
+
+  size_t bit_pos = 0;
+  const size_t num_bits = input.size() * 8;
+  int width = 9;
+  int next_code = kFirstCode;
+  int old_code = -1;
+  size_t out = 0;
+
+  // Writes the string for `code` to `dest`, truncating at the end of `dest`.
+  auto emit = [&](int code) {
+    const size_t n = length[code];
+    for (size_t i = n; i-- > 0; code = prefix[code]) {
+      if (out + i < dest.size()) dest[out + i] = suffix[code];
+    }
+    out += n;
+  };
+
+  while (out < dest.size() && bit_pos + width <= num_bits) {
+    int code = 0;
+    for (int i = 0; i < width; ++i, ++bit_pos) {
+      code = (code << 1) |
+             ((static_cast<unsigned char>(input[bit_pos / 8]) >>
+               (7 - bit_pos % 8)) &
+              1);
+    }
+    if (code == kEndOfInformation) break;
+    if (code == kClearCode) {
+      width = 9;
+      next_code = kFirstCode;
+      old_code = -1;
+      continue;
+    }
+    if (old_code == -1) {
+      if (code >= 256) break;
+      emit(code);
+      old_code = code;
+      continue;
+    }
+    if (code > next_code || (code == next_code && next_code >= kMaxCodes)) {
+      break;
+    }
+    if (next_code < kMaxCodes) {
+      prefix[next_code] = old_code;
+      first[next_code] = first[old_code];
+      suffix[next_code] = first[code == next_code ? old_code : code];
+      length[next_code] = length[old_code] + 1;
+      ++next_code;
+    }
+    emit(code);
+    old_code = code;
+    if (next_code + 1 >= (1 << width) && width < 12) ++width;
+  }
+  if (out < dest.size()) {
+    return absl::DataLossError("Invalid LZW-compressed TIFF data");
+  }
+  return absl::OkStatus();
+}
+
+template <typename T>
+void UndoHorizontalDifferencing(unsigned char* data, size_t num_rows,
+                                size_t width, size_t samples) {
+  T* values = reinterpret_cast<T*>(data);
+  for (size_t row = 0; row < num_rows; ++row) {
+    T* row_values = values + row * width * samples;
+    for (size_t i = samples; i < width * samples; ++i) {
+      row_values[i] = static_cast<T>(row_values[i] + row_values[i - samples]);
+    }
+  }
+}
+
+}  // namespace
+
+DataType TiffDirectory::dtype() const {
+  switch (sample_format) {
+    case 1:  // Unsigned integer
+      switch (bits_per_sample) {
+        case 8:
+          return dtype_v<uint8_t>;
+        case 16:
+          return dtype_v<uint16_t>;
+        case 32:
+          return dtype_v<uint32_t>;
+        case 64:
+          return dtype_v<uint64_t>;
+      }
+      break;
+    case 2:  // Signed integer
+      switch (bits_per_sample) {
+        case 8:
+          return dtype_v<int8_t>;
+        case 16:
+          return dtype_v<int16_t>;
+        case 32:
+          return dtype_v<int32_t>;
+        case 64:
+          return dtype_v<int64_t>;
+      }
+      break;
+    case 3:  // IEEE floating point
+      switch (bits_per_sample) {
+        case 16:
+          return dtype_v<dtypes::float16_t>;
+        case 32:
+          return dtype_v<dtypes::float32_t>;
+        case 64:
+          return dtype_v<dtypes::float64_t>;
+      }
+      break;
+  }
+  return DataType();
+}
+
+void TiffDirectoryParser::AddData(uint64_t offset, const absl::Cord& data) {
+  if (data.empty()) return;
+  uint64_t start = offset;
+  uint64_t end = offset + data.size();
+  // Merge with any overlapping or adjacent segments.
+  auto it = segments_.upper_bound(start);
+  if (it != segments_.begin() &&
+      std::prev(it)->first + std::prev(it)->second.size() >= start) {
+    --it;
+  }
+  std::string merged;
+  if (it != segments_.end() && it->first < start) {
+    start = it->first;
+  }
+  auto last = it;
+  while (last != segments_.end() && last->first <= end) {
+    end = std::max(end, last->first + last->second.size());
+    ++last;
+  }
+  merged.resize(end - start);
+  for (auto seg = it; seg != last; ++seg) {
+    std::memcpy(merged.data() + (seg->first - start), seg->second.data(),
+                seg->second.size());
+  }
+  CopyCordToSpan(data,
+                 reinterpret_cast<unsigned char*>(merged.data()) +
+                     (offset - start),
+                 data.size());
+  segments_.erase(it, last);
+  segments_.emplace(start, std::move(merged));
+}
+
+const char* TiffDirectoryParser::GetData(uint64_t offset,
+                                         uint64_t size) const {
+  auto it = segments_.upper_bound(offset);
+  if (it == segments_.begin()) return nullptr;
+  --it;
+  const uint64_t end = it->first + it->second.size();
+  if (end < offset || end - offset < size) return nullptr;
+  return it->second.data() + (offset - it->first);
+}
+
+bool TiffDirectoryParser::Read(uint64_t offset, size_t size,
+                               char* dest) const {
+  const char* data = GetData(offset, size);
+  if (!data) return false;
+  std::memcpy(dest, data, size);
+  return true;
+}
+
+Result<std::optional<ByteRange>> TiffDirectoryParser::Parse() {
+  if (!header_parsed_) {
+    char header[16];
+    if (!Read(0, 8, header)) return ByteRange{0, 16};
+    if (header[0] == 'I' && header[1] == 'I') {
+      big_endian_ = false;
+    } else if (header[0] == 'M' && header[1] == 'M') {
+      big_endian_ = true;
+    } else {
+      return absl::DataLossError("Invalid TIFF byte order mark");
+    }
+    const uint64_t version = LoadUnsigned(header + 2, 2, big_endian_);
+    if (version == 42) {
+      next_ifd_offset_ = LoadUnsigned(header + 4, 4, big_endian_);
+    } else if (version == 43) {
+      if (!Read(0, 16, header)) return ByteRange{0, 16};
+      if (LoadUnsigned(header + 4, 2, big_endian_) != 8) {
+        return absl::DataLossError("Unsupported BigTIFF offset size");
+      }
+      big_tiff_ = true;
+      next_ifd_offset_ = LoadUnsigned(header + 8, 8, big_endian_);
+    } else {
+      return absl::DataLossError(
+          absl::StrFormat("Invalid TIFF version number: %d", version));
+    }
+    if (next_ifd_offset_ == 0) {
+      return absl::DataLossError("TIFF file contains no images");
+    }
+    header_parsed_ = true;
+  }
+  while (next_ifd_offset_ != 0) {
+    const uint64_t offset = next_ifd_offset_;
+    if (visited_ifd_offsets_.contains(offset)) {
+      return absl::DataLossError(absl::StrFormat(
+          "TIFF directory at offset %d is referenced more than once", offset));
+    }
+    TENSORSTORE_ASSIGN_OR_RETURN(auto needed, ParseDirectory(offset));
+    if (needed) return needed;
+    visited_ifd_offsets_.insert(offset);
+  }
+  return std::nullopt;
+}
+
+Result<std::optional<ByteRange>> TiffDirectoryParser::ParseDirectory(
+    uint64_t offset) {
+  const size_t count_size = big_tiff_ ? 8 : 2;
+  const size_t entry_size = big_tiff_ ? 20 : 12;
+  const size_t value_size = big_tiff_ ? 8 : 4;
+
+  char count_buffer[8];
+  if (!Read(offset, count_size, count_buffer)) {
+    return ByteRange{offset, count_size};
+  }
+  const uint64_t num_entries =
+      LoadUnsigned(count_buffer, count_size, big_endian_);
+  if (num_entries > kMaxDirectoryEntries) {
+    return absl::DataLossError(absl::StrFormat(
+        "TIFF directory at offset %d has too many entries", offset));
+  }
+  // The entries are followed by the offset of the next directory.
+  const uint64_t entries_offset = offset + count_size;
+  std::string entries(num_entries * entry_size + value_size, '\0');
+  if (!Read(entries_offset, entries.size(), entries.data())) {
+    return ByteRange{entries_offset, entries.size()};
+  }
+
+  TiffDirectory directory;
+  std::vector<uint64_t> bits_per_sample;
+  std::vector<uint64_t> sample_format;
+  std::vector<uint64_t> strip_offsets, strip_byte_counts;
+  std::vector<uint64_t> tile_offsets, tile_byte_counts;
+  std::optional<uint64_t> rows_per_strip, tile_width, tile_length;
+  std::vector<ByteRange> missing;
+
+  auto get_values = [&](const char* entry,
+                        std::vector<uint64_t>& values) -> absl::Status {
+    const uint16_t type = LoadUnsigned(entry + 2, 2, big_endian_);
+    const uint64_t count = LoadUnsigned(entry + 4, value_size, big_endian_);
+    const char* value_field = entry + 4 + value_size;
+    const size_t type_size = GetUnsignedTypeSize(type);
+    if (type_size == 0 || count == 0 ||
+        count > kMaxTagValueBytes / type_size) {
+      return absl::DataLossError(absl::StrFormat(
+          "Invalid type or count for TIFF tag %d",
+          LoadUnsigned(entry, 2, big_endian_)));
+    }
+    const uint64_t size = count * type_size;
+    const char* data = value_field;
+    if (size > value_size) {
+      const uint64_t data_offset =
+          LoadUnsigned(value_field, value_size, big_endian_);
+      if (data_offset > std::numeric_limits<uint64_t>::max() - size) {
+        return absl::DataLossError(absl::StrFormat(
+            "Invalid offset for TIFF tag %d",
+            LoadUnsigned(entry, 2, big_endian_)));
+      }
+      // The values are only allocated once they have been supplied, such that
+      // the allocation is bounded by the size of the file.
+      data = GetData(data_offset, size);
+      if (!data) {
+        missing.push_back(ByteRange{data_offset, size});
+        return absl::OkStatus();
+      }
+    }
+    values.resize(count);
+    for (uint64_t i = 0; i < count; ++i) {
+      values[i] = LoadUnsigned(data + i * type_size, type_size, big_endian_);
+    }
+    return absl::OkStatus();
+  };
+  auto get_value = [&](const char* entry,
+                       auto& value) -> absl::Status {
+    std::vector<uint64_t> values;
+    TENSORSTORE_RETURN_IF_ERROR(get_values(entry, values));
+    if (!values.empty()) {
+      value = static_cast<std::remove_reference_t<decltype(value)>>(values[0]);
+    }
+    return absl::OkStatus();
+  };
+
+  for (uint64_t i = 0; i < num_entries; ++i) {
+    const char* entry = entries.data() + i * entry_size;
+    const uint16_t tag = LoadUnsigned(entry, 2, big_endian_);
+    absl::Status status;
+    switch (tag) {
+      case kNewSubfileType:
+        status = get_value(entry, directory.subfile_type);
+        break;
+      case kImageWidth:
+        status = get_value(entry, directory.width);
+        break;
+      case kImageLength:
+        status = get_value(entry, directory.height);
+        break;
+      case kBitsPerSample:
+        status = get_values(entry, bits_per_sample);
+        break;
+      case kCompression:
+        status = get_value(entry, directory.compression);
+        break;
+      case kStripOffsets:
+        status = get_values(entry, strip_offsets);
+        break;
+      case kSamplesPerPixel:
+        status = get_value(entry, directory.samples_per_pixel);
+        break;
+      case kRowsPerStrip:
+        status = get_value(entry, rows_per_strip.emplace());
+        break;
+      case kStripByteCounts:
+        status = get_values(entry, strip_byte_counts);
+        break;
+      case kPlanarConfiguration:
+        status = get_value(entry, directory.planar_configuration);
+        break;
+      case kPredictor:
+        status = get_value(entry, directory.predictor);
+        break;
+      case kTileWidth:
+        status = get_value(entry, tile_width.emplace());
+        break;
+      case kTileLength:
+        status = get_value(entry, tile_length.emplace());
+        break;
+      case kTileOffsets:
+        status = get_values(entry, tile_offsets);
+        break;
+      case kTileByteCounts:
+        status = get_values(entry, tile_byte_counts);
+        break;
+      case kSampleFormat:
+        status = get_values(entry, sample_format);
+        break;
+      default:
+        break;
+    }
+    TENSORSTORE_RETURN_IF_ERROR(
+        status, tensorstore::MaybeAnnotateStatus(
+                    _, absl::StrFormat("In TIFF directory at offset %d",
+                                       offset)));
+  }
+
+  if (!missing.empty()) {
+    // Request all of the missing out-of-line values at once if they are close
+    // together, as is typically the case for the offset and byte count arrays.
+    uint64_t min_offset = missing[0].offset;
+    uint64_t max_offset = missing[0].offset + missing[0].size;
+    uint64_t total_size = 0;
+    for (const auto& range : missing) {
+      min_offset = std::min(min_offset, range.offset);
+      max_offset = std::max(max_offset, range.offset + range.size);
+      total_size += range.size;
+    }
+    if (max_offset - min_offset <= total_size + kMaxRangeSlack) {
+      return ByteRange{min_offset, max_offset - min_offset};
+    }
+    return missing[0];
+  }
+
+  auto error = [&](std::string_view message) {
+    return absl::DataLossError(absl::StrFormat(
+        "TIFF directory at offset %d %s", offset, message));
+  };
+
+  if (directory.width == 0 || directory.height == 0) {
+    return error("has invalid image dimensions");
+  }
+  if (directory.samples_per_pixel == 0) {
+    return error("has invalid SamplesPerPixel");
+  }
+  // Differing sizes or formats between samples are not supported, and are
+  // represented by a `bits_per_sample` or `sample_format` of 0.
+  auto get_uniform = [](const std::vector<uint64_t>& values,
+                        uint16_t default_value) -> uint16_t {
+    if (values.empty()) return default_value;
+    for (uint64_t v : values) {
+      if (v != values[0]) return 0;
+    }
+    return static_cast<uint16_t>(values[0]);
+  };
+  directory.bits_per_sample = get_uniform(bits_per_sample, 1);
+  directory.sample_format = get_uniform(sample_format, 1);
+
+  if (tile_width || tile_length || !tile_offsets.empty()) {
+    if (!tile_width || !tile_length || *tile_width == 0 ||
+        *tile_length == 0 || *tile_width > kMaxTileSize ||
+        *tile_length > kMaxTileSize) {
+      return error("has invalid tile dimensions");
+    }
+    directory.tiled = true;
+    directory.chunk_width = static_cast<uint32_t>(*tile_width);
+    directory.chunk_height = static_cast<uint32_t>(*tile_length);
+    directory.chunk_offsets = std::move(tile_offsets);
+    directory.chunk_byte_counts = std::move(tile_byte_counts);
+  } else {
+    directory.chunk_width = directory.width;
+    directory.chunk_height = static_cast<uint32_t>(std::min<uint64_t>(
+        rows_per_strip.value_or(directory.height), directory.height));
+    if (directory.chunk_height == 0) {
+      return error("has invalid RowsPerStrip");
+    }
+    directory.chunk_offsets = std::move(strip_offsets);
+    directory.chunk_byte_counts = std::move(strip_byte_counts);
+  }
+  uint64_t chunk_bytes = directory.chunk_width;
+  if (internal::MulOverflow(chunk_bytes, uint64_t{directory.chunk_height},
+                            &chunk_bytes) ||
+      internal::MulOverflow(chunk_bytes,
+                            uint64_t{directory.samples_per_chunk()},
+                            &chunk_bytes) ||
+      internal::MulOverflow(
+          chunk_bytes,
+          std::max<uint64_t>(1, (uint64_t{directory.bits_per_sample} + 7) / 8),
+          &chunk_bytes) ||
+      chunk_bytes > kMaxChunkBytes) {
+    return error(absl::StrFormat("has %s larger than %d bytes",
+                                 directory.tiled ? "tiles" : "strips",
+                                 kMaxChunkBytes));
+  }
+  const uint64_t num_planes = directory.planar_configuration == 2
+                                  ? directory.samples_per_pixel
+                                  : 1;
+  const uint64_t num_chunks = num_planes * directory.chunks_across() *
+                              directory.chunks_down();
+  if (directory.chunk_offsets.size() != num_chunks ||
+      directory.chunk_byte_counts.size() != num_chunks) {
+    return error(absl::StrFormat(
+        "has %d %s offsets and %d byte counts, but %d are required",
+        directory.chunk_offsets.size(), directory.tiled ? "tile" : "strip",
+        directory.chunk_byte_counts.size(), num_chunks));
+  }
+
+  next_ifd_offset_ = LoadUnsigned(entries.data() + num_entries * entry_size,
+                                  value_size, big_endian_);
+  directories_.push_back(std::move(directory));
+  return std::nullopt;
+}
+
+absl::Status DecodeTiffChunk(const TiffDirectory& directory, bool big_endian,
+                             const absl::Cord& encoded, uint32_t num_rows,
+                             tensorstore::span<unsigned char> dest) {
+  const DataType dtype = directory.dtype();
+  if (!dtype.valid()) {
+    return absl::UnimplementedError(absl::StrFormat(
+        "TIFF images with %d bits per sample and sample format %d are not "
+        "supported",
+        directory.bits_per_sample, directory.sample_format));
+  }
+  const size_t bytes_per_sample = dtype.size();
+  const size_t samples = directory.samples_per_chunk();
+  const size_t row_samples = size_t{directory.chunk_width} * samples;
+  assert(dest.size() == row_samples * num_rows * bytes_per_sample);
+
+  switch (directory.compression) {
+    case 1:  // None
+      if (encoded.size() < dest.size()) {
+        return absl::DataLossError("Truncated uncompressed TIFF data");
+      }
+      CopyCordToSpan(encoded, dest.data(), dest.size());
+      break;
+    case 5:  // LZW
+      TENSORSTORE_RETURN_IF_ERROR(DecodeLzw(encoded, dest));
+      break;
+    case 8:       // Adobe Deflate
+    case 32946: {  // Deflate
+      // Decoding stops once the output exceeds the size of a full chunk, to
+      // guard against small inputs that inflate to huge outputs.  The final
+      // strip may be encoded with the full `chunk_height` rather than just
+      // `num_rows` rows.
+      const size_t max_decoded_size =
+          row_samples * directory.chunk_height * bytes_per_sample;
+      absl::Cord decoded;
+      TENSORSTORE_RETURN_IF_ERROR(
+          zlib::Decode(encoded, &decoded, /*use_gzip_header=*/false,
+                       max_decoded_size),
+          internal::MaybeConvertStatusTo(_, absl::StatusCode::kDataLoss));
+      if (decoded.size() < dest.size()) {
+        return absl::DataLossError("Truncated Deflate-compressed TIFF data");
+      }
+      CopyCordToSpan(decoded, dest.data(), dest.size());
+      break;
+    }
+    case 32773:  // PackBits
+      TENSORSTORE_RETURN_IF_ERROR(DecodePackBits(encoded, dest));
+      break;
+    default:
+      return absl::UnimplementedError(absl::StrFormat(
+          "TIFF compression scheme %d is not supported",
+          directory.compression));
+  }
+
+  if (bytes_per_sample > 1 &&
+      big_endian != (endian::native == endian::big)) {
+    for (size_t i = 0; i < dest.size(); i += bytes_per_sample) {
+      std::reverse(dest.data() + i, dest.data() + i + bytes_per_sample);
+    }
+  }
+
+  switch (directory.predictor) {
+    case 1:  // None
+      break;
+    case 2:  // Horizontal differencing
+      switch (directory.sample_format == 3 ? 0 : bytes_per_sample) {
+        case 1:
+          UndoHorizontalDifferencing<uint8_t>(dest.data(), num_rows,
+                                              directory.chunk_width, samples);
+          break;
+        case 2:
+          UndoHorizontalDifferencing<uint16_t>(dest.data(), num_rows,
+                                               directory.chunk_width, samples);
+          break;
+        case 4:
+          UndoHorizontalDifferencing<uint32_t>(dest.data(), num_rows,
+                                               directory.chunk_width, samples);
+          break;
+        case 8:
+          UndoHorizontalDifferencing<uint64_t>(dest.data(), num_rows,
+                                               directory.chunk_width, samples);
+          break;
+        default:
+          return absl::UnimplementedError(
+              "TIFF horizontal differencing predictor is not supported for "
+              "floating point samples");
+      }
+      break;
+    default:
+      return absl::UnimplementedError(absl::StrFormat(
+          "TIFF predictor %d is not supported", directory.predictor));
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace internal_image
+}  // namespace tensorstore
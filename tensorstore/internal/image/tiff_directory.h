@@ -0,0 +1,184 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_IMAGE_TIFF_DIRECTORY_H_
+#define TENSORSTORE_INTERNAL_IMAGE_TIFF_DIRECTORY_H_
+
+/// \file
+///
+/// Random-access support for TIFF files.
+///
+/// Unlike `TiffReader`, which decodes a whole image from a stream, these
+/// functions operate on the individual tiles (or strips) of a TIFF image, so
+/// that a tile can be read from storage and decoded without accessing the rest
+/// of the file.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal_image {
+
+/// Layout of a single TIFF image file directory (IFD).
+///
+/// Stripped images are represented as tiled images with a tile width equal to
+/// the image width and a tile height equal to the number of rows per strip.
+struct TiffDirectory {
+  uint32_t subfile_type = 0;
+  uint32_t width = 0;
+  uint32_t height = 0;
+  uint16_t samples_per_pixel = 1;
+  uint16_t bits_per_sample = 1;
+  uint16_t sample_format = 1;
+  uint16_t compression = 1;
+  uint16_t predictor = 1;
+  uint16_t planar_configuration = 1;
+
+  /// Indicates whether the image is tiled rather than stripped.
+  bool tiled = false;
+
+  /// Dimensions of each tile or strip.
+  uint32_t chunk_width = 0;
+  uint32_t chunk_height = 0;
+
+  /// Byte offset and size within the file of each tile or strip, in the order
+  /// defined by the TIFF specification: row-major within each sample plane.
+  std::vector<uint64_t> chunk_offsets;
+  std::vector<uint64_t> chunk_byte_counts;
+
+  /// Returns the data type of a sample, or an invalid data type if the
+  /// sample format is not supported.
+  DataType dtype() const;
+
+  /// Number of samples stored in each tile or strip.
+  uint16_t samples_per_chunk() const {
+    return planar_configuration == 2 ? 1 : samples_per_pixel;
+  }
+
+  /// Number of tiles or strips per row and column of each sample plane.
+  uint32_t chunks_across() const {
+    return (width + chunk_width - 1) / chunk_width;
+  }
+  uint32_t chunks_down() const {
+    return (height + chunk_height - 1) / chunk_height;
+  }
+
+  /// Returns the index into `chunk_offsets` of the specified tile or strip.
+  size_t GetChunkIndex(uint32_t plane, uint32_t row, uint32_t col) const {
+    return (static_cast<size_t>(plane) * chunks_down() + row) *
+               chunks_across() +
+           col;
+  }
+
+  /// Returns `true` if the directory describes a reduced-resolution version
+  /// of another image, such as a thumbnail.
+  bool is_reduced_resolution() const { return subfile_type & 1; }
+};
+
+/// Incrementally parses all image file directories of a TIFF or BigTIFF file
+/// from a sparse set of byte ranges of the file.
+///
+/// Example:
+///
+///     TiffDirectoryParser parser;
+///     while (true) {
+///       TENSORSTORE_ASSIGN_OR_RETURN(auto needed, parser.Parse());
+///       if (!needed) break;
+///       parser.AddData(needed->offset, ReadAtLeast(*needed));
+///     }
+///
+class TiffDirectoryParser {
+ public:
+  /// Range of bytes of the file.
+  struct ByteRange {
+    uint64_t offset;
+    uint64_t size;
+  };
+
+  /// Supplies `data` as the contents of the file starting at `offset`.
+  void AddData(uint64_t offset, const absl::Cord& data);
+
+  /// Parses as many directories as possible from the data supplied so far.
+  ///
+  /// \returns The range of bytes that must be supplied by `AddData` in order
+  ///     to make further progress, or `std::nullopt` once all directories have
+  ///     been parsed.
+  /// \error `absl::StatusCode::kDataLoss` if the file is not a valid TIFF file.
+  Result<std::optional<ByteRange>> Parse();
+
+  /// Indicates whether multi-byte values are stored in big endian order.
+  bool big_endian() const { return big_endian_; }
+
+  /// Directories parsed so far, in file order.
+  const std::vector<TiffDirectory>& directories() const {
+    return directories_;
+  }
+
+ private:
+  // Copies `size` bytes starting at `offset` to `dest`.  Returns `false` if
+  // the data has not been supplied.
+  bool Read(uint64_t offset, size_t size, char* dest) const;
+
+  // Returns a pointer to the `size` bytes starting at `offset`, or `nullptr`
+  // if the data has not been supplied.
+  const char* GetData(uint64_t offset, uint64_t size) const;
+
+  // Parses the directory at `offset`.  On success, returns `std::nullopt` and
+  // sets `next_ifd_offset_`.
+  Result<std::optional<ByteRange>> ParseDirectory(uint64_t offset);
+
+  // Non-overlapping segments of the file that have been supplied, keyed by
+  // offset.
+  std::map<uint64_t, std::string> segments_;
+
+  bool header_parsed_ = false;
+  bool big_endian_ = false;
+  bool big_tiff_ = false;
+  uint64_t next_ifd_offset_ = 0;
+  absl::flat_hash_set<uint64_t> visited_ifd_offsets_;
+  std::vector<TiffDirectory> directories_;
+};
+
+/// Decodes a single tile or strip of `directory`.
+///
+/// \param directory The directory containing the tile or strip.
+/// \param big_endian Byte order of the file.
+/// \param encoded The encoded tile or strip data.
+/// \param num_rows Number of rows stored in the tile or strip; this is less
+///     than `directory.chunk_height` only for the final strip of an image.
+/// \param dest[out] Destination for the decoded samples in C order with shape
+///     `{num_rows, chunk_width, samples_per_chunk()}` and native byte order.
+/// \error `absl::StatusCode::kUnimplemented` if the compression scheme or
+///     predictor is not supported.
+/// \error `absl::StatusCode::kDataLoss` if `encoded` is corrupt.
+absl::Status DecodeTiffChunk(const TiffDirectory& directory, bool big_endian,
+                             const absl::Cord& encoded, uint32_t num_rows,
+                             tensorstore::span<unsigned char> dest);
+
+}  // namespace internal_image
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_IMAGE_TIFF_DIRECTORY_H_
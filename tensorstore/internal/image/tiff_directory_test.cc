@@ -0,0 +1,423 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/image/tiff_directory.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/internal/compression/zlib.h"
+#include "tensorstore/util/span.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::dtype_v;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::internal_image::DecodeTiffChunk;
+using ::tensorstore::internal_image::TiffDirectory;
+using ::tensorstore::internal_image::TiffDirectoryParser;
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+
+// Builds a classic TIFF file in memory.
+class TiffBuilder {
+ public:
+  struct Entry {
+    uint16_t tag;
+    uint16_t type;  // 3 = SHORT, 4 = LONG
+    std::vector<uint32_t> values;
+  };
+
+  explicit TiffBuilder(bool big_endian = false) : big_endian_(big_endian) {
+    data_ = big_endian ? "MM" : "II";
+    Append(42, 2);
+    next_ifd_pos_ = data_.size();
+    Append(0, 4);
+  }
+
+  // Appends `data` to the file and returns its offset.
+  uint32_t AddData(std::string_view data) {
+    const uint32_t offset = data_.size();
+    data_.append(data);
+    return offset;
+  }
+
+  // Appends a directory and links it from the previous directory.
+  void AddDirectory(std::vector<Entry> entries) {
+    // Store out-of-line values first.
+    std::vector<uint32_t> value_offsets;
+    for (const auto& entry : entries) {
+      const size_t type_size = entry.type == 3 ? 2 : 4;
+      if (entry.values.size() * type_size > 4) {
+        value_offsets.push_back(data_.size());
+        for (uint32_t v : entry.values) Append(v, type_size);
+      } else {
+        value_offsets.push_back(0);
+      }
+    }
+    if (data_.size() % 2) data_.push_back('\0');
+    const uint32_t ifd_offset = data_.size();
+    Patch(next_ifd_pos_, ifd_offset);
+    Append(entries.size(), 2);
+    for (size_t i = 0; i < entries.size(); ++i) {
+      const auto& entry = entries[i];
+      const size_t type_size = entry.type == 3 ? 2 : 4;
+      Append(entry.tag, 2);
+      Append(entry.type, 2);
+      Append(entry.values.size(), 4);
+      if (value_offsets[i]) {
+        Append(value_offsets[i], 4);
+      } else {
+        size_t n = 0;
+        for (uint32_t v : entry.values) {
+          Append(v, type_size);
+          n += type_size;
+        }
+        for (; n < 4; ++n) data_.push_back('\0');
+      }
+    }
+    next_ifd_pos_ = data_.size();
+    Append(0, 4);
+  }
+
+  const std::string& data() const { return data_; }
+
+  // Appends `value` with the file byte order.
+  void Append(uint64_t value, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+      const size_t shift = 8 * (big_endian_ ? size - 1 - i : i);
+      data_.push_back(static_cast<char>((value >> shift) & 0xff));
+    }
+  }
+
+ private:
+  void Patch(size_t pos, uint32_t value) {
+    std::string saved = data_.substr(pos + 4);
+    data_.resize(pos);
+    Append(value, 4);
+    data_ += saved;
+  }
+
+  bool big_endian_;
+  std::string data_;
+  size_t next_ifd_pos_;
+};
+
+// Parses `file`, supplying exactly the bytes requested by the parser.
+std::vector<TiffDirectory> ParseIncrementally(const std::string& file,
+                                              bool* big_endian = nullptr) {
+  TiffDirectoryParser parser;
+  for (int i = 0; i < 100; ++i) {
+    auto needed = parser.Parse();
+    EXPECT_TRUE(needed.ok()) << needed.status();
+    if (!needed.ok()) return {};
+    if (!*needed) {
+      if (big_endian) *big_endian = parser.big_endian();
+      return parser.directories();
+    }
+    EXPECT_LE((*needed)->offset + (*needed)->size, file.size());
+    parser.AddData((*needed)->offset,
+                   absl::Cord(file.substr((*needed)->offset, (*needed)->size)));
+  }
+  ADD_FAILURE() << "Parser made no progress";
+  return {};
+}
+
+TEST(TiffDirectoryParserTest, Stripped) {
+  TiffBuilder builder;
+  const uint32_t strip0 = builder.AddData("\x01\x02\x03\x04\x05\x06\x07\x08");
+  const uint32_t strip1 = builder.AddData("\x09\x0a\x0b\x0c");
+  builder.AddDirectory({
+      {256, 3, {4}},               // ImageWidth
+      {257, 3, {3}},               // ImageLength
+      {258, 3, {8}},               // BitsPerSample
+      {273, 4, {strip0, strip1}},  // StripOffsets
+      {278, 3, {2}},               // RowsPerStrip
+      {279, 4, {8, 4}},            // StripByteCounts
+  });
+
+  bool big_endian = true;
+  auto directories = ParseIncrementally(builder.data(), &big_endian);
+  ASSERT_EQ(1, directories.size());
+  EXPECT_FALSE(big_endian);
+  const auto& dir = directories[0];
+  EXPECT_EQ(4, dir.width);
+  EXPECT_EQ(3, dir.height);
+  EXPECT_FALSE(dir.tiled);
+  EXPECT_EQ(4, dir.chunk_width);
+  EXPECT_EQ(2, dir.chunk_height);
+  EXPECT_EQ(1, dir.chunks_across());
+  EXPECT_EQ(2, dir.chunks_down());
+  EXPECT_EQ(dtype_v<uint8_t>, dir.dtype());
+  EXPECT_THAT(dir.chunk_offsets, ElementsAre(strip0, strip1));
+  EXPECT_THAT(dir.chunk_byte_counts, ElementsAre(8, 4));
+
+  // The final strip contains only a single row.
+  std::vector<unsigned char> decoded(4);
+  TENSORSTORE_EXPECT_OK(DecodeTiffChunk(
+      dir, big_endian, absl::Cord(builder.data().substr(strip1, 4)),
+      /*num_rows=*/1, decoded));
+  EXPECT_THAT(decoded, ElementsAre(9, 10, 11, 12));
+}
+
+TEST(TiffDirectoryParserTest, TiledMultiPageBigEndian) {
+  TiffBuilder builder(/*big_endian=*/true);
+  for (int page = 0; page < 3; ++page) {
+    std::vector<uint32_t> offsets;
+    for (int tile = 0; tile < 4; ++tile) {
+      std::string tile_data;
+      for (int i = 0; i < 16 * 16; ++i) {
+        const uint16_t value = page * 1000 + tile * 100 + i % 100;
+        tile_data.push_back(static_cast<char>(value >> 8));
+        tile_data.push_back(static_cast<char>(value & 0xff));
+      }
+      offsets.push_back(builder.AddData(tile_data));
+    }
+    builder.AddDirectory({
+        {256, 3, {20}},                  // ImageWidth
+        {257, 3, {30}},                  // ImageLength
+        {258, 3, {16}},                  // BitsPerSample
+        {322, 3, {16}},                  // TileWidth
+        {323, 3, {16}},                  // TileLength
+        {324, 4, offsets},               // TileOffsets
+        {325, 4, {512, 512, 512, 512}},  // TileByteCounts
+    });
+  }
+
+  bool big_endian = false;
+  auto directories = ParseIncrementally(builder.data(), &big_endian);
+  ASSERT_EQ(3, directories.size());
+  EXPECT_TRUE(big_endian);
+  for (const auto& dir : directories) {
+    EXPECT_TRUE(dir.tiled);
+    EXPECT_EQ(16, dir.chunk_width);
+    EXPECT_EQ(16, dir.chunk_height);
+    EXPECT_EQ(2, dir.chunks_across());
+    EXPECT_EQ(2, dir.chunks_down());
+    EXPECT_EQ(dtype_v<uint16_t>, dir.dtype());
+  }
+
+  const auto& dir = directories[2];
+  const size_t tile_index = dir.GetChunkIndex(0, 1, 0);
+  EXPECT_EQ(2, tile_index);
+  std::vector<uint16_t> decoded(16 * 16);
+  TENSORSTORE_EXPECT_OK(DecodeTiffChunk(
+      dir, big_endian,
+      absl::Cord(builder.data().substr(dir.chunk_offsets[tile_index], 512)),
+      /*num_rows=*/16,
+      tensorstore::span(reinterpret_cast<unsigned char*>(decoded.data()),
+                        512)));
+  EXPECT_EQ(2200, decoded[0]);
+  EXPECT_EQ(2205, decoded[5]);
+}
+
+TEST(TiffDirectoryParserTest, InvalidHeader) {
+  TiffDirectoryParser parser;
+  parser.AddData(0,
+                 absl::Cord(std::string("XX\x2a\x00\x08\x00\x00\x00", 8)));
+  EXPECT_THAT(parser.Parse(), MatchesStatus(absl::StatusCode::kDataLoss,
+                                            "Invalid TIFF byte order mark"));
+}
+
+TEST(TiffDirectoryParserTest, DirectoryCycle) {
+  TiffBuilder builder;
+  const uint32_t strip = builder.AddData("\x01");
+  builder.AddDirectory({
+      {256, 3, {1}},
+      {257, 3, {1}},
+      {273, 4, {strip}},
+      {279, 4, {1}},
+  });
+  // Point the next directory offset back at the first directory.
+  std::string file = builder.data();
+  const std::string first_ifd = file.substr(4, 4);
+  file.replace(file.size() - 4, 4, first_ifd);
+  TiffDirectoryParser parser;
+  parser.AddData(0, absl::Cord(file));
+  EXPECT_THAT(parser.Parse(),
+              MatchesStatus(absl::StatusCode::kDataLoss,
+                            ".*referenced more than once"));
+}
+
+TEST(TiffDirectoryParserTest, MissingChunkOffsets) {
+  TiffBuilder builder;
+  builder.AddDirectory({
+      {256, 3, {4}},
+      {257, 3, {4}},
+  });
+  TiffDirectoryParser parser;
+  parser.AddData(0, absl::Cord(builder.data()));
+  EXPECT_THAT(parser.Parse(),
+              MatchesStatus(absl::StatusCode::kDataLoss,
+                            ".*has 0 strip offsets and 0 byte counts, but 1 "
+                            "are required"));
+}
+
+TEST(TiffDirectoryParserTest, TagCountTooLarge) {
+  TiffBuilder builder;
+  builder.AddDirectory({
+      {256, 3, {4}},
+      {257, 3, {4}},
+      {273, 4, {100, 200}},
+  });
+  std::string file = builder.data();
+  // Replace the count of the StripOffsets entry, which would otherwise require
+  // reading and allocating 4 GiB.
+  const uint32_t ifd_offset = static_cast<unsigned char>(file[4]) |
+                              (static_cast<unsigned char>(file[5]) << 8);
+  file.replace(ifd_offset + 2 + 2 * 12 + 4, 4, "\xff\xff\xff\xff", 4);
+  TiffDirectoryParser parser;
+  parser.AddData(0, absl::Cord(file));
+  EXPECT_THAT(parser.Parse(),
+              MatchesStatus(absl::StatusCode::kDataLoss,
+                            ".*Invalid type or count for TIFF tag 273.*"));
+}
+
+TEST(TiffDirectoryParserTest, StripTooLarge) {
+  TiffBuilder builder;
+  // A single strip of 65535 * 65535 bytes, which would be allocated at once.
+  builder.AddDirectory({
+      {256, 3, {65535}},  // ImageWidth
+      {257, 3, {65535}},  // ImageLength
+      {273, 4, {8}},      // StripOffsets
+      {279, 4, {1}},      // StripByteCounts
+  });
+  TiffDirectoryParser parser;
+  parser.AddData(0, absl::Cord(builder.data()));
+  EXPECT_THAT(parser.Parse(),
+              MatchesStatus(absl::StatusCode::kDataLoss,
+                            ".*has strips larger than 1073741824 bytes"));
+}
+
+TiffDirectory MakeDirectory(uint16_t compression, uint32_t width,
+                            uint32_t height, uint16_t samples_per_pixel = 1,
+                            uint16_t bits_per_sample = 8) {
+  TiffDirectory dir;
+  dir.width = dir.chunk_width = width;
+  dir.height = dir.chunk_height = height;
+  dir.samples_per_pixel = samples_per_pixel;
+  dir.bits_per_sample = bits_per_sample;
+  dir.compression = compression;
+  return dir;
+}
+
+TEST(DecodeTiffChunkTest, PackBits) {
+  auto dir = MakeDirectory(32773, 6, 1);
+  std::vector<unsigned char> decoded(6);
+  // Literal run of 2 bytes, followed by a repeat run of 4 bytes.
+  TENSORSTORE_EXPECT_OK(DecodeTiffChunk(
+      dir, false, absl::Cord(std::string("\x01\x07\x08\xfd\x09", 5)), 1,
+      decoded));
+  EXPECT_THAT(decoded, ElementsAre(7, 8, 9, 9, 9, 9));
+
+  EXPECT_THAT(
+      DecodeTiffChunk(dir, false, absl::Cord(std::string("\x05\x01", 2)), 1,
+                      decoded),
+      MatchesStatus(absl::StatusCode::kDataLoss, ".*PackBits.*"));
+}
+
+// Packs 9-bit LZW codes MSB-first.
+std::string PackLzwCodes(std::vector<int> codes) {
+  std::string out;
+  uint32_t buffer = 0;
+  int bits = 0;
+  for (int code : codes) {
+    buffer = (buffer << 9) | code;
+    bits += 9;
+    while (bits >= 8) {
+      out.push_back(static_cast<char>((buffer >> (bits - 8)) & 0xff));
+      bits -= 8;
+    }
+  }
+  if (bits) out.push_back(static_cast<char>((buffer << (8 - bits)) & 0xff));
+  return out;
+}
+
+TEST(DecodeTiffChunkTest, Lzw) {
+  auto dir = MakeDirectory(5, 5, 1);
+  std::vector<unsigned char> decoded(5);
+  // Clear, 1, 2, <258 = {1, 2}>, 1, end of information.
+  TENSORSTORE_EXPECT_OK(DecodeTiffChunk(
+      dir, false, absl::Cord(PackLzwCodes({256, 1, 2, 258, 1, 257})), 1,
+      decoded));
+  EXPECT_THAT(decoded, ElementsAre(1, 2, 1, 2, 1));
+
+  std::vector<unsigned char> decoded2(4);
+  auto dir2 = MakeDirectory(5, 4, 1);
+  // Clear, 1, <258 = {1, 1}> (not yet defined), 1, end of information.
+  TENSORSTORE_EXPECT_OK(DecodeTiffChunk(
+      dir2, false, absl::Cord(PackLzwCodes({256, 1, 258, 1, 257})), 1,
+      decoded2));
+  EXPECT_THAT(decoded2, ElementsAre(1, 1, 1, 1));
+}
+
+TEST(DecodeTiffChunkTest, DeflateWithPredictor) {
+  auto dir = MakeDirectory(8, 4, 2, /*samples_per_pixel=*/2,
+                           /*bits_per_sample=*/16);
+  dir.predictor = 2;
+  // Horizontally differenced little endian samples.
+  std::vector<uint16_t> differenced = {1, 10, 1, 10, 1, 10, 1, 10,  //
+                                       5, 0,  1, 1,  1, 1,  1, 1};
+  std::string raw;
+  for (uint16_t v : differenced) {
+    raw.push_back(static_cast<char>(v & 0xff));
+    raw.push_back(static_cast<char>(v >> 8));
+  }
+  absl::Cord encoded;
+  tensorstore::zlib::Encode(absl::Cord(raw), &encoded, {});
+  std::vector<uint16_t> decoded(16);
+  TENSORSTORE_EXPECT_OK(DecodeTiffChunk(
+      dir, /*big_endian=*/false, encoded, 2,
+      tensorstore::span(reinterpret_cast<unsigned char*>(decoded.data()),
+                        32)));
+  EXPECT_THAT(decoded, ElementsAreArray<uint16_t>({1, 10, 2, 20, 3, 30, 4, 40,
+                                                   5, 0, 6, 1, 7, 2, 8, 3}));
+}
+
+TEST(DecodeTiffChunkTest, DeflateTooLarge) {
+  auto dir = MakeDirectory(8, 4, 1);
+  // Small input that inflates to far more than the 4-byte chunk.
+  absl::Cord encoded;
+  tensorstore::zlib::Encode(absl::Cord(std::string(1024 * 1024, '\0')),
+                            &encoded, {});
+  std::vector<unsigned char> decoded(4);
+  EXPECT_THAT(DecodeTiffChunk(dir, /*big_endian=*/false, encoded, 1, decoded),
+              MatchesStatus(absl::StatusCode::kDataLoss,
+                            ".*exceeds maximum size.*"));
+}
+
+TEST(DecodeTiffChunkTest, Unsupported) {
+  std::vector<unsigned char> decoded(4);
+  EXPECT_THAT(
+      DecodeTiffChunk(MakeDirectory(7, 4, 1), false, absl::Cord("abcd"), 1,
+                      decoded),
+      MatchesStatus(absl::StatusCode::kUnimplemented,
+                    "TIFF compression scheme 7 is not supported"));
+  EXPECT_THAT(DecodeTiffChunk(MakeDirectory(1, 4, 1, 1, /*bits_per_sample=*/1),
+                              false, absl::Cord("abcd"), 1, decoded),
+              MatchesStatus(absl::StatusCode::kUnimplemented,
+                            "TIFF images with 1 bits per sample.*"));
+}
+
+}  // namespace
@@ -111,17 +111,22 @@ absl::Status WebPReader::Context::Init() {
 
 absl::Status WebPReader::Context::Decode(tensorstore::span<unsigned char> dest,
                                          const WebPReaderOptions& options) {
-  WebPDecBuffer buf;
-  if (!WebPInitDecBuffer(&buf)) {
-    return absl::InternalError("Failed to init WEBP decoder buffer");
+  WebPDecoderConfig config;
+  if (!WebPInitDecoderConfig(&config)) {
+    return absl::InternalError("Failed to init WEBP decoder config");
   }
+  WebPDecBuffer& buf = config.output;
   buf.colorspace = features_.has_alpha ? MODE_RGBA : MODE_RGB;
   buf.u.RGBA.rgba = dest.data();
   buf.u.RGBA.stride = features_.width * (features_.has_alpha ? 4 : 3);
   buf.u.RGBA.size = dest.size();
   buf.is_external_memory = 1;
+  config.options.use_threads = options.use_threads;
 
-  WebPIDecoder* idec = WebPINewDecoder(&buf);
+  WebPIDecoder* idec = WebPIDecode(nullptr, 0, &config);
+  if (idec == nullptr) {
+    return absl::InternalError("Failed to create WEBP decoder");
+  }
   auto status = [&]() -> absl::Status {
     while (reader_->Pull()) {
       auto status =
@@ -26,7 +26,11 @@
 namespace tensorstore {
 namespace internal_image {
 
-struct WebPReaderOptions {};
+struct WebPReaderOptions {
+  /// Decode lossy images using an additional thread, which applies the
+  /// in-loop filter concurrently with the entropy decoding.
+  bool use_threads = false;
+};
 
 class WebPReader : public ImageReader {
  public:
@@ -31,6 +31,7 @@
 #include "tensorstore/internal/nditerable.h"
 #include "tensorstore/internal/nditerable_buffer_management.h"
 #include "tensorstore/internal/nditerable_util.h"
+#include "tensorstore/internal/tiled_copy.h"
 #include "tensorstore/util/iterate.h"
 #include "tensorstore/util/span.h"
 
@@ -107,6 +108,31 @@ bool NDIteratorCopyManager::CopyImplBoth(NDIteratorCopyManager* self,
                                     status);
 }
 
+bool NDIteratorCopyManager::CopyImplBothStrided(
+    NDIteratorCopyManager* self, tensorstore::span<const Index> indices,
+    IterationBufferShape block_shape, absl::Status* status) {
+  IterationBufferPointer input_pointer, output_pointer;
+  if (!self->input_->GetBlock(indices, block_shape, &input_pointer, status) ||
+      !self->output_->GetBlock(indices, block_shape, &output_pointer,
+                               status)) {
+    return false;
+  }
+  if (IsTransposingStridedCopy(self->element_size_, block_shape,
+                               input_pointer, output_pointer)) {
+    if (!TiledCopy(self->copy_elements_function_,
+                   self->trivial_element_size_, block_shape, input_pointer,
+                   output_pointer, status)) {
+      return false;
+    }
+  } else if (!self->copy_elements_function_(nullptr, block_shape,
+                                            input_pointer, output_pointer,
+                                            status)) {
+    return false;
+  }
+  return self->output_->UpdateBlock(indices, block_shape, output_pointer,
+                                    status);
+}
+
 bool NDIteratorCopyManager::CopyImplInput(
     NDIteratorCopyManager* self, tensorstore::span<const Index> indices,
     IterationBufferShape block_shape, absl::Status* status) {
@@ -167,13 +193,23 @@ NDIteratorCopyManager::NDIteratorCopyManager(
     case NDIterableCopyManager::BufferSource::kOutput:
       copy_impl_ = NDIteratorCopyManager::CopyImplOutput;
       break;
-    case NDIterableCopyManager::BufferSource::kBoth:
-      copy_impl_ = NDIteratorCopyManager::CopyImplBoth;
+    case NDIterableCopyManager::BufferSource::kBoth: {
+      const DataType dtype = iterable.input()->dtype();
       copy_elements_function_ =
-          iterable.input()
-              ->dtype()
-              ->copy_assign[buffer_parameters.input_buffer_kind];
+          dtype->copy_assign[buffer_parameters.input_buffer_kind];
+      if (buffer_parameters.input_buffer_kind ==
+          IterationBufferKind::kStrided) {
+        // The inner dimension of one of the buffers may be strided while the
+        // other is contiguous, e.g. when copying between C-order and
+        // Fortran-order arrays.
+        copy_impl_ = NDIteratorCopyManager::CopyImplBothStrided;
+        element_size_ = dtype->size;
+        trivial_element_size_ = GetTiledCopyTrivialElementSize(dtype);
+      } else {
+        copy_impl_ = NDIteratorCopyManager::CopyImplBoth;
+      }
       break;
+    }
     case NDIterableCopyManager::BufferSource::kExternal:
       copy_impl_ = NDIteratorCopyManager::CopyImplExternal;
       buffer_manager_.Initialize(layout.block_shape,
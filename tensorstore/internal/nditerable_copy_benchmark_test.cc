@@ -30,6 +30,8 @@
 #include "tensorstore/internal/nditerable_array.h"
 #include "tensorstore/internal/nditerable_copy.h"
 #include "tensorstore/internal/nditerable_transformed_array.h"
+#include "tensorstore/internal/nditerable_util.h"
+#include "tensorstore/internal/tiled_copy.h"
 #include "tensorstore/util/result.h"
 #include "tensorstore/util/status.h"
 
@@ -226,6 +228,134 @@ void DefineArgs(Bench* benchmark) {
   benchmark->Args({2000, 16});
 }
 
+// Copies a 64^3 uint8 chunk into a translated region of a larger array, as
+// when reading a chunk, and reports the number of NDIterable allocations per
+// copy that did not fit in the arena buffer and were heap allocated.
+//
+// `state.range(0)` selects the arena: 0 for an `Arena` without a buffer, as a
+// baseline in which all NDIterable state is heap allocated, and 1 for
+// `DefaultNDIterableArena`.
+void BM_ChunkCopy(benchmark::State& state) {
+  constexpr int64_t kChunkSize = 64;
+  auto chunk = tensorstore::AllocateArray<uint8_t>(
+      {kChunkSize, kChunkSize, kChunkSize}, tensorstore::c_order,
+      tensorstore::value_init);
+  auto target_array = tensorstore::AllocateArray<uint8_t>(
+      {2 * kChunkSize, 2 * kChunkSize, 2 * kChunkSize}, tensorstore::c_order,
+      tensorstore::value_init);
+  TENSORSTORE_CHECK_OK_AND_ASSIGN(
+      auto target, target_array | tensorstore::AllDims().TranslateSizedInterval(
+                                      kChunkSize / 2, kChunkSize));
+  const auto do_copy = [&](tensorstore::internal::Arena* arena) {
+    {
+      auto source_iterable = GetArrayNDIterable(chunk, arena);
+      auto target_iterable =
+          GetTransformedArrayNDIterable(target, arena).value();
+      tensorstore::internal::NDIterableCopier copier(
+          *source_iterable, *target_iterable, chunk.shape(),
+          tensorstore::c_order, arena);
+      TENSORSTORE_CHECK_OK(copier.Copy());
+    }
+    return arena->num_heap_allocations();
+  };
+  int64_t num_heap_allocations = 0;
+  for (auto s : state) {
+    if (state.range(0) == 0) {
+      tensorstore::internal::Arena arena;
+      num_heap_allocations += do_copy(&arena);
+    } else {
+      tensorstore::internal::DefaultNDIterableArena arena;
+      num_heap_allocations += do_copy(arena);
+    }
+  }
+  state.counters["allocs_per_copy"] = benchmark::Counter(
+      static_cast<double>(num_heap_allocations) /
+      static_cast<double>(state.iterations()));
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          chunk.num_elements());
+}
+
+// Copies an `n x n` array between C-order and Fortran-order layouts.
+//
+// `state.range(0)` is `n`; `state.range(1)` and `state.range(2)` select the
+// source and target layouts, respectively: 0 for C order and 1 for Fortran
+// order.  Mismatched layouts result in a transposing copy.
+template <typename T>
+void BM_LayoutCopy(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  const auto get_order = [](int64_t i) {
+    return i == 0 ? tensorstore::c_order : tensorstore::fortran_order;
+  };
+  auto source = tensorstore::AllocateArray<T>({n, n}, get_order(state.range(1)),
+                                              tensorstore::value_init);
+  auto target = tensorstore::AllocateArray<T>({n, n}, get_order(state.range(2)),
+                                              tensorstore::value_init);
+  for (auto s : state) {
+    tensorstore::internal::DefaultNDIterableArena arena;
+    auto source_iterable = GetArrayNDIterable(source, arena);
+    auto target_iterable = GetArrayNDIterable(target, arena);
+    tensorstore::internal::NDIterableCopier copier(
+        *source_iterable, *target_iterable, source.shape(),
+        tensorstore::c_order, arena);
+    TENSORSTORE_CHECK_OK(copier.Copy());
+  }
+  state.counters["block_bytes"] = benchmark::Counter(static_cast<double>(
+      tensorstore::internal::GetNDIterationTargetBlockBytes()));
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          source.num_elements() * sizeof(T));
+}
+
+template <typename Bench>
+void DefineLayoutArgs(Bench* benchmark) {
+  benchmark->ArgsProduct({{64, 1024, 4096}, {0, 1}, {0, 1}});
+}
+
+// Transposes an `n x n` array with the `kStrided` copy function of the data
+// type (`state.range(1) == 0`) or with `TiledCopy` (`state.range(1) == 1`).
+template <typename T>
+void BM_TransposeKernel(benchmark::State& state) {
+  using ::tensorstore::internal::IterationBufferKind;
+  using ::tensorstore::internal::IterationBufferPointer;
+  const int64_t n = state.range(0);
+  auto source = tensorstore::AllocateArray<T>({n, n}, tensorstore::c_order,
+                                              tensorstore::value_init);
+  auto target = tensorstore::AllocateArray<T>({n, n}, tensorstore::c_order,
+                                              tensorstore::value_init);
+  const int64_t size = sizeof(T);
+  IterationBufferPointer source_pointer(source.data(), n * size, size);
+  IterationBufferPointer target_pointer(target.data(), size, n * size);
+  auto copy_function =
+      tensorstore::dtype_v<T>->copy_assign[IterationBufferKind::kStrided];
+  for (auto s : state) {
+    if (state.range(1) == 0) {
+      copy_function(nullptr, {n, n}, source_pointer, target_pointer, nullptr);
+    } else {
+      tensorstore::internal::TiledCopy(copy_function, size, {n, n},
+                                       source_pointer, target_pointer,
+                                       nullptr);
+    }
+    benchmark::DoNotOptimize(target.data());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * n * n *
+                          size);
+}
+
+template <typename Bench>
+void DefineTransposeArgs(Bench* benchmark) {
+  benchmark->ArgsProduct({{256, 4096}, {0, 1}});
+}
+
+BENCHMARK(BM_ChunkCopy)->Arg(0)->Arg(1);
+
+BENCHMARK(BM_TransposeKernel<uint8_t>)->Apply(DefineTransposeArgs);
+BENCHMARK(BM_TransposeKernel<uint16_t>)->Apply(DefineTransposeArgs);
+BENCHMARK(BM_TransposeKernel<uint32_t>)->Apply(DefineTransposeArgs);
+BENCHMARK(BM_TransposeKernel<uint64_t>)->Apply(DefineTransposeArgs);
+
+BENCHMARK(BM_LayoutCopy<uint8_t>)->Apply(DefineLayoutArgs);
+BENCHMARK(BM_LayoutCopy<uint32_t>)->Apply(DefineLayoutArgs);
+BENCHMARK(BM_LayoutCopy<uint64_t>)->Apply(DefineLayoutArgs);
+
 BENCHMARK(BM_Copy<kNDIter>)->Apply(DefineArgs);
 BENCHMARK(BM_Copy<kUnrolled>)->Apply(DefineArgs);
 BENCHMARK(BM_Copy<kSimple>)->Apply(DefineArgs);
@@ -85,6 +85,40 @@ TEST(NDIterableCopyTest, Example) {
   EXPECT_EQ(MakeArray<int>({{1, 2, 3}, {4, 0, 0}}), dest_array);
 }
 
+// Tests copying between C-order and Fortran-order arrays, which uses a tiled
+// transposing copy.
+template <typename T>
+void TestTransposingCopy(Index outer_size, Index inner_size) {
+  auto source_array = tensorstore::AllocateArray<T>(
+      {outer_size, inner_size}, tensorstore::c_order, tensorstore::value_init);
+  for (Index i = 0; i < outer_size; ++i) {
+    for (Index j = 0; j < inner_size; ++j) {
+      source_array(i, j) = static_cast<T>(i * inner_size + j);
+    }
+  }
+  auto dest_array = tensorstore::AllocateArray<T>({outer_size, inner_size},
+                                                  tensorstore::fortran_order,
+                                                  tensorstore::value_init);
+  tensorstore::internal::Arena arena;
+  auto source_iterable =
+      GetTransformedArrayNDIterable(source_array, &arena).value();
+  auto dest_iterable =
+      GetTransformedArrayNDIterable(dest_array, &arena).value();
+  tensorstore::internal::NDIterableCopier copier(
+      *source_iterable, *dest_iterable, dest_array.shape(),
+      tensorstore::c_order, &arena);
+  TENSORSTORE_EXPECT_OK(copier.Copy());
+  EXPECT_EQ(source_array, dest_array);
+}
+
+TEST(NDIterableCopyTest, Transpose) {
+  TestTransposingCopy<uint8_t>(100, 67);
+  TestTransposingCopy<uint16_t>(100, 67);
+  TestTransposingCopy<int32_t>(100, 67);
+  TestTransposingCopy<double>(67, 100);
+  TestTransposingCopy<tensorstore::dtypes::complex128_t>(40, 50);
+}
+
 /// Copies from a transformed array with an elementwise input transform to a
 /// transformed array with an elementwise output transform.
 template <typename IntermediateElement, typename SourceArray,
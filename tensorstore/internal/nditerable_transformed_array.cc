@@ -429,7 +429,8 @@ class IterableImpl : public NDIterable::Base<IterableImpl> {
   /// Maintains ownership of the array data.
   std::shared_ptr<const void> data_owner_;
   IndexTransform<> transform_;
-  // TODO(jbms): Use arena allocator for SingleArrayIterationState as well.
+  // Note: `SingleArrayIterationState` is sized for `kMaxRank` but, as a member
+  // of this arena-allocated object, does not require a separate allocation.
   internal_index_space::SingleArrayIterationState state_;
   DataType dtype_;
   std::vector<input_dim_iter_flags::Bitmask,
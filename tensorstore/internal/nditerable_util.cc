@@ -18,23 +18,60 @@
 
 #include <algorithm>
 #include <cassert>
+#include <memory>
+#include <optional>
+#include <utility>
 
 #include "absl/base/optimization.h"
+#include "absl/container/inlined_vector.h"
+#include "absl/flags/flag.h"
 #include "absl/status/status.h"
 #include "tensorstore/contiguous_layout.h"
 #include "tensorstore/index.h"
 #include "tensorstore/internal/elementwise_function.h"
+#include "tensorstore/internal/env.h"
 #include "tensorstore/internal/integer_overflow.h"
 #include "tensorstore/internal/nditerable.h"
+#include "tensorstore/internal/os/cpu_cache_info.h"
 #include "tensorstore/rank.h"
 #include "tensorstore/util/iterate.h"
 #include "tensorstore/util/span.h"
 
+ABSL_FLAG(std::optional<size_t>, tensorstore_nditerable_block_bytes,
+          std::nullopt,
+          "Target working memory in bytes for each block of an NDIterable "
+          "iteration.  Defaults to 3/4 of the L1 data cache size. "
+          "Overrides TENSORSTORE_NDITERABLE_BLOCK_BYTES");
+
 namespace tensorstore {
 namespace internal {
 
 namespace {
 
+// Used if the L1 data cache size cannot be determined.
+constexpr size_t kFallbackL1DataCacheSize = 32 * 1024;
+
+// Bounds on the target block memory usage.  The upper bound leaves room in
+// `DefaultNDIterableArena` for the iterators themselves.
+constexpr size_t kMinNDIterationBlockBytes = 1024;
+constexpr size_t kMaxNDIterationBlockBytes = kDefaultNDIterableArenaSize / 2;
+
+Index ComputeNDIterationTargetBlockBytes() {
+  size_t target = internal::GetFlagOrEnvValue(
+                      FLAGS_tensorstore_nditerable_block_bytes,
+                      "TENSORSTORE_NDITERABLE_BLOCK_BYTES")
+                      .value_or(0);
+  if (target == 0) {
+    size_t l1_size = internal_os::GetCpuCacheInfo().l1_data_cache_bytes;
+    if (l1_size == 0) l1_size = kFallbackL1DataCacheSize;
+    // Leave part of the L1 cache for the source and destination arrays
+    // themselves, which are accessed along with the buffers.
+    target = l1_size / 4 * 3;
+  }
+  return static_cast<Index>(std::clamp(target, kMinNDIterationBlockBytes,
+                                       kMaxNDIterationBlockBytes));
+}
+
 #ifndef NDEBUG
 bool nditerable_use_unit_block_size = false;
 #endif
@@ -158,6 +195,11 @@ void GetNDIterationLayoutInfo(const NDIterableLayoutConstraint& iterable,
   GetNDIterationLayoutInfo<true>(iterable, shape, constraints, info);
 }
 
+Index GetNDIterationTargetBlockBytes() {
+  static const Index target = ComputeNDIterationTargetBlockBytes();
+  return target;
+}
+
 IterationBufferShape GetNDIterationBlockShape(
     ptrdiff_t working_memory_bytes_per_element,
     tensorstore::span<const Index> iteration_shape) {
@@ -169,18 +211,16 @@ IterationBufferShape GetNDIterationBlockShape(
     return {1, 1};
   }
 #endif
-  // TODO(jbms): maybe choose based on actual L1 cache size.
-  //
-  // Note: Choose an amount smaller than the default arena size of `32 * 1024`.
-  constexpr Index kTargetMemoryUsage = 24 * 1024;
+  const Index target_memory_usage = GetNDIterationTargetBlockBytes();
   const Index penultimate_dimension_size =
       iteration_shape[iteration_shape.size() - 2];
   const Index last_dimension_size = iteration_shape[iteration_shape.size() - 1];
   if (working_memory_bytes_per_element == 0) {
     return {penultimate_dimension_size, last_dimension_size};
   } else {
-    const Index target_size = std::max(
-        Index(8), kTargetMemoryUsage / Index(working_memory_bytes_per_element));
+    const Index target_size =
+        std::max(Index(8), target_memory_usage /
+                               Index(working_memory_bytes_per_element));
     const Index block_inner_size =
         std::max(Index(1), std::min(last_dimension_size, target_size));
     Index block_outer_size = 1;
@@ -210,6 +250,48 @@ void GetNDIterationBufferInfo(const NDIterableBufferConstraint& iterable,
       GetNDIterationBlockShape(iterable, layout, buffer_info->buffer_kind);
 }
 
+namespace {
+
+/// Maximum number of unused `DefaultNDIterableArena` buffers retained by each
+/// thread.
+constexpr size_t kMaxPooledNDIterableArenaBuffers = 2;
+
+using NDIterableArenaBufferPool =
+    absl::InlinedVector<std::unique_ptr<unsigned char[]>,
+                        kMaxPooledNDIterableArenaBuffers>;
+
+NDIterableArenaBufferPool& GetNDIterableArenaBufferPool() {
+  thread_local NDIterableArenaBufferPool pool;
+  return pool;
+}
+
+std::unique_ptr<unsigned char[]> AcquireNDIterableArenaBuffer() {
+  auto& pool = GetNDIterableArenaBufferPool();
+  if (pool.empty()) {
+    // Note: Uninitialized, since the arena never reads memory before it is
+    // written.
+    return std::unique_ptr<unsigned char[]>(
+        new unsigned char[kDefaultNDIterableArenaSize]);
+  }
+  auto buffer = std::move(pool.back());
+  pool.pop_back();
+  return buffer;
+}
+
+}  // namespace
+
+DefaultNDIterableArena::DefaultNDIterableArena()
+    : buffer_(AcquireNDIterableArenaBuffer()),
+      arena_(tensorstore::span<unsigned char>(buffer_.get(),
+                                              kDefaultNDIterableArenaSize)) {}
+
+DefaultNDIterableArena::~DefaultNDIterableArena() {
+  auto& pool = GetNDIterableArenaBufferPool();
+  if (pool.size() < kMaxPooledNDIterableArenaBuffers) {
+    pool.push_back(std::move(buffer_));
+  }
+}
+
 #ifndef NDEBUG
 void SetNDIterableTestUnitBlockSize(bool value) {
   nditerable_use_unit_block_size = value;
@@ -23,6 +23,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
@@ -143,6 +144,15 @@ struct NDIterationBufferInfo {
   IterationBufferShape block_shape;
 };
 
+/// Returns the target number of bytes of temporary buffer space for each block
+/// chosen by `GetNDIterationBlockShape`.
+///
+/// Defaults to 3/4 of the L1 data cache size of the machine, and may be
+/// overridden by the `--tensorstore_nditerable_block_bytes` flag or the
+/// `TENSORSTORE_NDITERABLE_BLOCK_BYTES` environment variable.  In either case
+/// the value is bounded to at most half of `kDefaultNDIterableArenaSize`.
+Index GetNDIterationTargetBlockBytes();
+
 /// Computes the block shape to use for iteration that is L1-cache efficient.
 ///
 /// For testing purposes, the behavior may be overridden to always return 1 by
@@ -475,11 +485,23 @@ class NDIterationPositionStepper {
   Index block_size_;
 };
 
-/// Arena with a stack-allocated buffer of 32 KiB.
+/// Size of the buffer used by `DefaultNDIterableArena`.
+constexpr size_t kDefaultNDIterableArenaSize = 128 * 1024;
+
+/// Arena with a buffer of `kDefaultNDIterableArenaSize` bytes.
+///
+/// The buffer is taken from a small per-thread pool and returned to it on
+/// destruction, such that repeated copies of small chunks on the same thread
+/// do not heap allocate their NDIterable state, while nested arenas still
+/// obtain distinct buffers.  Must be destroyed on the thread that constructed
+/// it.
 class DefaultNDIterableArena {
  public:
-  DefaultNDIterableArena()
-      : arena_(/*Workaround gcc -Wuninitialized*/ (buffer_[0] = 0, buffer_)) {}
+  DefaultNDIterableArena();
+  ~DefaultNDIterableArena();
+
+  DefaultNDIterableArena(const DefaultNDIterableArena&) = delete;
+  DefaultNDIterableArena& operator=(const DefaultNDIterableArena&) = delete;
 
   operator Arena*() { return &arena_; }
 
@@ -489,7 +511,7 @@ class DefaultNDIterableArena {
   }
 
  private:
-  unsigned char buffer_[32 * 1024];
+  std::unique_ptr<unsigned char[]> buffer_;
   tensorstore::internal::Arena arena_;
 };
 
@@ -20,12 +20,17 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "tensorstore/index.h"
+#include "tensorstore/internal/arena.h"
 #include "tensorstore/util/span.h"
 
 namespace {
 
 using ::tensorstore::Index;
+using ::tensorstore::internal::Arena;
+using ::tensorstore::internal::DefaultNDIterableArena;
+using ::tensorstore::internal::kDefaultNDIterableArenaSize;
 using ::tensorstore::internal::GetNDIterationBlockShape;
+using ::tensorstore::internal::GetNDIterationTargetBlockBytes;
 using ::tensorstore::internal::NDIterationPositionStepper;
 using ::tensorstore::internal::ResetBufferPositionAtBeginning;
 using ::tensorstore::internal::ResetBufferPositionAtEnd;
@@ -55,20 +60,35 @@ TEST(GetNDIterationBlockShape, Basic) {
                                tensorstore::span<const Index>({3, 4, 15})),
       ElementsAre(expected_block_size(4), expected_block_size(15)));
 
+  const Index target = GetNDIterationTargetBlockBytes();
+
   EXPECT_THAT(
       GetNDIterationBlockShape(/*working_memory_bytes_per_element=*/1,
                                tensorstore::span<const Index>({3, 4, 1000000})),
-      ElementsAre(1, expected_block_size(24 * 1024)));
+      ElementsAre(1, expected_block_size(target)));
 
   EXPECT_THAT(
       GetNDIterationBlockShape(/*working_memory_bytes_per_element=*/32,
                                tensorstore::span<const Index>({3, 4, 1000000})),
-      ElementsAre(1, expected_block_size(768)));
+      ElementsAre(1, expected_block_size(target / 32)));
 
   EXPECT_THAT(
       GetNDIterationBlockShape(/*working_memory_bytes_per_element=*/64,
                                tensorstore::span<const Index>({3, 4, 1000000})),
-      ElementsAre(1, expected_block_size(384)));
+      ElementsAre(1, expected_block_size(target / 64)));
+
+  // Multiple rows are used if the last dimension is small.
+  EXPECT_THAT(
+      GetNDIterationBlockShape(/*working_memory_bytes_per_element=*/8,
+                               tensorstore::span<const Index>({1000, 16})),
+      ElementsAre(expected_block_size(target / 8 / 16),
+                  expected_block_size(16)));
+}
+
+TEST(GetNDIterationTargetBlockBytesTest, Bounds) {
+  const Index target = GetNDIterationTargetBlockBytes();
+  EXPECT_GE(target, 1024);
+  EXPECT_LE(target, kDefaultNDIterableArenaSize / 2);
 }
 
 TEST(ResetBufferPositionTest, OneDimensional) {
@@ -298,4 +318,34 @@ TEST(NDIterationPositionStepperTest, Backward) {
   EXPECT_THAT(results, ElementsAreArray(expected_results));
 }
 
+TEST(DefaultNDIterableArenaTest, ReusesBuffer) {
+  unsigned char* first;
+  {
+    DefaultNDIterableArena arena;
+    Arena* a = arena;
+    first = a->allocate(16);
+    a->deallocate(first, 16);
+  }
+  {
+    DefaultNDIterableArena arena;
+    Arena* a = arena;
+    unsigned char* second = a->allocate(16);
+    EXPECT_EQ(first, second);
+    a->deallocate(second, 16);
+  }
+}
+
+TEST(DefaultNDIterableArenaTest, Nested) {
+  DefaultNDIterableArena outer_arena;
+  DefaultNDIterableArena inner_arena;
+  Arena* outer = outer_arena;
+  Arena* inner = inner_arena;
+  unsigned char* outer_ptr = outer->allocate(kDefaultNDIterableArenaSize / 2);
+  unsigned char* inner_ptr = inner->allocate(kDefaultNDIterableArenaSize / 2);
+  EXPECT_TRUE(inner_ptr + kDefaultNDIterableArenaSize / 2 <= outer_ptr ||
+              outer_ptr + kDefaultNDIterableArenaSize / 2 <= inner_ptr);
+  outer->deallocate(outer_ptr, kDefaultNDIterableArenaSize / 2);
+  inner->deallocate(inner_ptr, kDefaultNDIterableArenaSize / 2);
+}
+
 }  // namespace
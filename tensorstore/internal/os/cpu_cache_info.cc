@@ -0,0 +1,55 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/os/cpu_cache_info.h"
+
+#include <stddef.h>
+
+#include <optional>
+#include <string_view>
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/numbers.h"
+
+namespace tensorstore {
+namespace internal_os {
+
+std::optional<size_t> ParseSysfsCacheSize(std::string_view s) {
+  s = absl::StripAsciiWhitespace(s);
+  if (s.empty()) return std::nullopt;
+  size_t multiplier = 1;
+  switch (s.back()) {
+    case 'K':
+    case 'k':
+      multiplier = size_t(1) << 10;
+      break;
+    case 'M':
+    case 'm':
+      multiplier = size_t(1) << 20;
+      break;
+    case 'G':
+    case 'g':
+      multiplier = size_t(1) << 30;
+      break;
+    default:
+      break;
+  }
+  if (multiplier != 1) s.remove_suffix(1);
+  size_t value;
+  if (!absl::SimpleAtoi(s, &value)) return std::nullopt;
+  return value * multiplier;
+}
+
+}  // namespace internal_os
+}  // namespace tensorstore
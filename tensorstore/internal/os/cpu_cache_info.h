@@ -0,0 +1,51 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_OS_CPU_CACHE_INFO_H_
+#define TENSORSTORE_INTERNAL_OS_CPU_CACHE_INFO_H_
+
+#include <stddef.h>
+
+#include <optional>
+#include <string_view>
+
+namespace tensorstore {
+namespace internal_os {
+
+/// Cache sizes of the current machine.
+struct CpuCacheInfo {
+  /// Size in bytes of the per-core level 1 data cache, or `0` if unknown.
+  size_t l1_data_cache_bytes = 0;
+
+  /// Size in bytes of the level 2 cache, or `0` if unknown.
+  size_t l2_cache_bytes = 0;
+};
+
+/// Returns the cache sizes of the current machine.
+///
+/// The sizes are detected on the first call and cached.  Detection reads
+/// `/sys/devices/system/cpu/cpu0/cache` on Linux, `sysctl` on macOS, and
+/// `GetLogicalProcessorInformation` on Windows; sizes that cannot be
+/// determined are reported as `0`.
+const CpuCacheInfo& GetCpuCacheInfo();
+
+/// Parses a cache size as reported by Linux sysfs, e.g. `"48K"`.
+///
+/// Exposed for testing.
+std::optional<size_t> ParseSysfsCacheSize(std::string_view s);
+
+}  // namespace internal_os
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_OS_CPU_CACHE_INFO_H_
@@ -0,0 +1,114 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef _WIN32
+#error "Use cpu_cache_info_win.cc instead."
+#endif
+
+#include "tensorstore/internal/os/cpu_cache_info.h"
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <optional>
+#include <string>
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+
+#if defined(__APPLE__)
+#include <sys/sysctl.h>
+#include <sys/types.h>
+#endif
+
+namespace tensorstore {
+namespace internal_os {
+namespace {
+
+#if defined(__linux__)
+std::optional<std::string> ReadSysfsFile(const std::string& path) {
+  std::ifstream file(path);
+  std::string contents;
+  if (!file || !std::getline(file, contents)) return std::nullopt;
+  return std::string(absl::StripAsciiWhitespace(contents));
+}
+
+void GetSysfsCacheInfo(CpuCacheInfo& info) {
+  // Each `indexN` directory describes one cache of cpu0; the directories are
+  // contiguous starting from `index0`.
+  for (int i = 0;; ++i) {
+    const std::string dir =
+        absl::StrCat("/sys/devices/system/cpu/cpu0/cache/index", i, "/");
+    auto level = ReadSysfsFile(dir + "level");
+    if (!level) break;
+    auto type = ReadSysfsFile(dir + "type");
+    auto size_str = ReadSysfsFile(dir + "size");
+    if (!type || !size_str) continue;
+    auto size = ParseSysfsCacheSize(*size_str);
+    if (!size) continue;
+    if (*level == "1" && (*type == "Data" || *type == "Unified")) {
+      info.l1_data_cache_bytes = *size;
+    } else if (*level == "2" && *type != "Instruction") {
+      info.l2_cache_bytes = *size;
+    }
+  }
+}
+#endif  // defined(__linux__)
+
+#if defined(__APPLE__)
+size_t GetSysctlSize(const char* name) {
+  int64_t value = 0;
+  size_t size = sizeof(value);
+  if (::sysctlbyname(name, &value, &size, nullptr, 0) != 0 || value < 0) {
+    return 0;
+  }
+  return static_cast<size_t>(value);
+}
+#endif  // defined(__APPLE__)
+
+CpuCacheInfo DetectCpuCacheInfo() {
+  CpuCacheInfo info;
+#if defined(__linux__)
+  GetSysfsCacheInfo(info);
+#if defined(_SC_LEVEL1_DCACHE_SIZE) && defined(_SC_LEVEL2_CACHE_SIZE)
+  // Fall back to glibc, which queries cpuid on x86.
+  if (info.l1_data_cache_bytes == 0) {
+    long size = ::sysconf(_SC_LEVEL1_DCACHE_SIZE);
+    if (size > 0) info.l1_data_cache_bytes = size;
+  }
+  if (info.l2_cache_bytes == 0) {
+    long size = ::sysconf(_SC_LEVEL2_CACHE_SIZE);
+    if (size > 0) info.l2_cache_bytes = size;
+  }
+#endif
+#elif defined(__APPLE__)
+  info.l1_data_cache_bytes = GetSysctlSize("hw.l1dcachesize");
+  info.l2_cache_bytes = GetSysctlSize("hw.l2cachesize");
+#endif
+  return info;
+}
+
+}  // namespace
+
+const CpuCacheInfo& GetCpuCacheInfo() {
+  static const CpuCacheInfo info = DetectCpuCacheInfo();
+  return info;
+}
+
+}  // namespace internal_os
+}  // namespace tensorstore
@@ -0,0 +1,46 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/os/cpu_cache_info.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+using ::tensorstore::internal_os::GetCpuCacheInfo;
+using ::tensorstore::internal_os::ParseSysfsCacheSize;
+using ::testing::Optional;
+
+TEST(ParseSysfsCacheSizeTest, Basic) {
+  EXPECT_THAT(ParseSysfsCacheSize("48K"), Optional(48 * 1024));
+  EXPECT_THAT(ParseSysfsCacheSize("2048K\n"), Optional(2048 * 1024));
+  EXPECT_THAT(ParseSysfsCacheSize("1M"), Optional(1024 * 1024));
+  EXPECT_THAT(ParseSysfsCacheSize("512"), Optional(512));
+  EXPECT_EQ(std::nullopt, ParseSysfsCacheSize(""));
+  EXPECT_EQ(std::nullopt, ParseSysfsCacheSize("K"));
+  EXPECT_EQ(std::nullopt, ParseSysfsCacheSize("abc"));
+}
+
+TEST(GetCpuCacheInfoTest, Basic) {
+  const auto& info = GetCpuCacheInfo();
+  // Detection may fail in sandboxed environments; when it succeeds the sizes
+  // are ordered.
+  if (info.l1_data_cache_bytes != 0 && info.l2_cache_bytes != 0) {
+    EXPECT_LE(info.l1_data_cache_bytes, info.l2_cache_bytes);
+  }
+  EXPECT_EQ(&info, &GetCpuCacheInfo());
+}
+
+}  // namespace
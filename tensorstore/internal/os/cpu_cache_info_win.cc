@@ -0,0 +1,66 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _WIN32
+#error "Use cpu_cache_info_posix.cc instead."
+#endif
+
+#include "tensorstore/internal/os/cpu_cache_info.h"
+//
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "tensorstore/internal/os/include_windows.h"
+
+namespace tensorstore {
+namespace internal_os {
+namespace {
+
+CpuCacheInfo DetectCpuCacheInfo() {
+  CpuCacheInfo info;
+  DWORD length = 0;
+  if (::GetLogicalProcessorInformation(nullptr, &length) ||
+      ::GetLastError() != ERROR_INSUFFICIENT_BUFFER) {
+    return info;
+  }
+  std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> buffer(
+      length / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+  if (!::GetLogicalProcessorInformation(buffer.data(), &length)) {
+    return info;
+  }
+  buffer.resize(length / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+  for (const auto& entry : buffer) {
+    if (entry.Relationship != RelationCache) continue;
+    const CACHE_DESCRIPTOR& cache = entry.Cache;
+    if (cache.Type == CacheInstruction) continue;
+    if (cache.Level == 1) {
+      info.l1_data_cache_bytes = cache.Size;
+    } else if (cache.Level == 2) {
+      info.l2_cache_bytes = cache.Size;
+    }
+  }
+  return info;
+}
+
+}  // namespace
+
+const CpuCacheInfo& GetCpuCacheInfo() {
+  static const CpuCacheInfo info = DetectCpuCacheInfo();
+  return info;
+}
+
+}  // namespace internal_os
+}  // namespace tensorstore
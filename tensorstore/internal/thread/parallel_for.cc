@@ -0,0 +1,83 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/thread/parallel_for.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/function_ref.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/util/executor.h"
+
+namespace tensorstore {
+namespace internal {
+namespace {
+
+// State shared between the calling thread and the helper tasks.  Helper tasks
+// may start running after `ParallelFor` has returned, in which case they find
+// no remaining work and never access `func`.
+struct ParallelForState {
+  ParallelForState(size_t n, absl::FunctionRef<void(size_t)> func)
+      : n(n), func(func), remaining(n) {}
+
+  void Run() {
+    size_t completed = 0;
+    while (true) {
+      size_t i = next.fetch_add(1, std::memory_order_relaxed);
+      if (i >= n) break;
+      func(i);
+      ++completed;
+    }
+    if (completed == 0) return;
+    absl::MutexLock lock(&mutex);
+    remaining -= completed;
+  }
+
+  void Wait() {
+    absl::MutexLock lock(&mutex);
+    mutex.Await(absl::Condition(
+        +[](size_t* remaining) { return *remaining == 0; }, &remaining));
+  }
+
+  const size_t n;
+  const absl::FunctionRef<void(size_t)> func;
+  std::atomic<size_t> next{0};
+  absl::Mutex mutex;
+  size_t remaining ABSL_GUARDED_BY(mutex);
+};
+
+}  // namespace
+
+void ParallelFor(const Executor& executor, size_t max_parallelism, size_t n,
+                 absl::FunctionRef<void(size_t)> func) {
+  const size_t num_helpers = std::min(max_parallelism, n);
+  if (!executor || num_helpers <= 1) {
+    for (size_t i = 0; i < n; ++i) func(i);
+    return;
+  }
+  auto state = std::make_shared<ParallelForState>(n, func);
+  for (size_t i = 1; i < num_helpers; ++i) {
+    executor([state] { state->Run(); });
+  }
+  state->Run();
+  state->Wait();
+}
+
+}  // namespace internal
+}  // namespace tensorstore
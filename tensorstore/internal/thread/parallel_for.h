@@ -0,0 +1,43 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_THREAD_PARALLEL_FOR_H_
+#define TENSORSTORE_INTERNAL_THREAD_PARALLEL_FOR_H_
+
+#include <stddef.h>
+
+#include "absl/functional/function_ref.h"
+#include "tensorstore/util/executor.h"
+
+namespace tensorstore {
+namespace internal {
+
+/// Invokes `func(i)` for each `i` in `[0, n)`, using up to `max_parallelism`
+/// threads, and returns once all invocations have completed.
+///
+/// The calling thread participates in the work, and up to
+/// `max_parallelism - 1` additional tasks are submitted to `executor`.  Since
+/// work is claimed dynamically, this never deadlocks even if none of the
+/// submitted tasks start running before the calling thread finishes, which
+/// makes it safe to call from a task already running on `executor`.
+///
+/// If `executor` is null or `max_parallelism <= 1`, all invocations happen
+/// sequentially on the calling thread.
+void ParallelFor(const Executor& executor, size_t max_parallelism, size_t n,
+                 absl::FunctionRef<void(size_t)> func);
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_THREAD_PARALLEL_FOR_H_
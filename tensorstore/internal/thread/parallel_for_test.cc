@@ -0,0 +1,69 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/thread/parallel_for.h"
+
+#include <stddef.h>
+
+#include <atomic>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/functional/any_invocable.h"
+#include "tensorstore/internal/thread/thread_pool.h"
+#include "tensorstore/util/executor.h"
+
+namespace {
+
+using ::tensorstore::Executor;
+using ::tensorstore::InlineExecutor;
+using ::tensorstore::internal::ParallelFor;
+
+TEST(ParallelForTest, Sequential) {
+  std::vector<size_t> order;
+  ParallelFor(Executor{}, 4, 5, [&](size_t i) { order.push_back(i); });
+  EXPECT_THAT(order, ::testing::ElementsAre(0, 1, 2, 3, 4));
+}
+
+TEST(ParallelForTest, InlineExecutor) {
+  std::vector<size_t> counts(100);
+  ParallelFor(InlineExecutor{}, 8, counts.size(),
+              [&](size_t i) { ++counts[i]; });
+  EXPECT_THAT(counts, ::testing::Each(1));
+}
+
+TEST(ParallelForTest, ThreadPool) {
+  auto executor = tensorstore::internal::DetachedThreadPool(4);
+  std::vector<std::atomic<int>> counts(1000);
+  ParallelFor(executor, 4, counts.size(), [&](size_t i) { ++counts[i]; });
+  for (auto& count : counts) EXPECT_EQ(1, count.load());
+}
+
+TEST(ParallelForTest, TasksNeverRun) {
+  // Tasks submitted to the executor are only run after `ParallelFor` returns;
+  // the calling thread must complete all of the work itself.
+  std::vector<absl::AnyInvocable<void() &&>> deferred;
+  Executor executor = [&](absl::AnyInvocable<void() &&> task) {
+    deferred.push_back(std::move(task));
+  };
+  std::vector<size_t> counts(10);
+  ParallelFor(executor, 4, counts.size(), [&](size_t i) { ++counts[i]; });
+  EXPECT_THAT(counts, ::testing::Each(1));
+  EXPECT_EQ(3, deferred.size());
+  for (auto& task : deferred) std::move(task)();
+  EXPECT_THAT(counts, ::testing::Each(1));
+}
+
+}  // namespace
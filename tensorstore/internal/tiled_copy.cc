@@ -0,0 +1,219 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/tiled_copy.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "tensorstore/data_type.h"
+#include "tensorstore/index.h"
+#include "tensorstore/internal/elementwise_function.h"
+
+namespace tensorstore {
+namespace internal {
+namespace {
+
+// Strides larger than this along the inner dimension access a separate cache
+// line for each element.
+constexpr Index kCacheLineBytes = 64;
+
+// Extent of the square tiles, in elements.  A tile of the largest supported
+// trivial element type occupies 8 KiB in each of the source and target.
+constexpr Index kTileSize = 32;
+
+// Extent of the square sub-tiles transposed through a local buffer by
+// `CopyTile`.
+constexpr Index kMicroTileSize = 8;
+
+template <typename T>
+inline T Load(const char* p) {
+  T value;
+  // Elements of e.g. `complex64` are only aligned to 4 bytes.
+  memcpy(&value, p, sizeof(T));
+  return value;
+}
+
+template <typename T>
+inline void Store(char* p, T value) {
+  memcpy(p, &value, sizeof(T));
+}
+
+// Copies a tile of trivial elements of size `sizeof(T)`.
+//
+// Full `kMicroTileSize x kMicroTileSize` sub-tiles are read along the inner
+// dimension of the source into a local buffer, which the compiler keeps in
+// vector registers, and written along the outer dimension of the target,
+// such that each pass accesses consecutive elements when the source is
+// contiguous along the inner dimension and the target along the outer
+// dimension.
+template <typename T>
+void CopyTile(Index outer_size, Index inner_size, const char* source,
+              Index source_outer_stride, Index source_inner_stride,
+              char* target, Index target_outer_stride,
+              Index target_inner_stride) {
+  Index outer_i = 0;
+  for (; outer_i + kMicroTileSize <= outer_size; outer_i += kMicroTileSize) {
+    Index inner_i = 0;
+    for (; inner_i + kMicroTileSize <= inner_size;
+         inner_i += kMicroTileSize) {
+      T buffer[kMicroTileSize][kMicroTileSize];
+      const char* s = source + outer_i * source_outer_stride +
+                      inner_i * source_inner_stride;
+      for (Index i = 0; i < kMicroTileSize; ++i) {
+        for (Index j = 0; j < kMicroTileSize; ++j) {
+          buffer[j][i] = Load<T>(s + i * source_outer_stride +
+                                 j * source_inner_stride);
+        }
+      }
+      char* t = target + outer_i * target_outer_stride +
+                inner_i * target_inner_stride;
+      for (Index j = 0; j < kMicroTileSize; ++j) {
+        for (Index i = 0; i < kMicroTileSize; ++i) {
+          Store<T>(t + j * target_inner_stride + i * target_outer_stride,
+                   buffer[j][i]);
+        }
+      }
+    }
+    // Remaining columns.
+    for (Index i = outer_i; i < outer_i + kMicroTileSize; ++i) {
+      for (Index j = inner_i; j < inner_size; ++j) {
+        Store<T>(target + i * target_outer_stride + j * target_inner_stride,
+                 Load<T>(source + i * source_outer_stride +
+                         j * source_inner_stride));
+      }
+    }
+  }
+  // Remaining rows.
+  for (Index i = outer_i; i < outer_size; ++i) {
+    for (Index j = 0; j < inner_size; ++j) {
+      Store<T>(target + i * target_outer_stride + j * target_inner_stride,
+               Load<T>(source + i * source_outer_stride +
+                       j * source_inner_stride));
+    }
+  }
+}
+
+template <typename T>
+void TiledCopyTrivial(IterationBufferShape shape,
+                      IterationBufferPointer source,
+                      IterationBufferPointer target) {
+  const char* source_base = static_cast<const char*>(source.pointer.get());
+  char* target_base = static_cast<char*>(target.pointer.get());
+  for (Index outer_i = 0; outer_i < shape[0]; outer_i += kTileSize) {
+    const Index outer_size = std::min(kTileSize, shape[0] - outer_i);
+    for (Index inner_i = 0; inner_i < shape[1]; inner_i += kTileSize) {
+      const Index inner_size = std::min(kTileSize, shape[1] - inner_i);
+      CopyTile<T>(outer_size, inner_size,
+                  source_base + outer_i * source.outer_byte_stride +
+                      inner_i * source.inner_byte_stride,
+                  source.outer_byte_stride, source.inner_byte_stride,
+                  target_base + outer_i * target.outer_byte_stride +
+                      inner_i * target.inner_byte_stride,
+                  target.outer_byte_stride, target.inner_byte_stride);
+    }
+  }
+}
+
+}  // namespace
+
+ptrdiff_t GetTiledCopyTrivialElementSize(DataType dtype) {
+  switch (dtype.id()) {
+    case DataTypeId::custom:
+    case DataTypeId::string_t:
+    case DataTypeId::ustring_t:
+    case DataTypeId::json_t:
+      return 0;
+    default:
+      break;
+  }
+  switch (dtype.size()) {
+    case 1:
+    case 2:
+    case 4:
+    case 8:
+      return dtype.size();
+    default:
+      return 0;
+  }
+}
+
+bool IsTransposingStridedCopy(ptrdiff_t element_size,
+                              IterationBufferShape shape,
+                              IterationBufferPointer source,
+                              IterationBufferPointer target) {
+  if (shape[0] < kMicroTileSize || shape[1] < kMicroTileSize) return false;
+  const Index source_inner = std::abs(source.inner_byte_stride);
+  const Index target_inner = std::abs(target.inner_byte_stride);
+  const auto is_local = [&](Index inner_stride, Index outer_stride) {
+    return inner_stride <= element_size ||
+           (inner_stride <= kCacheLineBytes &&
+            inner_stride <= std::abs(outer_stride));
+  };
+  const bool source_local = is_local(source_inner, source.outer_byte_stride);
+  const bool target_local = is_local(target_inner, target.outer_byte_stride);
+  if (source_local == target_local) return false;
+  // The non-local buffer must be accessed more locally along the outer
+  // dimension; otherwise, tiling does not reduce the number of cache lines
+  // accessed.
+  return source_local
+             ? std::abs(target.outer_byte_stride) < target_inner
+             : std::abs(source.outer_byte_stride) < source_inner;
+}
+
+bool TiledCopy(SpecializedElementwiseFunctionPointer<2, void*> copy_function,
+               ptrdiff_t trivial_element_size, IterationBufferShape shape,
+               IterationBufferPointer source, IterationBufferPointer target,
+               void* status) {
+  switch (trivial_element_size) {
+    case 1:
+      TiledCopyTrivial<uint8_t>(shape, source, target);
+      return true;
+    case 2:
+      TiledCopyTrivial<uint16_t>(shape, source, target);
+      return true;
+    case 4:
+      TiledCopyTrivial<uint32_t>(shape, source, target);
+      return true;
+    case 8:
+      TiledCopyTrivial<uint64_t>(shape, source, target);
+      return true;
+    default:
+      break;
+  }
+  for (Index outer_i = 0; outer_i < shape[0]; outer_i += kTileSize) {
+    const Index outer_size = std::min(kTileSize, shape[0] - outer_i);
+    for (Index inner_i = 0; inner_i < shape[1]; inner_i += kTileSize) {
+      const Index inner_size = std::min(kTileSize, shape[1] - inner_i);
+      IterationBufferPointer source_tile = source;
+      IterationBufferPointer target_tile = target;
+      source_tile.AddElementOffset(IterationBufferKind::kStrided, outer_i,
+                                   inner_i);
+      target_tile.AddElementOffset(IterationBufferKind::kStrided, outer_i,
+                                   inner_i);
+      if (!copy_function(nullptr, {outer_size, inner_size}, source_tile,
+                         target_tile, status)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace internal
+}  // namespace tensorstore
@@ -0,0 +1,75 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_TILED_COPY_H_
+#define TENSORSTORE_INTERNAL_TILED_COPY_H_
+
+/// \file
+///
+/// Cache-blocked copying of 2-d strided buffers whose layouts differ, as when
+/// copying between C-order and Fortran-order arrays.
+
+#include <stddef.h>
+
+#include "tensorstore/data_type.h"
+#include "tensorstore/index.h"
+#include "tensorstore/internal/elementwise_function.h"
+
+namespace tensorstore {
+namespace internal {
+
+/// Returns the element size of `dtype` if it may be copied by `TiledCopy`
+/// without calling its copy assignment function, or `0` otherwise.
+///
+/// Non-zero only for trivially-copyable data types with a size of 1, 2, 4 or
+/// 8 bytes.
+ptrdiff_t GetTiledCopyTrivialElementSize(DataType dtype);
+
+/// Returns `true` if copying a `kStrided` block from `source` to `target` is a
+/// transposing copy that benefits from `TiledCopy`.
+///
+/// This is the case if one of the buffers is accessed with a stride larger
+/// than a cache line along the inner dimension, while the other is not.
+///
+/// \param element_size The element size in bytes.
+/// \param shape The block shape.
+/// \param source The source buffer, of kind `kStrided`.
+/// \param target The target buffer, of kind `kStrided`.
+bool IsTransposingStridedCopy(ptrdiff_t element_size,
+                              IterationBufferShape shape,
+                              IterationBufferPointer source,
+                              IterationBufferPointer target);
+
+/// Copies a `kStrided` block from `source` to `target` in square tiles, such
+/// that the cache lines of both buffers are reused across a tile.
+///
+/// \param copy_function The `kStrided` copy function of the data type, used to
+///     copy each tile if `trivial_element_size == 0`.
+/// \param trivial_element_size The result of
+///     `GetTiledCopyTrivialElementSize`.  If non-zero, tiles are copied by a
+///     transpose kernel specialized for the element size instead.
+/// \param shape The block shape.
+/// \param source The source buffer, of kind `kStrided`.
+/// \param target The target buffer, of kind `kStrided`.
+/// \param status Passed to `copy_function`.
+/// \returns `true` on success, or the result of `copy_function` on failure.
+bool TiledCopy(SpecializedElementwiseFunctionPointer<2, void*> copy_function,
+               ptrdiff_t trivial_element_size, IterationBufferShape shape,
+               IterationBufferPointer source, IterationBufferPointer target,
+               void* status);
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_TILED_COPY_H_
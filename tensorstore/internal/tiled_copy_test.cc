@@ -0,0 +1,123 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/tiled_copy.h"
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "tensorstore/data_type.h"
+#include "tensorstore/index.h"
+#include "tensorstore/internal/elementwise_function.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace {
+
+using ::tensorstore::dtype_v;
+using ::tensorstore::Index;
+using ::tensorstore::internal::GetTiledCopyTrivialElementSize;
+using ::tensorstore::internal::IsTransposingStridedCopy;
+using ::tensorstore::internal::IterationBufferKind;
+using ::tensorstore::internal::IterationBufferPointer;
+using ::tensorstore::internal::TiledCopy;
+
+TEST(GetTiledCopyTrivialElementSizeTest, Basic) {
+  EXPECT_EQ(1, GetTiledCopyTrivialElementSize(dtype_v<uint8_t>));
+  EXPECT_EQ(1, GetTiledCopyTrivialElementSize(dtype_v<bool>));
+  EXPECT_EQ(2, GetTiledCopyTrivialElementSize(dtype_v<int16_t>));
+  EXPECT_EQ(4, GetTiledCopyTrivialElementSize(dtype_v<float>));
+  EXPECT_EQ(8, GetTiledCopyTrivialElementSize(dtype_v<double>));
+  EXPECT_EQ(8, GetTiledCopyTrivialElementSize(
+                   dtype_v<tensorstore::dtypes::complex64_t>));
+  EXPECT_EQ(0, GetTiledCopyTrivialElementSize(
+                   dtype_v<tensorstore::dtypes::complex128_t>));
+  EXPECT_EQ(0, GetTiledCopyTrivialElementSize(dtype_v<std::string>));
+}
+
+TEST(IsTransposingStridedCopyTest, Basic) {
+  char data[1];
+  const auto pointer = [&](Index outer_byte_stride, Index inner_byte_stride) {
+    return IterationBufferPointer(&data[0], outer_byte_stride,
+                                  inner_byte_stride);
+  };
+  // C order to Fortran order.
+  EXPECT_TRUE(IsTransposingStridedCopy(4, {100, 200}, pointer(800, 4),
+                                       pointer(4, 400)));
+  EXPECT_TRUE(IsTransposingStridedCopy(4, {100, 200}, pointer(4, 400),
+                                       pointer(800, 4)));
+  // Same layout.
+  EXPECT_FALSE(IsTransposingStridedCopy(4, {100, 200}, pointer(800, 4),
+                                        pointer(800, 4)));
+  // Both strided along both dimensions.
+  EXPECT_FALSE(IsTransposingStridedCopy(4, {100, 200}, pointer(800, 4),
+                                        pointer(8000, 400)));
+  // Too small to tile.
+  EXPECT_FALSE(IsTransposingStridedCopy(4, {100, 2}, pointer(8, 4),
+                                        pointer(4, 400)));
+}
+
+// Copies a C-order `outer_size x inner_size` array to a Fortran-order array
+// using `TiledCopy` and checks the result.
+template <typename T>
+void TestTranspose(Index outer_size, Index inner_size,
+                   ptrdiff_t trivial_element_size) {
+  SCOPED_TRACE(tensorstore::StrCat("outer_size=", outer_size,
+                                   ", inner_size=", inner_size,
+                                   ", trivial_element_size=",
+                                   trivial_element_size));
+  std::vector<T> source(outer_size * inner_size);
+  for (Index i = 0; i < source.size(); ++i) source[i] = static_cast<T>(i);
+  std::vector<T> target(outer_size * inner_size);
+  const Index size = sizeof(T);
+  IterationBufferPointer source_pointer(source.data(), inner_size * size,
+                                        size);
+  IterationBufferPointer target_pointer(target.data(), size,
+                                        outer_size * size);
+  EXPECT_TRUE(TiledCopy(
+      dtype_v<T>->copy_assign[IterationBufferKind::kStrided],
+      trivial_element_size, {outer_size, inner_size}, source_pointer,
+      target_pointer, nullptr));
+  for (Index i = 0; i < outer_size; ++i) {
+    for (Index j = 0; j < inner_size; ++j) {
+      ASSERT_EQ(source[i * inner_size + j], target[j * outer_size + i])
+          << "i=" << i << ", j=" << j;
+    }
+  }
+}
+
+TEST(TiledCopyTest, Trivial) {
+  for (Index outer_size : {1, 7, 8, 33, 70}) {
+    for (Index inner_size : {1, 9, 32, 65}) {
+      TestTranspose<uint8_t>(outer_size, inner_size, 1);
+      TestTranspose<uint16_t>(outer_size, inner_size, 2);
+      TestTranspose<uint32_t>(outer_size, inner_size, 4);
+      TestTranspose<uint64_t>(outer_size, inner_size, 8);
+    }
+  }
+}
+
+TEST(TiledCopyTest, CopyFunction) {
+  for (Index outer_size : {1, 33, 70}) {
+    for (Index inner_size : {1, 9, 65}) {
+      TestTranspose<uint32_t>(outer_size, inner_size, 0);
+      TestTranspose<double>(outer_size, inner_size, 0);
+    }
+  }
+}
+
+}  // namespace
@@ -0,0 +1,219 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+///
+/// Key-value store adapter that coalesces concurrent reads of nearby byte
+/// ranges of the same key into fewer reads of the base kvstore.
+
+#include <stddef.h>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/time/time.h"
+#include "tensorstore/context.h"
+#include "tensorstore/internal/data_copy_concurrency_resource.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/kvstore/driver.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/key_range.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/ocdbt/io/coalesce_kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/kvstore/registry.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/kvstore/supported_features.h"
+#include "tensorstore/transaction.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/garbage_collection/garbage_collection.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/str_cat.h"
+
+/// specializations
+#include "tensorstore/internal/cache_key/absl_time.h"  // IWYU pragma: keep
+#include "tensorstore/internal/json_binding/absl_time.h"  // IWYU pragma: keep
+#include "tensorstore/serialization/absl_time.h"  // IWYU pragma: keep
+
+namespace tensorstore {
+namespace {
+
+namespace jb = tensorstore::internal_json_binding;
+
+using ::tensorstore::internal_ocdbt::CoalesceKvStoreOptions;
+using ::tensorstore::internal_ocdbt::MakeCoalesceKvStoreDriver;
+
+struct CoalesceKvStoreSpecData {
+  kvstore::Spec base;
+  size_t threshold_bytes = 0;
+  size_t merged_bytes = 0;
+  absl::Duration interval = absl::ZeroDuration();
+  bool adaptive = true;
+  Context::Resource<internal::DataCopyConcurrencyResource>
+      data_copy_concurrency;
+
+  constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+    return f(x.base, x.threshold_bytes, x.merged_bytes, x.interval,
+             x.adaptive, x.data_copy_concurrency);
+  };
+
+  constexpr static auto default_json_binder = jb::Object(
+      jb::Member("base", jb::Projection<&CoalesceKvStoreSpecData::base>()),
+      jb::Member("threshold_bytes",
+                 jb::Projection<&CoalesceKvStoreSpecData::threshold_bytes>(
+                     jb::DefaultInitializedValue())),
+      jb::Member("merged_bytes",
+                 jb::Projection<&CoalesceKvStoreSpecData::merged_bytes>(
+                     jb::DefaultInitializedValue())),
+      jb::Member("interval",
+                 jb::Projection<&CoalesceKvStoreSpecData::interval>(
+                     jb::DefaultInitializedValue())),
+      jb::Member("adaptive",
+                 jb::Projection<&CoalesceKvStoreSpecData::adaptive>(
+                     jb::DefaultValue([](auto* v) { *v = true; }))),
+      jb::Member(
+          internal::DataCopyConcurrencyResource::id,
+          jb::Projection<&CoalesceKvStoreSpecData::data_copy_concurrency>()));
+};
+
+class CoalesceKvStoreSpec
+    : public internal_kvstore::RegisteredDriverSpec<CoalesceKvStoreSpec,
+                                                    CoalesceKvStoreSpecData> {
+ public:
+  static constexpr char id[] = "coalesce";
+
+  Future<kvstore::DriverPtr> DoOpen() const override;
+
+  absl::Status ApplyOptions(kvstore::DriverSpecOptions&& options) override {
+    return data_.base.driver.Set(std::move(options));
+  }
+
+  Result<kvstore::Spec> GetBase(std::string_view path) const override {
+    return data_.base;
+  }
+};
+
+/// Defines the "coalesce" key value store.
+///
+/// Reads are forwarded to `coalesced_`, which merges concurrent reads of the
+/// same key.  All other operations are forwarded directly to `base_`.
+class CoalesceKvStore
+    : public internal_kvstore::RegisteredDriver<CoalesceKvStore,
+                                                CoalesceKvStoreSpec> {
+ public:
+  Future<ReadResult> Read(Key key, ReadOptions options) override {
+    return coalesced_->Read(GetBaseKey(key), std::move(options));
+  }
+
+  Future<TimestampedStorageGeneration> Write(Key key,
+                                             std::optional<Value> value,
+                                             WriteOptions options) override {
+    return base_.driver->Write(GetBaseKey(key), std::move(value),
+                               std::move(options));
+  }
+
+  absl::Status ReadModifyWrite(internal::OpenTransactionPtr& transaction,
+                               size_t& phase, Key key,
+                               ReadModifyWriteSource& source) override {
+    return base_.driver->ReadModifyWrite(transaction, phase, GetBaseKey(key),
+                                         source);
+  }
+
+  absl::Status TransactionalDeleteRange(
+      const internal::OpenTransactionPtr& transaction,
+      KeyRange range) override {
+    return base_.driver->TransactionalDeleteRange(
+        transaction, KeyRange::AddPrefix(base_.path, std::move(range)));
+  }
+
+  Future<const void> DeleteRange(KeyRange range) override {
+    return base_.driver->DeleteRange(
+        KeyRange::AddPrefix(base_.path, std::move(range)));
+  }
+
+  void ListImpl(ListOptions options, ListReceiver receiver) override {
+    options.range = KeyRange::AddPrefix(base_.path, std::move(options.range));
+    options.strip_prefix_length += base_.path.size();
+    base_.driver->ListImpl(std::move(options), std::move(receiver));
+  }
+
+  std::string DescribeKey(std::string_view key) override {
+    return base_.driver->DescribeKey(GetBaseKey(key));
+  }
+
+  absl::Status GetBoundSpecData(CoalesceKvStoreSpecData& spec) const {
+    spec = spec_data_;
+    return absl::OkStatus();
+  }
+
+  kvstore::SupportedFeatures GetSupportedFeatures(
+      const KeyRange& key_range) const final {
+    return base_.driver->GetSupportedFeatures(
+        KeyRange::AddPrefix(base_.path, key_range));
+  }
+
+  Result<KvStore> GetBase(std::string_view path,
+                          const Transaction& transaction) const override {
+    return KvStore(base_.driver, GetBaseKey(path), transaction);
+  }
+
+  std::string GetBaseKey(std::string_view key) const {
+    return tensorstore::StrCat(base_.path, key);
+  }
+
+  CoalesceKvStoreSpecData spec_data_;
+  kvstore::KvStore base_;
+  kvstore::DriverPtr coalesced_;
+};
+
+Future<kvstore::DriverPtr> CoalesceKvStoreSpec::DoOpen() const {
+  return MapFutureValue(
+      InlineExecutor{},
+      [spec = internal::IntrusivePtr<const CoalesceKvStoreSpec>(this)](
+          kvstore::KvStore& base_kvstore) mutable
+      -> Result<kvstore::DriverPtr> {
+        auto driver = internal::MakeIntrusivePtr<CoalesceKvStore>();
+        driver->spec_data_ = spec->data_;
+        driver->base_ = std::move(base_kvstore);
+        CoalesceKvStoreOptions options;
+        options.threshold = spec->data_.threshold_bytes;
+        options.merged_threshold = spec->data_.merged_bytes;
+        options.interval = spec->data_.interval;
+        options.adaptive = spec->data_.adaptive;
+        driver->coalesced_ = MakeCoalesceKvStoreDriver(
+            driver->base_.driver, options,
+            spec->data_.data_copy_concurrency->executor);
+        return driver;
+      },
+      kvstore::Open(data_.base));
+}
+
+}  // namespace
+}  // namespace tensorstore
+
+TENSORSTORE_DECLARE_GARBAGE_COLLECTION_NOT_REQUIRED(
+    tensorstore::CoalesceKvStore)
+
+// Registers the driver.
+namespace {
+const tensorstore::internal_kvstore::DriverRegistration<
+    tensorstore::CoalesceKvStoreSpec>
+    registration;
+
+}  // namespace
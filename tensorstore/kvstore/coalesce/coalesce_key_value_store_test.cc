@@ -0,0 +1,124 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/cord.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/internal/global_initializer.h"
+#include "tensorstore/internal/testing/json_gtest.h"
+#include "tensorstore/json_serialization_options_base.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/mock_kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/kvstore/test_matchers.h"
+#include "tensorstore/kvstore/test_util.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+namespace kvstore = ::tensorstore::kvstore;
+
+using ::tensorstore::Context;
+using ::tensorstore::MatchesJson;
+using ::tensorstore::OptionalByteRangeRequest;
+using ::tensorstore::internal::KeyValueStoreOpsTestParameters;
+using ::tensorstore::internal::MatchesKvsReadResult;
+using ::tensorstore::internal::MockKeyValueStore;
+using ::tensorstore::internal::MockKeyValueStoreResource;
+
+TENSORSTORE_GLOBAL_INITIALIZER {
+  KeyValueStoreOpsTestParameters params;
+  params.test_name = "Basic";
+  params.get_store = [](auto callback) {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto store,
+        kvstore::Open({{"driver", "coalesce"},
+                       {"base", {{"driver", "memory"}, {"path", "prefix/"}}}})
+            .result());
+    callback(store);
+  };
+  RegisterKeyValueStoreOpsTests(params);
+}
+
+TEST(CoalesceKvStoreTest, SpecRoundtrip) {
+  ::nlohmann::json json_spec{
+      {"driver", "coalesce"},
+      {"base", {{"driver", "memory"}, {"path", "prefix/"}}},
+      {"threshold_bytes", 1024},
+      {"merged_bytes", 4096},
+      {"interval", "10ms"},
+      {"adaptive", false},
+      {"path", "a/"},
+  };
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store,
+                                   kvstore::Open(json_spec).result());
+  EXPECT_THAT(store.spec().value().ToJson(tensorstore::IncludeDefaults{false}),
+              ::testing::Optional(MatchesJson(json_spec)));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto base, store.base());
+  EXPECT_EQ("prefix/a/", base.path);
+}
+
+TEST(CoalesceKvStoreTest, CoalescesReads) {
+  auto context = Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto mock_key_value_store_resource,
+      context.GetResource<MockKeyValueStoreResource>());
+  MockKeyValueStore* mock_store = mock_key_value_store_resource->get();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto memory_store, kvstore::Open({{"driver", "memory"}}).result());
+  TENSORSTORE_ASSERT_OK(
+      kvstore::Write(memory_store, "p/a", absl::Cord("0123456789")));
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", "coalesce"},
+                     {"base",
+                      {{"driver", "mock_key_value_store"}, {"path", "p/"}}},
+                     {"threshold_bytes", 2},
+                     {"adaptive", false}},
+                    context)
+          .result());
+
+  kvstore::ReadOptions options1, options2, options3;
+  options1.byte_range = OptionalByteRangeRequest(0, 1);
+  options2.byte_range = OptionalByteRangeRequest(2, 3);
+  options3.byte_range = OptionalByteRangeRequest(4, 6);
+  auto future1 = kvstore::Read(store, "a", options1);
+  auto future2 = kvstore::Read(store, "a", options2);
+  auto future3 = kvstore::Read(store, "a", options3);
+
+  // The first read is issued immediately; the remaining reads are merged once
+  // it completes.
+  {
+    auto req = mock_store->read_requests.pop();
+    EXPECT_EQ("p/a", req.key);
+    EXPECT_EQ(OptionalByteRangeRequest(0, 1), req.options.byte_range);
+    req(memory_store.driver);
+  }
+  {
+    auto req = mock_store->read_requests.pop();
+    EXPECT_EQ("p/a", req.key);
+    EXPECT_EQ(OptionalByteRangeRequest(2, 6), req.options.byte_range);
+    req(memory_store.driver);
+  }
+  EXPECT_THAT(future1.result(), MatchesKvsReadResult(absl::Cord("0")));
+  EXPECT_THAT(future2.result(), MatchesKvsReadResult(absl::Cord("2")));
+  EXPECT_THAT(future3.result(), MatchesKvsReadResult(absl::Cord("45")));
+}
+
+}  // namespace
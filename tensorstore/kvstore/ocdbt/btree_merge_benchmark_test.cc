@@ -0,0 +1,113 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// This benchmarks point reads from an OCDBT database after heavy delete churn.
+//
+// BM_ReadAfterDeleteChurn/<num_rounds>
+//
+// num_rounds:
+//
+//   Number of churn rounds.  Each round writes a grid of `kKeysPerRound` chunk
+//   keys and then deletes all but every `kStride`-th key of the grid.  The
+//   B+tree height is reported as the "height" counter; with node merging it
+//   depends on the number of remaining keys rather than on the total number of
+//   keys ever written.
+
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "absl/strings/cord.h"
+#include "absl/strings/str_format.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/ocdbt/driver.h"
+#include "tensorstore/kvstore/ocdbt/format/manifest.h"
+#include "tensorstore/kvstore/ocdbt/test_util.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+
+namespace {
+
+namespace kvstore = ::tensorstore::kvstore;
+using ::tensorstore::Future;
+using ::tensorstore::TimestampedStorageGeneration;
+
+constexpr size_t kGridSize = 64;
+constexpr size_t kKeysPerRound = kGridSize * kGridSize;
+constexpr size_t kStride = 16;
+
+std::string ChunkKey(size_t round, size_t i) {
+  return absl::StrFormat("grid%03d/c/%d/%d", round, i / kGridSize,
+                         i % kGridSize);
+}
+
+void WaitAll(std::vector<Future<TimestampedStorageGeneration>>& futures) {
+  for (auto& future : futures) {
+    TENSORSTORE_CHECK_OK(future.result());
+  }
+  futures.clear();
+}
+
+void BM_ReadAfterDeleteChurn(benchmark::State& state) {
+  const size_t num_rounds = state.range(0);
+  TENSORSTORE_CHECK_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", "ocdbt"},
+                     {"base", "memory://"},
+                     {"config", {{"max_decoded_node_bytes", 4096}}}})
+          .result());
+
+  std::vector<std::string> remaining_keys;
+  std::vector<Future<TimestampedStorageGeneration>> futures;
+  for (size_t round = 0; round < num_rounds; ++round) {
+    for (size_t i = 0; i < kKeysPerRound; ++i) {
+      futures.push_back(
+          kvstore::Write(store, ChunkKey(round, i), absl::Cord("chunk")));
+    }
+    WaitAll(futures);
+    for (size_t i = 0; i < kKeysPerRound; ++i) {
+      if (i % kStride == 0) {
+        remaining_keys.push_back(ChunkKey(round, i));
+        continue;
+      }
+      futures.push_back(kvstore::Delete(store, ChunkKey(round, i)));
+    }
+    WaitAll(futures);
+  }
+
+  auto& driver =
+      static_cast<tensorstore::internal_ocdbt::OcdbtDriver&>(*store.driver);
+  TENSORSTORE_CHECK_OK_AND_ASSIGN(
+      auto manifest, tensorstore::internal_ocdbt::ReadManifest(driver));
+  state.counters["height"] = manifest->latest_version().root_height;
+  state.counters["keys"] = remaining_keys.size();
+
+  size_t i = 0;
+  for (auto s : state) {
+    auto result =
+        kvstore::Read(store, remaining_keys[i++ % remaining_keys.size()])
+            .result();
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+BENCHMARK(BM_ReadAfterDeleteChurn)->Arg(1)->Arg(4)->Arg(16);
+
+}  // namespace
@@ -0,0 +1,41 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/ocdbt/bulk_load.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/cord.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/ocdbt/driver.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/bulk_load.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace ocdbt {
+
+Future<const void> BulkLoad(
+    const KvStore& store,
+    std::vector<std::pair<std::string, absl::Cord>> entries) {
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto* driver,
+      internal_ocdbt::GetOcdbtDriverForDatabase(store, "BulkLoad"));
+  return internal_ocdbt::BulkLoad(driver->io_handle_, std::move(entries));
+}
+
+}  // namespace ocdbt
+}  // namespace tensorstore
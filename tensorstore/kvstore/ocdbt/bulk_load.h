@@ -0,0 +1,61 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_OCDBT_BULK_LOAD_H_
+#define TENSORSTORE_KVSTORE_OCDBT_BULK_LOAD_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/cord.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace ocdbt {
+
+/// Replaces the contents of an OCDBT database with `entries`.
+///
+/// The B+tree of the new version is written bottom-up directly from
+/// `entries`, which is much faster than writing the entries individually.
+/// The manifest is created if it does not already exist.  If the manifest is
+/// modified concurrently, the commit is retried, and the new version still
+/// replaces the entire contents of the database.
+///
+/// Example:
+///
+///     TENSORSTORE_ASSIGN_OR_RETURN(
+///       auto store,
+///       tensorstore::kvstore::Open({
+///         {"driver", "ocdbt"},
+///         {"base", "gs://bucket/path"},
+///       }).result());
+///     TENSORSTORE_RETURN_IF_ERROR(
+///       tensorstore::ocdbt::BulkLoad(store, std::move(entries)).result());
+///
+/// \param store OCDBT kvstore that refers to the root of the database, and is
+///     not bound to a transaction.
+/// \param entries Entries of the new version, sorted by key with no duplicate
+///     keys.
+/// \error `absl::StatusCode::kInvalidArgument` if `store` is not a valid OCDBT
+///     kvstore, or if `entries` is not sorted by key.
+Future<const void> BulkLoad(
+    const KvStore& store,
+    std::vector<std::pair<std::string, absl::Cord>> entries);
+
+}  // namespace ocdbt
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_OCDBT_BULK_LOAD_H_
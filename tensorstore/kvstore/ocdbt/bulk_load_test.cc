@@ -0,0 +1,180 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/ocdbt/bulk_load.h"
+
+#include <stddef.h>
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_format.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/ocdbt/driver.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/bulk_load.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/create_new_manifest.h"
+#include "tensorstore/kvstore/ocdbt/test_util.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/test_matchers.h"
+#include "tensorstore/kvstore/test_util.h"
+#include "tensorstore/transaction.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+namespace kvstore = ::tensorstore::kvstore;
+using ::tensorstore::KvStore;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::Transaction;
+using ::tensorstore::internal::GetMap;
+using ::tensorstore::internal::MatchesKvsReadResult;
+using ::tensorstore::internal_ocdbt::BulkLoader;
+using ::tensorstore::internal_ocdbt::EnsureExistingManifest;
+using ::tensorstore::internal_ocdbt::OcdbtDriver;
+using ::tensorstore::internal_ocdbt::ReadManifest;
+using ::tensorstore::ocdbt::BulkLoad;
+
+KvStore OpenStore(::nlohmann::json config) {
+  return kvstore::Open({{"driver", "ocdbt"},
+                        {"base", "memory://"},
+                        {"config", std::move(config)}})
+      .value();
+}
+
+OcdbtDriver& GetDriver(KvStore& store) {
+  return static_cast<OcdbtDriver&>(*store.driver);
+}
+
+std::vector<std::pair<std::string, absl::Cord>> MakeEntries(size_t num_keys) {
+  std::vector<std::pair<std::string, absl::Cord>> entries;
+  for (size_t i = 0; i < num_keys; ++i) {
+    entries.emplace_back(absl::StrFormat("key%05d", i),
+                         absl::Cord(absl::StrFormat("value%d", i)));
+  }
+  return entries;
+}
+
+TEST(BulkLoadTest, MultiLevel) {
+  constexpr size_t kNumKeys = 2000;
+  auto store = OpenStore({{"max_decoded_node_bytes", 500},
+                          {"max_inline_value_bytes", 8}});
+  auto entries = MakeEntries(kNumKeys);
+  std::map<std::string, absl::Cord> expected(entries.begin(), entries.end());
+  TENSORSTORE_ASSERT_OK(
+      BulkLoad(store, std::move(entries)).result());
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto manifest,
+                                   ReadManifest(GetDriver(store)));
+  ASSERT_TRUE(manifest);
+  // The initial empty version and the bulk-loaded version.
+  EXPECT_EQ(2, manifest->latest_generation());
+  EXPECT_GE(manifest->latest_version().root_height, 2);
+  EXPECT_EQ(kNumKeys, manifest->latest_version().root.statistics.num_keys);
+  EXPECT_THAT(GetMap(store), ::testing::Optional(expected));
+
+  // The database remains writable.
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "key00001", absl::Cord("new")));
+  EXPECT_THAT(kvstore::Read(store, "key00001").result(),
+              MatchesKvsReadResult(absl::Cord("new")));
+  TENSORSTORE_ASSERT_OK(kvstore::Delete(store, "key00002").result());
+  expected["key00001"] = absl::Cord("new");
+  expected.erase("key00002");
+  EXPECT_THAT(GetMap(store), ::testing::Optional(expected));
+}
+
+TEST(BulkLoadTest, SingleLeaf) {
+  auto store = OpenStore(::nlohmann::json::object_t{});
+  auto entries = MakeEntries(10);
+  std::map<std::string, absl::Cord> expected(entries.begin(), entries.end());
+  TENSORSTORE_ASSERT_OK(
+      BulkLoad(store, std::move(entries)).result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto manifest,
+                                   ReadManifest(GetDriver(store)));
+  EXPECT_EQ(0, manifest->latest_version().root_height);
+  EXPECT_THAT(GetMap(store), ::testing::Optional(expected));
+}
+
+TEST(BulkLoadTest, ReplacesExistingContents) {
+  auto store = OpenStore({{"max_decoded_node_bytes", 500}});
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord("old")));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "zzz", absl::Cord("old")));
+  auto entries = MakeEntries(100);
+  std::map<std::string, absl::Cord> expected(entries.begin(), entries.end());
+  TENSORSTORE_ASSERT_OK(
+      BulkLoad(store, std::move(entries)).result());
+  EXPECT_THAT(GetMap(store), ::testing::Optional(expected));
+}
+
+TEST(BulkLoadTest, Empty) {
+  auto store = OpenStore(::nlohmann::json::object_t{});
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord("old")));
+  TENSORSTORE_ASSERT_OK(BulkLoad(store, {}).result());
+  EXPECT_THAT(GetMap(store), ::testing::Optional(::testing::IsEmpty()));
+}
+
+TEST(BulkLoadTest, UnsortedKeys) {
+  auto store = OpenStore(::nlohmann::json::object_t{});
+  auto& io_handle = GetDriver(store).io_handle_;
+  TENSORSTORE_ASSERT_OK(EnsureExistingManifest(io_handle).result());
+  BulkLoader loader(io_handle);
+  TENSORSTORE_EXPECT_OK(loader.Add("b", absl::Cord("1")));
+  EXPECT_THAT(loader.Add("b", absl::Cord("2")),
+              MatchesStatus(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(loader.Add("c", absl::Cord("3")),
+              MatchesStatus(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(loader.Commit().result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(BulkLoadTest, UnsortedEntries) {
+  auto store = OpenStore(::nlohmann::json::object_t{});
+  std::vector<std::pair<std::string, absl::Cord>> entries{
+      {"b", absl::Cord("1")}, {"a", absl::Cord("2")}};
+  EXPECT_THAT(BulkLoad(store, std::move(entries)).result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            ".*strictly increasing.*"));
+}
+
+TEST(BulkLoadTest, InvalidStore) {
+  auto store = OpenStore(::nlohmann::json::object_t{});
+  EXPECT_THAT(BulkLoad(kvstore::Open("memory://").value(), {}).result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            "BulkLoad requires an OCDBT kvstore"));
+  EXPECT_THAT(BulkLoad(store.WithPathSuffix("a/"), {}).result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            "BulkLoad requires a kvstore that refers to the "
+                            "root of the database.*"));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto transactional_store,
+      store | Transaction(tensorstore::atomic_isolated));
+  EXPECT_THAT(BulkLoad(transactional_store, {}).result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            "BulkLoad does not support transactions"));
+}
+
+TEST(BulkLoadTest, NoManifest) {
+  auto store = OpenStore(::nlohmann::json::object_t{});
+  BulkLoader loader(GetDriver(store).io_handle_);
+  EXPECT_THAT(loader.Add("a", absl::Cord("1")),
+              MatchesStatus(absl::StatusCode::kFailedPrecondition));
+}
+
+}  // namespace
@@ -0,0 +1,62 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_OCDBT_COMPACT_H_
+#define TENSORSTORE_KVSTORE_OCDBT_COMPACT_H_
+
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/compact.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace ocdbt {
+
+/// Retention and deletion options for `Compact`.
+using CompactOptions = internal_ocdbt::CompactOptions;
+
+/// Statistics returned by `Compact`.
+using CompactionStatistics = internal_ocdbt::CompactionStatistics;
+
+/// Compacts an OCDBT database.
+///
+/// The B+tree nodes, out-of-line values and version tree nodes reachable from
+/// the retained versions are rewritten into new, densely packed data files,
+/// and the manifest is replaced.  Versions excluded by `options` are removed.
+///
+/// Data files are only deleted if `options.exclusive` is `true`, which
+/// requires that no other writer, in this or any other process, writes to the
+/// database while the compaction is in progress.
+///
+/// Example:
+///
+///     tensorstore::ocdbt::CompactOptions options;
+///     options.keep_last_versions = 1;
+///     TENSORSTORE_ASSIGN_OR_RETURN(
+///       auto stats,
+///       tensorstore::ocdbt::Compact(store, options).result());
+///
+/// \param store OCDBT kvstore that refers to the root of the database, and is
+///     not bound to a transaction.
+/// \param options Retention and deletion options.
+/// \error `absl::StatusCode::kInvalidArgument` if `store` is not a valid OCDBT
+///     kvstore.
+/// \error `absl::StatusCode::kUnimplemented` if the database does not use
+///     ``manifest_kind="single"``.
+Future<CompactionStatistics> Compact(const KvStore& store,
+                                     const CompactOptions& options = {});
+
+}  // namespace ocdbt
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_OCDBT_COMPACT_H_
@@ -0,0 +1,232 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/ocdbt/compact.h"
+
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/time/time.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/kvstore/key_range.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/ocdbt/driver.h"
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/list_versions.h"
+#include "tensorstore/kvstore/ocdbt/test_util.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/test_matchers.h"
+#include "tensorstore/kvstore/test_util.h"
+#include "tensorstore/util/status_testutil.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace {
+
+namespace kvstore = ::tensorstore::kvstore;
+using ::tensorstore::KeyRange;
+using ::tensorstore::KvStore;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::internal::UniqueNow;
+using ::tensorstore::internal_ocdbt::BtreeGenerationReference;
+using ::tensorstore::internal_ocdbt::ListVersionsFuture;
+using ::tensorstore::internal_ocdbt::OcdbtDriver;
+using ::tensorstore::ocdbt::Compact;
+using ::tensorstore::ocdbt::CompactOptions;
+
+constexpr size_t kNumWrites = 10;
+
+class CompactTest : public ::testing::Test {
+ protected:
+  KvStore store;
+  std::vector<BtreeGenerationReference> versions;
+
+  void SetUp() override {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        store, kvstore::Open({{"driver", "ocdbt"},
+                              {"base", "memory://"},
+                              {"config",
+                               {{"max_inline_value_bytes", 0},
+                                {"version_tree_arity_log2", 1}}}})
+                   .result());
+    for (size_t i = 0; i < kNumWrites; ++i) {
+      UniqueNow();
+      TENSORSTORE_ASSERT_OK(kvstore::Write(store,
+                                           tensorstore::StrCat("key", i % 3),
+                                           absl::Cord(tensorstore::StrCat(i))));
+    }
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        versions, ListVersionsFuture(driver().io_handle_).result());
+    ASSERT_EQ(kNumWrites, versions.size());
+  }
+
+  OcdbtDriver& driver() { return static_cast<OcdbtDriver&>(*store.driver); }
+
+  tensorstore::Result<tensorstore::ocdbt::CompactionStatistics> RunCompact(
+      const CompactOptions& options) {
+    return Compact(store, options).result();
+  }
+
+  std::vector<std::string> ListDataFiles() {
+    std::vector<std::string> keys;
+    for (auto& entry :
+         kvstore::ListFuture(driver().base_, {KeyRange::Prefix("d/")})
+             .value()) {
+      keys.push_back(entry.key);
+    }
+    return keys;
+  }
+
+  // Checks that the latest version has the expected contents, and that the
+  // root node of every remaining version can be read.
+  void CheckContents() {
+    for (size_t i = kNumWrites - 3; i < kNumWrites; ++i) {
+      EXPECT_THAT(kvstore::Read(store, tensorstore::StrCat("key", i % 3))
+                      .result(),
+                  tensorstore::internal::MatchesKvsReadResult(
+                      absl::Cord(tensorstore::StrCat(i))));
+    }
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto remaining_versions,
+        ListVersionsFuture(driver().io_handle_).result());
+    for (const auto& version : remaining_versions) {
+      TENSORSTORE_EXPECT_OK(
+          driver().io_handle_->GetBtreeNode(version.root.location).result());
+    }
+  }
+};
+
+TEST_F(CompactTest, RetainsAllVersionsByDefault) {
+  const auto files = ListDataFiles();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto stats, RunCompact({}));
+  EXPECT_EQ(kNumWrites, stats.num_versions_retained);
+  EXPECT_EQ(0, stats.num_versions_removed);
+  // Non-exclusive compaction never deletes data files.
+  EXPECT_EQ(0, stats.num_data_files_deleted);
+  EXPECT_THAT(ListDataFiles(), ::testing::IsSupersetOf(files));
+
+  // Generation numbers and commit times are preserved.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto new_versions, ListVersionsFuture(driver().io_handle_).result());
+  ASSERT_EQ(versions.size(), new_versions.size());
+  for (size_t i = 0; i < versions.size(); ++i) {
+    EXPECT_EQ(versions[i].generation_number, new_versions[i].generation_number);
+    EXPECT_EQ(versions[i].commit_time, new_versions[i].commit_time);
+    EXPECT_EQ(versions[i].root.statistics.num_keys,
+              new_versions[i].root.statistics.num_keys);
+  }
+  CheckContents();
+}
+
+TEST_F(CompactTest, KeepLastVersions) {
+  CompactOptions options;
+  options.keep_last_versions = 3;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto stats, RunCompact(options));
+  EXPECT_EQ(3, stats.num_versions_retained);
+  EXPECT_EQ(kNumWrites - 3, stats.num_versions_removed);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto new_versions, ListVersionsFuture(driver().io_handle_).result());
+  ASSERT_EQ(3, new_versions.size());
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(versions[kNumWrites - 3 + i].generation_number,
+              new_versions[i].generation_number);
+  }
+  CheckContents();
+
+  // The database can still be written after compaction.
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "key", absl::Cord("value")));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      new_versions, ListVersionsFuture(driver().io_handle_).result());
+  ASSERT_EQ(4, new_versions.size());
+  EXPECT_EQ(kNumWrites + 1, new_versions.back().generation_number);
+}
+
+TEST_F(CompactTest, KeepNewerThan) {
+  CompactOptions options;
+  options.keep_last_versions = 1;
+  options.keep_newer_than = static_cast<absl::Time>(versions[4].commit_time);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto stats, RunCompact(options));
+  EXPECT_EQ(kNumWrites - 4, stats.num_versions_retained);
+  EXPECT_EQ(4, stats.num_versions_removed);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto new_versions, ListVersionsFuture(driver().io_handle_).result());
+  ASSERT_EQ(kNumWrites - 4, new_versions.size());
+  EXPECT_EQ(versions[4].generation_number, new_versions[0].generation_number);
+  CheckContents();
+}
+
+TEST_F(CompactTest, ExclusiveDeletesOrphanedFiles) {
+  const std::string orphan = "d/0123456789abcdef0123456789abcdef";
+  TENSORSTORE_ASSERT_OK(
+      kvstore::Write(driver().base_, orphan, absl::Cord("orphan")));
+  TENSORSTORE_ASSERT_OK(
+      kvstore::Write(driver().base_, "d/other", absl::Cord("other")));
+
+  // Non-exclusive compaction does not delete any files.
+  TENSORSTORE_ASSERT_OK(RunCompact({}));
+  EXPECT_THAT(ListDataFiles(), ::testing::Contains(orphan));
+
+  const size_t num_files = ListDataFiles().size();
+  CompactOptions options;
+  options.exclusive = true;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto stats, RunCompact(options));
+  auto files = ListDataFiles();
+  // All files that match the data file naming scheme are deleted.
+  EXPECT_EQ(num_files - 1, stats.num_data_files_deleted);
+  EXPECT_LT(files.size(), num_files);
+  EXPECT_THAT(files, ::testing::Not(::testing::Contains(orphan)));
+  EXPECT_THAT(files, ::testing::Contains("d/other"));
+  CheckContents();
+}
+
+TEST_F(CompactTest, NoDelete) {
+  const size_t num_files = ListDataFiles().size();
+  CompactOptions options;
+  options.keep_last_versions = 1;
+  options.exclusive = true;
+  options.delete_unreferenced_files = false;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto stats, RunCompact(options));
+  EXPECT_EQ(0, stats.num_data_files_deleted);
+  EXPECT_LT(num_files, ListDataFiles().size());
+  CheckContents();
+}
+
+TEST(CompactNumberedManifestTest, Unsupported) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", "ocdbt"},
+                     {"base", "memory://"},
+                     {"config", {{"manifest_kind", "numbered"}}}})
+          .result());
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "key", absl::Cord("value")));
+  EXPECT_THAT(Compact(store).result(),
+              MatchesStatus(absl::StatusCode::kUnimplemented));
+}
+
+TEST_F(CompactTest, InvalidStore) {
+  EXPECT_THAT(Compact(driver().base_).result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            "Compact requires an OCDBT kvstore"));
+  EXPECT_THAT(Compact(store.WithPathSuffix("key")).result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            "Compact requires a kvstore that refers to the "
+                            "root of the database.*"));
+}
+
+}  // namespace
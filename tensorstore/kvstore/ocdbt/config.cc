@@ -32,6 +32,7 @@
 #include "tensorstore/internal/json_binding/std_optional.h"
 #include "tensorstore/internal/json_binding/std_variant.h"
 #include "tensorstore/kvstore/ocdbt/format/config.h"
+#include "tensorstore/kvstore/ocdbt/format/key_filter.h"
 #include "tensorstore/kvstore/ocdbt/format/version_tree.h"
 #include "tensorstore/kvstore/supported_features.h"
 #include "tensorstore/util/result.h"
@@ -84,6 +85,10 @@ TENSORSTORE_DEFINE_JSON_DEFAULT_BINDER(
                    jb::Projection<&ConfigConstraints::version_tree_arity_log2>(
                        jb::Optional(
                            jb::Integer<uint8_t>(1, kMaxVersionTreeArityLog2)))),
+        jb::Member("key_filter_bits_per_key",
+                   jb::Projection<&ConfigConstraints::key_filter_bits_per_key>(
+                       jb::Optional(
+                           jb::Integer<uint8_t>(0, kMaxKeyFilterBitsPerKey)))),
         jb::Member("compression",
                    jb::Projection<&ConfigConstraints::compression>(
                        jb::Optional(ConfigCompressionJsonBinder)))))
@@ -128,6 +133,7 @@ absl::Status ValidateConfig(const Config& config,
   TENSORTORE_INTERNAL_DO_VALIDATE(max_inline_value_bytes)
   TENSORTORE_INTERNAL_DO_VALIDATE(max_decoded_node_bytes)
   TENSORTORE_INTERNAL_DO_VALIDATE(version_tree_arity_log2)
+  TENSORTORE_INTERNAL_DO_VALIDATE(key_filter_bits_per_key)
   TENSORTORE_INTERNAL_DO_VALIDATE(compression)
 
 #undef TENSORTORE_INTERNAL_DO_VALIDATE
@@ -170,6 +176,8 @@ absl::Status CreateConfig(const ConfigConstraints& constraints,
       default_config.max_decoded_node_bytes);
   config.version_tree_arity_log2 = constraints.version_tree_arity_log2.value_or(
       default_config.version_tree_arity_log2);
+  config.key_filter_bits_per_key = constraints.key_filter_bits_per_key.value_or(
+      default_config.key_filter_bits_per_key);
   config.compression =
       constraints.compression.value_or(default_config.compression);
   return absl::OkStatus();
@@ -180,7 +188,13 @@ ConfigConstraints::ConfigConstraints(const Config& config)
       max_inline_value_bytes(config.max_inline_value_bytes),
       max_decoded_node_bytes(config.max_decoded_node_bytes),
       version_tree_arity_log2(config.version_tree_arity_log2),
-      compression(config.compression) {}
+      compression(config.compression) {
+  // Omitted when key filters are disabled, so that the spec of a database that
+  // does not use them is unaffected by the option.
+  if (config.key_filter_bits_per_key != 0) {
+    key_filter_bits_per_key = config.key_filter_bits_per_key;
+  }
+}
 
 Result<ConfigStatePtr> ConfigState::Make(
     const ConfigConstraints& constraints,
@@ -41,6 +41,7 @@ struct ConfigConstraints {
   std::optional<uint32_t> max_inline_value_bytes;
   std::optional<uint32_t> max_decoded_node_bytes;
   std::optional<uint8_t> version_tree_arity_log2;
+  std::optional<uint8_t> key_filter_bits_per_key;
   std::optional<Config::Compression> compression;
 
   friend bool operator==(const ConfigConstraints& a,
@@ -57,7 +58,7 @@ struct ConfigConstraints {
   constexpr static auto ApplyMembers = [](auto&& x, auto f) {
     return f(x.uuid, x.manifest_kind, x.max_inline_value_bytes,
              x.max_decoded_node_bytes, x.version_tree_arity_log2,
-             x.compression);
+             x.key_filter_bits_per_key, x.compression);
   };
 };
 
@@ -102,13 +102,16 @@ struct BtreeLeafNodeWriteMutationCodec {
       return false;
     }
     if constexpr (std::is_same_v<IO, riegeli::Reader>) {
-      if (mode > BtreeNodeWriteMutation::kAddNew) {
+      if (mode > BtreeNodeWriteMutation::kDeleteRange) {
         io.Fail(absl::InvalidArgumentError(
             absl::StrFormat("Invalid mutation mode: %d", mode)));
       }
       value.mode = static_cast<BtreeNodeWriteMutation::Mode>(mode);
     }
     if (mode <= BtreeNodeWriteMutation::kDeleteExisting) return true;
+    if (mode == BtreeNodeWriteMutation::kDeleteRange) {
+      return KeyCodec{}(io, value.exclusive_max);
+    }
     using DataFileTableOrBuilder =
         std::conditional_t<std::is_same_v<IO, riegeli::Reader>, DataFileTable,
                            DataFileTableBuilder>;
@@ -244,7 +247,8 @@ absl::Status BtreeInteriorNodeWriteMutation::EncodeTo(
 
 bool AddNewEntries(BtreeNodeEncoder<LeafNodeEntry>& encoder,
                    const BtreeLeafNodeWriteMutation& mutation) {
-  assert(mutation.mode != BtreeNodeWriteMutation::kRetainExisting);
+  assert(mutation.mode != BtreeNodeWriteMutation::kRetainExisting &&
+         mutation.mode != BtreeNodeWriteMutation::kDeleteRange);
   if (mutation.mode != BtreeNodeWriteMutation::kAddNew) return false;
   auto& new_entry = mutation.new_entry;
   LeafNodeEntry entry;
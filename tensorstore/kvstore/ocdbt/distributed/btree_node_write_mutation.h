@@ -48,6 +48,10 @@ struct BtreeNodeWriteMutation
 
     // Replace existing value with new entry/entries.
     kAddNew = 2,
+
+    // Delete all existing values within a key range.  Only valid for leaf
+    // node mutations, and only unconditionally.
+    kDeleteRange = 3,
   };
   Mode mode;
 };
@@ -63,6 +67,11 @@ struct BtreeLeafNodeWriteMutation : public BtreeNodeWriteMutation {
   // `BtreeNodeWriteMutation::mode == kAddNew`.
   NewEntry new_entry;
 
+  // Exclusive upper bound of the range `[key, exclusive_max)` to delete, where
+  // an empty string indicates no upper bound.  Meaningful only if
+  // `BtreeNodeWriteMutation::mode == kDeleteRange`.
+  std::string exclusive_max;
+
   std::string_view inclusive_min() const { return key; }
   std::string_view key_or_range() const { return key; }
 
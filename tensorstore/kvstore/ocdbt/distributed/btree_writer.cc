@@ -14,11 +14,10 @@
 
 // This module implements distributed write operations for the OCDBT database.
 //
-// For simplicity of the initial implementation, currently only single-key
-// write/delete operations are implemented directly.  `DeleteRange` operations
-// are supported but simply use the non-distributed implementation, meaning that
-// there will be high contention if `DeleteRange` operations are attempted
-// concurrently with other write operations.
+// Single-key write/delete operations and `DeleteRange` operations are
+// implemented directly.  `CopySubtree` operations are supported but simply use
+// the non-distributed implementation, meaning that there will be high
+// contention if they are attempted concurrently with other write operations.
 //
 // Distributed writing involves two gRPC services:
 //
@@ -74,6 +73,14 @@
 //     in-process cooperator instance to complete.  See
 //     `WriterCommitOperation::SubmitRequests`.
 //
+// 2d. [Submitting range deletions] For each `DeleteRange` request, the B+tree
+//     is traversed down to height 1 nodes, following only subtrees that
+//     intersect the range, and a range deletion mutation is submitted to the
+//     local cooperator for each leaf node identifier that intersects the range.
+//     The cooperator that owns the leaf node deletes all entries in the range,
+//     and the request completes once all leaf nodes have been updated.  See
+//     `WriterCommitOperation::TraverseBtreeForDeleteRange`.
+//
 // 3. [Processing of locally-originated requests by cooperators]
 //    (cooperator.h)
 //
@@ -130,6 +137,10 @@
 //     - If the node is the root node, the cooperator writes any necessary
 //       version tree nodes and then updates the manifest.
 //
+//     While the parent update is in progress, a subsequent commit for the same
+//     node may already apply newly-pending requests to the new node, provided
+//     the node was replaced by a single node with the same key range.
+//
 // 4f. [Sending responses] Once the parent has indicated success, the staged
 //     requests are completed.
 
@@ -195,12 +206,19 @@ struct PendingDistributedRequests {
     Future<const void> flush_future;
     Promise<TimestampedStorageGeneration> promise;
   };
+  struct DeleteRangeRequest {
+    KeyRange range;
+    Promise<void> promise;
+  };
   std::vector<WriteRequest> write_requests;
+  std::vector<DeleteRangeRequest> delete_range_requests;
   bool needs_inline_value_pass = false;
 };
 
 struct StagedDistributedRequests {
   std::vector<PendingDistributedRequests::WriteRequest> write_requests;
+  std::vector<PendingDistributedRequests::DeleteRangeRequest>
+      delete_range_requests;
 };
 
 class DistributedBtreeWriter : public BtreeWriter {
@@ -211,7 +229,7 @@ class DistributedBtreeWriter : public BtreeWriter {
   Future<const void> DeleteRange(KeyRange range) override;
   Future<const void> CopySubtree(CopySubtreeOptions&& options) override;
 
-  // Non-distributed writer instance used to handle `DeleteRange` requests.
+  // Non-distributed writer instance used to handle `CopySubtree` requests.
   BtreeWriterPtr non_distributed_writer_;
 
   IoHandle::Ptr io_handle_;
@@ -358,6 +376,57 @@ struct WriterCommitOperation
       WriterCommitOperation::Ptr commit_op, BtreeNodeIdentifier identifier,
       StorageGeneration node_generation,
       span<const PendingDistributedRequests::WriteRequest> write_requests);
+
+  // Begins asynchronously traversing the B+tree in order to submit a range
+  // deletion mutation for each leaf node that intersects the range of
+  // `request`.
+  //
+  // If any leaf node no longer exists, the request is retried by a subsequent
+  // commit.  Since deleting a range is idempotent, it is safe to resubmit it to
+  // leaf nodes that already processed it.
+  static void TraverseBtreeForDeleteRange(
+      WriterCommitOperation::Ptr commit_op,
+      PendingDistributedRequests::DeleteRangeRequest request);
+
+  // State used for the B+tree traversal initiated by
+  // `TraverseBtreeForDeleteRange`.
+  struct DeleteRangeVisitParameters {
+    // Commit operation for which this traversal is being performed.
+    WriterCommitOperation::Ptr commit_op;
+
+    // Range deletion mutation to submit for each leaf node.
+    internal::IntrusivePtr<const BtreeLeafNodeWriteMutation> mutation;
+
+    // Completed with an error if submitting the mutation to any leaf node
+    // fails.
+    Promise<void> promise;
+
+    // Node identifier of the current subtree being visited.
+    BtreeNodeIdentifier node_identifier;
+
+    // Length of the prefix of `inclusive_min_key` that is a common prefix of
+    // all keys within the current subtree.
+    KeyLength subtree_common_prefix_length;
+
+    // Inclusive min key within the current non-root subtree being visited
+    // (equal to the empty string when visiting the root node).
+    std::string inclusive_min_key;
+
+    std::string_view key_prefix() const {
+      return std::string_view(inclusive_min_key)
+          .substr(0, subtree_common_prefix_length);
+    }
+  };
+
+  // Asynchronously traverse the subtree rooted at the specified `node_ref`,
+  // for a range deletion.
+  static void VisitNodeReferenceForDeleteRange(
+      DeleteRangeVisitParameters&& state, const BtreeNodeReference& node_ref);
+
+  // Asynchronously traverse the children of the specified non-leaf `node` that
+  // intersect the range to delete.
+  static void VisitNodeForDeleteRange(DeleteRangeVisitParameters&& state,
+                                      std::shared_ptr<const BtreeNode> node);
 };
 
 void WriterCommitOperation::MaybeStart(DistributedBtreeWriter& writer,
@@ -423,6 +492,10 @@ void WriterCommitOperation::StartCommit(DistributedBtreeWriter& writer,
                     commit_op->existing_manifest_->config),
                 commit_op->CommitFailed(_));
             commit_op->StagePending();
+            for (auto& request : commit_op->staged_.delete_range_requests) {
+              TraverseBtreeForDeleteRange(commit_op, std::move(request));
+            }
+            if (commit_op->staged_.write_requests.empty()) return;
             TraverseBtreeStartingFromRoot(std::move(commit_op));
           }));
 }
@@ -430,7 +503,8 @@ void WriterCommitOperation::StartCommit(DistributedBtreeWriter& writer,
 void WriterCommitOperation::CommitFailed(const absl::Status& error) {
   ABSL_LOG_IF(INFO, ocdbt_logging) << "Commit failed: " << error;
   assert(!error.ok());
-  if (staged_.write_requests.empty()) {
+  if (staged_.write_requests.empty() &&
+      staged_.delete_range_requests.empty()) {
     // No requests have been staged yet.
     //
     // In this case, `error` almost surely relates to reading or writing the
@@ -445,10 +519,14 @@ void WriterCommitOperation::CommitFailed(const absl::Status& error) {
       writer_->commit_in_progress_ = false;
     }
     staged_.write_requests = std::move(pending.write_requests);
+    staged_.delete_range_requests = std::move(pending.delete_range_requests);
   }
   for (auto& write_request : staged_.write_requests) {
     write_request.promise.SetResult(error);
   }
+  for (auto& delete_range_request : staged_.delete_range_requests) {
+    delete_range_request.promise.SetResult(error);
+  }
 }
 
 void WriterCommitOperation::StagePending() {
@@ -459,8 +537,10 @@ void WriterCommitOperation::StagePending() {
     writer_->commit_in_progress_ = false;
   }
   staged_.write_requests = std::move(pending.write_requests);
+  staged_.delete_range_requests = std::move(pending.delete_range_requests);
   ABSL_LOG_IF(INFO, ocdbt_logging)
-      << "Staged write requests: " << staged_.write_requests.size();
+      << "Staged write requests: " << staged_.write_requests.size()
+      << ", delete range requests: " << staged_.delete_range_requests.size();
   auto config = existing_config();
   const auto max_inline_value_bytes = config.max_inline_value_bytes;
   for (auto& write_request : staged_.write_requests) {
@@ -677,6 +757,7 @@ void WriterCommitOperation::SubmitRequests(
                   stamp.generation = mutation.existing_generation;
                   break;
                 case BtreeNodeWriteMutation::kDeleteExisting:
+                case BtreeNodeWriteMutation::kDeleteRange:
                   stamp.generation = StorageGeneration::NoValue();
                   break;
                 case BtreeNodeWriteMutation::kAddNew:
@@ -708,6 +789,161 @@ void WriterCommitOperation::SubmitRequests(
       }));
 }
 
+void WriterCommitOperation::TraverseBtreeForDeleteRange(
+    WriterCommitOperation::Ptr commit_op,
+    PendingDistributedRequests::DeleteRangeRequest request) {
+  auto& latest_version = commit_op->existing_manifest_->latest_version();
+  ABSL_LOG_IF(INFO, ocdbt_logging)
+      << "TraverseBtreeForDeleteRange: range=" << request.range
+      << ", root=" << latest_version.root;
+  if (latest_version.root.location.IsMissing()) {
+    // Tree is empty.
+    request.promise.SetResult(absl::OkStatus());
+    return;
+  }
+  auto mutation = internal::MakeIntrusivePtr<BtreeLeafNodeWriteMutation>();
+  mutation->mode = BtreeNodeWriteMutation::kDeleteRange;
+  mutation->key = request.range.inclusive_min;
+  mutation->exclusive_max = request.range.exclusive_max;
+
+  auto [promise, future] = PromiseFuturePair<void>::Make(absl::OkStatus());
+  std::move(future).ExecuteWhenReady(WithExecutor(
+      commit_op->writer_->io_handle_->executor,
+      [writer = commit_op->writer_,
+       existing_manifest_time = commit_op->existing_manifest_time_,
+       request = std::move(request)](ReadyFuture<void> future) mutable {
+        auto& r = future.result();
+        if (!absl::IsAborted(r.status())) {
+          request.promise.SetResult(r);
+          return;
+        }
+        // Retry
+        ABSL_LOG_IF(INFO, ocdbt_logging)
+            << "Retrying delete range: " << r.status();
+        UniqueWriterLock lock{writer->mutex_};
+        writer->pending_.delete_range_requests.push_back(std::move(request));
+        auto new_staleness_bound =
+            existing_manifest_time + absl::Nanoseconds(1);
+        MaybeStart(*writer, new_staleness_bound, std::move(lock));
+      }));
+
+  DeleteRangeVisitParameters state;
+  state.commit_op = std::move(commit_op);
+  state.mutation = std::move(mutation);
+  state.promise = std::move(promise);
+  state.node_identifier.height = latest_version.root_height;
+  state.subtree_common_prefix_length = 0;
+  VisitNodeReferenceForDeleteRange(std::move(state), latest_version.root);
+}
+
+void WriterCommitOperation::VisitNodeReferenceForDeleteRange(
+    DeleteRangeVisitParameters&& state, const BtreeNodeReference& node_ref) {
+  if (state.node_identifier.height == 0) {
+    // Submit the range deletion to the owner of this leaf node.
+    internal_ocdbt_cooperator::MutationBatchRequest batch_request;
+    batch_request.root_generation =
+        state.commit_op->existing_manifest_->latest_generation();
+    batch_request.node_generation = internal_ocdbt::ComputeStorageGeneration(
+        node_ref.location, state.key_prefix());
+    batch_request.mutations.resize(1);
+    batch_request.mutations[0].mutation = std::move(state.mutation);
+    LinkError(std::move(state.promise),
+              internal_ocdbt_cooperator::SubmitMutationBatch(
+                  *state.commit_op->writer_->cooperator_,
+                  std::move(state.node_identifier), std::move(batch_request)));
+    return;
+  }
+  auto read_future =
+      state.commit_op->writer_->io_handle_->GetBtreeNode(node_ref.location);
+  read_future.Force();
+  read_future.ExecuteWhenReady(
+      [state =
+           std::move(state)](ReadyFuture<const std::shared_ptr<const BtreeNode>>
+                                 read_future) mutable {
+        TENSORSTORE_ASSIGN_OR_RETURN(
+            auto node, read_future.result(),
+            static_cast<void>(state.promise.SetResult(_)));
+        auto executor = state.commit_op->writer_->io_handle_->executor;
+        executor([state = std::move(state), node = std::move(node)]() mutable {
+          VisitNodeForDeleteRange(std::move(state), std::move(node));
+        });
+      });
+}
+
+void WriterCommitOperation::VisitNodeForDeleteRange(
+    DeleteRangeVisitParameters&& state, std::shared_ptr<const BtreeNode> node) {
+  TENSORSTORE_RETURN_IF_ERROR(
+      ValidateBtreeNodeReference(
+          *node, state.node_identifier.height,
+          std::string_view(state.inclusive_min_key)
+              .substr(state.subtree_common_prefix_length)),
+      static_cast<void>(state.promise.SetResult(_)));
+
+  const KeyRange range(state.mutation->key, state.mutation->exclusive_max);
+
+  std::string existing_key_prefix =
+      tensorstore::StrCat(state.key_prefix(), node->key_prefix);
+
+  ComparePrefixedKeyToUnprefixedKey compare_existing_and_new_keys{
+      existing_key_prefix};
+
+  span<const InteriorNodeEntry> existing_entries =
+      std::get<BtreeNode::InteriorNodeEntries>(node->entries);
+
+  assert(!existing_entries.empty());
+
+  // Skip to the last child with an inclusive_min key <= the start of the range.
+  auto existing_it = std::upper_bound(
+      existing_entries.begin() + 1, existing_entries.end(),
+      std::string_view(range.inclusive_min),
+      [&](std::string_view inclusive_min, const InteriorNodeEntry& entry) {
+        return compare_existing_and_new_keys(entry.key, inclusive_min) > 0;
+      });
+  --existing_it;
+
+  for (; existing_it != existing_entries.end(); ++existing_it) {
+    auto& existing_entry = *existing_it;
+    DeleteRangeVisitParameters sub_state;
+    sub_state.inclusive_min_key =
+        tensorstore::StrCat(existing_key_prefix, existing_entry.key);
+    if (&existing_entry == &existing_entries.front()) {
+      sub_state.node_identifier.range.inclusive_min =
+          state.node_identifier.range.inclusive_min;
+    } else {
+      if (KeyRange::CompareKeyAndExclusiveMax(sub_state.inclusive_min_key,
+                                              range.exclusive_max) >= 0) {
+        // This child and all subsequent children are after the range.
+        break;
+      }
+      sub_state.node_identifier.range.inclusive_min =
+          sub_state.inclusive_min_key;
+    }
+    if (existing_it + 1 == existing_entries.end()) {
+      sub_state.node_identifier.range.exclusive_max =
+          state.node_identifier.range.exclusive_max;
+    } else {
+      sub_state.node_identifier.range.exclusive_max =
+          tensorstore::StrCat(existing_key_prefix, (existing_it + 1)->key);
+    }
+    size_t subtree_common_prefix_length =
+        existing_key_prefix.size() +
+        existing_entry.subtree_common_prefix_length;
+    if (subtree_common_prefix_length >
+        std::numeric_limits<KeyLength>::max()) {
+      state.promise.SetResult(absl::DataLossError(
+          "subtree_common_prefix_length exceeds maximum"));
+      return;
+    }
+    sub_state.subtree_common_prefix_length =
+        static_cast<KeyLength>(subtree_common_prefix_length);
+    sub_state.node_identifier.height = state.node_identifier.height - 1;
+    sub_state.commit_op = state.commit_op;
+    sub_state.mutation = state.mutation;
+    sub_state.promise = state.promise;
+    VisitNodeReferenceForDeleteRange(std::move(sub_state), existing_entry.node);
+  }
+}
+
 Future<TimestampedStorageGeneration> DistributedBtreeWriter::Write(
     std::string key, std::optional<absl::Cord> value,
     kvstore::WriteOptions options) {
@@ -755,8 +991,18 @@ Future<TimestampedStorageGeneration> DistributedBtreeWriter::Write(
 }
 
 Future<const void> DistributedBtreeWriter::DeleteRange(KeyRange range) {
-  // TODO(jbms): Implement cooperative write support for `DeleteRange`.
-  return non_distributed_writer_->DeleteRange(range);
+  auto& writer = *this;
+  ABSL_LOG_IF(INFO, ocdbt_logging) << "DeleteRange: " << range;
+  if (range.empty()) return MakeReadyFuture();
+  auto [promise, future] = PromiseFuturePair<void>::Make();
+  UniqueWriterLock lock{writer.mutex_};
+  writer.pending_.delete_range_requests.push_back(
+      PendingDistributedRequests::DeleteRangeRequest{std::move(range),
+                                                     std::move(promise)});
+  WriterCommitOperation::MaybeStart(
+      writer, /*manifest_staleness_bound=*/absl::InfinitePast(),
+      std::move(lock));
+  return std::move(future);
 }
 
 Future<const void> DistributedBtreeWriter::CopySubtree(
@@ -781,7 +1027,7 @@ BtreeWriterPtr MakeDistributedBtreeWriter(
       &hasher, reinterpret_cast<uint8_t*>(writer->storage_identifier_.data()),
       writer->storage_identifier_.size());
 
-  // Used for DeleteRange currently.
+  // Used for CopySubtree currently.
   writer->non_distributed_writer_ =
       MakeNonDistributedBtreeWriter(writer->io_handle_);
   writer->coordinator_address_ = std::move(options.coordinator_address);
@@ -29,6 +29,7 @@
 #include "absl/base/attributes.h"
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
+#include "absl/strings/cord.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
@@ -65,6 +66,113 @@ ABSL_CONST_INIT internal_log::VerboseFlag ocdbt_logging("ocdbt");
 
 using NodeMutationRequests = Cooperator::NodeMutationRequests;
 
+// Result of a commit that published a `PipelinedNodeState`.
+struct PipelinedCommitResult {
+  // Latest local time known not to be newer than the manifest that references
+  // the published node.
+  absl::Time time;
+};
+
+struct PipelinedNodeState {
+  std::shared_ptr<const Manifest> existing_manifest;
+  absl::Time existing_manifest_time;
+
+  // Key prefix that applies to `node`, excluding `node->key_prefix`.
+  std::string key_prefix;
+
+  KeyRange key_range;
+  KeyRange parent_key_range;
+
+  // Generation of the parent node as of `existing_manifest`.  This predates
+  // the commit that published `node`, which rewrites the parent.
+  StorageGeneration parent_node_generation;
+  BtreeNodeHeight height;
+
+  // Decoded replacement node.
+  std::shared_ptr<const BtreeNode> node;
+
+  // Generation derived from the location of `node`.
+  StorageGeneration node_generation;
+
+  // Becomes ready once the commit that wrote `node` completes.  Resolves to an
+  // error if `node` did not become part of the B+tree.
+  Future<const PipelinedCommitResult> committed;
+};
+
+namespace {
+
+// Returns `true` if any of `requests` is a range deletion.
+bool HasDeleteRangeMutations(span<const PendingRequest> requests) {
+  return std::any_of(
+      requests.begin(), requests.end(), [](const PendingRequest& request) {
+        return request.mutation->mode == BtreeNodeWriteMutation::kDeleteRange;
+      });
+}
+
+// Replaces each range deletion in `requests` by single-key deletions.
+//
+// A range deletion applies both to existing entries and to the mutations that
+// precede it.  It is therefore replaced by an unconditional deletion of each
+// key within the range that is either present in `existing_entries` or is the
+// key of a preceding mutation.  The replacement deletions refer to the batch
+// position of the range deletion, which is always marked as successful.
+//
+// Args:
+//   requests: Staged leaf node requests, in the order they were received.
+//   existing_entries: Entries of the existing leaf node.
+//   key_prefix: Key prefix that applies to `existing_entries`.
+std::vector<PendingRequest> ExpandDeleteRangeMutations(
+    span<const PendingRequest> requests,
+    span<const LeafNodeEntry> existing_entries, std::string_view key_prefix) {
+  std::vector<PendingRequest> expanded;
+  expanded.reserve(requests.size());
+  ComparePrefixedKeyToUnprefixedKey compare_existing_and_new_keys{key_prefix};
+  for (const auto& request : requests) {
+    auto& mutation =
+        static_cast<const BtreeLeafNodeWriteMutation&>(*request.mutation);
+    if (mutation.mode != BtreeNodeWriteMutation::kDeleteRange) {
+      expanded.push_back(request);
+      continue;
+    }
+    request.batch_promise.raw_result()
+        ->conditions_matched[request.index_within_batch] = true;
+    KeyRange range(mutation.key, mutation.exclusive_max);
+    std::vector<std::string> keys;
+    for (auto existing_it = std::lower_bound(
+             existing_entries.begin(), existing_entries.end(),
+             std::string_view(range.inclusive_min),
+             [&](const LeafNodeEntry& entry, std::string_view key) {
+               return compare_existing_and_new_keys(entry.key, key) < 0;
+             });
+         existing_it != existing_entries.end(); ++existing_it) {
+      std::string key = tensorstore::StrCat(key_prefix, existing_it->key);
+      if (!Contains(range, key)) break;
+      keys.push_back(std::move(key));
+    }
+    for (const auto& prior_request : expanded) {
+      auto& prior_mutation = static_cast<const BtreeLeafNodeWriteMutation&>(
+          *prior_request.mutation);
+      if (Contains(range, prior_mutation.key)) {
+        keys.push_back(prior_mutation.key);
+      }
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    for (auto& key : keys) {
+      auto deletion = internal::MakeIntrusivePtr<BtreeLeafNodeWriteMutation>();
+      deletion->mode = BtreeNodeWriteMutation::kDeleteExisting;
+      deletion->key = std::move(key);
+      auto& deletion_request = expanded.emplace_back();
+      deletion_request.batch_promise = request.batch_promise;
+      deletion_request.index_within_batch = request.index_within_batch;
+      deletion_request.mutation = std::move(deletion);
+    }
+  }
+  return expanded;
+}
+
+}  // namespace
+
 // Asynchronous operation state for committing a batch of updates to a B+tree
 // node.
 //
@@ -89,6 +197,16 @@ using NodeMutationRequests = Cooperator::NodeMutationRequests;
 // 6. If existing node is not the root, submit update to parent node.
 //
 // 7. If existing node is the root, write new manifest.
+//
+// To avoid serializing successive commits to the same leased node on the
+// latency of updating the parent node, a commit that replaces a non-root node
+// with a single new node covering the same key range publishes the new node as
+// a `PipelinedNodeState` before step 6.  The next commit for the node may then
+// start immediately by applying its mutations to the new node (skipping steps
+// 1-2), but waits for the previous commit to complete before submitting its
+// own update to the parent.  If the previous commit fails or has to retry, the
+// next commit restarts at step 1 once the previous commit completes, which
+// preserves the order in which mutations are applied.
 struct NodeCommitOperation
     : internal::AtomicReferenceCount<NodeCommitOperation> {
   using Ptr = internal::IntrusivePtr<NodeCommitOperation>;
@@ -125,6 +243,25 @@ struct NodeCommitOperation
   // node/nodes can be referenced.
   FlushPromise flush_promise;
 
+  // Commit that wrote the node to which this commit applies its mutations, if
+  // this commit started from a `PipelinedNodeState`.  Reset to null once
+  // ready.
+  Future<const PipelinedCommitResult> predecessor;
+
+  // Set to `true` once this commit has published a `PipelinedNodeState`, at
+  // which point it no longer holds `NodeMutationRequests::commit_in_progress`
+  // and must not stage additional requests.
+  bool published = false;
+
+  // Indicates that the published node has not been invalidated by a retry.
+  bool published_node_valid = false;
+
+  // Identifies the published node state, if any.
+  const PipelinedNodeState* published_node = nullptr;
+
+  // Resolves `PipelinedNodeState::committed` of the published node.
+  Promise<PipelinedCommitResult> committed_promise;
+
   // Starts or restarts the commit operation.
   //
   // Args:
@@ -133,6 +270,23 @@ struct NodeCommitOperation
   static void StartCommit(NodeCommitOperation::Ptr commit_op,
                           absl::Time manifest_staleness_bound);
 
+  // Starts the commit operation by applying mutations to a node published by
+  // the previous commit.
+  static void StartPipelined(NodeCommitOperation::Ptr commit_op,
+                             std::shared_ptr<const PipelinedNodeState> state);
+
+  // Publishes the single node `new_entry` written by this commit as the
+  // starting point for the next commit, if there are pending requests.
+  //
+  // Args:
+  //   commit_op: Commit operation state.
+  //   encoded_node: Encoded representation of the node.
+  //   new_entry: Reference to the new node to be stored in the parent.
+  static void MaybePublishPipelinedNode(
+      const NodeCommitOperation::Ptr& commit_op,
+      const absl::Cord& encoded_node,
+      const InteriorNodeEntryData<std::string>& new_entry);
+
   // Called when the existing manifest has been successfully retrieved and saved
   // in `commit_op`.
   //
@@ -263,6 +417,24 @@ void NodeCommitOperation::StartCommit(NodeCommitOperation::Ptr commit_op,
                                       absl::Time manifest_staleness_bound) {
   ABSL_LOG_IF(INFO, ocdbt_logging)
       << "[Port=" << commit_op->server->listening_port_ << "] StartCommit";
+  if (!commit_op->predecessor.null()) {
+    // The node to which mutations were applied may not become part of the
+    // B+tree.  Wait for the previous commit to complete before restarting, to
+    // ensure mutations are applied in order.
+    auto predecessor = std::move(commit_op->predecessor);
+    predecessor.ExecuteWhenReady(
+        [commit_op = std::move(commit_op), manifest_staleness_bound](
+            ReadyFuture<const PipelinedCommitResult> future) mutable {
+          if (future.result().ok()) {
+            manifest_staleness_bound =
+                std::max(manifest_staleness_bound, future.value().time);
+          }
+          StartCommit(std::move(commit_op), manifest_staleness_bound);
+        });
+    return;
+  }
+  // A retry invalidates any previously-published node.
+  commit_op->published_node_valid = false;
   auto manifest_future =
       GetManifestForWriting(*commit_op->server, manifest_staleness_bound);
   manifest_future.Force();
@@ -278,6 +450,28 @@ void NodeCommitOperation::StartCommit(NodeCommitOperation::Ptr commit_op,
       });
 }
 
+void NodeCommitOperation::StartPipelined(
+    NodeCommitOperation::Ptr commit_op,
+    std::shared_ptr<const PipelinedNodeState> state) {
+  ABSL_LOG_IF(INFO, ocdbt_logging)
+      << "[Port=" << commit_op->server->listening_port_
+      << "] StartPipelined: key_range=" << state->key_range;
+  commit_op->existing_manifest = state->existing_manifest;
+  commit_op->existing_manifest_time = state->existing_manifest_time;
+  commit_op->height = state->height;
+  commit_op->key_prefix = state->key_prefix;
+  commit_op->key_range = state->key_range;
+  commit_op->parent_key_range = state->parent_key_range;
+  commit_op->parent_node_generation = state->parent_node_generation;
+  commit_op->node_generation = state->node_generation;
+  commit_op->predecessor = state->committed;
+  auto executor = commit_op->server->io_handle_->executor;
+  executor([commit_op = std::move(commit_op),
+            state = std::move(state)]() mutable {
+    VisitNode(std::move(commit_op), *state->node);
+  });
+}
+
 void NodeCommitOperation::ExistingManifestReady(
     NodeCommitOperation::Ptr commit_op) {
   auto& latest_version = commit_op->existing_manifest->latest_version();
@@ -447,11 +641,28 @@ void NodeCommitOperation::ApplyMutations(NodeCommitOperation::Ptr commit_op,
 
 void NodeCommitOperation::Done() {
   UniqueWriterLock lock{mutation_requests->mutex};
-  mutation_requests->commit_in_progress = false;
+  if (published) {
+    --mutation_requests->num_pipelined_commits;
+    if (mutation_requests->pipelined_node.get() == published_node) {
+      // Not used by a subsequent commit.
+      mutation_requests->pipelined_node = nullptr;
+    }
+    // A subsequent commit is responsible for any pending requests.
+    if (mutation_requests->commit_in_progress) return;
+  } else {
+    mutation_requests->commit_in_progress = false;
+  }
+  if (mutation_requests->pending.requests.empty() &&
+      mutation_requests->num_pipelined_commits != 0) {
+    // The last pipelined commit to complete removes `mutation_requests`.
+    return;
+  }
   MaybeCommit(*server, std::move(mutation_requests), std::move(lock));
 }
 
 void NodeCommitOperation::StagePending() {
+  // Once published, any new requests are handled by a subsequent commit.
+  if (published) return;
   absl::MutexLock lock(&mutation_requests->mutex);
   ABSL_LOG_IF(INFO, ocdbt_logging)
       << "[Port=" << server->listening_port_
@@ -475,6 +686,9 @@ void NodeCommitOperation::SetError(const absl::Status& status) {
     if (request.index_within_batch != 0) continue;
     request.batch_promise.SetResult(status);
   }
+  if (!committed_promise.null()) {
+    committed_promise.SetResult(status);
+  }
   Done();
 }
 
@@ -491,6 +705,14 @@ void NodeCommitOperation::SetSuccess(GenerationNumber root_generation,
     response.root_generation = root_generation;
     response.time = time;
   }
+  if (!committed_promise.null()) {
+    if (published_node_valid) {
+      committed_promise.SetResult(PipelinedCommitResult{time});
+    } else {
+      committed_promise.SetResult(
+          absl::AbortedError("Published node was superseded by retry"));
+    }
+  }
   Done();
 }
 
@@ -510,26 +732,38 @@ void NodeCommitOperation::ApplyMutationsForEntry(
                  std::is_same_v<Entry, LeafNodeEntry>) ||
                 (std::is_same_v<Mutation, BtreeInteriorNodeWriteMutation> &&
                  std::is_same_v<Entry, InteriorNodeEntry>));
+  BtreeNodeHeight height = commit_op->height;
+  const std::string key_prefix = commit_op->key_prefix;
+  span<const Entry> existing_entries;
+  if (node) {
+    existing_entries = std::get<std::vector<Entry>>(node->entries);
+  }
+  std::vector<PendingRequest>* requests = &commit_op->staged.requests;
+  std::vector<PendingRequest> expanded_requests;
+  if constexpr (std::is_same_v<Mutation, BtreeLeafNodeWriteMutation>) {
+    // Range deletions depend on the order in which requests were received, and
+    // must be expanded before sorting.  `staged.requests` is left unmodified
+    // since the expansion depends on the existing node.
+    if (HasDeleteRangeMutations(*requests)) {
+      expanded_requests =
+          ExpandDeleteRangeMutations(*requests, existing_entries, key_prefix);
+      requests = &expanded_requests;
+    }
+  }
   // Use stable sort to ensure multiple writes to the same key are resolved
   // consistently.
   std::stable_sort(
-      commit_op->staged.requests.begin(), commit_op->staged.requests.end(),
+      requests->begin(), requests->end(),
       [](const PendingRequest& a, const PendingRequest& b) {
         return static_cast<const Mutation&>(*a.mutation).inclusive_min() <
                static_cast<const Mutation&>(*b.mutation).inclusive_min();
       });
-  BtreeNodeHeight height = commit_op->height;
-  const std::string key_prefix = commit_op->key_prefix;
   BtreeNodeEncoder<Entry> node_encoder(commit_op->existing_manifest->config,
                                        height, key_prefix);
   ComparePrefixedKeyToUnprefixedKey compare_existing_and_new_keys{key_prefix};
   bool modified = false;
-  span<const Entry> existing_entries;
-  if (node) {
-    existing_entries = std::get<std::vector<Entry>>(node->entries);
-  }
   auto existing_it = existing_entries.begin();
-  span<const PendingRequest> staged_requests = commit_op->staged.requests;
+  span<const PendingRequest> staged_requests = *requests;
   for (auto mutation_it = staged_requests.begin();
        mutation_it != staged_requests.end();) {
     // 3-way comparison result between inclusive_min of current existing child
@@ -630,9 +864,22 @@ void NodeCommitOperation::ApplyMutationsForEntry(
     TENSORSTORE_ASSIGN_OR_RETURN(auto encoded_nodes,
                                  node_encoder.Finalize(may_be_root),
                                  commit_op->SetError(_));
+    // The next commit can only start from the new node if it has the same
+    // node identifier as the existing node.
+    std::optional<absl::Cord> pipelined_encoded_node;
+    if (!may_be_root && !commit_op->published && encoded_nodes.size() == 1 &&
+        (commit_op->key_range.inclusive_min.empty() ||
+         encoded_nodes[0].info.inclusive_min_key ==
+             commit_op->key_range.inclusive_min)) {
+      pipelined_encoded_node = encoded_nodes[0].encoded_node;
+    }
     new_entries = internal_ocdbt::WriteNodes(*commit_op->server->io_handle_,
                                              commit_op->flush_promise,
                                              std::move(encoded_nodes));
+    if (pipelined_encoded_node) {
+      MaybePublishPipelinedNode(commit_op, *pipelined_encoded_node,
+                                (*new_entries)[0]);
+    }
   }
 
   if (may_be_root) {
@@ -642,6 +889,51 @@ void NodeCommitOperation::ApplyMutationsForEntry(
   }
 }
 
+void NodeCommitOperation::MaybePublishPipelinedNode(
+    const NodeCommitOperation::Ptr& commit_op, const absl::Cord& encoded_node,
+    const InteriorNodeEntryData<std::string>& new_entry) {
+  auto& mutation_requests = *commit_op->mutation_requests;
+  {
+    absl::ReaderMutexLock lock(&mutation_requests.mutex);
+    // Only worthwhile if there are requests waiting for this commit.
+    if (mutation_requests.pending.requests.empty()) return;
+  }
+  auto node_result = DecodeBtreeNode(encoded_node, /*base_path=*/{});
+  if (!node_result.ok()) return;
+  auto state = std::make_shared<PipelinedNodeState>();
+  state->existing_manifest = commit_op->existing_manifest;
+  state->existing_manifest_time = commit_op->existing_manifest_time;
+  state->key_prefix = std::string_view(new_entry.key).substr(
+      0, new_entry.subtree_common_prefix_length);
+  state->key_range = commit_op->key_range;
+  state->parent_key_range = commit_op->parent_key_range;
+  state->parent_node_generation = commit_op->parent_node_generation;
+  state->height = commit_op->height;
+  state->node = std::make_shared<const BtreeNode>(*std::move(node_result));
+  state->node_generation = internal_ocdbt::ComputeStorageGeneration(
+      new_entry.node.location, state->key_prefix);
+  auto [promise, future] = PromiseFuturePair<PipelinedCommitResult>::Make(
+      absl::AbortedError("Commit abandoned"));
+  state->committed = std::move(future);
+
+  UniqueWriterLock lock(mutation_requests.mutex);
+  if (mutation_requests.pending.requests.empty()) return;
+  ABSL_LOG_IF(INFO, ocdbt_logging)
+      << "[Port=" << commit_op->server->listening_port_
+      << "] MaybePublishPipelinedNode: node_identifier="
+      << mutation_requests.node_identifier
+      << ", pending_requests=" << mutation_requests.pending.requests.size();
+  commit_op->published = true;
+  commit_op->published_node_valid = true;
+  commit_op->published_node = state.get();
+  commit_op->committed_promise = std::move(promise);
+  mutation_requests.pipelined_node = std::move(state);
+  mutation_requests.commit_in_progress = false;
+  ++mutation_requests.num_pipelined_commits;
+  MaybeCommit(*commit_op->server, commit_op->mutation_requests,
+              std::move(lock));
+}
+
 template <typename Mutation, typename Entry>
 std::pair<const PendingRequest*, std::optional<const PendingRequest*>>
 NodeCommitOperation::ResolveMutationsForKey(
@@ -671,6 +963,8 @@ NodeCommitOperation::ResolveMutationsForKey(
           existing_generation = StorageGeneration::Unknown();
           break;
         case BtreeNodeWriteMutation::kDeleteExisting:
+        case BtreeNodeWriteMutation::kDeleteRange:
+          // Range deletions are expanded by `ExpandDeleteRangeMutations`.
           effective_request = nullptr;
           existing_generation = StorageGeneration::NoValue();
           break;
@@ -695,6 +989,31 @@ void NodeCommitOperation::UpdateParent(
     NodeCommitOperation::Ptr commit_op,
     std::optional<std::vector<InteriorNodeEntryData<std::string>>>
         new_entries) {
+  if (!commit_op->predecessor.null()) {
+    // The existing node was written by the previous commit, which must be
+    // applied to the parent first.
+    if (!commit_op->predecessor.ready()) {
+      auto predecessor = commit_op->predecessor;
+      predecessor.ExecuteWhenReady(
+          [commit_op = std::move(commit_op),
+           new_entries = std::move(new_entries)](
+              ReadyFuture<const PipelinedCommitResult> future) mutable {
+            UpdateParent(std::move(commit_op), std::move(new_entries));
+          });
+      return;
+    }
+    if (!commit_op->predecessor.result().ok()) {
+      ABSL_LOG_IF(INFO, ocdbt_logging)
+          << "[Port=" << commit_op->server->listening_port_
+          << "] Retrying commit because previous commit failed: "
+          << commit_op->predecessor.status();
+      commit_op->predecessor = {};
+      RetryCommit(std::move(commit_op));
+      return;
+    }
+    commit_op->existing_manifest_time = commit_op->predecessor.value().time;
+    commit_op->predecessor = {};
+  }
   auto mutation = internal::MakeIntrusivePtr<BtreeInteriorNodeWriteMutation>();
   mutation->existing_range = commit_op->key_range;
   mutation->existing_generation = commit_op->node_generation;
@@ -707,6 +1026,10 @@ void NodeCommitOperation::UpdateParent(
     mutation->mode = BtreeNodeWriteMutation::kRetainExisting;
   }
   MutationBatchRequest batch_request;
+  // `parent_node_generation` was observed as of `existing_manifest`, even if
+  // the predecessor has since committed a newer root generation.  Pairing it
+  // with the predecessor's root generation would instead cause the parent to
+  // treat its (already rewritten) node as stale.
   batch_request.root_generation =
       commit_op->existing_manifest->latest_generation();
   batch_request.node_generation = std::move(commit_op->parent_node_generation);
@@ -865,10 +1188,16 @@ void MaybeCommit(Cooperator& server,
   }
   if (mutation_requests->commit_in_progress) return;
   mutation_requests->commit_in_progress = true;
+  auto pipelined_node = std::move(mutation_requests->pipelined_node);
   lock.unlock();
   auto commit_op = internal::MakeIntrusivePtr<NodeCommitOperation>();
   commit_op->server.reset(&server);
   commit_op->mutation_requests = std::move(mutation_requests);
+  if (pipelined_node) {
+    NodeCommitOperation::StartPipelined(std::move(commit_op),
+                                        std::move(pipelined_node));
+    return;
+  }
   NodeCommitOperation::StartCommit(
       std::move(commit_op), /*manifest_staleness_bound=*/absl::InfinitePast());
 }
@@ -69,6 +69,11 @@ struct PendingRequests {
   void Append(PendingRequests&& other);
 };
 
+// State of a leased node that has been replaced by a commit that has not yet
+// been applied to the parent node.  Defined in
+// `cooperator_commit_mutations.cc`.
+struct PipelinedNodeState;
+
 struct Cooperator : public grpc_gen::Cooperator::CallbackService,
                     public internal::AtomicReferenceCount<Cooperator> {
   ~Cooperator();
@@ -82,6 +87,16 @@ struct Cooperator : public grpc_gen::Cooperator::CallbackService,
     PendingRequests pending;
     bool commit_in_progress = false;
 
+    // Replacement node written by the most recent commit, which may be used
+    // as the starting point of the next commit while the parent node update
+    // of the previous commit is still in progress.  Consumed by the next
+    // commit.
+    std::shared_ptr<const PipelinedNodeState> pipelined_node;
+
+    // Number of commits that have published a `pipelined_node` and are still
+    // in progress.  These commits are not reflected in `commit_in_progress`.
+    size_t num_pipelined_commits = 0;
+
     NodeKey node_key() const {
       return {lease_node->key, node_identifier.height};
     }
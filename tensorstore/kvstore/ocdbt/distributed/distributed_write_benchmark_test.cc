@@ -0,0 +1,168 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// This benchmarks many-writer ingestion into an OCDBT database using
+// distributed coordination, with several cooperators running in the same
+// process and coordinated by an in-process coordinator server.
+//
+// BM_DistributedWrite/<num_cooperators>/<writes_per_cooperator>
+//
+// num_cooperators:
+//
+//   Number of independently-opened OCDBT kvstores, each of which starts its
+//   own cooperator server, as would be the case for separate processes.
+//
+// writes_per_cooperator:
+//
+//   Number of concurrent writes issued through each kvstore per iteration.
+//   Keys are chosen randomly, such that writes from different cooperators
+//   frequently map to the same leaf nodes.
+//
+// BM_DistributedDeleteRange/<num_cooperators>
+//
+//   Each iteration writes a grid of keys through all cooperators and then
+//   deletes it with one `DeleteRange` request per cooperator.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "absl/random/random.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_format.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/internal/testing/scoped_directory.h"
+#include "tensorstore/kvstore/key_range.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/ocdbt/distributed/coordinator_server.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace {
+
+namespace kvstore = ::tensorstore::kvstore;
+using ::tensorstore::AnyFuture;
+using ::tensorstore::Context;
+using ::tensorstore::KeyRange;
+using ::tensorstore::ocdbt::CoordinatorServer;
+
+// Coordinator server and the kvstores of the cooperators that use it.
+struct DistributedDatabase {
+  tensorstore::internal_testing::ScopedTemporaryDirectory tempdir;
+  CoordinatorServer coordinator_server;
+  std::vector<kvstore::KvStore> stores;
+
+  explicit DistributedDatabase(size_t num_cooperators) {
+    ::nlohmann::json security_json = ::nlohmann::json::value_t::discarded;
+    CoordinatorServer::Options options;
+    options.spec = CoordinatorServer::Spec::FromJson(
+                       {{"bind_addresses", {"localhost:0"}},
+                        {"security", security_json}})
+                       .value();
+    TENSORSTORE_CHECK_OK_AND_ASSIGN(
+        coordinator_server, CoordinatorServer::Start(std::move(options)));
+    TENSORSTORE_CHECK_OK_AND_ASSIGN(
+        auto context_spec,
+        Context::Spec::FromJson(
+            {{"ocdbt_coordinator",
+              {{"address", tensorstore::StrCat("localhost:",
+                                               coordinator_server.port())},
+               {"security", security_json}}}}));
+    ::nlohmann::json kvs_spec{
+        {"driver", "ocdbt"},
+        {"base", {{"driver", "file"}, {"path", tempdir.path() + "/"}}},
+        {"config", {{"max_decoded_node_bytes", 4096}}},
+    };
+    for (size_t i = 0; i < num_cooperators; ++i) {
+      // Each kvstore uses a separate context, and therefore a separate
+      // cooperator.
+      TENSORSTORE_CHECK_OK_AND_ASSIGN(
+          auto store, kvstore::Open(kvs_spec, Context(context_spec)).result());
+      stores.push_back(std::move(store));
+    }
+  }
+};
+
+void WaitAll(std::vector<AnyFuture>& futures) {
+  for (auto& future : futures) {
+    TENSORSTORE_CHECK_OK(future.status());
+  }
+  futures.clear();
+}
+
+void BM_DistributedWrite(benchmark::State& state) {
+  const size_t num_cooperators = state.range(0);
+  const size_t writes_per_cooperator = state.range(1);
+  DistributedDatabase db(num_cooperators);
+  std::minstd_rand gen{0};
+  std::vector<AnyFuture> futures;
+  for (auto s : state) {
+    for (size_t i = 0; i < writes_per_cooperator; ++i) {
+      for (auto& store : db.stores) {
+        futures.push_back(kvstore::Write(
+            store, absl::StrFormat("%08x", absl::Uniform<uint32_t>(gen)),
+            absl::Cord("value")));
+      }
+    }
+    WaitAll(futures);
+  }
+  state.SetItemsProcessed(state.iterations() * num_cooperators *
+                          writes_per_cooperator);
+}
+
+BENCHMARK(BM_DistributedWrite)
+    ->Args({1, 256})
+    ->Args({2, 256})
+    ->Args({4, 256})
+    ->Args({4, 1024})
+    ->UseRealTime();
+
+void BM_DistributedDeleteRange(benchmark::State& state) {
+  constexpr size_t kKeysPerCooperator = 1024;
+  const size_t num_cooperators = state.range(0);
+  DistributedDatabase db(num_cooperators);
+  std::vector<AnyFuture> futures;
+  for (auto s : state) {
+    state.PauseTiming();
+    for (size_t c = 0; c < num_cooperators; ++c) {
+      for (size_t i = 0; i < kKeysPerCooperator; ++i) {
+        futures.push_back(kvstore::Write(db.stores[c],
+                                         absl::StrFormat("%02d/%05d", c, i),
+                                         absl::Cord("value")));
+      }
+    }
+    WaitAll(futures);
+    state.ResumeTiming();
+    for (size_t c = 0; c < num_cooperators; ++c) {
+      futures.push_back(kvstore::DeleteRange(
+          db.stores[c], KeyRange::Prefix(absl::StrFormat("%02d/", c))));
+    }
+    WaitAll(futures);
+  }
+  state.SetItemsProcessed(state.iterations() * num_cooperators *
+                          kKeysPerCooperator);
+}
+
+BENCHMARK(BM_DistributedDeleteRange)->Arg(1)->Arg(4)->UseRealTime();
+
+}  // namespace
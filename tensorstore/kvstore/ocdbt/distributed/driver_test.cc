@@ -37,6 +37,7 @@
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/testing/random_seed.h"
 #include "tensorstore/internal/testing/scoped_directory.h"
+#include "tensorstore/kvstore/key_range.h"
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/kvstore/ocdbt/distributed/coordinator_server.h"
 #include "tensorstore/kvstore/ocdbt/format/btree.h"
@@ -202,6 +203,60 @@ TEST_F(DistributedTest, MultipleCooperatorsManyWrites) {
   }
 }
 
+TEST_F(DistributedTest, MultipleCooperatorsDeleteRange) {
+  tensorstore::internal_testing::ScopedTemporaryDirectory tempdir;
+  ::nlohmann::json base_kvs_store_spec{{"driver", "file"},
+                                       {"path", tempdir.path() + "/"}};
+  ::nlohmann::json kvs_spec{
+      {"driver", "ocdbt"},
+      {"base", base_kvs_store_spec},
+      {"config", {{"max_decoded_node_bytes", 500}}},
+  };
+  constexpr size_t kNumCooperators = 3;
+  constexpr size_t kNumKeys = 100;
+  std::vector<kvstore::KvStore> stores;
+  for (size_t i = 0; i < kNumCooperators; ++i) {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto store, kvstore::Open(kvs_spec, Context(context_spec)).result());
+    stores.push_back(store);
+  }
+  std::vector<tensorstore::AnyFuture> futures;
+  for (size_t i = 0; i < kNumKeys; ++i) {
+    futures.push_back(kvstore::Write(stores[i % kNumCooperators],
+                                     absl::StrFormat("%03d", i),
+                                     absl::Cord("a")));
+  }
+  for (auto& future : futures) {
+    TENSORSTORE_ASSERT_OK(future.status());
+  }
+  futures.clear();
+
+  // Each range spans multiple leaf nodes.
+  futures.push_back(kvstore::DeleteRange(
+      stores[0], tensorstore::KeyRange("010", "040")));
+  futures.push_back(kvstore::DeleteRange(
+      stores[1], tensorstore::KeyRange("035", "070")));
+  futures.push_back(
+      kvstore::DeleteRange(stores[2], tensorstore::KeyRange("090", "")));
+  for (auto& future : futures) {
+    TENSORSTORE_ASSERT_OK(future.status());
+  }
+
+  std::vector<std::string> expected_keys;
+  for (size_t i = 0; i < kNumKeys; ++i) {
+    if ((i >= 10 && i < 70) || i >= 90) continue;
+    expected_keys.push_back(absl::StrFormat("%03d", i));
+  }
+  for (auto& store : stores) {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto map, GetMap(store));
+    std::vector<std::string> keys;
+    for (const auto& [key, value] : map) {
+      keys.push_back(key);
+    }
+    EXPECT_EQ(expected_keys, keys);
+  }
+}
+
 TEST_F(DistributedTest, TwoCooperatorsManifestDeleted) {
   ::nlohmann::json base_kvs_store_spec = "memory://";
   ::nlohmann::json kvs_spec{
@@ -163,9 +163,30 @@ TENSORSTORE_DEFINE_JSON_DEFAULT_BINDER(
             "experimental_read_coalescing_interval",
             jb::Projection<
                 &OcdbtDriverSpecData::experimental_read_coalescing_interval>()),
+        jb::Member(
+            "experimental_read_coalescing_adaptive",
+            jb::Projection<
+                &OcdbtDriverSpecData::experimental_read_coalescing_adaptive>()),
         jb::Member(
             "target_data_file_size",
             jb::Projection<&OcdbtDriverSpecData::target_data_file_size>()),
+        jb::Member(
+            "experimental_max_in_flight_btree_nodes",
+            jb::Projection<&OcdbtDriverSpecData::
+                               experimental_max_in_flight_btree_nodes>(
+                jb::Optional(jb::Integer<size_t>(1)))),
+        jb::Member(
+            "experimental_manifest_poll_interval",
+            jb::Projection<
+                &OcdbtDriverSpecData::experimental_manifest_poll_interval>()),
+        jb::Member(
+            "experimental_data_file_flush_delay",
+            jb::Projection<
+                &OcdbtDriverSpecData::experimental_data_file_flush_delay>()),
+        jb::Member(
+            "experimental_max_in_flight_data_file_bytes",
+            jb::Projection<&OcdbtDriverSpecData::
+                               experimental_max_in_flight_data_file_bytes>()),
         jb::Member("coordinator",
                    jb::Projection<&OcdbtDriverSpecData::coordinator>()),
         jb::Member(internal::CachePoolResource::id,
@@ -205,12 +226,23 @@ Future<kvstore::DriverPtr> OcdbtDriverSpec::DoOpen() const {
             spec->data_.experimental_read_coalescing_merged_bytes;
         driver->experimental_read_coalescing_interval_ =
             spec->data_.experimental_read_coalescing_interval;
+        driver->experimental_read_coalescing_adaptive_ =
+            spec->data_.experimental_read_coalescing_adaptive;
         driver->target_data_file_size_ = spec->data_.target_data_file_size;
+        driver->experimental_max_in_flight_btree_nodes_ =
+            spec->data_.experimental_max_in_flight_btree_nodes;
+        driver->experimental_manifest_poll_interval_ =
+            spec->data_.experimental_manifest_poll_interval;
+        driver->experimental_data_file_flush_delay_ =
+            spec->data_.experimental_data_file_flush_delay;
+        driver->experimental_max_in_flight_data_file_bytes_ =
+            spec->data_.experimental_max_in_flight_data_file_bytes;
 
         std::optional<ReadCoalesceOptions> read_coalesce_options;
         if (driver->experimental_read_coalescing_threshold_bytes_ ||
             driver->experimental_read_coalescing_merged_bytes_ ||
-            driver->experimental_read_coalescing_interval_) {
+            driver->experimental_read_coalescing_interval_ ||
+            driver->experimental_read_coalescing_adaptive_.value_or(false)) {
           read_coalesce_options.emplace();
           read_coalesce_options->max_overhead_bytes_per_request =
               static_cast<int64_t>(
@@ -223,6 +255,8 @@ Future<kvstore::DriverPtr> OcdbtDriverSpec::DoOpen() const {
           read_coalesce_options->max_interval =
               driver->experimental_read_coalescing_interval_.value_or(
                   absl::ZeroDuration());
+          read_coalesce_options->adaptive =
+              driver->experimental_read_coalescing_adaptive_.value_or(false);
         }
 
         TENSORSTORE_ASSIGN_OR_RETURN(
@@ -237,7 +271,14 @@ Future<kvstore::DriverPtr> OcdbtDriverSpec::DoOpen() const {
                                              : driver->base_,
             std::move(config_state), driver->data_file_prefixes_,
             driver->target_data_file_size_.value_or(kDefaultTargetBufferSize),
-            std::move(read_coalesce_options));
+            std::move(read_coalesce_options),
+            driver->experimental_max_in_flight_btree_nodes_.value_or(
+                kDefaultMaxInFlightBtreeNodes),
+            driver->experimental_manifest_poll_interval_.value_or(
+                absl::ZeroDuration()),
+            driver->experimental_data_file_flush_delay_.value_or(
+                absl::InfiniteDuration()),
+            driver->experimental_max_in_flight_data_file_bytes_.value_or(0));
         driver->btree_writer_ =
             MakeNonDistributedBtreeWriter(driver->io_handle_);
         driver->coordinator_ = spec->data_.coordinator;
@@ -299,7 +340,16 @@ absl::Status OcdbtDriver::GetBoundSpecData(OcdbtDriverSpecData& spec) const {
       experimental_read_coalescing_merged_bytes_;
   spec.experimental_read_coalescing_interval =
       experimental_read_coalescing_interval_;
+  spec.experimental_read_coalescing_adaptive =
+      experimental_read_coalescing_adaptive_;
   spec.target_data_file_size = target_data_file_size_;
+  spec.experimental_max_in_flight_btree_nodes =
+      experimental_max_in_flight_btree_nodes_;
+  spec.experimental_manifest_poll_interval =
+      experimental_manifest_poll_interval_;
+  spec.experimental_data_file_flush_delay = experimental_data_file_flush_delay_;
+  spec.experimental_max_in_flight_data_file_bytes =
+      experimental_max_in_flight_data_file_bytes_;
   spec.coordinator = coordinator_;
   return absl::Status();
 }
@@ -459,6 +509,25 @@ Future<kvstore::ReadResult> OcdbtDriver::TransactionalRead(
       this, *io_handle_, transaction, std::move(key), std::move(options));
 }
 
+Result<OcdbtDriver*> GetOcdbtDriverForDatabase(const KvStore& store,
+                                               std::string_view operation) {
+  auto* driver = dynamic_cast<OcdbtDriver*>(store.driver.get());
+  if (!driver) {
+    return absl::InvalidArgumentError(
+        tensorstore::StrCat(operation, " requires an OCDBT kvstore"));
+  }
+  if (!store.path.empty()) {
+    return absl::InvalidArgumentError(tensorstore::StrCat(
+        operation, " requires a kvstore that refers to the root of the ",
+        "database, but path is ", tensorstore::QuoteString(store.path)));
+  }
+  if (store.transaction != no_transaction) {
+    return absl::InvalidArgumentError(tensorstore::StrCat(
+        operation, " does not support transactions"));
+  }
+  return driver;
+}
+
 }  // namespace internal_ocdbt
 }  // namespace tensorstore
 
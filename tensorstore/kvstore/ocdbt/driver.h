@@ -87,7 +87,12 @@ struct OcdbtDriverSpecData {
   std::optional<size_t> experimental_read_coalescing_threshold_bytes;
   std::optional<size_t> experimental_read_coalescing_merged_bytes;
   std::optional<absl::Duration> experimental_read_coalescing_interval;
+  std::optional<bool> experimental_read_coalescing_adaptive;
   std::optional<size_t> target_data_file_size;
+  std::optional<size_t> experimental_max_in_flight_btree_nodes;
+  std::optional<absl::Duration> experimental_manifest_poll_interval;
+  std::optional<absl::Duration> experimental_data_file_flush_delay;
+  std::optional<size_t> experimental_max_in_flight_data_file_bytes;
   bool assume_config = false;
   Context::Resource<OcdbtCoordinatorResource> coordinator;
 
@@ -101,8 +106,12 @@ struct OcdbtDriverSpecData {
              x.data_copy_concurrency,
              x.experimental_read_coalescing_threshold_bytes,
              x.experimental_read_coalescing_merged_bytes,
-             x.experimental_read_coalescing_interval, x.target_data_file_size,
-             x.coordinator);
+             x.experimental_read_coalescing_interval,
+             x.experimental_read_coalescing_adaptive, x.target_data_file_size,
+             x.experimental_max_in_flight_btree_nodes,
+             x.experimental_manifest_poll_interval,
+             x.experimental_data_file_flush_delay,
+             x.experimental_max_in_flight_data_file_bytes, x.coordinator);
   };
 };
 
@@ -174,10 +183,22 @@ class OcdbtDriver
   std::optional<size_t> experimental_read_coalescing_threshold_bytes_;
   std::optional<size_t> experimental_read_coalescing_merged_bytes_;
   std::optional<absl::Duration> experimental_read_coalescing_interval_;
+  std::optional<bool> experimental_read_coalescing_adaptive_;
   std::optional<size_t> target_data_file_size_;
+  std::optional<size_t> experimental_max_in_flight_btree_nodes_;
+  std::optional<absl::Duration> experimental_manifest_poll_interval_;
+  std::optional<absl::Duration> experimental_data_file_flush_delay_;
+  std::optional<size_t> experimental_max_in_flight_data_file_bytes_;
   Context::Resource<OcdbtCoordinatorResource> coordinator_;
 };
 
+// Returns the driver of `store`, which must be an OCDBT kvstore that refers to
+// the root of the database and is not bound to a transaction.
+//
+// `operation` names the requested operation in error messages.
+Result<OcdbtDriver*> GetOcdbtDriverForDatabase(const KvStore& store,
+                                               std::string_view operation);
+
 }  // namespace internal_ocdbt
 
 namespace garbage_collection {
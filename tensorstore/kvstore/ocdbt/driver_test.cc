@@ -17,10 +17,13 @@
 #include <stdint.h>
 
 #include <initializer_list>
+#include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
+#include <variant>
 #include <vector>
 
 #include <gmock/gmock.h>
@@ -32,6 +35,7 @@
 #include "tensorstore/context.h"
 #include "tensorstore/internal/cache/kvs_backed_cache_testutil.h"
 #include "tensorstore/internal/global_initializer.h"
+#include "tensorstore/internal/metrics/registry.h"
 #include "tensorstore/internal/testing/dynamic.h"
 #include "tensorstore/internal/testing/json_gtest.h"
 #include "tensorstore/internal/testing/scoped_directory.h"
@@ -70,8 +74,10 @@ using ::tensorstore::internal::MatchesKvsReadResult;
 using ::tensorstore::internal::MatchesKvsReadResultNotFound;
 using ::tensorstore::internal::MatchesListEntry;
 using ::tensorstore::internal::MockKeyValueStore;
+using ::tensorstore::internal_ocdbt::BtreeNode;
 using ::tensorstore::internal_ocdbt::Config;
 using ::tensorstore::internal_ocdbt::ConfigConstraints;
+using ::tensorstore::internal_ocdbt::IndirectDataReference;
 using ::tensorstore::internal_ocdbt::ManifestKind;
 using ::tensorstore::internal_ocdbt::OcdbtDriver;
 using ::tensorstore::internal_ocdbt::ReadManifest;
@@ -351,6 +357,284 @@ TEST(OcdbtTest, DeleteRangeMinArity) {
               MatchesKvsReadResultNotFound());
 }
 
+// Returns the height of the root node of the latest version.
+int GetRootHeight(tensorstore::KvStore& store) {
+  auto& driver = static_cast<OcdbtDriver&>(*store.driver);
+  auto manifest = ReadManifest(driver).value();
+  return manifest ? manifest->latest_version().root_height : 0;
+}
+
+// Opens an OCDBT database with small nodes, and writes `num_keys` keys to it.
+//
+// Members of `extra_spec` are added to the driver spec.
+tensorstore::KvStore OpenSmallNodeStore(
+    size_t num_keys, ::nlohmann::json::object_t extra_spec = {}) {
+  ::nlohmann::json::object_t spec{
+      {"driver", "ocdbt"},
+      {"base", "memory://"},
+      {"config", {{"max_decoded_node_bytes", 500}}},
+  };
+  spec.merge(extra_spec);
+  auto store = kvstore::Open(spec).value();
+  std::vector<tensorstore::Future<tensorstore::TimestampedStorageGeneration>>
+      futures;
+  for (size_t i = 0; i < num_keys; ++i) {
+    futures.push_back(kvstore::Write(store, absl::StrFormat("key%04d", i),
+                                     absl::Cord("value")));
+  }
+  for (auto& future : futures) {
+    TENSORSTORE_EXPECT_OK(future.result());
+  }
+  return store;
+}
+
+TEST(OcdbtTest, MergeUnderfullNodes) {
+  constexpr size_t kNumKeys = 400;
+  constexpr size_t kStride = 25;
+  auto store = OpenSmallNodeStore(kNumKeys);
+  const int initial_height = GetRootHeight(store);
+  EXPECT_GE(initial_height, 2);
+
+  // Delete all but every `kStride`-th key.
+  std::vector<tensorstore::Future<tensorstore::TimestampedStorageGeneration>>
+      futures;
+  for (size_t i = 0; i < kNumKeys; ++i) {
+    if (i % kStride == 0) continue;
+    futures.push_back(kvstore::Delete(store, absl::StrFormat("key%04d", i)));
+  }
+  for (auto& future : futures) {
+    TENSORSTORE_ASSERT_OK(future.result());
+  }
+
+  EXPECT_LT(GetRootHeight(store), initial_height);
+  std::map<std::string, absl::Cord> expected;
+  for (size_t i = 0; i < kNumKeys; i += kStride) {
+    expected.emplace(absl::StrFormat("key%04d", i), absl::Cord("value"));
+  }
+  EXPECT_THAT(GetMap(store), ::testing::Optional(expected));
+
+  // The database remains writable.
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "key0001", absl::Cord("new")));
+  EXPECT_THAT(kvstore::Read(store, "key0001").result(),
+              MatchesKvsReadResult(absl::Cord("new")));
+}
+
+TEST(OcdbtTest, MergeUnderfullNodesToSingleLeaf) {
+  constexpr size_t kNumKeys = 400;
+  auto store = OpenSmallNodeStore(kNumKeys);
+  const int initial_height = GetRootHeight(store);
+  EXPECT_GE(initial_height, 2);
+
+  TENSORSTORE_ASSERT_OK(
+      kvstore::DeleteRange(store, KeyRange("key0001", "")).result());
+  EXPECT_LT(GetRootHeight(store), initial_height);
+  EXPECT_THAT(GetMap(store),
+              ::testing::Optional(::testing::ElementsAre(
+                  ::testing::Pair("key0000", absl::Cord("value")))));
+
+  // The height is reduced by one level per commit.
+  for (int i = 0; i < initial_height && GetRootHeight(store) != 0; ++i) {
+    TENSORSTORE_ASSERT_OK(kvstore::Write(store, "key0000", absl::Cord("new")));
+  }
+  EXPECT_EQ(0, GetRootHeight(store));
+  EXPECT_THAT(GetMap(store),
+              ::testing::Optional(::testing::ElementsAre(
+                  ::testing::Pair("key0000", absl::Cord("new")))));
+}
+
+TEST(OcdbtTest, UnderfullNodesWithoutRemovedEntriesNotMerged) {
+  auto store = kvstore::Open({{"driver", "ocdbt"},
+                              {"base", "memory://"},
+                              {"config",
+                               {{"max_decoded_node_bytes", 500},
+                                {"max_inline_value_bytes", 400}}}})
+                   .value();
+  // Each large inline value fills most of a leaf node.
+  const absl::Cord large_value(std::string(400, 'x'));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", large_value));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "b", large_value));
+  ASSERT_EQ(1, GetRootHeight(store));
+
+  // Returns the locations of the children of the root node.
+  auto& driver = static_cast<OcdbtDriver&>(*store.driver);
+  const auto get_leaf_locations = [&] {
+    auto manifest = ReadManifest(driver).value();
+    const auto& root = manifest->latest_version().root;
+    auto node = driver.io_handle_->GetBtreeNode(root.location).value();
+    std::vector<IndirectDataReference> locations;
+    for (const auto& entry :
+         std::get<BtreeNode::InteriorNodeEntries>(node->entries)) {
+      locations.push_back(entry.node.location);
+    }
+    return locations;
+  };
+  const auto initial_locations = get_leaf_locations();
+  ASSERT_EQ(2, initial_locations.size());
+
+  // Shrinking the value of "b" and then appending "c" leaves the second leaf
+  // underfull, but no entries were removed, so the first leaf is neither
+  // read nor rewritten.
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "b", absl::Cord("b")));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "c", absl::Cord("c")));
+  EXPECT_EQ(1, GetRootHeight(store));
+  auto locations = get_leaf_locations();
+  ASSERT_EQ(2, locations.size());
+  EXPECT_EQ(initial_locations[0], locations[0]);
+
+  // Removing an entry from the underfull leaf merges it with its sibling.
+  TENSORSTORE_ASSERT_OK(kvstore::Delete(store, "c"));
+  EXPECT_EQ(0, GetRootHeight(store));
+  EXPECT_THAT(GetMap(store), ::testing::Optional(::testing::ElementsAre(
+                                 ::testing::Pair("a", large_value),
+                                 ::testing::Pair("b", absl::Cord("b")))));
+}
+
+TEST(OcdbtTest, ListBoundedInFlightNodes) {
+  constexpr size_t kNumKeys = 400;
+  for (size_t max_in_flight : {1, 3}) {
+    SCOPED_TRACE(absl::StrFormat("max_in_flight=%d", max_in_flight));
+    auto store = OpenSmallNodeStore(
+        kNumKeys, {{"experimental_max_in_flight_btree_nodes", max_in_flight}});
+    EXPECT_GE(GetRootHeight(store), 2);
+
+    // Keys are emitted in order.
+    std::vector<std::string> expected_keys;
+    for (size_t i = 0; i < kNumKeys; ++i) {
+      expected_keys.push_back(absl::StrFormat("key%04d", i));
+    }
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto entries,
+                                     kvstore::ListFuture(store).result());
+    std::vector<std::string> keys;
+    for (const auto& entry : entries) keys.push_back(entry.key);
+    EXPECT_THAT(keys, ::testing::ElementsAreArray(expected_keys));
+
+    kvstore::ListOptions options;
+    options.range = KeyRange("key0100", "key0300");
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        entries, kvstore::ListFuture(store, std::move(options)).result());
+    keys.clear();
+    for (const auto& entry : entries) keys.push_back(entry.key);
+    EXPECT_THAT(keys, ::testing::ElementsAreArray(expected_keys.begin() + 100,
+                                                  expected_keys.begin() + 300));
+  }
+}
+
+TEST(OcdbtTest, InvalidMaxInFlightBtreeNodes) {
+  EXPECT_THAT(kvstore::Open({{"driver", "ocdbt"},
+                             {"base", "memory://"},
+                             {"experimental_max_in_flight_btree_nodes", 0}})
+                  .result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(OcdbtTest, KeyFilter) {
+  constexpr size_t kNumKeys = 400;
+  auto store = kvstore::Open({{"driver", "ocdbt"},
+                              {"base", "memory://"},
+                              {"config",
+                               {{"max_decoded_node_bytes", 500},
+                                {"key_filter_bits_per_key", 10}}}})
+                   .value();
+  std::vector<tensorstore::Future<tensorstore::TimestampedStorageGeneration>>
+      futures;
+  for (size_t i = 0; i < kNumKeys; i += 2) {
+    futures.push_back(kvstore::Write(store, absl::StrFormat("key%04d", i),
+                                     absl::Cord("value")));
+  }
+  for (auto& future : futures) {
+    TENSORSTORE_ASSERT_OK(future.result());
+  }
+
+  auto& driver = static_cast<OcdbtDriver&>(*store.driver);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto manifest, ReadManifest(driver));
+  ASSERT_TRUE(manifest);
+  EXPECT_EQ(10, manifest->config.key_filter_bits_per_key);
+  ASSERT_GE(manifest->latest_version().root_height, 1);
+
+  // Every reference to a leaf node includes a key filter.
+  auto node_ref = manifest->latest_version().root;
+  while (true) {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto node, driver.io_handle_->GetBtreeNode(node_ref.location).result());
+    auto& entries = std::get<BtreeNode::InteriorNodeEntries>(node->entries);
+    if (node->height == 1) {
+      for (auto& entry : entries) {
+        EXPECT_THAT(entry.node.key_filter,
+                    ::testing::Not(::testing::IsEmpty()));
+      }
+      break;
+    }
+    node_ref = entries.front().node;
+  }
+
+  for (size_t i = 0; i < kNumKeys; ++i) {
+    auto key = absl::StrFormat("key%04d", i);
+    if (i % 2 == 0) {
+      EXPECT_THAT(kvstore::Read(store, key).result(),
+                  MatchesKvsReadResult(absl::Cord("value")));
+    } else {
+      EXPECT_THAT(kvstore::Read(store, key).result(),
+                  MatchesKvsReadResultNotFound());
+    }
+  }
+
+  // The key filters are updated by subsequent writes.
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "key0001", absl::Cord("new")));
+  EXPECT_THAT(kvstore::Read(store, "key0001").result(),
+              MatchesKvsReadResult(absl::Cord("new")));
+}
+
+int64_t GetCounterValue(std::string_view metric_name) {
+  auto metric =
+      tensorstore::internal_metrics::GetMetricRegistry().Collect(metric_name);
+  if (!metric || metric->values.empty()) return 0;
+  return std::get<int64_t>(metric->values[0].value);
+}
+
+int64_t GetManifestFetchCount() {
+  return GetCounterValue("/tensorstore/kvstore/ocdbt/manifest_reads") +
+         GetCounterValue("/tensorstore/kvstore/ocdbt/numbered_manifest_lists") +
+         GetCounterValue("/tensorstore/kvstore/ocdbt/numbered_manifest_reads");
+}
+
+TEST(OcdbtTest, ManifestFetchedForEachRead) {
+  auto store =
+      kvstore::Open({{"driver", "ocdbt"}, {"base", "memory://"}}).value();
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord("b")));
+  const int64_t fetches_before = GetManifestFetchCount();
+  EXPECT_THAT(kvstore::Read(store, "a").result(),
+              MatchesKvsReadResult(absl::Cord("b")));
+  EXPECT_EQ(fetches_before + 1, GetManifestFetchCount());
+}
+
+TEST(OcdbtTest, ManifestPollInterval) {
+  for (const char* manifest_kind : {"single", "numbered"}) {
+    SCOPED_TRACE(manifest_kind);
+    auto store = kvstore::Open({{"driver", "ocdbt"},
+                                {"base", "memory://"},
+                                {"config", {{"manifest_kind", manifest_kind}}},
+                                {"experimental_manifest_poll_interval", "1h"}})
+                     .value();
+    TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord("b")));
+
+    // Reads and lists use the cached manifest rather than fetching it again.
+    const int64_t fetches_before = GetManifestFetchCount();
+    for (int i = 0; i < 10; ++i) {
+      EXPECT_THAT(kvstore::Read(store, "a").result(),
+                  MatchesKvsReadResult(absl::Cord("b")));
+    }
+    EXPECT_THAT(kvstore::ListFuture(store).result(),
+                ::testing::Optional(
+                    ::testing::ElementsAre(MatchesListEntry("a"))));
+    EXPECT_EQ(fetches_before, GetManifestFetchCount());
+
+    // Writes still observe their own updates.
+    TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord("c")));
+    EXPECT_THAT(kvstore::Read(store, "a").result(),
+                MatchesKvsReadResult(absl::Cord("c")));
+  }
+}
+
 TEST(OcdbtTest, SpecRoundtrip) {
   tensorstore::internal::KeyValueStoreSpecRoundtripOptions options;
   options.create_spec = {
@@ -551,6 +835,28 @@ TENSORSTORE_GLOBAL_INITIALIZER {
     };
     RegisterKeyValueStoreOpsTests(params);
   }
+  {
+    KeyValueStoreOpsTestParameters params;
+    params.test_delete_range = false;
+    params.test_list = false;
+    params.test_transactional_list = false;
+    params.test_name = "WithAdaptiveReadCoalescing";
+    params.get_store = [](auto callback) {
+      ::nlohmann::json json_spec{
+          {"driver", "ocdbt"},
+          {"base", {{"driver", "memory"}}},
+          {"config", {{"max_decoded_node_bytes", 1}}},
+          {"experimental_read_coalescing_adaptive", true},
+      };
+      TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+          auto store, tensorstore::kvstore::Open(json_spec).result());
+      EXPECT_THAT(
+          store.spec().value().ToJson(tensorstore::IncludeDefaults{false}),
+          ::testing::Optional(tensorstore::MatchesJson(json_spec)));
+      callback(store);
+    };
+    RegisterKeyValueStoreOpsTests(params);
+  }
 }
 
 // Tests that if a batch of writes leaves a node unmodified, it is not
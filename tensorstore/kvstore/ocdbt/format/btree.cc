@@ -181,17 +181,24 @@ bool ReadKeys(riegeli::Reader& reader, std::string_view& common_prefix,
 template <typename Entry>
 bool ReadBtreeNodeEntries(riegeli::Reader& reader,
                           const DataFileTable& data_file_table,
-                          uint64_t num_entries, BtreeNode& node) {
+                          uint64_t num_entries, uint32_t version,
+                          BtreeNode& node) {
   auto& entries = node.entries.emplace<std::vector<Entry>>();
   entries.resize(num_entries);
   if (!ReadKeys<Entry>(reader, node.key_prefix, node.key_buffer, entries)) {
     return false;
   }
   if constexpr (std::is_same_v<Entry, InteriorNodeEntry>) {
-    return BtreeNodeReferenceArrayCodec{data_file_table,
-                                        [](auto& entry) -> decltype(auto) {
-                                          return (entry.node);
-                                        }}(reader, entries);
+    if (!BtreeNodeReferenceArrayCodec{data_file_table,
+                                      [](auto& entry) -> decltype(auto) {
+                                        return (entry.node);
+                                      }}(reader, entries)) {
+      return false;
+    }
+    if (version < kBtreeNodeKeyFilterFormatVersion) return true;
+    return KeyFilterArrayCodec{[](auto& entry) -> decltype(auto) {
+      return (entry.node.key_filter);
+    }}(reader, entries);
   } else {
     return LeafNodeValueReferenceArrayCodec{data_file_table,
                                             [](auto& entry) -> decltype(auto) {
@@ -206,7 +213,7 @@ Result<BtreeNode> DecodeBtreeNode(const absl::Cord& encoded,
                                   const BasePath& base_path) {
   BtreeNode node;
   auto status = DecodeWithOptionalCompression(
-      encoded, kBtreeNodeMagic, kBtreeNodeFormatVersion,
+      encoded, kBtreeNodeMagic, kMaxBtreeNodeFormatVersion,
       [&](riegeli::Reader& reader, uint32_t version) -> bool {
         if (!reader.ReadByte(node.height)) return false;
         DataFileTable data_file_table;
@@ -226,11 +233,11 @@ Result<BtreeNode> DecodeBtreeNode(const absl::Cord& encoded,
           return false;
         }
         if (node.height == 0) {
-          return ReadBtreeNodeEntries<LeafNodeEntry>(reader, data_file_table,
-                                                     num_entries, node);
+          return ReadBtreeNodeEntries<LeafNodeEntry>(
+              reader, data_file_table, num_entries, version, node);
         } else {
           return ReadBtreeNodeEntries<InteriorNodeEntry>(
-              reader, data_file_table, num_entries, node);
+              reader, data_file_table, num_entries, version, node);
         }
       });
   if (!status.ok()) {
@@ -306,12 +313,16 @@ std::ostream& operator<<(std::ostream& os, const LeafNodeEntry& e) {
 }
 
 bool operator==(const BtreeNodeReference& a, const BtreeNodeReference& b) {
-  return a.location == b.location && a.statistics == b.statistics;
+  return a.location == b.location && a.statistics == b.statistics &&
+         a.key_filter == b.key_filter;
 }
 
 std::ostream& operator<<(std::ostream& os, const BtreeNodeReference& x) {
-  return os << "{location=" << x.location << ", statistics=" << x.statistics
-            << "}";
+  os << "{location=" << x.location << ", statistics=" << x.statistics;
+  if (!x.key_filter.empty()) {
+    os << ", key_filter_bytes=" << x.key_filter.size();
+  }
+  return os << "}";
 }
 
 std::ostream& operator<<(std::ostream& os, const InteriorNodeEntry& e) {
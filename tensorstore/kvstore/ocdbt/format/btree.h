@@ -87,6 +87,14 @@ struct BtreeNodeReference {
   /// Statistics for the referenced sub-tree.
   BtreeNodeStatistics statistics;
 
+  /// Bloom filter over the full keys within the referenced sub-tree, encoded
+  /// as described in `key_filter.h`.  Empty if there is no filter, in which
+  /// case any key may be present.
+  ///
+  /// Only stored within interior nodes, for references to leaf nodes, when
+  /// `Config::key_filter_bits_per_key` is non-zero.
+  std::string key_filter;
+
   friend bool operator==(const BtreeNodeReference& a,
                          const BtreeNodeReference& b);
   friend bool operator!=(const BtreeNodeReference& a,
@@ -96,7 +104,7 @@ struct BtreeNodeReference {
   friend std::ostream& operator<<(std::ostream& os,
                                   const BtreeNodeReference& x);
   constexpr static auto ApplyMembers = [](auto&& x, auto f) {
-    return f(x.location, x.statistics);
+    return f(x.location, x.statistics, x.key_filter);
   };
 };
 
@@ -275,7 +283,8 @@ inline size_t EstimateDecodedEntrySizeExcludingKey(const LeafNodeEntry& entry) {
 /// an interior node entry.
 inline size_t EstimateDecodedEntrySizeExcludingKey(
     const InteriorNodeEntry& entry) {
-  return kInteriorNodeFixedSize + entry.node.location.file_id.size();
+  return kInteriorNodeFixedSize + entry.node.location.file_id.size() +
+         entry.node.key_filter.size();
 }
 
 /// Validates that a b+tree node has the expected height and min key.
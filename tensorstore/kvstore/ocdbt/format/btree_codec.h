@@ -37,6 +37,7 @@
 #include "tensorstore/kvstore/ocdbt/format/data_file_id_codec.h"
 #include "tensorstore/kvstore/ocdbt/format/indirect_data_reference.h"
 #include "tensorstore/kvstore/ocdbt/format/indirect_data_reference_codec.h"
+#include "tensorstore/kvstore/ocdbt/format/key_filter.h"
 #include "tensorstore/util/status.h"
 
 namespace tensorstore {
@@ -44,6 +45,19 @@ namespace internal_ocdbt {
 
 constexpr uint32_t kBtreeNodeMagic = 0x0cdb20de;
 constexpr uint8_t kBtreeNodeFormatVersion = 0;
+
+/// Format version that adds the `key_filter` column to interior nodes.
+///
+/// Only used when `Config::key_filter_bits_per_key` is non-zero, so that
+/// databases that do not use key filters remain readable by older versions.
+constexpr uint8_t kBtreeNodeKeyFilterFormatVersion = 1;
+constexpr uint8_t kMaxBtreeNodeFormatVersion = kBtreeNodeKeyFilterFormatVersion;
+
+/// Returns the format version with which b+tree nodes are encoded.
+inline uint8_t GetBtreeNodeFormatVersion(const Config& config) {
+  return config.key_filter_bits_per_key ? kBtreeNodeKeyFilterFormatVersion
+                                        : kBtreeNodeFormatVersion;
+}
 constexpr size_t kMaxNodeArity = 1024 * 1024;
 
 using NumIndirectValueBytesCodec = VarintCodec<uint64_t>;
@@ -112,6 +126,42 @@ BtreeNodeReferenceArrayCodec(const DataFileTable&, Getter,
                              bool allow_missing = false)
     -> BtreeNodeReferenceArrayCodec<DataFileTable, Getter>;
 
+using KeyFilterLengthCodec = VarintCodec<uint64_t>;
+
+/// Codec for the `key_filter` column of interior nodes.
+template <typename Getter>
+struct KeyFilterArrayCodec {
+  Getter getter;
+  template <typename Vec>
+  [[nodiscard]] bool operator()(riegeli::Reader& reader, Vec&& vec) const {
+    std::vector<uint64_t> lengths(vec.size());
+    for (auto& length : lengths) {
+      if (!KeyFilterLengthCodec{}(reader, length)) return false;
+    }
+    for (size_t i = 0; i < vec.size(); ++i) {
+      auto& key_filter = getter(vec[i]);
+      if (!reader.Read(lengths[i], key_filter)) return false;
+      TENSORSTORE_RETURN_IF_ERROR(ValidateKeyFilter(key_filter),
+                                  (reader.Fail(_), false));
+    }
+    return true;
+  }
+
+  template <typename Vec>
+  [[nodiscard]] bool operator()(riegeli::Writer& writer, Vec&& vec) const {
+    for (auto& entry : vec) {
+      if (!KeyFilterLengthCodec{}(writer, getter(entry).size())) return false;
+    }
+    for (auto& entry : vec) {
+      if (!writer.Write(getter(entry))) return false;
+    }
+    return true;
+  }
+};
+
+template <typename Getter>
+KeyFilterArrayCodec(Getter) -> KeyFilterArrayCodec<Getter>;
+
 template <typename DataFileTable, typename Getter>
 struct LeafNodeValueReferenceArrayCodec {
   const DataFileTable& data_file_table;
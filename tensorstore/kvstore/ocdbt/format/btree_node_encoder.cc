@@ -15,6 +15,7 @@
 #include "tensorstore/kvstore/ocdbt/format/btree_node_encoder.h"
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <algorithm>
 #include <cassert>
@@ -41,6 +42,7 @@
 #include "tensorstore/kvstore/ocdbt/format/config.h"
 #include "tensorstore/kvstore/ocdbt/format/data_file_id_codec.h"
 #include "tensorstore/kvstore/ocdbt/format/indirect_data_reference.h"
+#include "tensorstore/kvstore/ocdbt/format/key_filter.h"
 #include "tensorstore/util/division.h"
 #include "tensorstore/util/quote_string.h"
 #include "tensorstore/util/result.h"
@@ -193,14 +195,26 @@ void BtreeNodeEncoder<Entry>::AddEntry(bool existing, Entry&& entry) {
 namespace {
 template <typename Entry>
 bool EncodeEntriesInner(
-    riegeli::Writer& writer, BtreeNodeHeight height,
-    std::string_view existing_prefix,
+    riegeli::Writer& writer, uint32_t version, uint8_t key_filter_bits_per_key,
+    BtreeNodeHeight height, std::string_view existing_prefix,
     span<typename BtreeNodeEncoder<Entry>::BufferedEntry> entries, bool is_root,
     EncodedNodeInfo& info) {
   info.statistics = {};
 
   if constexpr (std::is_same_v<Entry, LeafNodeEntry>) {
     info.statistics.num_keys = entries.size();
+    // The root node is not referenced from an interior node, and therefore
+    // does not need a key filter.
+    if (key_filter_bits_per_key != 0 && !is_root) {
+      std::vector<uint32_t> key_hashes;
+      key_hashes.reserve(entries.size());
+      for (const auto& entry : entries) {
+        key_hashes.push_back(GetKeyFilterHash(
+            entry.existing ? existing_prefix : std::string_view{},
+            entry.entry.key));
+      }
+      info.key_filter = BuildKeyFilter(key_hashes, key_filter_bits_per_key);
+    }
   } else {
     for (const auto& entry : entries) {
       info.statistics += entry.entry.node.statistics;
@@ -295,6 +309,12 @@ bool EncodeEntriesInner(
                                       }}(writer, entries)) {
       return false;
     }
+    if (version >= kBtreeNodeKeyFilterFormatVersion &&
+        !KeyFilterArrayCodec{[](auto& e) -> decltype(auto) {
+          return (e.entry.node.key_filter);
+        }}(writer, entries)) {
+      return false;
+    }
   }
   return true;
 }
@@ -307,13 +327,14 @@ Result<EncodedNode> EncodeEntries(
     span<typename BtreeNodeEncoder<Entry>::BufferedEntry> entries,
     bool is_root) {
   EncodedNode encoded;
+  const uint32_t version = GetBtreeNodeFormatVersion(config);
   auto result = EncodeWithOptionalCompression(
-      config, kBtreeNodeMagic, kBtreeNodeFormatVersion,
-      [&](riegeli::Writer& writer) -> bool {
+      config, kBtreeNodeMagic, version, [&](riegeli::Writer& writer) -> bool {
         // height
         if (!writer.WriteByte(height)) return false;
-        return EncodeEntriesInner<Entry>(writer, height, existing_prefix,
-                                         entries, is_root, encoded.info);
+        return EncodeEntriesInner<Entry>(
+            writer, version, config.key_filter_bits_per_key, height,
+            existing_prefix, entries, is_root, encoded.info);
       });
   TENSORSTORE_ASSIGN_OR_RETURN(
       encoded.encoded_node, std::move(result),
@@ -385,6 +406,8 @@ Result<std::vector<EncodedNode>> BtreeNodeEncoder<Entry>::Finalize(
             config_, height_, existing_prefix_,
             span(buffered_entries_.data() + start_i, end_i - start_i),
             may_be_root && start_i == 0 && end_i == buffered_entries_.size()));
+    encoded_node.info.num_entries = end_i - start_i;
+    encoded_node.info.decoded_size_estimate = get_range_size(end_i);
     encoded_nodes.push_back(std::move(encoded_node));
     start_i = end_i;
     prev_size_estimate = buffered_entries_[end_i - 1].cumulative_size;
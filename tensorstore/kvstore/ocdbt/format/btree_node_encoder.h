@@ -15,6 +15,8 @@
 #ifndef TENSORSTORE_KVSTORE_OCDBT_FORMAT_BTREE_NODE_ENCODER_H_
 #define TENSORSTORE_KVSTORE_OCDBT_FORMAT_BTREE_NODE_ENCODER_H_
 
+#include <stddef.h>
+
 #include <string>
 #include <string_view>
 #include <vector>
@@ -37,6 +39,17 @@ struct EncodedNodeInfo {
 
   /// Statistics for the encoded node.
   BtreeNodeStatistics statistics;
+
+  /// Number of entries in the encoded node.
+  size_t num_entries = 0;
+
+  /// Estimated size of the decoded node, as used to determine node splits.
+  size_t decoded_size_estimate = 0;
+
+  /// Key filter for the encoded node, to be stored in the parent's reference
+  /// to it.  Only computed for non-root leaf nodes when
+  /// `Config::key_filter_bits_per_key` is non-zero.
+  std::string key_filter;
 };
 
 /// Encoded b+tree node, generated by `BtreeNodeEncoder`.
@@ -15,6 +15,7 @@
 #include "tensorstore/kvstore/ocdbt/format/btree.h"
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <algorithm>
 #include <string>
@@ -33,6 +34,7 @@
 #include "tensorstore/kvstore/ocdbt/format/btree_node_encoder.h"
 #include "tensorstore/kvstore/ocdbt/format/codec_util.h"
 #include "tensorstore/kvstore/ocdbt/format/config.h"
+#include "tensorstore/kvstore/ocdbt/format/key_filter.h"
 #include "tensorstore/util/quote_string.h"
 #include "tensorstore/util/status_testutil.h"
 #include "tensorstore/util/str_cat.h"
@@ -41,12 +43,16 @@ namespace {
 
 using ::tensorstore::MatchesStatus;
 using ::tensorstore::Result;
+using ::tensorstore::internal_ocdbt::BtreeLeafNodeEncoder;
 using ::tensorstore::internal_ocdbt::BtreeNode;
 using ::tensorstore::internal_ocdbt::BtreeNodeEncoder;
+using ::tensorstore::internal_ocdbt::BuildKeyFilter;
 using ::tensorstore::internal_ocdbt::Config;
 using ::tensorstore::internal_ocdbt::DecodeBtreeNode;
 using ::tensorstore::internal_ocdbt::EncodedNode;
+using ::tensorstore::internal_ocdbt::GetKeyFilterHash;
 using ::tensorstore::internal_ocdbt::InteriorNodeEntry;
+using ::tensorstore::internal_ocdbt::KeyFilterMayContain;
 using ::tensorstore::internal_ocdbt::kMaxNodeArity;
 using ::tensorstore::internal_ocdbt::LeafNodeEntry;
 
@@ -143,6 +149,66 @@ TEST(BtreeNodeTest, InteriorNodeRoundTrip) {
   TestBtreeNodeRoundTrip(config, node);
 }
 
+TEST(BtreeNodeTest, InteriorNodeKeyFilterRoundTrip) {
+  Config config;
+  config.key_filter_bits_per_key = 10;
+  BtreeNode node;
+  node.height = 1;
+  auto& entries = node.entries.emplace<BtreeNode::InteriorNodeEntries>();
+  {
+    InteriorNodeEntry entry;
+    entry.key = "abc";
+    entry.subtree_common_prefix_length = 0;
+    entry.node.location.file_id.relative_path = "def";
+    entry.node.location.length = 6;
+    entry.node.statistics.num_keys = 2;
+    const uint32_t key_hashes[] = {GetKeyFilterHash("", "abc"),
+                                   GetKeyFilterHash("", "abd")};
+    entry.node.key_filter = BuildKeyFilter(key_hashes, 10);
+    entries.push_back(entry);
+  }
+  {
+    // Key filters are optional.
+    InteriorNodeEntry entry;
+    entry.key = "def";
+    entry.subtree_common_prefix_length = 0;
+    entry.node.location.file_id.relative_path = "def1";
+    entry.node.location.length = 9;
+    entry.node.statistics.num_keys = 8;
+    entries.push_back(entry);
+  }
+  TestBtreeNodeRoundTrip(config, node);
+}
+
+TEST(BtreeNodeTest, LeafNodeKeyFilter) {
+  Config config;
+  config.key_filter_bits_per_key = 10;
+  const auto encode = [&](bool may_be_root) {
+    BtreeLeafNodeEncoder encoder(config, /*height=*/0,
+                                 /*existing_prefix=*/"ab");
+    encoder.AddEntry(/*existing=*/true, LeafNodeEntry{"c", absl::Cord("1")});
+    encoder.AddEntry(/*existing=*/false,
+                     LeafNodeEntry{"abd", absl::Cord("2")});
+    return encoder.Finalize(may_be_root);
+  };
+  {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto encoded_nodes,
+                                     encode(/*may_be_root=*/false));
+    ASSERT_EQ(1, encoded_nodes.size());
+    const auto& key_filter = encoded_nodes[0].info.key_filter;
+    EXPECT_THAT(key_filter, ::testing::Not(::testing::IsEmpty()));
+    EXPECT_TRUE(KeyFilterMayContain(key_filter, "abc"));
+    EXPECT_TRUE(KeyFilterMayContain(key_filter, "abd"));
+  }
+  {
+    // No key filter is computed for the root node.
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto encoded_nodes,
+                                     encode(/*may_be_root=*/true));
+    ASSERT_EQ(1, encoded_nodes.size());
+    EXPECT_THAT(encoded_nodes[0].info.key_filter, ::testing::IsEmpty());
+  }
+}
+
 TEST(BtreeNodeTest, InteriorNodeBasePath) {
   Config config;
   BtreeNode node;
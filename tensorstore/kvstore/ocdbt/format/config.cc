@@ -73,6 +73,7 @@ bool operator==(const Config& a, const Config& b) {
          a.max_inline_value_bytes == b.max_inline_value_bytes &&
          a.max_decoded_node_bytes == b.max_decoded_node_bytes &&
          a.version_tree_arity_log2 == b.version_tree_arity_log2 &&
+         a.key_filter_bits_per_key == b.key_filter_bits_per_key &&
          a.compression == b.compression;
 }
 
@@ -82,6 +83,8 @@ std::ostream& operator<<(std::ostream& os, const Config& x) {
             << ", max_decoded_node_bytes=" << x.max_decoded_node_bytes
             << ", version_tree_arity_log2="
             << static_cast<int>(x.version_tree_arity_log2)
+            << ", key_filter_bits_per_key="
+            << static_cast<int>(x.key_filter_bits_per_key)
             << ", compression=" << x.compression << "}";
 }
 
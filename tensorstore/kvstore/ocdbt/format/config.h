@@ -73,6 +73,15 @@ struct Config {
   /// Base-2 logarithm of the arity of the version tree, must be >= 1.
   uint8_t version_tree_arity_log2 = 4;
 
+  /// Number of bits per key of the Bloom filters over the keys of each leaf
+  /// node, stored in the parent interior node.  A value of 0 indicates that no
+  /// key filters are stored.
+  ///
+  /// Key filters allow reads of missing keys to complete without reading any
+  /// leaf node, at the cost of larger interior nodes.  A non-zero value
+  /// requires manifest and b+tree node format version 1.
+  uint8_t key_filter_bits_per_key = 0;
+
   struct NoCompression {
     friend bool operator==(NoCompression, NoCompression) { return true; }
     friend bool operator!=(NoCompression, NoCompression) { return false; }
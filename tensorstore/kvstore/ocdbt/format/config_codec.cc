@@ -14,6 +14,8 @@
 
 #include "tensorstore/kvstore/ocdbt/format/config_codec.h"
 
+#include <stdint.h>
+
 #include <string>
 #include <variant>
 
@@ -25,6 +27,7 @@
 #include "tensorstore/internal/meta/type_traits.h"
 #include "tensorstore/kvstore/ocdbt/format/codec_util.h"
 #include "tensorstore/kvstore/ocdbt/format/config.h"
+#include "tensorstore/kvstore/ocdbt/format/key_filter.h"
 
 namespace tensorstore {
 namespace internal_ocdbt {
@@ -104,5 +107,17 @@ bool ManifestKindCodec::operator()(riegeli::Reader& reader,
   return true;
 }
 
+bool KeyFilterBitsPerKeyCodec::operator()(riegeli::Reader& reader,
+                                          uint8_t& value) const {
+  if (!reader.ReadByte(value)) return false;
+  if (value > kMaxKeyFilterBitsPerKey) {
+    reader.Fail(absl::DataLossError(
+        absl::StrFormat("key_filter_bits_per_key=%d exceeds maximum of %d",
+                        value, kMaxKeyFilterBitsPerKey)));
+    return false;
+  }
+  return true;
+}
+
 }  // namespace internal_ocdbt
 }  // namespace tensorstore
@@ -19,6 +19,10 @@
 ///
 /// Internal codecs for `Config`, used by the manifest codec.
 
+#include <stdint.h>
+
+#include <type_traits>
+
 #include "riegeli/bytes/reader.h"
 #include "riegeli/bytes/writer.h"
 #include "tensorstore/kvstore/ocdbt/format/codec_util.h"
@@ -50,15 +54,39 @@ struct ManifestKindCodec {
   }
 };
 
+struct KeyFilterBitsPerKeyCodec {
+  [[nodiscard]] bool operator()(riegeli::Reader& reader, uint8_t& value) const;
+
+  [[nodiscard]] bool operator()(riegeli::Writer& writer, uint8_t value) const {
+    return writer.WriteByte(value);
+  }
+};
+
+/// Format version of the manifest that adds `key_filter_bits_per_key` to the
+/// configuration.
+constexpr uint32_t kManifestKeyFilterFormatVersion = 1;
+
 struct ConfigCodec {
+  /// Manifest format version.
+  uint32_t version;
+
   template <typename IO, typename T>
   [[nodiscard]] bool operator()(IO& io, T&& value) const {
-    return UuidCodec{}(io, value.uuid) &&
-           ManifestKindCodec{}(io, value.manifest_kind) &&
-           MaxInlineValueBytesCodec{}(io, value.max_inline_value_bytes) &&
-           MaxDecodedNodeBytesCodec{}(io, value.max_decoded_node_bytes) &&
-           VersionTreeArityLog2Codec{}(io, value.version_tree_arity_log2) &&
-           CompressionConfigCodec{}(io, value.compression);
+    if (!UuidCodec{}(io, value.uuid) ||
+        !ManifestKindCodec{}(io, value.manifest_kind) ||
+        !MaxInlineValueBytesCodec{}(io, value.max_inline_value_bytes) ||
+        !MaxDecodedNodeBytesCodec{}(io, value.max_decoded_node_bytes) ||
+        !VersionTreeArityLog2Codec{}(io, value.version_tree_arity_log2) ||
+        !CompressionConfigCodec{}(io, value.compression)) {
+      return false;
+    }
+    if (version < kManifestKeyFilterFormatVersion) {
+      if constexpr (std::is_same_v<IO, riegeli::Reader>) {
+        value.key_filter_bits_per_key = 0;
+      }
+      return true;
+    }
+    return KeyFilterBitsPerKeyCodec{}(io, value.key_filter_bits_per_key);
   }
 };
 
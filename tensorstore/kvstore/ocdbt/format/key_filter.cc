@@ -0,0 +1,115 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/ocdbt/format/key_filter.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <cassert>
+#include <string>
+#include <string_view>
+
+#include "absl/crc/crc32c.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_format.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+
+namespace {
+
+// Minimum number of filter bits, to avoid a high false positive rate for
+// nodes with very few keys.
+constexpr size_t kMinKeyFilterBits = 64;
+
+// Calls `callback(bit_index)` for each bit probed for the key with the
+// specified hash, using double hashing.
+template <typename Callback>
+bool ForEachKeyFilterProbe(uint32_t hash, size_t num_bits, uint8_t num_probes,
+                           Callback callback) {
+  const uint32_t delta = (hash >> 17) | (hash << 15);
+  for (uint8_t i = 0; i < num_probes; ++i) {
+    if (!callback(hash % num_bits)) return false;
+    hash += delta;
+  }
+  return true;
+}
+
+}  // namespace
+
+uint32_t GetKeyFilterHash(std::string_view key_prefix,
+                          std::string_view key_suffix) {
+  uint32_t h = static_cast<uint32_t>(
+      absl::ExtendCrc32c(absl::ComputeCrc32c(key_prefix), key_suffix));
+  // Mix the bits, since the probe positions are derived from both the low and
+  // high bits of the hash.
+  h ^= h >> 16;
+  h *= 0x85ebca6b;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35;
+  h ^= h >> 16;
+  return h;
+}
+
+std::string BuildKeyFilter(span<const uint32_t> key_hashes,
+                           uint8_t bits_per_key) {
+  assert(bits_per_key >= 1 && bits_per_key <= kMaxKeyFilterBitsPerKey);
+  // The false positive rate is minimized by `bits_per_key * ln(2)` probes.
+  const uint8_t num_probes = static_cast<uint8_t>(std::clamp<size_t>(
+      bits_per_key * 69 / 100, 1, kMaxKeyFilterProbes));
+  const size_t num_bytes =
+      (std::max<size_t>(kMinKeyFilterBits,
+                        key_hashes.size() * bits_per_key) + 7) / 8;
+  const size_t num_bits = num_bytes * 8;
+  std::string filter(num_bytes + 1, '\0');
+  for (uint32_t hash : key_hashes) {
+    ForEachKeyFilterProbe(hash, num_bits, num_probes, [&](size_t bit) {
+      filter[bit / 8] |= static_cast<char>(1 << (bit % 8));
+      return true;
+    });
+  }
+  filter[num_bytes] = static_cast<char>(num_probes);
+  return filter;
+}
+
+bool KeyFilterMayContain(std::string_view filter, std::string_view key) {
+  if (filter.size() < 2) return true;
+  const size_t num_bits = (filter.size() - 1) * 8;
+  const uint8_t num_probes = static_cast<uint8_t>(filter.back());
+  return ForEachKeyFilterProbe(
+      GetKeyFilterHash({}, key), num_bits, num_probes, [&](size_t bit) {
+        return (static_cast<uint8_t>(filter[bit / 8]) >> (bit % 8)) & 1;
+      });
+}
+
+absl::Status ValidateKeyFilter(std::string_view filter) {
+  if (filter.empty()) return absl::OkStatus();
+  if (filter.size() < 2) {
+    return absl::DataLossError(
+        absl::StrFormat("Key filter of length %d is too short", filter.size()));
+  }
+  const uint8_t num_probes = static_cast<uint8_t>(filter.back());
+  if (num_probes == 0 || num_probes > kMaxKeyFilterProbes) {
+    return absl::DataLossError(absl::StrFormat(
+        "Key filter num_probes=%d is outside valid range [1, %d]", num_probes,
+        kMaxKeyFilterProbes));
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
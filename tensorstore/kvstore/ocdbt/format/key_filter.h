@@ -0,0 +1,74 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_OCDBT_FORMAT_KEY_FILTER_H_
+#define TENSORSTORE_KVSTORE_OCDBT_FORMAT_KEY_FILTER_H_
+
+/// \file
+///
+/// Bloom filters over the keys of a b+tree subtree.
+///
+/// A key filter is stored along with the reference to a b+tree node, and
+/// allows a lookup of a key that is not present in the subtree to be rejected
+/// without reading the node.
+///
+/// The encoded filter consists of the filter bits, followed by a single byte
+/// specifying the number of probes.  An empty filter indicates that no filter
+/// is available, i.e. that any key may be present.
+///
+/// See the format documentation in `index.rst`.
+
+#include <stdint.h>
+
+#include <string>
+#include <string_view>
+
+#include "absl/status/status.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+
+/// Maximum value of `Config::key_filter_bits_per_key`.
+constexpr uint8_t kMaxKeyFilterBitsPerKey = 32;
+
+/// Maximum number of probes supported by `KeyFilterMayContain`.
+constexpr uint8_t kMaxKeyFilterProbes = 30;
+
+/// Returns the hash of the full key `key_prefix + key_suffix` used by the key
+/// filter.
+uint32_t GetKeyFilterHash(std::string_view key_prefix,
+                          std::string_view key_suffix);
+
+/// Builds a key filter for the keys with the specified hashes (computed by
+/// `GetKeyFilterHash`).
+///
+/// \param bits_per_key Number of filter bits per key, must be in the range
+///     `[1, kMaxKeyFilterBitsPerKey]`.
+std::string BuildKeyFilter(span<const uint32_t> key_hashes,
+                           uint8_t bits_per_key);
+
+/// Returns `false` if `key` is definitely not one of the keys from which
+/// `filter` was built.
+///
+/// Returns `true` if `filter` is empty.
+bool KeyFilterMayContain(std::string_view filter, std::string_view key);
+
+/// Validates an encoded key filter.
+absl::Status ValidateKeyFilter(std::string_view filter);
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_OCDBT_FORMAT_KEY_FILTER_H_
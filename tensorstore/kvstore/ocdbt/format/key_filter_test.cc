@@ -0,0 +1,107 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/ocdbt/format/key_filter.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/str_format.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::internal_ocdbt::BuildKeyFilter;
+using ::tensorstore::internal_ocdbt::GetKeyFilterHash;
+using ::tensorstore::internal_ocdbt::KeyFilterMayContain;
+using ::tensorstore::internal_ocdbt::ValidateKeyFilter;
+
+std::string BuildFilterForKeys(const std::vector<std::string>& keys,
+                               uint8_t bits_per_key) {
+  std::vector<uint32_t> hashes;
+  for (const auto& key : keys) {
+    hashes.push_back(GetKeyFilterHash("", key));
+  }
+  return BuildKeyFilter(hashes, bits_per_key);
+}
+
+std::vector<std::string> ChunkKeys(size_t begin, size_t end) {
+  std::vector<std::string> keys;
+  for (size_t i = begin; i < end; ++i) {
+    keys.push_back(
+        absl::StrFormat("c/%d/%d/%d", i / 100, (i / 10) % 10, i % 10));
+  }
+  return keys;
+}
+
+TEST(KeyFilterTest, HashOfSplitKey) {
+  EXPECT_EQ(GetKeyFilterHash("", "abcdef"), GetKeyFilterHash("abc", "def"));
+  EXPECT_EQ(GetKeyFilterHash("abcdef", ""), GetKeyFilterHash("abc", "def"));
+  EXPECT_NE(GetKeyFilterHash("", "abcdef"), GetKeyFilterHash("", "abcdeg"));
+}
+
+TEST(KeyFilterTest, NoFalseNegatives) {
+  for (uint8_t bits_per_key : {1, 4, 10, 32}) {
+    auto keys = ChunkKeys(0, 1000);
+    auto filter = BuildFilterForKeys(keys, bits_per_key);
+    TENSORSTORE_EXPECT_OK(ValidateKeyFilter(filter));
+    for (const auto& key : keys) {
+      EXPECT_TRUE(KeyFilterMayContain(filter, key))
+          << "bits_per_key=" << static_cast<int>(bits_per_key)
+          << ", key=" << key;
+    }
+  }
+}
+
+TEST(KeyFilterTest, FalsePositiveRate) {
+  auto filter = BuildFilterForKeys(ChunkKeys(0, 1000), 10);
+  size_t num_false_positives = 0;
+  const auto absent_keys = ChunkKeys(1000, 11000);
+  for (const auto& key : absent_keys) {
+    num_false_positives += KeyFilterMayContain(filter, key);
+  }
+  // The expected false positive rate is about 1%.
+  EXPECT_LT(num_false_positives, absent_keys.size() * 3 / 100);
+}
+
+TEST(KeyFilterTest, SmallFilter) {
+  auto filter = BuildFilterForKeys({"a"}, 10);
+  EXPECT_EQ(64 / 8 + 1, filter.size());
+  EXPECT_TRUE(KeyFilterMayContain(filter, "a"));
+}
+
+TEST(KeyFilterTest, EmptyFilter) {
+  TENSORSTORE_EXPECT_OK(ValidateKeyFilter(""));
+  EXPECT_TRUE(KeyFilterMayContain("", "a"));
+}
+
+TEST(KeyFilterTest, Invalid) {
+  EXPECT_THAT(ValidateKeyFilter(std::string(1, '\x01')),
+              MatchesStatus(absl::StatusCode::kDataLoss, ".*too short"));
+  EXPECT_THAT(ValidateKeyFilter(std::string("\xff\x00", 2)),
+              MatchesStatus(absl::StatusCode::kDataLoss,
+                            ".*num_probes=0 is outside valid range.*"));
+  EXPECT_THAT(ValidateKeyFilter(std::string("\xff\x1f", 2)),
+              MatchesStatus(absl::StatusCode::kDataLoss,
+                            ".*num_probes=31 is outside valid range.*"));
+}
+
+}  // namespace
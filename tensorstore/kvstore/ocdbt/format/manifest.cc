@@ -14,6 +14,8 @@
 
 #include "tensorstore/kvstore/ocdbt/format/manifest.h"
 
+#include <stdint.h>
+
 #include <cassert>
 #include <ostream>
 #include <string>
@@ -43,6 +45,16 @@ namespace internal_ocdbt {
 
 constexpr uint32_t kManifestMagic = 0x0cdb3a2a;
 constexpr uint8_t kManifestFormatVersion = 0;
+constexpr uint8_t kMaxManifestFormatVersion = kManifestKeyFilterFormatVersion;
+
+namespace {
+// Returns the oldest manifest format version that can represent `config`, so
+// that databases not using newer features remain readable by older versions.
+uint32_t GetManifestFormatVersion(const Config& config) {
+  return config.key_filter_bits_per_key ? kManifestKeyFilterFormatVersion
+                                        : kManifestFormatVersion;
+}
+}  // namespace
 
 void ForEachManifestVersionTreeNodeRef(
     GenerationNumber generation_number, uint8_t version_tree_arity_log2,
@@ -162,15 +174,16 @@ Result<absl::Cord> EncodeManifest(const Manifest& manifest,
 #ifndef NDEBUG
   CheckManifestInvariants(manifest, encode_as_single);
 #endif
+  const uint32_t version = GetManifestFormatVersion(manifest.config);
   return EncodeWithOptionalCompression(
-      manifest.config, kManifestMagic, kManifestFormatVersion,
+      manifest.config, kManifestMagic, version,
       [&](riegeli::Writer& writer) -> bool {
         if (encode_as_single) {
           Config new_config = manifest.config;
           new_config.manifest_kind = ManifestKind::kSingle;
-          if (!ConfigCodec{}(writer, new_config)) return false;
+          if (!ConfigCodec{version}(writer, new_config)) return false;
         } else {
-          if (!ConfigCodec{}(writer, manifest.config)) return false;
+          if (!ConfigCodec{version}(writer, manifest.config)) return false;
           if (manifest.config.manifest_kind != ManifestKind::kSingle) {
             // This is a config-only manifest.
             return true;
@@ -200,9 +213,9 @@ Result<absl::Cord> EncodeManifest(const Manifest& manifest,
 Result<Manifest> DecodeManifest(const absl::Cord& encoded) {
   Manifest manifest;
   auto status = DecodeWithOptionalCompression(
-      encoded, kManifestMagic, kManifestFormatVersion,
+      encoded, kManifestMagic, kMaxManifestFormatVersion,
       [&](riegeli::Reader& reader, uint32_t version) -> bool {
-        if (!ConfigCodec{}(reader, manifest.config)) return false;
+        if (!ConfigCodec{version}(reader, manifest.config)) return false;
         if (manifest.config.manifest_kind != ManifestKind::kSingle) {
           // This is a config-only manifest.
           return true;
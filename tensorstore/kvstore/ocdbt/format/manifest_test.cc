@@ -96,6 +96,22 @@ TEST(ManifestTest, RoundTripNonZeroHeight) {
   TestManifestRoundTrip(manifest);
 }
 
+TEST(ManifestTest, RoundTripKeyFilter) {
+  auto manifest = GetSimpleManifest();
+  manifest.config.key_filter_bits_per_key = 10;
+  TestManifestRoundTrip(manifest);
+}
+
+TEST(ManifestTest, FormatVersion) {
+  // Format version 1 is only used if key filters are enabled.
+  auto manifest = GetSimpleManifest();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto encoded, EncodeManifest(manifest));
+  EXPECT_EQ(0, encoded.Subcord(12, 1).Flatten()[0]);
+  manifest.config.key_filter_bits_per_key = 10;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(encoded, EncodeManifest(manifest));
+  EXPECT_EQ(1, encoded.Subcord(12, 1).Flatten()[0]);
+}
+
 TEST(ManifestTest, CorruptMagic) {
   TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto encoded,
                                    EncodeManifest(GetSimpleManifest()));
@@ -122,12 +138,12 @@ TEST(ManifestTest, InvalidVersion) {
   TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto encoded,
                                    EncodeManifest(GetSimpleManifest()));
   auto corrupt = encoded.Subcord(0, 12);
-  corrupt.Append(std::string(1, 1));
+  corrupt.Append(std::string(1, 2));
   corrupt.Append(encoded.Subcord(13, -1));
   EXPECT_THAT(
       DecodeManifest(corrupt),
       MatchesStatus(absl::StatusCode::kDataLoss,
-                    ".*: Maximum supported version is 0 but received: 1.*"));
+                    ".*: Maximum supported version is 1 but received: 2.*"));
 }
 
 TEST(ManifestTest, CorruptChecksum) {
@@ -62,6 +62,23 @@ namespace {
 
 ABSL_CONST_INIT internal_log::VerboseFlag ocdbt_logging("ocdbt");
 
+// Weight of each prior observation relative to the next one in
+// `ReadCostEstimator`.  Observations have a half life of about 35 reads.
+constexpr double kReadCostDecay = 0.98;
+
+// Minimum number of reads observed before `ReadCostEstimator` provides an
+// estimate.
+constexpr size_t kMinReadCostObservations = 16;
+
+// Bounds on the thresholds chosen by adaptive coalescing, which guard against
+// extreme estimates.
+constexpr size_t kMaxAdaptiveThreshold = size_t{64} << 20;
+constexpr size_t kMinAdaptiveMergedThreshold = size_t{1} << 20;
+
+// Adaptive coalescing limits merged reads to the size that is estimated to
+// take as long to transfer as this many requests take to start.
+constexpr size_t kAdaptiveMergedThresholdMultiple = 16;
+
 absl::Cord DeepCopyCord(const absl::Cord& cord) {
   // If the Cord is flat, skipping the CordBuilder improves performance.
   if (std::optional<absl::string_view> flat = cord.TryFlat();
@@ -136,14 +153,15 @@ struct PendingReadHash {
 
 class CoalesceKvStoreDriver final : public kvstore::Driver {
  public:
-  explicit CoalesceKvStoreDriver(kvstore::DriverPtr base, size_t threshold,
-                                 size_t merged_threshold,
-                                 absl::Duration interval, Executor executor)
+  explicit CoalesceKvStoreDriver(kvstore::DriverPtr base,
+                                 const CoalesceKvStoreOptions& options,
+                                 Executor executor)
       : base_(std::move(base)),
-        threshold_(threshold),
-        merged_threshold_(merged_threshold),
-        interval_(interval),
-        thread_pool_executor_(std::move(executor)) {}
+        interval_(options.interval),
+        adaptive_(options.adaptive),
+        thread_pool_executor_(std::move(executor)),
+        threshold_(options.threshold),
+        merged_threshold_(options.merged_threshold) {}
 
   ~CoalesceKvStoreDriver() override = default;
 
@@ -196,18 +214,58 @@ class CoalesceKvStoreDriver final : public kvstore::Driver {
   void StartNextRead(internal::IntrusivePtr<PendingRead> state_ptr);
 
  private:
+  // Issues a read to the base kvstore, and records its cost if adaptive
+  // coalescing is enabled.
+  Future<ReadResult> ReadFromBase(const Key& key, ReadOptions options);
+
+  void ObserveRead(size_t size, absl::Duration duration);
+
   kvstore::DriverPtr base_;
-  size_t threshold_;
-  size_t merged_threshold_;
   absl::Duration interval_;
+  bool adaptive_;
   Executor thread_pool_executor_;
 
   absl::Mutex mu_;
+  size_t threshold_ ABSL_GUARDED_BY(mu_);
+  size_t merged_threshold_ ABSL_GUARDED_BY(mu_);
+  ReadCostEstimator read_cost_estimator_ ABSL_GUARDED_BY(mu_);
   absl::flat_hash_set<internal::IntrusivePtr<PendingRead>, PendingReadHash,
                       PendingReadEq>
       pending_ ABSL_GUARDED_BY(mu_);
 };
 
+Future<kvstore::ReadResult> CoalesceKvStoreDriver::ReadFromBase(
+    const Key& key, ReadOptions options) {
+  auto future = base_->Read(key, std::move(options));
+  if (adaptive_) {
+    future.ExecuteWhenReady(
+        [self = internal::IntrusivePtr<CoalesceKvStoreDriver>(this),
+         start_time = absl::Now()](ReadyFuture<ReadResult> ready) {
+          auto& r = ready.result();
+          if (!r.ok() || !r->has_value()) return;
+          self->ObserveRead(r->value.size(), absl::Now() - start_time);
+        });
+  }
+  return future;
+}
+
+void CoalesceKvStoreDriver::ObserveRead(size_t size,
+                                        absl::Duration duration) {
+  absl::MutexLock l(&mu_);
+  read_cost_estimator_.Observe(size, duration);
+  auto gap = read_cost_estimator_.GetBreakEvenGap();
+  if (!gap) return;
+  size_t threshold = std::min(*gap, kMaxAdaptiveThreshold);
+  size_t merged_threshold =
+      std::max(threshold * kAdaptiveMergedThresholdMultiple,
+               kMinAdaptiveMergedThreshold);
+  ABSL_LOG_IF(INFO, ocdbt_logging && threshold != threshold_)
+      << "Adapting coalescing threshold: " << threshold
+      << ", merged_threshold: " << merged_threshold;
+  threshold_ = threshold;
+  merged_threshold_ = merged_threshold;
+}
+
 Future<kvstore::ReadResult> CoalesceKvStoreDriver::Read(Key key,
                                                         ReadOptions options) {
   internal::IntrusivePtr<PendingRead> state_ptr;
@@ -252,7 +310,7 @@ Future<kvstore::ReadResult> CoalesceKvStoreDriver::Read(Key key,
   }
 
   // non-interval based trigger
-  auto future = base_->Read(key, std::move(options));
+  auto future = ReadFromBase(key, std::move(options));
   future.ExecuteWhenReady(
       [self = internal::IntrusivePtr<CoalesceKvStoreDriver>(this),
        state = std::move(state_ptr)](ReadyFuture<ReadResult>) {
@@ -312,6 +370,7 @@ void OnReadComplete(MergeValue merge_values,
 void CoalesceKvStoreDriver::StartNextRead(
     internal::IntrusivePtr<PendingRead> state_ptr) {
   std::vector<PendingRead::Op> pending;
+  size_t threshold, merged_threshold;
   {
     absl::MutexLock l(&mu_);
     if (state_ptr->pending_ops.empty()) {
@@ -321,6 +380,8 @@ void CoalesceKvStoreDriver::StartNextRead(
     } else {
       std::swap(pending, state_ptr->pending_ops);
     }
+    threshold = threshold_;
+    merged_threshold = merged_threshold_;
   }
 
   if (interval_ != absl::ZeroDuration()) {
@@ -372,7 +433,7 @@ void CoalesceKvStoreDriver::StartNextRead(
       // The options differ from the prior options, so issue the pending
       // request and start another.
       assert(!merged.subreads.empty());
-      auto f = base_->Read(key, merged.options);
+      auto f = ReadFromBase(key, merged.options);
       f.ExecuteWhenReady(
           [merged = std::move(merged)](ReadyFuture<kvstore::ReadResult> ready) {
             OnReadComplete(std::move(merged), std::move(ready));
@@ -382,15 +443,14 @@ void CoalesceKvStoreDriver::StartNextRead(
     } else if (merged.options.byte_range.exclusive_max != -1 &&
                ((e.options.byte_range.inclusive_min -
                      merged.options.byte_range.exclusive_max >
-                 threshold_) ||
-                (merged_threshold_ > 0 &&
-                 merged.options.byte_range.size() > merged_threshold_))) {
+                 threshold) ||
+                (merged_threshold > 0 &&
+                 merged.options.byte_range.size() > merged_threshold))) {
       // The distance from the end of the prior read to the beginning of the
-      // next read exceeds threshold_ or the total merged_size exceeds
-      // merged_threshold_, so issue the pending request and start
-      // another.
+      // next read exceeds threshold or the total merged_size exceeds
+      // merged_threshold, so issue the pending request and start another.
       assert(!merged.subreads.empty());
-      auto f = base_->Read(key, merged.options);
+      auto f = ReadFromBase(key, merged.options);
       f.ExecuteWhenReady(
           [merged = std::move(merged)](ReadyFuture<kvstore::ReadResult> ready) {
             OnReadComplete(std::move(merged), std::move(ready));
@@ -424,7 +484,7 @@ void CoalesceKvStoreDriver::StartNextRead(
   // Issue final request. This request will trigger additional reads via
   // StartNextRead.
   assert(!merged.subreads.empty());
-  auto f = base_->Read(key, merged.options);
+  auto f = ReadFromBase(key, merged.options);
   f.ExecuteWhenReady(
       [self = internal::IntrusivePtr<CoalesceKvStoreDriver>(this),
        merged = std::move(merged),
@@ -442,18 +502,65 @@ void CoalesceKvStoreDriver::StartNextRead(
 
 }  // namespace
 
+void ReadCostEstimator::Observe(size_t size, absl::Duration duration) {
+  const double x = static_cast<double>(size);
+  const double y = absl::ToDoubleSeconds(duration);
+  ++num_observations_;
+  weight_ = weight_ * kReadCostDecay + 1;
+  sum_size_ = sum_size_ * kReadCostDecay + x;
+  sum_seconds_ = sum_seconds_ * kReadCostDecay + y;
+  sum_size_squared_ = sum_size_squared_ * kReadCostDecay + x * x;
+  sum_size_seconds_ = sum_size_seconds_ * kReadCostDecay + x * y;
+}
+
+std::optional<size_t> ReadCostEstimator::GetBreakEvenGap() const {
+  if (num_observations_ < kMinReadCostObservations) return std::nullopt;
+  // Fit `seconds = latency + size * seconds_per_byte`.
+  const double size_variance =
+      weight_ * sum_size_squared_ - sum_size_ * sum_size_;
+  if (!(size_variance > 1e-6 * weight_ * sum_size_squared_)) {
+    // The sizes of the observed reads are too similar to distinguish latency
+    // from transfer time.
+    return std::nullopt;
+  }
+  const double seconds_per_byte =
+      (weight_ * sum_size_seconds_ - sum_size_ * sum_seconds_) / size_variance;
+  const double latency =
+      (sum_seconds_ - seconds_per_byte * sum_size_) / weight_;
+  if (latency <= 0) return 0;
+  if (seconds_per_byte <= 0) return std::numeric_limits<size_t>::max();
+  // Reading a gap of `latency / seconds_per_byte` bytes takes as long as an
+  // additional request.
+  const double gap = latency / seconds_per_byte;
+  if (gap >= static_cast<double>(std::numeric_limits<size_t>::max())) {
+    return std::numeric_limits<size_t>::max();
+  }
+  return static_cast<size_t>(gap);
+}
+
+kvstore::DriverPtr MakeCoalesceKvStoreDriver(
+    kvstore::DriverPtr base, const CoalesceKvStoreOptions& options,
+    Executor executor) {
+  ABSL_LOG_IF(INFO, ocdbt_logging)
+      << "Coalescing reads with threshold: " << options.threshold
+      << ", merged_threshold: " << options.merged_threshold
+      << ", interval: " << options.interval
+      << ", adaptive: " << options.adaptive;
+  return internal::MakeIntrusivePtr<CoalesceKvStoreDriver>(
+      std::move(base), options, std::move(executor));
+}
+
 kvstore::DriverPtr MakeCoalesceKvStoreDriver(kvstore::DriverPtr base,
                                              size_t threshold,
                                              size_t merged_threshold,
                                              absl::Duration interval,
                                              Executor executor) {
-  ABSL_LOG_IF(INFO, ocdbt_logging)
-      << "Coalescing reads with threshold: " << threshold
-      << ", merged_threshold: " << merged_threshold
-      << ", interval: " << interval;
-  return internal::MakeIntrusivePtr<CoalesceKvStoreDriver>(
-      std::move(base), threshold, merged_threshold, interval,
-      std::move(executor));
+  CoalesceKvStoreOptions options;
+  options.threshold = threshold;
+  options.merged_threshold = merged_threshold;
+  options.interval = interval;
+  return MakeCoalesceKvStoreDriver(std::move(base), options,
+                                   std::move(executor));
 }
 
 }  // namespace internal_ocdbt
@@ -15,17 +15,72 @@
 #ifndef TENSORSTORE_KVSTORE_OCDBT_IO_COALESCE_KVSTORE_H_
 #define TENSORSTORE_KVSTORE_OCDBT_IO_COALESCE_KVSTORE_H_
 
+#include <stddef.h>
+
+#include <optional>
+
+#include "absl/time/time.h"
 #include "tensorstore/kvstore/spec.h"
 #include "tensorstore/util/executor.h"
 
 namespace tensorstore {
 namespace internal_ocdbt {
 
+/// Estimates the cost of reads from a kvstore as a fixed per-request latency
+/// plus a per-byte transfer time.
+///
+/// The parameters are fit by exponentially-weighted least squares regression
+/// over the sizes and durations of recent reads, such that the estimate tracks
+/// changes in the behavior of the kvstore.
+class ReadCostEstimator {
+ public:
+  /// Records a read of `size` bytes that completed after `duration`.
+  void Observe(size_t size, absl::Duration duration);
+
+  /// Returns the gap between two byte ranges, in bytes, above which issuing
+  /// separate reads is estimated to be faster than reading the gap.
+  ///
+  /// Returns `std::nullopt` if too few reads of differing sizes have been
+  /// observed.
+  std::optional<size_t> GetBreakEvenGap() const;
+
+ private:
+  size_t num_observations_ = 0;
+  double weight_ = 0;
+  double sum_size_ = 0;
+  double sum_seconds_ = 0;
+  double sum_size_squared_ = 0;
+  double sum_size_seconds_ = 0;
+};
+
+struct CoalesceKvStoreOptions {
+  /// Concurrent reads for the same key may be merged if the ranges are
+  /// separated by at most `threshold` bytes.
+  size_t threshold = 0;
+
+  /// Reads are not merged into ranges larger than `merged_threshold` bytes.
+  /// `0` indicates no limit.
+  size_t merged_threshold = 0;
+
+  /// If non-zero, reads for the same key are issued at most once per
+  /// `interval`, rather than once the previous read completes.
+  absl::Duration interval = absl::ZeroDuration();
+
+  /// If `true`, `threshold` and `merged_threshold` are only initial values,
+  /// and are replaced by values derived from the latency and throughput of
+  /// reads from the base kvstore, as estimated by `ReadCostEstimator`, once
+  /// enough reads have completed.
+  bool adaptive = false;
+};
+
 /// Adapts a base kvstore to coalesce read ranges.
 ///
 /// Concurrent reads for the same key may be merged if the ranges are
 /// separated by less than threshold bytes. 1MB may be a reasonable value
 /// for reducing GCS reads in the OCDBT driver.
+kvstore::DriverPtr MakeCoalesceKvStoreDriver(
+    kvstore::DriverPtr base, const CoalesceKvStoreOptions& options,
+    Executor executor);
 kvstore::DriverPtr MakeCoalesceKvStoreDriver(kvstore::DriverPtr base,
                                              size_t threshold,
                                              size_t merged_threshold,
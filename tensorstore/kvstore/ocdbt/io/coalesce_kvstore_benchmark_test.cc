@@ -0,0 +1,189 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// This benchmarks byte range reads through `MakeCoalesceKvStoreDriver` from a
+// simulated kvstore with a per-request latency of 1ms and a throughput of
+// 200MB/s, for which the break-even gap is 200KB.
+//
+// BM_CoalesceRead/<pattern>/<mode>
+//
+// pattern:
+//
+//   0: Reads of 4KB at uniformly random offsets.
+//
+//   1: Clustered reads: 16 clusters of 16 reads of 4KB, each separated by
+//      4KB, at random offsets.
+//
+// mode:
+//
+//   0: No coalescing.
+//
+//   1: Coalescing with a fixed threshold of 1MB.
+//
+//   2: Adaptive coalescing.
+//
+// The number of requests issued to the simulated kvstore per batch of 256
+// reads is reported as the "requests" counter.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "absl/strings/cord.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/thread/schedule_at.h"
+#include "tensorstore/internal/thread/thread_pool.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/driver.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/memory/memory_key_value_store.h"
+#include "tensorstore/kvstore/ocdbt/io/coalesce_kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/garbage_collection/garbage_collection.h"
+#include "tensorstore/util/status.h"
+
+namespace {
+
+namespace kvstore = ::tensorstore::kvstore;
+using ::tensorstore::Future;
+using ::tensorstore::OptionalByteRangeRequest;
+using ::tensorstore::PromiseFuturePair;
+using ::tensorstore::TimestampedStorageGeneration;
+using ::tensorstore::internal_ocdbt::CoalesceKvStoreOptions;
+using ::tensorstore::internal_ocdbt::MakeCoalesceKvStoreDriver;
+
+constexpr size_t kValueSize = size_t{64} << 20;
+constexpr size_t kReadSize = 4096;
+constexpr size_t kReadsPerBatch = 256;
+constexpr size_t kReadsPerCluster = 16;
+constexpr absl::Duration kLatency = absl::Milliseconds(1);
+constexpr double kBytesPerSecond = 200e6;
+
+// Delays reads from a base kvstore according to a per-request latency and a
+// throughput, and counts them.
+class SimulatedLatencyKvStore : public kvstore::Driver {
+ public:
+  explicit SimulatedLatencyKvStore(kvstore::DriverPtr base)
+      : base_(std::move(base)) {}
+
+  Future<ReadResult> Read(Key key, ReadOptions options) override {
+    num_requests_.fetch_add(1, std::memory_order_relaxed);
+    const int64_t size = options.byte_range.exclusive_max == -1
+                             ? int64_t{kValueSize}
+                             : options.byte_range.size();
+    auto pair = PromiseFuturePair<ReadResult>::Make();
+    tensorstore::internal::ScheduleAt(
+        absl::Now() + kLatency + absl::Seconds(size / kBytesPerSecond),
+        [base = base_, key = std::move(key), options = std::move(options),
+         promise = std::move(pair.promise)] {
+          LinkResult(promise, base->Read(key, options));
+        });
+    return std::move(pair.future);
+  }
+
+  Future<TimestampedStorageGeneration> Write(Key key,
+                                             std::optional<Value> value,
+                                             WriteOptions options) override {
+    return base_->Write(std::move(key), std::move(value), std::move(options));
+  }
+
+  void GarbageCollectionVisit(
+      tensorstore::garbage_collection::GarbageCollectionVisitor& visitor)
+      const override {}
+
+  int64_t num_requests() const {
+    return num_requests_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  kvstore::DriverPtr base_;
+  std::atomic<int64_t> num_requests_{0};
+};
+
+std::vector<int64_t> GetReadOffsets(std::minstd_rand& gen, bool clustered) {
+  std::vector<int64_t> offsets;
+  if (clustered) {
+    std::uniform_int_distribution<int64_t> dist(
+        0, kValueSize - kReadsPerCluster * 2 * kReadSize);
+    while (offsets.size() < kReadsPerBatch) {
+      int64_t start = dist(gen);
+      for (size_t i = 0; i < kReadsPerCluster; ++i) {
+        offsets.push_back(start + i * 2 * kReadSize);
+      }
+    }
+  } else {
+    std::uniform_int_distribution<int64_t> dist(0, kValueSize - kReadSize);
+    for (size_t i = 0; i < kReadsPerBatch; ++i) {
+      offsets.push_back(dist(gen));
+    }
+  }
+  return offsets;
+}
+
+void BM_CoalesceRead(benchmark::State& state) {
+  const bool clustered = state.range(0) == 1;
+  const int mode = state.range(1);
+
+  auto simulated = tensorstore::internal::MakeIntrusivePtr<
+      SimulatedLatencyKvStore>(tensorstore::GetMemoryKeyValueStore());
+  kvstore::DriverPtr driver = simulated;
+  TENSORSTORE_CHECK_OK(
+      kvstore::Write(driver, "a", absl::Cord(std::string(kValueSize, 'x')))
+          .result());
+
+  if (mode != 0) {
+    CoalesceKvStoreOptions options;
+    options.threshold = size_t{1} << 20;
+    options.adaptive = (mode == 2);
+    driver = MakeCoalesceKvStoreDriver(
+        simulated, options, tensorstore::internal::DetachedThreadPool(4));
+  }
+
+  std::minstd_rand gen;
+  const int64_t initial_requests = simulated->num_requests();
+  std::vector<Future<kvstore::ReadResult>> futures;
+  for (auto s : state) {
+    for (int64_t offset : GetReadOffsets(gen, clustered)) {
+      kvstore::ReadOptions options;
+      options.byte_range = OptionalByteRangeRequest(offset, offset + kReadSize);
+      futures.push_back(kvstore::Read(driver, "a", std::move(options)));
+    }
+    for (auto& future : futures) {
+      TENSORSTORE_CHECK_OK(future.result());
+    }
+    futures.clear();
+  }
+  state.SetBytesProcessed(state.iterations() * kReadsPerBatch * kReadSize);
+  state.counters["requests"] = benchmark::Counter(
+      simulated->num_requests() - initial_requests,
+      benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_CoalesceRead)
+    ->ArgsProduct({{0, 1}, {0, 1, 2}})
+    ->UseRealTime();
+
+}  // namespace
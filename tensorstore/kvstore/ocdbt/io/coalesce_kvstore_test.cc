@@ -14,6 +14,10 @@
 
 #include "tensorstore/kvstore/ocdbt/io/coalesce_kvstore.h"
 
+#include <stddef.h>
+
+#include <optional>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/strings/cord.h"
@@ -32,6 +36,7 @@ using ::tensorstore::Context;
 using ::tensorstore::OptionalByteRangeRequest;
 using ::tensorstore::internal::MockKeyValueStore;
 using ::tensorstore::internal_ocdbt::MakeCoalesceKvStoreDriver;
+using ::tensorstore::internal_ocdbt::ReadCostEstimator;
 using ::tensorstore::kvstore::ReadOptions;
 
 TEST(CoalesceKvstoreTest, SimpleRead) {
@@ -264,4 +269,59 @@ TEST(CoalesceKvstoreTest, ReadWithInterval) {
   EXPECT_EQ(read_future4.result().value().value, absl::Cord("7"));
 }
 
+// Returns the duration of a read from a kvstore with the specified latency and
+// bandwidth.
+absl::Duration SimulatedReadDuration(size_t size) {
+  return absl::Milliseconds(2) + absl::Seconds(size / 100e6);
+}
+
+TEST(ReadCostEstimatorTest, EstimatesBreakEvenGap) {
+  ReadCostEstimator estimator;
+  EXPECT_EQ(std::nullopt, estimator.GetBreakEvenGap());
+  for (size_t i = 0; i < 32; ++i) {
+    size_t size = (i % 4 + 1) * 100000;
+    estimator.Observe(size, SimulatedReadDuration(size));
+  }
+  // Reading 200000 bytes at 100MB/s takes as long as the 2ms latency.
+  auto gap = estimator.GetBreakEvenGap();
+  ASSERT_TRUE(gap.has_value());
+  EXPECT_NEAR(200000, *gap, 1000);
+}
+
+TEST(ReadCostEstimatorTest, TooFewObservations) {
+  ReadCostEstimator estimator;
+  for (size_t i = 0; i < 4; ++i) {
+    size_t size = (i + 1) * 100000;
+    estimator.Observe(size, SimulatedReadDuration(size));
+  }
+  EXPECT_EQ(std::nullopt, estimator.GetBreakEvenGap());
+}
+
+TEST(ReadCostEstimatorTest, UniformSizes) {
+  // Latency cannot be distinguished from transfer time if all reads have the
+  // same size.
+  ReadCostEstimator estimator;
+  for (size_t i = 0; i < 32; ++i) {
+    estimator.Observe(4096, SimulatedReadDuration(4096));
+  }
+  EXPECT_EQ(std::nullopt, estimator.GetBreakEvenGap());
+}
+
+TEST(ReadCostEstimatorTest, TracksChanges) {
+  ReadCostEstimator estimator;
+  for (size_t i = 0; i < 32; ++i) {
+    size_t size = (i % 4 + 1) * 100000;
+    estimator.Observe(size, SimulatedReadDuration(size));
+  }
+  // The latency drops to 0.2ms, e.g. due to a local cache.
+  for (size_t i = 0; i < 500; ++i) {
+    size_t size = (i % 4 + 1) * 100000;
+    estimator.Observe(size,
+                      absl::Microseconds(200) + absl::Seconds(size / 100e6));
+  }
+  auto gap = estimator.GetBreakEvenGap();
+  ASSERT_TRUE(gap.has_value());
+  EXPECT_NEAR(20000, *gap, 1000);
+}
+
 }  // namespace
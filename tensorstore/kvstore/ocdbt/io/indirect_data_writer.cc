@@ -25,11 +25,14 @@
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/log/verbose_flag.h"
 #include "tensorstore/internal/metrics/histogram.h"
 #include "tensorstore/internal/metrics/metadata.h"
 #include "tensorstore/internal/mutex.h"
+#include "tensorstore/internal/thread/schedule_at.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/kvstore/ocdbt/format/data_file_id.h"
@@ -56,20 +59,28 @@ class IndirectDataWriter
     : public internal::AtomicReferenceCount<IndirectDataWriter> {
  public:
   explicit IndirectDataWriter(kvstore::KvStore kvstore, std::string prefix,
-                              size_t target_size)
+                              size_t target_size, absl::Duration flush_delay,
+                              size_t max_in_flight_bytes)
       : kvstore_(std::move(kvstore)),
         prefix_(std::move(prefix)),
-        target_size_(target_size) {}
+        target_size_(target_size),
+        flush_delay_(flush_delay),
+        max_in_flight_bytes_(max_in_flight_bytes) {}
 
   // Treat as private:
   kvstore::KvStore kvstore_;
   std::string prefix_;
   size_t target_size_;
+  absl::Duration flush_delay_;
+  size_t max_in_flight_bytes_;
   absl::Mutex mutex_;
 
   // Count of in-flight flush operations.
   size_t in_flight_ = 0;
 
+  // Total size of in-flight flush operations.
+  size_t in_flight_bytes_ = 0;
+
   // Indicates that a flush was requested by a call to `Future::Force` on the
   // future corresponding to `promise_` after the last flush started.  Note that
   // this may be set to true even while `flush_in_progress_` is true; in that
@@ -97,21 +108,54 @@ void intrusive_ptr_decrement(IndirectDataWriter* p) {
 }
 
 namespace {
+
+// Returns `true` if the buffer must be flushed without waiting for a flush to
+// be requested.
+bool MustFlushImmediately(const IndirectDataWriter& self) {
+  if (self.target_size_ > 0 && self.buffer_.size() >= self.target_size_) {
+    return true;
+  }
+  return self.max_in_flight_bytes_ > 0 &&
+         self.buffer_.size() + self.in_flight_bytes_ >=
+             self.max_in_flight_bytes_;
+}
+
+// Returns `true` if flushing the buffer must be deferred until in-flight
+// flushes complete, because together they would exceed the in-flight limit.
+//
+// This applies back-pressure without blocking: writes are still added to the
+// buffer, which is not bounded, but their futures do not become ready until
+// the deferred flush completes.  It also ensures that the buffer is not
+// flushed as a separate, tiny data file by every write once the limit is
+// reached.
+bool MustWaitForInFlightFlushes(const IndirectDataWriter& self) {
+  return self.max_in_flight_bytes_ > 0 && self.in_flight_ > 0 &&
+         self.buffer_.size() + self.in_flight_bytes_ >
+             self.max_in_flight_bytes_;
+}
+
 void MaybeFlush(IndirectDataWriter& self, UniqueWriterLock<absl::Mutex> lock) {
-  bool buffer_at_target =
-      self.target_size_ > 0 && self.buffer_.size() >= self.target_size_;
+  if (self.buffer_.empty()) return;
+  bool flush_immediately = MustFlushImmediately(self);
+  bool wait_for_in_flight = MustWaitForInFlightFlushes(self);
 
   ABSL_LOG_IF(INFO, ocdbt_logging)
       << "MaybeFlush: flush_requested=" << self.flush_requested_
       << ", in_flight=" << self.in_flight_
-      << ", buffer_at_target=" << buffer_at_target;
-  if (buffer_at_target) {
+      << ", in_flight_bytes=" << self.in_flight_bytes_
+      << ", flush_immediately=" << flush_immediately
+      << ", wait_for_in_flight=" << wait_for_in_flight;
+  if (wait_for_in_flight) {
+    // `MaybeFlush` is called again once an in-flight flush completes.
+    return;
+  } else if (flush_immediately) {
     // Write a new buffer
   } else if (!self.flush_requested_ || self.in_flight_ > 0) {
     return;
   }
 
   self.in_flight_++;
+  self.in_flight_bytes_ += self.buffer_.size();
 
   // Clear the state
   self.flush_requested_ = false;
@@ -120,7 +164,8 @@ void MaybeFlush(IndirectDataWriter& self, UniqueWriterLock<absl::Mutex> lock) {
   DataFileId data_file_id = self.data_file_id_;
   lock.unlock();
 
-  indirect_data_writer_histogram.Observe(buffer.size());
+  const size_t size = buffer.size();
+  indirect_data_writer_histogram.Observe(size);
   ABSL_LOG_IF(INFO, ocdbt_logging)
       << "Flushing " << buffer.size() << " bytes to " << data_file_id;
 
@@ -129,11 +174,22 @@ void MaybeFlush(IndirectDataWriter& self, UniqueWriterLock<absl::Mutex> lock) {
   write_future.Force();
   write_future.ExecuteWhenReady(
       [promise = std::move(promise), data_file_id = std::move(data_file_id),
-       self = internal::IntrusivePtr<IndirectDataWriter>(&self)](
+       size, self = internal::IntrusivePtr<IndirectDataWriter>(&self)](
           ReadyFuture<TimestampedStorageGeneration> future) {
         auto& r = future.result();
         ABSL_LOG_IF(INFO, ocdbt_logging)
             << "Done flushing data to " << data_file_id << ": " << r.status();
+        {
+          UniqueWriterLock lock{self->mutex_};
+          assert(self->in_flight_ > 0);
+          self->in_flight_--;
+          self->in_flight_bytes_ -= size;
+          // Another flush may have been requested, or deferred by the
+          // in-flight limit, while this flush was in progress (for additional
+          // writes that were not included in the just-completed flush).  Call
+          // `MaybeFlush` to see if another flush needs to be started.
+          MaybeFlush(*self, std::move(lock));
+        }
         if (!r.ok()) {
           promise.SetResult(r.status());
         } else if (StorageGeneration::IsUnknown(r->generation)) {
@@ -142,14 +198,6 @@ void MaybeFlush(IndirectDataWriter& self, UniqueWriterLock<absl::Mutex> lock) {
         } else {
           promise.SetResult(absl::OkStatus());
         }
-        UniqueWriterLock lock{self->mutex_};
-        assert(self->in_flight_ > 0);
-        self->in_flight_--;
-        // Another flush may have been requested even while this flush was in
-        // progress (for additional writes that were not included in the
-        // just-completed flush).  Call `MaybeFlush` to see if another flush
-        // needs to be started.
-        MaybeFlush(*self, std::move(lock));
       });
 }
 
@@ -182,13 +230,26 @@ Future<const void> Write(IndirectDataWriter& self, absl::Cord data,
           self->flush_requested_ = true;
           MaybeFlush(*self, std::move(lock));
         });
+    if (self.flush_delay_ != absl::InfiniteDuration()) {
+      // Flush the buffer once the delay elapses, even if no future is forced.
+      internal::ScheduleAt(
+          absl::Now() + self.flush_delay_,
+          [self = internal::IntrusivePtr<IndirectDataWriter>(&self),
+           promise = self.promise_] {
+            UniqueWriterLock lock{self->mutex_};
+            if (!HaveSameSharedState(promise, self->promise_)) return;
+            ABSL_LOG_IF(INFO, ocdbt_logging) << "Flush delay elapsed";
+            self->flush_requested_ = true;
+            MaybeFlush(*self, std::move(lock));
+          });
+    }
   }
   ref.file_id = self.data_file_id_;
   ref.offset = self.buffer_.size();
   ref.length = data.size();
   self.buffer_.Append(std::move(data));
 
-  if (self.target_size_ > 0 && self.buffer_.size() >= self.target_size_) {
+  if (MustFlushImmediately(self)) {
     MaybeFlush(self, std::move(lock));
   }
   return future;
@@ -196,9 +257,12 @@ Future<const void> Write(IndirectDataWriter& self, absl::Cord data,
 
 IndirectDataWriterPtr MakeIndirectDataWriter(kvstore::KvStore kvstore,
                                              std::string prefix,
-                                             size_t target_size) {
+                                             size_t target_size,
+                                             absl::Duration flush_delay,
+                                             size_t max_in_flight_bytes) {
   return internal::MakeIntrusivePtr<IndirectDataWriter>(
-      std::move(kvstore), std::move(prefix), target_size);
+      std::move(kvstore), std::move(prefix), target_size, flush_delay,
+      max_in_flight_bytes);
 }
 
 }  // namespace internal_ocdbt
@@ -17,7 +17,10 @@
 
 #include <stddef.h>
 
+#include <string>
+
 #include "absl/strings/cord.h"
+#include "absl/time/time.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/kvstore/ocdbt/format/indirect_data_reference.h"
@@ -34,10 +37,29 @@
 /// not start until `Future::Force` is called on the returned future, and isn't
 /// guaranteed to be durable until the returned future becomes ready.
 ///
-/// Currently, values that are written are buffered in memory until they are
-/// explicitly flushed by forcing a returned future.  In the future, there may
-/// be support for streaming writes and appending to existing keys in the
-/// underlying kvstore.
+/// Values that are written are buffered in memory and written together as a
+/// single data file.  The buffer is flushed when:
+///
+/// - a returned future is forced;
+///
+/// - the buffer reaches the target size;
+///
+/// - the flush delay has elapsed since the first value was added to the
+///   buffer; or
+///
+/// - the total size of the buffer and all in-progress flushes reaches the
+///   in-flight limit.
+///
+/// The last two conditions allow large ingests to stream values to the
+/// underlying kvstore while more values are written, rather than holding all
+/// of them in memory until a commit forces the returned futures.
+///
+/// The in-flight limit bounds only the data being written to the underlying
+/// kvstore, not the buffer.  `Write` never blocks: once the limit is reached,
+/// values are still added to the buffer, which may then grow beyond both the
+/// limit and the target size, but the buffer is not flushed until in-progress
+/// flushes complete.  Since the returned futures only become ready once the
+/// buffer is flushed, this throttles writers that wait for them, e.g. commits.
 ///
 /// This is used to store data values and btree nodes.
 
@@ -50,9 +72,21 @@ using IndirectDataWriterPtr = internal::IntrusivePtr<IndirectDataWriter>;
 void intrusive_ptr_increment(IndirectDataWriter* p);
 void intrusive_ptr_decrement(IndirectDataWriter* p);
 
-IndirectDataWriterPtr MakeIndirectDataWriter(kvstore::KvStore kvstore,
-                                             std::string prefix,
-                                             size_t target_size);
+/// Returns a new writer that stores data files under `prefix` in `kvstore`.
+///
+/// \param target_size Target size of each data file, or `0` for no limit.
+/// \param flush_delay Maximum time that a value is buffered before it is
+///     flushed even though no returned future was forced.
+///     `absl::InfiniteDuration()` indicates no limit.
+/// \param max_in_flight_bytes Limit on the number of bytes being flushed, or
+///     `0` for no limit.  A flush that would exceed the limit is deferred
+///     until in-progress flushes complete.  Once the buffer together with
+///     in-progress flushes reaches the limit, it is flushed as soon as no
+///     other flush is in progress.
+IndirectDataWriterPtr MakeIndirectDataWriter(
+    kvstore::KvStore kvstore, std::string prefix, size_t target_size,
+    absl::Duration flush_delay = absl::InfiniteDuration(),
+    size_t max_in_flight_bytes = 0);
 
 Future<const void> Write(IndirectDataWriter& self, absl::Cord data,
                          IndirectDataReference& ref);
@@ -23,6 +23,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/strings/cord.h"
+#include "absl/time/time.h"
 #include "tensorstore/internal/flat_cord_builder.h"
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/kvstore/memory/memory_key_value_store.h"
@@ -152,4 +153,78 @@ TEST(IndirectDataWriter, LimitedSize) {
   EXPECT_THAT(files, ::testing::ElementsAreArray(refs));
 }
 
+TEST(IndirectDataWriter, FlushDelay) {
+  auto memory_store = tensorstore::GetMemoryKeyValueStore();
+  auto mock_key_value_store = MockKeyValueStore::Make();
+  auto writer = MakeIndirectDataWriter(
+      tensorstore::kvstore::KvStore(mock_key_value_store), "d/", 0,
+      absl::Milliseconds(10));
+
+  IndirectDataReference ref1, ref2;
+  auto future1 = Write(*writer, GetCord(100), ref1);
+  auto future2 = Write(*writer, GetCord(100), ref2);
+  EXPECT_EQ(ref1.file_id, ref2.file_id);
+
+  // The buffer is flushed once the delay elapses, even though neither future
+  // was forced.
+  auto r = mock_key_value_store->write_requests.pop();
+  EXPECT_EQ(ref1.file_id.FullPath(), r.key);
+  EXPECT_EQ(200, r.value->size());
+  r(memory_store);
+  TENSORSTORE_ASSERT_OK(future1.status());
+  TENSORSTORE_ASSERT_OK(future2.status());
+  EXPECT_TRUE(mock_key_value_store->write_requests.empty());
+}
+
+TEST(IndirectDataWriter, MaxInFlightBytes) {
+  constexpr size_t kMaxInFlightBytes = 1024;
+
+  auto memory_store = tensorstore::GetMemoryKeyValueStore();
+  auto mock_key_value_store = MockKeyValueStore::Make();
+  auto writer = MakeIndirectDataWriter(
+      tensorstore::kvstore::KvStore(mock_key_value_store), "d/", 0,
+      absl::InfiniteDuration(), kMaxInFlightBytes);
+
+  std::vector<Future<const void>> futures;
+  // 4 * 260 bytes exceeds the limit, which flushes the buffer without forcing
+  // any future.
+  for (int i = 0; i < 4; ++i) {
+    IndirectDataReference ref;
+    futures.push_back(Write(*writer, GetCord(260), ref));
+  }
+  EXPECT_EQ(1, mock_key_value_store->write_requests.size());
+
+  // Additional writes do not block, but are not flushed, even if forced,
+  // until the in-flight flush completes.  They are combined into a single data
+  // file rather than flushed separately.
+  std::vector<Future<const void>> deferred_futures;
+  for (int i = 0; i < 4; ++i) {
+    IndirectDataReference ref;
+    auto future = Write(*writer, GetCord(260), ref);
+    future.Force();
+    deferred_futures.push_back(std::move(future));
+  }
+  EXPECT_EQ(1, mock_key_value_store->write_requests.size());
+
+  mock_key_value_store->write_requests.pop()(memory_store);
+  for (auto& f : futures) {
+    TENSORSTORE_ASSERT_OK(f.status());
+  }
+  EXPECT_FALSE(deferred_futures[0].ready());
+  {
+    auto r = mock_key_value_store->write_requests.pop();
+    EXPECT_EQ(4 * 260, r.value->size());
+    r(memory_store);
+  }
+  for (auto& f : deferred_futures) {
+    TENSORSTORE_ASSERT_OK(f.status());
+  }
+  EXPECT_TRUE(mock_key_value_store->write_requests.empty());
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto entries,
+      tensorstore::kvstore::ListFuture(memory_store.get()).result());
+  EXPECT_THAT(entries, ::testing::SizeIs(2));
+}
+
 }  // namespace
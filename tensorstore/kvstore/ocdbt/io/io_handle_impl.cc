@@ -29,6 +29,7 @@
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "tensorstore/context.h"
 #include "tensorstore/internal/cache/async_cache.h"
@@ -39,6 +40,7 @@
 #include "tensorstore/internal/data_copy_concurrency_resource.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/log/verbose_flag.h"
+#include "tensorstore/internal/thread/schedule_at.h"
 #include "tensorstore/kvstore/driver.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/kvstore.h"
@@ -61,6 +63,7 @@
 #include "tensorstore/util/executor.h"
 #include "tensorstore/util/future.h"
 #include "tensorstore/util/status.h"
+#include "tensorstore/util/stop_token.h"
 
 namespace tensorstore {
 namespace internal_ocdbt {
@@ -68,6 +71,48 @@ namespace internal_ocdbt {
 namespace {
 ABSL_CONST_INIT internal_log::VerboseFlag ocdbt_logging("ocdbt");
 
+// Periodically refreshes the cached manifest.
+//
+// Only the manifest cache entries are retained, rather than the `IoHandleImpl`
+// itself, such that polling stops once the `IoHandleImpl` is destroyed.
+struct ManifestPoller {
+  internal::PinnedCacheEntry<ManifestCache> manifest_cache_entry;
+  internal::PinnedCacheEntry<NumberedManifestCache>
+      numbered_manifest_cache_entry;
+  absl::Duration interval;
+  StopToken stop_token;
+
+  void ScheduleNext() const {
+    // Poll twice per interval, such that the cached manifest normally satisfies
+    // the staleness bound computed by `GetReadManifestStalenessBound`.
+    internal::ScheduleAt(
+        absl::Now() + interval / 2,
+        [poller = *this]() mutable { std::move(poller).Poll(); }, stop_token);
+  }
+
+  void Poll() && {
+    if (stop_token.stop_requested()) return;
+    bool numbered;
+    {
+      internal::AsyncCache::ReadLock<Manifest> lock{*manifest_cache_entry};
+      auto* manifest = lock.data();
+      numbered = manifest &&
+                 manifest->config.manifest_kind != ManifestKind::kSingle;
+    }
+    ABSL_LOG_IF(INFO, ocdbt_logging)
+        << "Polling " << (numbered ? "numbered" : "single") << " manifest";
+    auto future = numbered ? numbered_manifest_cache_entry->Read({absl::Now()})
+                           : manifest_cache_entry->Read({absl::Now()});
+    future.Force();
+    std::move(future).ExecuteWhenReady(
+        [poller = std::move(*this)](ReadyFuture<const void> future) {
+          // Errors are ignored here; they are reported by any subsequent
+          // request that requires the manifest.
+          poller.ScheduleNext();
+        });
+  }
+};
+
 }  // namespace
 
 class IoHandleImpl : public IoHandle {
@@ -87,6 +132,12 @@ class IoHandleImpl : public IoHandle {
                                                       absl::InfinitePast()};
   mutable ManifestWithTime cached_numbered_manifest_{nullptr,
                                                      absl::InfinitePast()};
+
+  // Stops the `ManifestPoller`, if any.
+  StopSource manifest_poll_stop_source_;
+
+  ~IoHandleImpl() override { manifest_poll_stop_source_.request_stop(); }
+
   Future<const std::shared_ptr<const BtreeNode>> GetBtreeNode(
       const IndirectDataReference& ref) const final {
     return btree_node_cache_->ReadEntry(ref);
@@ -421,21 +472,29 @@ IoHandle::Ptr MakeIoHandle(
     internal::CachePool* cache_pool, const KvStore& base_kvstore,
     const KvStore& manifest_kvstore, ConfigStatePtr config_state,
     const DataFilePrefixes& data_file_prefixes, size_t write_target_size,
-    std::optional<ReadCoalesceOptions> read_coalesce_options) {
+    std::optional<ReadCoalesceOptions> read_coalesce_options,
+    size_t max_in_flight_btree_nodes, absl::Duration manifest_poll_interval,
+    absl::Duration write_flush_delay, size_t max_in_flight_write_bytes) {
   // Maybe wrap the base driver in CoalesceKvStoreDriver.
-  kvstore::DriverPtr driver_with_optional_coalescing =
-      read_coalesce_options.has_value()
-          ? MakeCoalesceKvStoreDriver(
-                base_kvstore.driver,
-                read_coalesce_options->max_overhead_bytes_per_request,
-                read_coalesce_options->max_merged_bytes_per_request,
-                read_coalesce_options->max_interval,
-                data_copy_concurrency->executor)
-          : base_kvstore.driver;
+  kvstore::DriverPtr driver_with_optional_coalescing = base_kvstore.driver;
+  if (read_coalesce_options.has_value()) {
+    CoalesceKvStoreOptions coalesce_options;
+    coalesce_options.threshold =
+        read_coalesce_options->max_overhead_bytes_per_request;
+    coalesce_options.merged_threshold =
+        read_coalesce_options->max_merged_bytes_per_request;
+    coalesce_options.interval = read_coalesce_options->max_interval;
+    coalesce_options.adaptive = read_coalesce_options->adaptive;
+    driver_with_optional_coalescing =
+        MakeCoalesceKvStoreDriver(base_kvstore.driver, coalesce_options,
+                                  data_copy_concurrency->executor);
+  }
   auto impl = internal::MakeIntrusivePtr<IoHandleImpl>();
   impl->base_kvstore_ = base_kvstore;
   impl->config_state = std::move(config_state);
   impl->executor = data_copy_concurrency->executor;
+  impl->max_in_flight_btree_nodes = max_in_flight_btree_nodes;
+  impl->manifest_poll_interval = manifest_poll_interval;
   auto data_kvstore =
       kvstore::KvStore(driver_with_optional_coalescing, base_kvstore.path);
   {
@@ -452,7 +511,8 @@ IoHandle::Ptr MakeIoHandle(
                        &data_prefix_array[0];
       if (match_i == i) {
         impl->indirect_data_writer_[i] = internal_ocdbt::MakeIndirectDataWriter(
-            data_kvstore, std::string(data_prefix_array[i]), write_target_size);
+            data_kvstore, std::string(data_prefix_array[i]), write_target_size,
+            write_flush_delay, max_in_flight_write_bytes);
       } else {
         impl->indirect_data_writer_[i] = impl->indirect_data_writer_[match_i];
       }
@@ -492,6 +552,12 @@ IoHandle::Ptr MakeIoHandle(
     impl->numbered_manifest_cache_entry_ = tensorstore::internal::GetCacheEntry(
         numbered_manifest_cache, manifest_kvstore.path);
   }
+  if (manifest_poll_interval > absl::ZeroDuration()) {
+    ManifestPoller{impl->manifest_cache_entry_,
+                   impl->numbered_manifest_cache_entry_, manifest_poll_interval,
+                   impl->manifest_poll_stop_source_.get_token()}
+        .ScheduleNext();
+  }
   return impl;
 }
 
@@ -46,6 +46,7 @@ struct ReadCoalesceOptions {
   int64_t max_overhead_bytes_per_request;
   int64_t max_merged_bytes_per_request;
   absl::Duration max_interval;
+  bool adaptive = false;
 };
 
 /// Returns an `IoHandle` handle based on the specified arguments.
@@ -55,7 +56,11 @@ IoHandle::Ptr MakeIoHandle(
     internal::CachePool* cache_pool, const KvStore& base_kvstore,
     const KvStore& manifest_kvstore, ConfigStatePtr config_state,
     const DataFilePrefixes& data_file_prefixes, size_t write_target_size = 0,
-    std::optional<ReadCoalesceOptions> read_coalesce_options = std::nullopt);
+    std::optional<ReadCoalesceOptions> read_coalesce_options = std::nullopt,
+    size_t max_in_flight_btree_nodes = kDefaultMaxInFlightBtreeNodes,
+    absl::Duration manifest_poll_interval = absl::ZeroDuration(),
+    absl::Duration write_flush_delay = absl::InfiniteDuration(),
+    size_t max_in_flight_write_bytes = 0);
 
 }  // namespace internal_ocdbt
 }  // namespace tensorstore
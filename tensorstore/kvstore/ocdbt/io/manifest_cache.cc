@@ -76,6 +76,18 @@ auto& manifest_update_errors = internal_metrics::Counter<int64_t>::New(
     "/tensorstore/kvstore/ocdbt/manifest_update_errors",
     MetricMetadata("OCDBT driver manifest update errors (typically retried)"));
 
+auto& manifest_reads = internal_metrics::Counter<int64_t>::New(
+    "/tensorstore/kvstore/ocdbt/manifest_reads",
+    MetricMetadata("OCDBT driver reads of the single-file manifest"));
+
+auto& numbered_manifest_lists = internal_metrics::Counter<int64_t>::New(
+    "/tensorstore/kvstore/ocdbt/numbered_manifest_lists",
+    MetricMetadata("OCDBT driver list operations for numbered manifests"));
+
+auto& numbered_manifest_reads = internal_metrics::Counter<int64_t>::New(
+    "/tensorstore/kvstore/ocdbt/numbered_manifest_reads",
+    MetricMetadata("OCDBT driver reads of numbered manifests"));
+
 ABSL_CONST_INIT internal_log::VerboseFlag ocdbt_logging("ocdbt");
 
 using ReadState = internal::AsyncCache::ReadState;
@@ -159,6 +171,7 @@ void IssueRead(EntryOrNode* entry_or_node, kvstore::ReadOptions&& options,
 
   auto& cache = GetOwningCache(*entry_or_node);
   auto& entry = GetOwningEntry(*entry_or_node);
+  manifest_reads.Increment();
   auto future = cache.kvstore_driver_->Read(GetManifestPath(entry.key()),
                                             std::move(options));
   future.Force();
@@ -406,9 +419,13 @@ void ListNumberedManifests(NumberedManifestCache::Entry* entry,
   options.range = KeyRange(tensorstore::StrCat(key, "manifest.0"),
                            tensorstore::StrCat(key, "manifest.:"));
   options.strip_prefix_length = key.size() + 9;  // Length of "manifest."
-  // TODO(jbms): Support `staleness_bound`.  For now, we ignore it because
-  // `List` doesn't currently return a timestamp for the results.
-  auto time = absl::Now();
+  // `List` doesn't return a timestamp for the results.  The results reflect
+  // the state as of at least `staleness_bound` (if the base kvstore uses a
+  // cached listing) or as of the time the request is issued, whichever is
+  // earlier.
+  auto time = std::min(staleness_bound, absl::Now());
+  options.staleness_bound = time;
+  numbered_manifest_lists.Increment();
   auto future = kvstore::ListFuture(cache.kvstore_driver_, std::move(options));
   future.Force();
   future.ExecuteWhenReady(WithExecutor(
@@ -452,8 +469,14 @@ void ReadNumberedManifest(NumberedManifestCache::Entry* entry,
   auto& cache = GetOwningCache(*entry);
   ABSL_LOG_IF(INFO, ocdbt_logging)
       << "Reading numbered manifest: " << generation_number;
+  // Numbered manifests are never modified once written, only deleted, so any
+  // cached copy that satisfies `staleness_bound` may be used.
+  kvstore::ReadOptions options;
+  options.staleness_bound = staleness_bound;
+  numbered_manifest_reads.Increment();
   auto read_future = cache.kvstore_driver_->Read(
-      GetNumberedManifestPath(entry->key(), generation_number));
+      GetNumberedManifestPath(entry->key(), generation_number),
+      std::move(options));
   read_future.Force();
   read_future.ExecuteWhenReady(WithExecutor(
       cache.executor(),
@@ -15,6 +15,9 @@
 #ifndef TENSORSTORE_KVSTORE_OCDBT_IO_HANDLE_H_
 #define TENSORSTORE_KVSTORE_OCDBT_IO_HANDLE_H_
 
+#include <stddef.h>
+
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <string>
@@ -22,6 +25,7 @@
 
 #include "absl/strings/cord.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/kvstore/ocdbt/config.h"
@@ -37,6 +41,9 @@
 namespace tensorstore {
 namespace internal_ocdbt {
 
+/// Default value of `ReadonlyIoHandle::max_in_flight_btree_nodes`.
+constexpr size_t kDefaultMaxInFlightBtreeNodes = 64;
+
 /// Abstract interface used by operation implementations to read the OCDBT data
 /// structures for a single database.
 class ReadonlyIoHandle
@@ -64,6 +71,23 @@ class ReadonlyIoHandle
   ConfigStatePtr config_state;
   Executor executor;
 
+  /// Maximum number of B+tree nodes that a single list or commit traversal
+  /// reads concurrently.  List operations additionally count nodes that have
+  /// been read but not yet visited towards this limit.
+  size_t max_in_flight_btree_nodes = kDefaultMaxInFlightBtreeNodes;
+
+  /// If non-zero, non-transactional reads and lists may use a cached manifest
+  /// that is up to this old.  The manifest is refreshed in the background so
+  /// that such requests normally don't wait for the manifest to be fetched.
+  absl::Duration manifest_poll_interval = absl::ZeroDuration();
+
+  /// Returns the staleness bound to use for the manifest when performing a
+  /// non-transactional read or list with the specified `staleness_bound`.
+  absl::Time GetReadManifestStalenessBound(absl::Time staleness_bound) const {
+    if (manifest_poll_interval == absl::ZeroDuration()) return staleness_bound;
+    return std::min(staleness_bound, absl::Now() - manifest_poll_interval);
+  }
+
   virtual ~ReadonlyIoHandle();
 };
 
@@ -14,9 +14,13 @@
 
 #include "tensorstore/kvstore/ocdbt/non_distributed/btree_writer_commit_operation.h"
 
+#include <stddef.h>
+
 #include <algorithm>
 #include <cassert>
 #include <memory>
+#include <string>
+#include <string_view>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -28,8 +32,12 @@
 #include "absl/synchronization/mutex.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/rate_limiter/rate_limiter.h"
 #include "tensorstore/kvstore/ocdbt/format/btree.h"
+#include "tensorstore/kvstore/ocdbt/format/btree_codec.h"
 #include "tensorstore/kvstore/ocdbt/format/btree_node_encoder.h"
+#include "tensorstore/kvstore/ocdbt/format/config.h"
 #include "tensorstore/kvstore/ocdbt/format/indirect_data_reference.h"
 #include "tensorstore/kvstore/ocdbt/format/manifest.h"
 #include "tensorstore/kvstore/ocdbt/format/version_tree.h"
@@ -45,6 +53,128 @@
 
 namespace tensorstore {
 namespace internal_ocdbt {
+namespace {
+
+using InteriorNodeMutation =
+    BtreeWriterCommitOperationBase::InteriorNodeMutation;
+
+// A non-root node from which entries were removed, and that is left with less
+// than `1 / kUnderfullFraction` of the maximum node size, is merged with its
+// siblings rather than written on its own.  Nodes that did not lose entries are
+// never merged, such that appends do not rewrite unmodified siblings.
+constexpr size_t kUnderfullFraction = 4;
+
+// Returns `true` if a non-root node with the specified number of entries and
+// estimated decoded size should be merged with its siblings.
+bool IsUnderfull(const Config& config, size_t num_entries,
+                 size_t decoded_size_estimate) {
+  if (num_entries * kUnderfullFraction >= kMaxNodeArity) return false;
+  return config.max_decoded_node_bytes == 0 ||
+         decoded_size_estimate * kUnderfullFraction <
+             config.max_decoded_node_bytes;
+}
+
+size_t GetNumEntries(const BtreeNode& node) {
+  return std::visit([](const auto& entries) { return entries.size(); },
+                    node.entries);
+}
+
+// Sorts by key order, with deletions before additions, which allows the
+// mutations to remove and add the same key without additional checks.
+void SortMutations(span<InteriorNodeMutation> mutations) {
+  std::sort(mutations.begin(), mutations.end(),
+            [](const InteriorNodeMutation& a, const InteriorNodeMutation& b) {
+              int c = a.entry.key.compare(b.entry.key);
+              if (c != 0) return c < 0;
+              return a.add < b.add;
+            });
+}
+
+// Child node to be merged by `EncodeMergedNodes`.
+struct MergeChild {
+  // Full key prefix of the entries of `node`, including `node->key_prefix`.
+  std::string full_prefix;
+  std::shared_ptr<const BtreeNode> node;
+};
+
+// Encodes the concatenated entries of `children`, which must be consecutive
+// nodes of the specified `height`.
+template <typename Entry>
+Result<std::vector<EncodedNode>> EncodeMergedNodes(
+    const Config& config, BtreeNodeHeight height,
+    span<const MergeChild> children, bool may_be_root) {
+  size_t num_entries = 0;
+  for (const auto& child : children) {
+    num_entries += std::get<std::vector<Entry>>(child.node->entries).size();
+  }
+  // Full keys, which must remain valid until `Finalize` is called.
+  std::vector<std::string> keys;
+  keys.reserve(num_entries);
+  BtreeNodeEncoder<Entry> encoder(config, height, /*existing_prefix=*/{});
+  for (const auto& child : children) {
+    for (const auto& entry :
+         std::get<std::vector<Entry>>(child.node->entries)) {
+      Entry new_entry = entry;
+      new_entry.key =
+          keys.emplace_back(tensorstore::StrCat(child.full_prefix, entry.key));
+      if constexpr (std::is_same_v<Entry, InteriorNodeEntry>) {
+        new_entry.subtree_common_prefix_length += child.full_prefix.size();
+      }
+      encoder.AddEntry(/*existing=*/false, std::move(new_entry));
+    }
+  }
+  return encoder.Finalize(may_be_root);
+}
+
+// B+tree node read that is waiting to be admitted by, or has been admitted by,
+// `BtreeWriterCommitOperationBase::btree_node_read_queue_`.
+struct BtreeNodeReadTask
+    : public internal::RateLimiterNode,
+      public internal::AtomicReferenceCount<BtreeNodeReadTask> {
+  std::shared_ptr<internal::AdmissionQueue> queue;
+  IoHandle::Ptr io_handle;
+  IndirectDataReference location;
+  Promise<std::shared_ptr<const BtreeNode>> promise;
+
+  ~BtreeNodeReadTask() { queue->Finish(this); }
+
+  static void Admit(internal::RateLimiterNode* node) {
+    auto* self = static_cast<BtreeNodeReadTask*>(node);
+    // Start the read from the executor, since `Admit` may be called from
+    // `Finish` of a previous read.
+    self->io_handle->executor(
+        [self = internal::IntrusivePtr<BtreeNodeReadTask>(
+             self, internal::adopt_object_ref)]() mutable {
+          if (!self->promise.result_needed()) return;
+          auto read_future = self->io_handle->GetBtreeNode(self->location);
+          std::move(read_future)
+              .ExecuteWhenReady(
+                  [self = std::move(self)](
+                      ReadyFuture<const std::shared_ptr<const BtreeNode>>
+                          future) {
+                    self->promise.SetResult(future.result());
+                  });
+        });
+  }
+};
+
+}  // namespace
+
+Future<const std::shared_ptr<const BtreeNode>>
+BtreeWriterCommitOperationBase::ReadBtreeNode(
+    const IndirectDataReference& location) {
+  auto [promise, future] =
+      PromiseFuturePair<std::shared_ptr<const BtreeNode>>::Make();
+  auto task = internal::MakeIntrusivePtr<BtreeNodeReadTask>();
+  task->queue = btree_node_read_queue_;
+  task->io_handle = io_handle_;
+  task->location = location;
+  task->promise = std::move(promise);
+  // Reference adopted by `BtreeNodeReadTask::Admit`.
+  intrusive_ptr_increment(task.get());
+  btree_node_read_queue_->Admit(task.get(), &BtreeNodeReadTask::Admit);
+  return std::move(future);
+}
 
 void BtreeWriterCommitOperationBase::ReadManifest() {
   Future<const ManifestWithTime> read_future;
@@ -157,6 +287,8 @@ void BtreeWriterCommitOperationBase::RootNodeTraversalState::ApplyMutations() {
       BtreeGenerationReference ref;
       ref.root_height = this->height_ - 1;
       ref.root = new_root_mutation.entry.node;
+      // Key filters are only stored in interior nodes.
+      ref.root.key_filter.clear();
       this->writer_->CreateNewManifest(std::move(this->promise_), ref);
       return;
     }
@@ -164,6 +296,7 @@ void BtreeWriterCommitOperationBase::RootNodeTraversalState::ApplyMutations() {
     // Need to add a level to the tree.
     auto mutations = std::exchange(this->mutations_, {});
     UpdateParent(*this, /*existing_relative_child_key=*/{},
+                 /*existing_num_entries=*/0,
                  EncodeUpdatedInteriorNodes(this->writer_->existing_config(),
                                             this->height_,
                                             /*existing_prefix=*/{},
@@ -188,8 +321,19 @@ void BtreeWriterCommitOperationBase::InteriorNodeTraversalState::
     return;
   }
 
+  const bool has_underfull_children =
+      std::any_of(this->mutations_.begin(), this->mutations_.end(),
+                  [](const InteriorNodeMutation& mutation) {
+                    return mutation.pending_node != nullptr;
+                  });
+  if ((has_underfull_children || parent_state_->is_root_parent()) &&
+      !MergeUnderfullChildren()) {
+    return;
+  }
+
   UpdateParent(
       *parent_state_, existing_relative_child_key_,
+      std::get<BtreeNode::InteriorNodeEntries>(existing_node_->entries).size(),
       EncodeUpdatedInteriorNodes(
           this->writer_->existing_config(), this->height_,
           this->existing_subtree_key_prefix_,
@@ -198,37 +342,296 @@ void BtreeWriterCommitOperationBase::InteriorNodeTraversalState::
           /*may_be_root=*/parent_state_->is_root_parent()));
 }
 
+bool BtreeWriterCommitOperationBase::InteriorNodeTraversalState::
+    MergeUnderfullChildren() {
+  const Config& config = this->writer_->existing_config();
+  span<const InteriorNodeEntry> existing_entries =
+      std::get<BtreeNode::InteriorNodeEntries>(existing_node_->entries);
+  SortMutations(this->mutations_);
+
+  // Determine the children that remain after applying `mutations_`.
+  struct Child {
+    // Exactly one of `existing` and `mutation` is non-null.
+    const InteriorNodeEntry* existing = nullptr;
+    InteriorNodeMutation* mutation = nullptr;
+    bool pending() const { return mutation && mutation->pending_node; }
+  };
+  std::vector<Child> children;
+  {
+    ComparePrefixedKeyToUnprefixedKey compare_existing_and_new_keys{
+        this->existing_subtree_key_prefix_};
+    auto existing_it = existing_entries.begin();
+    auto mutation_it = this->mutations_.begin();
+    while (existing_it != existing_entries.end() ||
+           mutation_it != this->mutations_.end()) {
+      int c = existing_it == existing_entries.end() ? 1
+              : mutation_it == this->mutations_.end()
+                  ? -1
+                  : compare_existing_and_new_keys(existing_it->key,
+                                                  mutation_it->entry.key);
+      if (c < 0) {
+        children.push_back(Child{&*existing_it, nullptr});
+        ++existing_it;
+        continue;
+      }
+      if (c == 0) ++existing_it;
+      if (mutation_it->add) {
+        children.push_back(Child{nullptr, &*mutation_it});
+      }
+      ++mutation_it;
+    }
+  }
+
+  // Ranges of `children` to merge.  Each consists of a run of consecutive
+  // underfull children, extended by an adjacent unmodified sibling if the
+  // run as a whole is still underfull.
+  std::vector<std::pair<size_t, size_t>> groups;
+  for (size_t i = 0, claimed_end = 0; i < children.size();) {
+    if (!children[i].pending()) {
+      ++i;
+      continue;
+    }
+    size_t begin = i, end = i;
+    size_t num_entries = 0, size_estimate = 0;
+    for (; end < children.size() && children[end].pending(); ++end) {
+      auto& mutation = *children[end].mutation;
+      num_entries += GetNumEntries(*mutation.pending_node);
+      size_estimate += mutation.pending_size_estimate;
+    }
+    if (IsUnderfull(config, num_entries, size_estimate)) {
+      if (begin > claimed_end && children[begin - 1].existing) {
+        --begin;
+      } else if (end < children.size() && children[end].existing) {
+        ++end;
+      }
+    }
+    groups.emplace_back(begin, end);
+    claimed_end = i = end;
+  }
+
+  const bool is_root = parent_state_->is_root_parent();
+
+  // Replaces this root node with `new_root` at the next lower height.
+  const auto replace_root = [&](InteriorNodeEntryData<std::string> new_root) {
+    ABSL_LOG_IF(INFO, ocdbt_logging)
+        << "MergeUnderfullChildren: reducing height to "
+        << static_cast<int>(this->height_ - 1);
+    std::vector<InteriorNodeMutation> new_children(1);
+    new_children[0].add = true;
+    new_children[0].entry = std::move(new_root);
+    {
+      absl::MutexLock lock(&parent_state_->mutex_);
+      --parent_state_->height_;
+    }
+    ReplaceChild(*parent_state_, existing_relative_child_key_,
+                 std::move(new_children));
+  };
+
+  if (is_root && children.size() == 1 && groups.empty()) {
+    // The single child of the root node can become the new root node if no key
+    // prefix is excluded from it; otherwise it must be re-encoded.
+    auto& child = children[0];
+    const size_t subtree_common_prefix_length =
+        child.existing ? this->existing_subtree_key_prefix_.size() +
+                             child.existing->subtree_common_prefix_length
+                       : child.mutation->entry.subtree_common_prefix_length;
+    if (subtree_common_prefix_length == 0) {
+      InteriorNodeEntryData<std::string> new_root{};
+      new_root.node =
+          child.existing ? child.existing->node : child.mutation->entry.node;
+      replace_root(std::move(new_root));
+      return false;
+    }
+    if (child.existing) groups.emplace_back(0, 1);
+  }
+
+  if (groups.empty()) return true;
+
+  // Read any unmodified siblings that are to be merged.
+  std::vector<size_t> missing_siblings;
+  for (const auto& [begin, end] : groups) {
+    for (size_t i = begin; i < end; ++i) {
+      if (!children[i].existing) continue;
+      size_t index = children[i].existing - existing_entries.data();
+      if (!merge_siblings_.contains(index)) missing_siblings.push_back(index);
+    }
+  }
+  if (!missing_siblings.empty()) {
+    ReadMergeSiblings(missing_siblings);
+    return false;
+  }
+
+  const bool may_be_root = is_root && groups.size() == 1 &&
+                           groups[0].first == 0 &&
+                           groups[0].second == children.size();
+  const BtreeNodeHeight child_height = this->height_ - 1;
+  std::vector<InteriorNodeMutation> new_mutations;
+  for (const auto& [begin, end] : groups) {
+    std::vector<MergeChild> merge_children;
+    for (size_t i = begin; i < end; ++i) {
+      auto& child = children[i];
+      if (child.existing) {
+        const auto& existing = *child.existing;
+        auto& node = merge_siblings_[&existing - existing_entries.data()];
+        merge_children.push_back(MergeChild{
+            tensorstore::StrCat(
+                this->existing_subtree_key_prefix_,
+                existing.key.substr(0, existing.subtree_common_prefix_length),
+                node->key_prefix),
+            node});
+        auto& deletion = new_mutations.emplace_back();
+        deletion.add = false;
+        deletion.entry.key = tensorstore::StrCat(
+            this->existing_subtree_key_prefix_, existing.key);
+      } else {
+        auto& entry = child.mutation->entry;
+        auto& node = child.mutation->pending_node;
+        merge_children.push_back(MergeChild{
+            tensorstore::StrCat(std::string_view(entry.key).substr(
+                                    0, entry.subtree_common_prefix_length),
+                                node->key_prefix),
+            node});
+      }
+    }
+    auto encoded_nodes_result =
+        child_height == 0
+            ? EncodeMergedNodes<LeafNodeEntry>(config, child_height,
+                                               merge_children, may_be_root)
+            : EncodeMergedNodes<InteriorNodeEntry>(config, child_height,
+                                                   merge_children, may_be_root);
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto encoded_nodes, std::move(encoded_nodes_result),
+        (static_cast<void>(SetDeferredResult(this->promise_, _)), false));
+    ABSL_LOG_IF(INFO, ocdbt_logging)
+        << "MergeUnderfullChildren: merged " << (end - begin)
+        << " children into " << encoded_nodes.size();
+    auto new_entries = internal_ocdbt::WriteNodes(
+        *this->writer_->io_handle_, this->writer_->flush_promise_,
+        std::move(encoded_nodes));
+    if (may_be_root && new_entries.size() == 1) {
+      replace_root(std::move(new_entries[0]));
+      return false;
+    }
+    for (auto& new_entry : new_entries) {
+      auto& mutation = new_mutations.emplace_back();
+      mutation.add = true;
+      mutation.entry = std::move(new_entry);
+    }
+  }
+
+  for (auto& mutation : this->mutations_) {
+    if (mutation.pending_node) continue;
+    new_mutations.push_back(std::move(mutation));
+  }
+  this->mutations_ = std::move(new_mutations);
+  return true;
+}
+
+void BtreeWriterCommitOperationBase::InteriorNodeTraversalState::
+    ReadMergeSiblings(span<const size_t> indices) {
+  // This state is destroyed once `ApplyMutations` returns; transfer it to a
+  // new state that is kept alive until the reads complete.
+  auto state = internal::MakeIntrusivePtr<InteriorNodeTraversalState>();
+  state->writer_ = this->writer_;
+  state->promise_ = this->promise_;
+  state->mutations_ = std::move(this->mutations_);
+  state->existing_subtree_key_prefix_ =
+      std::move(this->existing_subtree_key_prefix_);
+  state->height_ = this->height_;
+  state->parent_state_ = std::move(parent_state_);
+  state->existing_node_ = std::move(existing_node_);
+  state->existing_relative_child_key_ = std::move(existing_relative_child_key_);
+  state->merge_siblings_ = std::move(merge_siblings_);
+
+  auto& io_handle = *state->writer_->io_handle_;
+  for (size_t index : indices) {
+    const auto& entry = std::get<BtreeNode::InteriorNodeEntries>(
+        state->existing_node_->entries)[index];
+    ABSL_LOG_IF(INFO, ocdbt_logging)
+        << "ReadMergeSiblings: "
+        << tensorstore::QuoteString(state->existing_subtree_key_prefix_) << "+"
+        << tensorstore::QuoteString(entry.key);
+    Link(WithExecutor(
+             io_handle.executor,
+             [state, index](
+                 Promise<void> promise,
+                 ReadyFuture<const std::shared_ptr<const BtreeNode>> future) {
+               const auto& node = future.value();
+               const auto& entry = std::get<BtreeNode::InteriorNodeEntries>(
+                   state->existing_node_->entries)[index];
+               TENSORSTORE_RETURN_IF_ERROR(
+                   ValidateBtreeNodeReference(*node, state->height_ - 1,
+                                              entry.key_suffix()),
+                   static_cast<void>(SetDeferredResult(promise, _)));
+               absl::MutexLock lock(&state->mutex_);
+               state->merge_siblings_[index] = node;
+             }),
+         state->promise_,
+         state->writer_->ReadBtreeNode(entry.node.location));
+  }
+}
+
 void BtreeWriterCommitOperationBase::UpdateParent(
     NodeTraversalState& parent_state,
-    std::string_view existing_relative_child_key,
+    std::string_view existing_relative_child_key, size_t existing_num_entries,
     Result<std::vector<EncodedNode>>&& encoded_nodes_result) {
   TENSORSTORE_ASSIGN_OR_RETURN(
       auto encoded_nodes, std::move(encoded_nodes_result),
       static_cast<void>(SetDeferredResult(parent_state.promise_, _)));
 
-  auto new_entries = internal_ocdbt::WriteNodes(
-      *parent_state.writer_->io_handle_, parent_state.writer_->flush_promise_,
-      std::move(encoded_nodes));
-
-  {
-    absl::MutexLock lock(&parent_state.mutex_);
-
-    // Remove `existing_relative_child_key` from the parent node.
-    {
-      auto& mutation = parent_state.mutations_.emplace_back();
-      mutation.add = false;
-      mutation.entry.key =
-          tensorstore::StrCat(parent_state.existing_subtree_key_prefix_,
-                              existing_relative_child_key);
-    }
-
-    // Add `new_entries` in its place.
+  std::vector<InteriorNodeMutation> new_children;
+  if (encoded_nodes.size() == 1 && !parent_state.is_root_parent() &&
+      encoded_nodes[0].info.num_entries < existing_num_entries &&
+      IsUnderfull(parent_state.writer_->existing_config(),
+                  encoded_nodes[0].info.num_entries,
+                  encoded_nodes[0].info.decoded_size_estimate)) {
+    // Defer writing the node until the parent merges it with its siblings.
+    auto& encoded_node = encoded_nodes[0];
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto node,
+        DecodeBtreeNode(encoded_node.encoded_node, /*base_path=*/{}),
+        static_cast<void>(SetDeferredResult(parent_state.promise_, _)));
+    auto& mutation = new_children.emplace_back();
+    mutation.add = true;
+    mutation.entry.key = std::move(encoded_node.info.inclusive_min_key);
+    mutation.entry.subtree_common_prefix_length =
+        encoded_node.info.excluded_prefix_length;
+    mutation.entry.node.statistics = encoded_node.info.statistics;
+    mutation.entry.node.key_filter = std::move(encoded_node.info.key_filter);
+    mutation.pending_node = std::make_shared<const BtreeNode>(std::move(node));
+    mutation.pending_size_estimate = encoded_node.info.decoded_size_estimate;
+  } else {
+    auto new_entries = internal_ocdbt::WriteNodes(
+        *parent_state.writer_->io_handle_,
+        parent_state.writer_->flush_promise_, std::move(encoded_nodes));
     for (auto& new_entry : new_entries) {
-      auto& mutation = parent_state.mutations_.emplace_back();
+      auto& mutation = new_children.emplace_back();
       mutation.add = true;
       mutation.entry = std::move(new_entry);
     }
   }
+  ReplaceChild(parent_state, existing_relative_child_key,
+               std::move(new_children));
+}
+
+void BtreeWriterCommitOperationBase::ReplaceChild(
+    NodeTraversalState& parent_state,
+    std::string_view existing_relative_child_key,
+    std::vector<InteriorNodeMutation> new_children) {
+  absl::MutexLock lock(&parent_state.mutex_);
+
+  // Remove `existing_relative_child_key` from the parent node.
+  {
+    auto& mutation = parent_state.mutations_.emplace_back();
+    mutation.add = false;
+    mutation.entry.key = tensorstore::StrCat(
+        parent_state.existing_subtree_key_prefix_, existing_relative_child_key);
+  }
+
+  // Add `new_children` in its place.
+  for (auto& new_child : new_children) {
+    parent_state.mutations_.push_back(std::move(new_child));
+  }
 }
 
 Result<std::vector<EncodedNode>>
@@ -237,14 +640,7 @@ BtreeWriterCommitOperationBase::EncodeUpdatedInteriorNodes(
     std::string_view existing_prefix,
     span<const InteriorNodeEntry> existing_entries,
     span<InteriorNodeMutation> mutations, bool may_be_root) {
-  // Sort by key order, with deletions before additions, which allows the code
-  // below to remove and add the same key without additional checks.
-  std::sort(mutations.begin(), mutations.end(),
-            [](const InteriorNodeMutation& a, const InteriorNodeMutation& b) {
-              int c = a.entry.key.compare(b.entry.key);
-              if (c != 0) return c < 0;
-              return a.add < b.add;
-            });
+  SortMutations(mutations);
 
   BtreeInteriorNodeEncoder encoder(config, height, existing_prefix);
   auto existing_it = existing_entries.begin();
@@ -274,6 +670,7 @@ BtreeWriterCommitOperationBase::EncodeUpdatedInteriorNodes(
     }
 
     if (mutation_it->add) {
+      assert(!mutation_it->pending_node);
       internal_ocdbt::AddNewInteriorEntry(encoder, mutation_it->entry);
     }
     ++mutation_it;
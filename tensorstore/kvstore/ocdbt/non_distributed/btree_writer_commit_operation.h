@@ -33,7 +33,8 @@
 // 3. The B+tree is traversed top-down (starting from the root), recursively
 //    partitioning the ordered list of staged mutations according to the B+tree
 //    node structure. B+tree nodes are fetched as required to perform the
-//    partitioning. Write conditions are checked during this traversal.
+//    partitioning, with at most `IoHandle::max_in_flight_btree_nodes` reads
+//    in progress at once. Write conditions are checked during this traversal.
 //
 // 4. Nodes are re-written (and split as required) in a bottom-up fashion.
 //    Non-leaf nodes are not rewritten until any child nodes that need to be
@@ -51,19 +52,21 @@
 // 8. If the manifest is written successfully, then the commit is done.
 //    Otherwise, return to step 2.
 //
-// TODO(jbms): Currently, B+tree nodes are never merged in response to delete
-// operations, which means that lookups are `O(log M)`, where `M` is the total
-// number of keys inserted, rather than `O(log N)`, where `N` is the current
-// number of keys.  It is expected that for most use cases, there won't be many
-// deletes, if any, and for such uses cases merging nodes is unnecessary.  To
-// avoid writing too-small nodes, any remaining elements of too-small nodes
-// could be propagated back to the parent `NodeTraversalState` and then inserted
-// into a sibling (which would require reading or re-reading the sibling first).
+// Nodes that lose entries and become underfull as a result are not written in
+// step 4.  Instead, they are propagated back to the parent
+// `NodeTraversalState`, which merges them with adjacent siblings (reading
+// unmodified siblings as needed) and re-splits the combined entries.  When
+// the root is left with a single child, the height of the tree is reduced by
+// one level.  This keeps lookups `O(log N)`, where `N` is the current number
+// of keys, rather than the total number of keys ever inserted.
 //
 // TODO(jbms): Currently the asynchronous traversal of the tree is not bounded
 // in its memory usage.  That needs to be addressed, e.g. by limiting the number
 // of in-flight nodes.
 
+#include <stddef.h>
+
+#include <algorithm>
 #include <cassert>
 #include <memory>
 #include <optional>
@@ -72,6 +75,7 @@
 #include <vector>
 
 #include "absl/base/attributes.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/functional/function_ref.h"
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
@@ -80,6 +84,7 @@
 #include "tensorstore/internal/container/intrusive_red_black_tree.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/log/verbose_flag.h"
+#include "tensorstore/internal/rate_limiter/admission_queue.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/key_range.h"
 #include "tensorstore/kvstore/ocdbt/format/btree.h"
@@ -334,7 +339,9 @@ void PartitionInteriorNodeMutations(
 class BtreeWriterCommitOperationBase {
  protected:
   BtreeWriterCommitOperationBase(IoHandle::Ptr io_handle)
-      : io_handle_(std::move(io_handle)) {}
+      : io_handle_(std::move(io_handle)),
+        btree_node_read_queue_(std::make_shared<internal::AdmissionQueue>(
+            std::max<size_t>(1, io_handle_->max_in_flight_btree_nodes))) {}
 
   ~BtreeWriterCommitOperationBase() = default;
 
@@ -353,6 +360,16 @@ class BtreeWriterCommitOperationBase {
   FlushPromise flush_promise_;
   absl::Time staleness_bound_ = absl::InfinitePast();
 
+  // Limits the number of concurrent B+tree node reads issued by the traversal
+  // to `IoHandle::max_in_flight_btree_nodes`.  Held by `shared_ptr` since
+  // queued reads may outlive the commit operation if it fails.
+  std::shared_ptr<internal::AdmissionQueue> btree_node_read_queue_;
+
+  // Reads the B+tree node at `location`, waiting for `btree_node_read_queue_`
+  // to admit the read.
+  Future<const std::shared_ptr<const BtreeNode>> ReadBtreeNode(
+      const IndirectDataReference& location);
+
   // Starts a commit attempt, beginning by reading the existing manifest as of
   // `staleness_bound_`.
   //
@@ -404,6 +421,15 @@ class BtreeWriterCommitOperationBase {
     // existing entry with the same key of `entry.key`.  If `false`, the
     // existing entry with a key of `entry.key` should be removed.
     bool add;
+
+    // If non-null, the new child specified by `entry` is underfull and has not
+    // been written, and `entry.node.location` is not valid.  Instead, the
+    // parent merges it with adjacent siblings.  Specifies the decoded
+    // representation of the new child.
+    std::shared_ptr<const BtreeNode> pending_node;
+
+    // Estimated decoded size of `pending_node`.
+    size_t pending_size_estimate = 0;
   };
 
   // Collects mutations to a node during the asynchronous traversal of the
@@ -475,7 +501,30 @@ class BtreeWriterCommitOperationBase {
     std::shared_ptr<const BtreeNode> existing_node_;
     std::string existing_relative_child_key_;
 
+    // Unmodified children of `existing_node_` that have been read in order to
+    // merge them with underfull siblings, indexed by position.
+    absl::flat_hash_map<size_t, std::shared_ptr<const BtreeNode>>
+        merge_siblings_;
+
     void ApplyMutations() final;
+
+    // Merges underfull children specified by `mutations_` with adjacent
+    // siblings, and replaces them in `mutations_` with the merged children.
+    //
+    // If this is the root node and it would be left with a single child,
+    // replaces this node in the parent with that child instead.
+    //
+    // Returns `true` if this node should then be encoded from `mutations_`.
+    // Returns `false` if this node has been replaced in the parent, an error
+    // occurred, or unmodified siblings must first be read, in which case the
+    // merge is retried by a new `InteriorNodeTraversalState` once they have
+    // been read.
+    bool MergeUnderfullChildren();
+
+    // Reads the children of `existing_node_` at the positions specified by
+    // `indices` into `merge_siblings_` of a copy of this state, and then
+    // applies the mutations of the copy.
+    void ReadMergeSiblings(span<const size_t> indices);
   };
 
   // Adds mutations to `parent_state` to replace the child with key
@@ -484,12 +533,22 @@ class BtreeWriterCommitOperationBase {
   // Args:
   //   parent_state: Parent to modify.
   //   existing_relative_child_key: Key of existing child to replace.
+  //   existing_num_entries: Number of entries in the existing child.  A new
+  //     child is only merged with its siblings if it is underfull and has
+  //     fewer entries than the existing child, i.e. entries were removed.
   //   encoded_nodes_result: New children, or error.
   static void UpdateParent(
       NodeTraversalState& parent_state,
       std::string_view existing_relative_child_key,
+      size_t existing_num_entries,
       Result<std::vector<EncodedNode>>&& encoded_nodes_result);
 
+  // Adds mutations to `parent_state` to replace the child with key
+  // `existing_relative_child_key` with `new_children`.
+  static void ReplaceChild(NodeTraversalState& parent_state,
+                           std::string_view existing_relative_child_key,
+                           std::vector<InteriorNodeMutation> new_children);
+
   // Applies mutations to an interior node.
   //
   // Args:
@@ -798,7 +857,7 @@ void BtreeWriterCommitOperation<MutationEntry>::VisitNodeReference(
       << "Process node reference: " << params.key_range
       << ", height=" << (params.parent_state->height_ - 1);
   auto read_future =
-      params.parent_state->writer_->io_handle_->GetBtreeNode(node_ref.location);
+      params.parent_state->writer_->ReadBtreeNode(node_ref.location);
   auto executor = params.parent_state->writer_->io_handle_->executor;
   auto promise = params.parent_state->promise_;
   Link(WithExecutor(std::move(executor), NodeReadyCallback{std::move(params)}),
@@ -1025,6 +1084,7 @@ void BtreeWriterCommitOperation<MutationEntry>::VisitLeafNode(
   }
 
   UpdateParent(*params.parent_state, params.inclusive_min_key_suffix,
+               existing_entries.size(),
                encoder.Finalize(params.parent_state->is_root_parent()));
 }
 
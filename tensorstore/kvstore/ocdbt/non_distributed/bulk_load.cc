@@ -0,0 +1,337 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/ocdbt/non_distributed/bulk_load.h"
+
+#include <stddef.h>
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/attributes.h"
+#include "absl/log/absl_log.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/log/verbose_flag.h"
+#include "tensorstore/kvstore/ocdbt/format/btree.h"
+#include "tensorstore/kvstore/ocdbt/format/btree_codec.h"
+#include "tensorstore/kvstore/ocdbt/format/btree_node_encoder.h"
+#include "tensorstore/kvstore/ocdbt/format/config.h"
+#include "tensorstore/kvstore/ocdbt/format/indirect_data_reference.h"
+#include "tensorstore/kvstore/ocdbt/format/manifest.h"
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
+#include "tensorstore/kvstore/ocdbt/io_handle.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/create_new_manifest.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/write_nodes.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/quote_string.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+namespace {
+
+ABSL_CONST_INIT internal_log::VerboseFlag ocdbt_logging("ocdbt");
+
+// Asynchronous operation state that adds the root of a bulk-loaded b+tree as a
+// new version.
+struct BulkLoadCommitOperation
+    : public internal::AtomicReferenceCount<BulkLoadCommitOperation> {
+  using Ptr = internal::IntrusivePtr<BulkLoadCommitOperation>;
+
+  IoHandle::Ptr io_handle;
+  BtreeGenerationReference new_generation;
+  std::shared_ptr<const Manifest> existing_manifest;
+  std::shared_ptr<const Manifest> new_manifest;
+
+  static void ReadManifest(Ptr op, Promise<void> promise);
+  static void ManifestReady(Ptr op, Promise<void> promise,
+                            std::shared_ptr<const Manifest> manifest);
+  static void WriteNewManifest(Ptr op, Promise<void> promise);
+};
+
+void BulkLoadCommitOperation::ReadManifest(Ptr op, Promise<void> promise) {
+  auto* op_ptr = op.get();
+  auto manifest_future = op->io_handle->GetManifest(absl::Now());
+  LinkValue(WithExecutor(op_ptr->io_handle->executor,
+                         [op = std::move(op)](
+                             Promise<void> promise,
+                             ReadyFuture<const ManifestWithTime> future) {
+                           ManifestReady(std::move(op), std::move(promise),
+                                         future.value().manifest);
+                         }),
+            std::move(promise), std::move(manifest_future));
+}
+
+void BulkLoadCommitOperation::ManifestReady(
+    Ptr op, Promise<void> promise, std::shared_ptr<const Manifest> manifest) {
+  if (!manifest) {
+    promise.SetResult(
+        absl::FailedPreconditionError("Manifest was deleted during bulk load"));
+    return;
+  }
+  op->existing_manifest = std::move(manifest);
+  auto create_future = internal_ocdbt::CreateNewManifest(
+      op->io_handle, op->existing_manifest, op->new_generation);
+  LinkValue(
+      [op = std::move(op)](
+          Promise<void> promise,
+          ReadyFuture<std::pair<std::shared_ptr<Manifest>, Future<const void>>>
+              future) mutable {
+        auto& create_result = future.value();
+        op->new_manifest = std::move(create_result.first);
+        auto flush_future = std::move(create_result.second);
+        if (flush_future.null()) {
+          WriteNewManifest(std::move(op), std::move(promise));
+          return;
+        }
+        flush_future.Force();
+        auto* op_ptr = op.get();
+        LinkValue(WithExecutor(op_ptr->io_handle->executor,
+                               [op = std::move(op)](
+                                   Promise<void> promise,
+                                   ReadyFuture<const void> future) mutable {
+                                 WriteNewManifest(std::move(op),
+                                                  std::move(promise));
+                               }),
+                  std::move(promise), std::move(flush_future));
+      },
+      std::move(promise), std::move(create_future));
+}
+
+void BulkLoadCommitOperation::WriteNewManifest(Ptr op, Promise<void> promise) {
+  ABSL_LOG_IF(INFO, ocdbt_logging)
+      << "BulkLoad: writing new manifest for generation "
+      << op->new_manifest->latest_generation();
+  auto* op_ptr = op.get();
+  auto update_future = op->io_handle->TryUpdateManifest(
+      op->existing_manifest, op->new_manifest, absl::Now());
+  LinkValue(WithExecutor(op_ptr->io_handle->executor,
+                         [op = std::move(op)](
+                             Promise<void> promise,
+                             ReadyFuture<TryUpdateManifestResult> future) {
+                           if (!future.value().success) {
+                             ABSL_LOG_IF(INFO, ocdbt_logging)
+                                 << "BulkLoad: manifest modified "
+                                    "concurrently, retrying";
+                             ReadManifest(std::move(op), std::move(promise));
+                             return;
+                           }
+                           promise.SetResult(absl::OkStatus());
+                         }),
+            std::move(promise), std::move(update_future));
+}
+
+}  // namespace
+
+BulkLoader::BulkLoader(IoHandle::Ptr io_handle)
+    : io_handle_(std::move(io_handle)),
+      config_(io_handle_->config_state->GetExistingConfig()) {
+  if (!config_) {
+    status_ = absl::FailedPreconditionError(
+        "Bulk load requires an existing manifest");
+  }
+}
+
+bool BulkLoader::IsFull(size_t num_entries, size_t size_estimate,
+                        size_t entry_size) const {
+  if (num_entries == 0) return false;
+  if (num_entries >= kMaxNodeArity) return true;
+  return config_->max_decoded_node_bytes != 0 &&
+         size_estimate + entry_size > config_->max_decoded_node_bytes;
+}
+
+absl::Status BulkLoader::Add(std::string key, absl::Cord value) {
+  TENSORSTORE_RETURN_IF_ERROR(status_);
+  if (num_entries_ != 0 && key <= last_key_) {
+    status_ = absl::InvalidArgumentError(tensorstore::StrCat(
+        "Bulk load keys must be strictly increasing, but ",
+        tensorstore::QuoteString(key), " follows ",
+        tensorstore::QuoteString(last_key_)));
+    return status_;
+  }
+  ++num_entries_;
+  last_key_ = key;
+
+  LeafEntry entry;
+  entry.key = std::move(key);
+  if (value.size() > config_->max_inline_value_bytes) {
+    flush_promise_.Link(io_handle_->WriteData(
+        IndirectDataKind::kValue, std::move(value),
+        entry.value_reference.emplace<IndirectDataReference>()));
+  } else {
+    entry.value_reference = std::move(value);
+  }
+  const size_t entry_size =
+      EstimateDecodedEntrySizeExcludingKey(
+          LeafNodeEntry{entry.key, entry.value_reference}) +
+      entry.key.size();
+  // The leaf node is written when the next entry does not fit, which ensures
+  // that at least one leaf entry remains buffered for `Commit`.
+  if (IsFull(leaf_entries_.size(), leaf_size_estimate_, entry_size)) {
+    status_ = WriteLeafNodes(/*may_be_root=*/false);
+    TENSORSTORE_RETURN_IF_ERROR(status_);
+  }
+  leaf_size_estimate_ += entry_size;
+  leaf_entries_.push_back(std::move(entry));
+  return absl::OkStatus();
+}
+
+absl::Status BulkLoader::WriteLeafNodes(bool may_be_root) {
+  BtreeLeafNodeEncoder encoder(*config_, /*height=*/0,
+                               /*existing_prefix=*/{});
+  for (auto& leaf_entry : leaf_entries_) {
+    LeafNodeEntry entry;
+    entry.key = leaf_entry.key;
+    entry.value_reference = std::move(leaf_entry.value_reference);
+    encoder.AddEntry(/*existing=*/false, std::move(entry));
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(auto encoded_nodes,
+                               encoder.Finalize(may_be_root));
+  leaf_entries_.clear();
+  leaf_size_estimate_ = 0;
+  for (auto& new_entry : internal_ocdbt::WriteNodes(
+           *io_handle_, flush_promise_, std::move(encoded_nodes))) {
+    TENSORSTORE_RETURN_IF_ERROR(AddChild(0, std::move(new_entry)));
+  }
+  return absl::OkStatus();
+}
+
+absl::Status BulkLoader::WriteInteriorNodes(BtreeNodeHeight child_height) {
+  if (child_height == std::numeric_limits<BtreeNodeHeight>::max()) {
+    return absl::DataLossError("Maximum B+tree height exceeded");
+  }
+  auto entries = std::move(levels_[child_height].entries);
+  levels_[child_height] = {};
+  BtreeInteriorNodeEncoder encoder(*config_, child_height + 1,
+                                   /*existing_prefix=*/{});
+  for (auto& entry : entries) {
+    AddNewInteriorEntry(encoder, entry);
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(auto encoded_nodes,
+                               encoder.Finalize(/*may_be_root=*/false));
+  for (auto& new_entry : internal_ocdbt::WriteNodes(
+           *io_handle_, flush_promise_, std::move(encoded_nodes))) {
+    TENSORSTORE_RETURN_IF_ERROR(
+        AddChild(child_height + 1, std::move(new_entry)));
+  }
+  return absl::OkStatus();
+}
+
+absl::Status BulkLoader::AddChild(BtreeNodeHeight height,
+                                  InteriorNodeEntryData<std::string> entry) {
+  if (levels_.size() <= height) levels_.resize(height + 1);
+  const size_t entry_size =
+      kInteriorNodeFixedSize + entry.node.location.file_id.size() +
+      entry.node.key_filter.size() + entry.key.size();
+  if (IsFull(levels_[height].entries.size(), levels_[height].size_estimate,
+             entry_size)) {
+    TENSORSTORE_RETURN_IF_ERROR(WriteInteriorNodes(height));
+  }
+  auto& level = levels_[height];
+  level.size_estimate += entry_size;
+  level.entries.push_back(std::move(entry));
+  return absl::OkStatus();
+}
+
+Future<const void> BulkLoader::Commit() {
+  TENSORSTORE_RETURN_IF_ERROR(status_);
+  status_ = absl::FailedPreconditionError("Bulk load already committed");
+
+  auto op = internal::MakeIntrusivePtr<BulkLoadCommitOperation>();
+  op->io_handle = io_handle_;
+  auto& new_generation = op->new_generation;
+  if (num_entries_ == 0) {
+    new_generation.root_height = 0;
+    new_generation.root.statistics = {};
+    new_generation.root.location = IndirectDataReference::Missing();
+  } else {
+    // If no leaf node has been written yet, the remaining leaf entries may form
+    // the root.
+    TENSORSTORE_RETURN_IF_ERROR(
+        WriteLeafNodes(/*may_be_root=*/levels_.empty()));
+    // Since nodes are only written once the next entry does not fit, every
+    // level except the highest has buffered entries, and the highest level
+    // receives at least two entries unless the tree consists of a single
+    // level.  Therefore, every node written with `may_be_root=false` has a
+    // parent.
+    for (size_t height = 0; height + 1 < levels_.size(); ++height) {
+      TENSORSTORE_RETURN_IF_ERROR(WriteInteriorNodes(height));
+    }
+    const auto root_child_height =
+        static_cast<BtreeNodeHeight>(levels_.size() - 1);
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        new_generation,
+        WriteRootNode(*io_handle_, flush_promise_, root_child_height,
+                      std::move(levels_.back().entries)));
+  }
+  levels_.clear();
+  ABSL_LOG_IF(INFO, ocdbt_logging)
+      << "BulkLoad: wrote " << num_entries_ << " entries, root_height="
+      << static_cast<int>(new_generation.root_height);
+
+  auto [promise, future] = PromiseFuturePair<void>::Make();
+  auto flush_future = std::move(flush_promise_).future();
+  if (flush_future.null()) {
+    BulkLoadCommitOperation::ReadManifest(std::move(op), std::move(promise));
+  } else {
+    flush_future.Force();
+    auto* op_ptr = op.get();
+    LinkValue(WithExecutor(op_ptr->io_handle->executor,
+                           [op = std::move(op)](
+                               Promise<void> promise,
+                               ReadyFuture<const void> future) mutable {
+                             BulkLoadCommitOperation::ReadManifest(
+                                 std::move(op), std::move(promise));
+                           }),
+              std::move(promise), std::move(flush_future));
+  }
+  return std::move(future);
+}
+
+Future<const void> BulkLoad(
+    IoHandle::Ptr io_handle,
+    std::vector<std::pair<std::string, absl::Cord>> entries) {
+  auto ensure_future = EnsureExistingManifest(io_handle);
+  auto executor = io_handle->executor;
+  return PromiseFuturePair<void>::LinkValue(
+             WithExecutor(
+                 std::move(executor),
+                 [io_handle = std::move(io_handle),
+                  entries = std::move(entries)](
+                     Promise<void> promise,
+                     ReadyFuture<absl::Time> future) mutable {
+                   BulkLoader loader(std::move(io_handle));
+                   for (auto& [key, value] : entries) {
+                     TENSORSTORE_RETURN_IF_ERROR(
+                         loader.Add(std::move(key), std::move(value)),
+                         static_cast<void>(promise.SetResult(_)));
+                   }
+                   LinkResult(std::move(promise), loader.Commit());
+                 }),
+             std::move(ensure_future))
+      .future;
+}
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
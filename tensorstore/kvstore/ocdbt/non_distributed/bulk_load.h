@@ -0,0 +1,121 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_BULK_LOAD_H_
+#define TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_BULK_LOAD_H_
+
+#include <stddef.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "tensorstore/kvstore/ocdbt/format/btree.h"
+#include "tensorstore/kvstore/ocdbt/format/config.h"
+#include "tensorstore/kvstore/ocdbt/io_handle.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+
+// Builds a new version of an OCDBT database from key/value pairs supplied in
+// strictly increasing key order, replacing the existing contents.
+//
+// Unlike ordinary writes, which update the b+tree by read-modify-write of the
+// existing nodes, the bulk loader never reads any b+tree nodes:
+//
+// 1. Leaf nodes are encoded and written as soon as they reach
+//    `max_decoded_node_bytes`.
+//
+// 2. Interior nodes are built bottom-up: each level buffers the entries of
+//    its completed children, and is written once it is full.
+//
+// 3. `Commit` writes the remaining partially-filled nodes, and then adds the
+//    new root as a new version with a single manifest update.
+//
+// Memory usage is bounded by one node per level, in addition to the data
+// buffered by the `IndirectDataWriter` until a data file reaches the target
+// size.
+//
+// The manifest must already exist (see `EnsureExistingManifest`) when the
+// `BulkLoader` is constructed.
+//
+// This class is not thread-safe.
+class BulkLoader {
+ public:
+  explicit BulkLoader(IoHandle::Ptr io_handle);
+
+  // Adds an entry to the new version.
+  //
+  // Returns an error if `key` is not greater than the previously added key.
+  // After an error is returned, the bulk load must be abandoned.
+  absl::Status Add(std::string key, absl::Cord value);
+
+  // Writes the remaining nodes, and commits the new version once all data has
+  // been flushed.
+  //
+  // If the manifest is modified concurrently, the commit is retried with the
+  // new manifest; the new version still replaces the entire contents of the
+  // database.
+  //
+  // No further calls to `Add` or `Commit` are permitted.
+  Future<const void> Commit();
+
+ private:
+  struct LeafEntry {
+    std::string key;
+    LeafNodeValueReference value_reference;
+  };
+
+  // Entries referencing completed nodes of a given height that have not yet
+  // been added to a parent node.
+  struct Level {
+    std::vector<InteriorNodeEntryData<std::string>> entries;
+    size_t size_estimate = 0;
+  };
+
+  bool IsFull(size_t num_entries, size_t size_estimate,
+              size_t entry_size) const;
+  absl::Status WriteLeafNodes(bool may_be_root);
+  absl::Status WriteInteriorNodes(BtreeNodeHeight child_height);
+  absl::Status AddChild(BtreeNodeHeight height,
+                        InteriorNodeEntryData<std::string> entry);
+
+  IoHandle::Ptr io_handle_;
+  const Config* config_;
+  FlushPromise flush_promise_;
+  absl::Status status_;
+  size_t num_entries_ = 0;
+  std::string last_key_;
+  std::vector<LeafEntry> leaf_entries_;
+  size_t leaf_size_estimate_ = 0;
+  // `levels_[h]` holds the entries referencing nodes of height `h`.
+  std::vector<Level> levels_;
+};
+
+// Replaces the contents of an OCDBT database with `entries`, which must be
+// sorted by key with no duplicate keys.
+//
+// The manifest is created if it does not already exist.
+Future<const void> BulkLoad(
+    IoHandle::Ptr io_handle,
+    std::vector<std::pair<std::string, absl::Cord>> entries);
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_BULK_LOAD_H_
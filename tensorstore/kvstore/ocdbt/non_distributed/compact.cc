@@ -0,0 +1,724 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compacts an OCDBT database.
+//
+// Data files are only ever appended by `IndirectDataWriter`, and b+tree nodes,
+// version tree nodes and values that are superseded by later commits are never
+// reclaimed.  The compaction operation is implemented as follows:
+//
+// 1. In `exclusive` mode, list the existing data files.
+//
+// 2. Read the manifest and every version tree node to obtain the full list of
+//    versions.
+//
+// 3. Determine the retained versions.  These always form a suffix of the
+//    version history.
+//
+// 4. Rewrite the b+tree of each retained version bottom-up.  Every node and
+//    out-of-line value is rewritten at most once: versions typically share most
+//    of their nodes, and the rewritten result is memoized by the location of
+//    the existing node or value.  Since all writes go through the
+//    `IndirectDataWriter`, the rewritten data is densely packed.
+//
+// 5. Write a new version tree that references only the retained versions, and
+//    a new manifest.
+//
+// 6. Replace the manifest.  If the manifest was modified concurrently, retry
+//    starting at step 2 (reusing the memoized rewrites).
+//
+// 7. In `exclusive` mode, delete the data files listed in step 1.  Since every
+//    node and value reachable from the new manifest was written by this
+//    operation, none of them are referenced by the new manifest.
+//
+// Without `exclusive`, no data files are deleted.  `IndirectDataWriter`
+// packs the data of all concurrent writes through an `IoHandle` into the
+// same data file, so a data file referenced by the existing manifest may also
+// contain data of a transaction that has not yet committed, in this or in
+// another process.  Such a transaction may commit after the new manifest, and
+// must still be able to read its data.
+
+#include "tensorstore/kvstore/ocdbt/non_distributed/compact.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "absl/base/attributes.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/log/absl_log.h"
+#include "absl/status/status.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/log/verbose_flag.h"
+#include "tensorstore/kvstore/key_range.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/ocdbt/format/btree.h"
+#include "tensorstore/kvstore/ocdbt/format/btree_node_encoder.h"
+#include "tensorstore/kvstore/ocdbt/format/config.h"
+#include "tensorstore/kvstore/ocdbt/format/indirect_data_reference.h"
+#include "tensorstore/kvstore/ocdbt/format/manifest.h"
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
+#include "tensorstore/kvstore/ocdbt/io/io_handle_impl.h"
+#include "tensorstore/kvstore/ocdbt/io_handle.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/write_nodes.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+namespace {
+
+ABSL_CONST_INIT internal_log::VerboseFlag ocdbt_logging("ocdbt");
+
+// Entries referencing the node(s) that replace an existing b+tree node.
+using RewrittenEntries = std::vector<InteriorNodeEntryData<std::string>>;
+
+// Returns `true` if `key` is a data file name generated by
+// `GenerateDataFileId(prefix)`.
+bool IsDataFileKey(std::string_view key, std::string_view prefix) {
+  constexpr size_t kIdLength = 32;
+  if (!absl::StartsWith(key, prefix) ||
+      key.size() != prefix.size() + kIdLength) {
+    return false;
+  }
+  key.remove_prefix(prefix.size());
+  return std::all_of(key.begin(), key.end(), [](char c) {
+    return absl::ascii_isdigit(c) || (c >= 'a' && c <= 'f');
+  });
+}
+
+struct CompactOperation
+    : public internal::AtomicReferenceCount<CompactOperation> {
+  using Ptr = internal::IntrusivePtr<CompactOperation>;
+
+  IoHandle::Ptr io_handle;
+  kvstore::KvStore base;
+  CompactOptions options;
+  CompactionStatistics stats;
+
+  // Data files that existed when the operation started (only in `exclusive`
+  // mode).
+  std::vector<std::string> existing_data_files;
+
+  // State of the current attempt.
+  std::shared_ptr<const Manifest> existing_manifest;
+  std::shared_ptr<Manifest> new_manifest;
+  std::vector<BtreeGenerationReference> retained_versions;
+  std::vector<Future<const RewrittenEntries>> rewritten_roots;
+  FlushPromise flush_promise;
+
+  absl::Mutex mutex;
+
+  // All versions referenced by `existing_manifest`.
+  std::vector<BtreeGenerationReference> versions ABSL_GUARDED_BY(mutex);
+
+  // Memoized rewrites, keyed by the encoded location of the existing b+tree
+  // node or value.  These are shared by all attempts.
+  absl::flat_hash_map<std::string, Future<const RewrittenEntries>>
+      rewritten_nodes ABSL_GUARDED_BY(mutex);
+  absl::flat_hash_map<std::string, Future<const IndirectDataReference>>
+      rewritten_values ABSL_GUARDED_BY(mutex);
+
+  const Config& config() const {
+    auto* config = io_handle->config_state->GetExistingConfig();
+    assert(config);
+    return *config;
+  }
+
+  static void Start(Ptr op, Promise<CompactionStatistics> promise,
+                    const DataFilePrefixes& data_file_prefixes);
+  static void StartAttempt(Ptr op, Promise<CompactionStatistics> promise);
+  static void ManifestReady(Ptr op, Promise<CompactionStatistics> promise,
+                            std::shared_ptr<const Manifest> manifest);
+  static void ReadVersionTreeNode(Ptr op, Promise<void> promise,
+                                  const VersionNodeReference& node_ref);
+  static void VersionsReady(Ptr op, Promise<CompactionStatistics> promise);
+  static Future<const RewrittenEntries> RewriteSubtree(
+      Ptr op, const BtreeNodeReference& node_ref, BtreeNodeHeight height,
+      std::string inclusive_min_key, KeyLength subtree_common_prefix_length,
+      bool is_root);
+  static Future<const IndirectDataReference> RewriteValue(
+      Ptr op, const IndirectDataReference& ref);
+  static void RootsReady(Ptr op, Promise<CompactionStatistics> promise);
+  static Result<VersionNodeReference> WriteVersionTreeSubtree(
+      CompactOperation& op, span<const BtreeGenerationReference> versions,
+      VersionTreeHeight height);
+  static absl::Status BuildNewManifest(CompactOperation& op);
+  static void WriteNewManifest(Ptr op, Promise<CompactionStatistics> promise);
+  static void DeleteDataFiles(Ptr op, Promise<CompactionStatistics> promise);
+};
+
+void CompactOperation::Start(Ptr op, Promise<CompactionStatistics> promise,
+                             const DataFilePrefixes& data_file_prefixes) {
+  if (!op->options.exclusive || !op->options.delete_unreferenced_files) {
+    StartAttempt(std::move(op), std::move(promise));
+    return;
+  }
+
+  // List the existing data files before writing any new ones.
+  std::vector<std::string> prefixes{data_file_prefixes.value,
+                                    data_file_prefixes.btree_node,
+                                    data_file_prefixes.version_tree_node};
+  std::sort(prefixes.begin(), prefixes.end());
+  prefixes.erase(std::unique(prefixes.begin(), prefixes.end()),
+                 prefixes.end());
+  std::vector<Future<std::vector<kvstore::ListEntry>>> list_futures;
+  for (const auto& prefix : prefixes) {
+    kvstore::ListOptions list_options;
+    list_options.range = KeyRange::Prefix(prefix);
+    list_futures.push_back(kvstore::ListFuture(op->base, list_options));
+  }
+  auto all_listed = WaitAllFuture(span(list_futures));
+  LinkValue(
+      [op = std::move(op), prefixes = std::move(prefixes),
+       list_futures = std::move(list_futures)](
+          Promise<CompactionStatistics> promise,
+          ReadyFuture<void> future) mutable {
+        for (size_t i = 0; i < prefixes.size(); ++i) {
+          for (auto& entry : list_futures[i].value()) {
+            if (IsDataFileKey(entry.key, prefixes[i])) {
+              op->existing_data_files.push_back(std::move(entry.key));
+            }
+          }
+        }
+        // Prefixes may be nested, in which case a file may be listed more
+        // than once.
+        auto& files = op->existing_data_files;
+        std::sort(files.begin(), files.end());
+        files.erase(std::unique(files.begin(), files.end()), files.end());
+        StartAttempt(std::move(op), std::move(promise));
+      },
+      std::move(promise), std::move(all_listed));
+}
+
+void CompactOperation::StartAttempt(Ptr op,
+                                    Promise<CompactionStatistics> promise) {
+  ABSL_LOG_IF(INFO, ocdbt_logging) << "Compact: reading manifest";
+  auto* op_ptr = op.get();
+  auto manifest_future = op->io_handle->GetManifest(absl::Now());
+  LinkValue(WithExecutor(op_ptr->io_handle->executor,
+                         [op = std::move(op)](
+                             Promise<CompactionStatistics> promise,
+                             ReadyFuture<const ManifestWithTime> future) {
+                           ManifestReady(std::move(op), std::move(promise),
+                                         future.value().manifest);
+                         }),
+            std::move(promise), std::move(manifest_future));
+}
+
+void CompactOperation::ManifestReady(Ptr op,
+                                     Promise<CompactionStatistics> promise,
+                                     std::shared_ptr<const Manifest> manifest) {
+  if (!manifest) {
+    // Nothing to compact.
+    promise.SetResult(op->stats);
+    return;
+  }
+  if (manifest->config.manifest_kind != ManifestKind::kSingle) {
+    // Numbered manifests are keyed by the latest generation number, which is
+    // unchanged by compaction.
+    promise.SetResult(absl::UnimplementedError(
+        "Compaction requires manifest_kind=\"single\""));
+    return;
+  }
+  op->existing_manifest = std::move(manifest);
+  {
+    absl::MutexLock lock(&op->mutex);
+    op->versions = op->existing_manifest->versions;
+  }
+  auto [versions_promise, versions_future] =
+      PromiseFuturePair<void>::Make(absl::OkStatus());
+  for (const auto& node_ref : op->existing_manifest->version_tree_nodes) {
+    ReadVersionTreeNode(op, versions_promise, node_ref);
+  }
+  versions_promise = {};
+  auto* op_ptr = op.get();
+  LinkValue(
+      WithExecutor(op_ptr->io_handle->executor,
+                   [op = std::move(op)](Promise<CompactionStatistics> promise,
+                                        ReadyFuture<void> future) {
+                     VersionsReady(std::move(op), std::move(promise));
+                   }),
+      std::move(promise), std::move(versions_future));
+}
+
+void CompactOperation::ReadVersionTreeNode(
+    Ptr op, Promise<void> promise, const VersionNodeReference& node_ref) {
+  auto* op_ptr = op.get();
+  auto read_future = op->io_handle->GetVersionTreeNode(node_ref.location);
+  Link(WithExecutor(
+           op_ptr->io_handle->executor,
+           [op = std::move(op), generation_number = node_ref.generation_number,
+            height = node_ref.height](
+               Promise<void> promise,
+               ReadyFuture<const std::shared_ptr<const VersionTreeNode>>
+                   future) {
+             TENSORSTORE_ASSIGN_OR_RETURN(
+                 auto node, future.result(),
+                 static_cast<void>(SetDeferredResult(promise, _)));
+             TENSORSTORE_RETURN_IF_ERROR(
+                 ValidateVersionTreeNodeReference(*node, op->config(),
+                                                  generation_number, height),
+                 static_cast<void>(SetDeferredResult(promise, _)));
+             if (auto* entries =
+                     std::get_if<VersionTreeNode::LeafNodeEntries>(
+                         &node->entries)) {
+               absl::MutexLock lock(&op->mutex);
+               op->versions.insert(op->versions.end(), entries->begin(),
+                                   entries->end());
+               return;
+             }
+             for (const auto& child :
+                  std::get<VersionTreeNode::InteriorNodeEntries>(
+                      node->entries)) {
+               ReadVersionTreeNode(op, promise, child);
+             }
+           }),
+       std::move(promise), std::move(read_future));
+}
+
+void CompactOperation::VersionsReady(Ptr op,
+                                     Promise<CompactionStatistics> promise) {
+  std::vector<BtreeGenerationReference> versions;
+  {
+    absl::MutexLock lock(&op->mutex);
+    versions = std::exchange(op->versions, {});
+  }
+  std::sort(versions.begin(), versions.end(),
+            [](const BtreeGenerationReference& a,
+               const BtreeGenerationReference& b) {
+              return a.generation_number < b.generation_number;
+            });
+
+  // The retained versions are the union of the `keep_last_versions` most
+  // recent versions and the versions committed at or after `keep_newer_than`.
+  // Both are suffixes of the version history, as is their union.
+  const size_t num_versions = versions.size();
+  const GenerationNumber keep_last_versions =
+      std::max<GenerationNumber>(op->options.keep_last_versions, 1);
+  size_t first_retained =
+      num_versions - std::min<GenerationNumber>(keep_last_versions,
+                                                num_versions);
+  const auto newer_it = std::find_if(
+      versions.begin(), versions.end(),
+      [&](const BtreeGenerationReference& ref) {
+        return static_cast<absl::Time>(ref.commit_time) >=
+               op->options.keep_newer_than;
+      });
+  first_retained = std::min(
+      first_retained, static_cast<size_t>(newer_it - versions.begin()));
+  op->stats.num_versions_retained = num_versions - first_retained;
+  op->stats.num_versions_removed = first_retained;
+  ABSL_LOG_IF(INFO, ocdbt_logging)
+      << "Compact: retaining " << (num_versions - first_retained) << "/"
+      << num_versions << " versions";
+
+  auto [roots_promise, roots_future] =
+      PromiseFuturePair<void>::Make(absl::OkStatus());
+  op->retained_versions.assign(versions.begin() + first_retained,
+                               versions.end());
+  op->rewritten_roots.clear();
+  for (const auto& version : op->retained_versions) {
+    if (version.root.location.IsMissing()) {
+      // Empty b+tree.
+      op->rewritten_roots.emplace_back();
+      continue;
+    }
+    auto future = RewriteSubtree(op, version.root, version.root_height,
+                                 /*inclusive_min_key=*/{},
+                                 /*subtree_common_prefix_length=*/0,
+                                 /*is_root=*/true);
+    LinkError(roots_promise, future);
+    op->rewritten_roots.push_back(std::move(future));
+  }
+  roots_promise = {};
+  auto* op_ptr = op.get();
+  LinkValue(
+      WithExecutor(op_ptr->io_handle->executor,
+                   [op = std::move(op)](Promise<CompactionStatistics> promise,
+                                        ReadyFuture<void> future) {
+                     RootsReady(std::move(op), std::move(promise));
+                   }),
+      std::move(promise), std::move(roots_future));
+}
+
+// Encodes the rewritten entries of a node and writes the resultant node(s).
+template <typename Entry>
+Result<RewrittenEntries> WriteRewrittenNodes(const IoHandle& io_handle,
+                                             FlushPromise& flush_promise,
+                                             BtreeNodeEncoder<Entry>& encoder,
+                                             bool is_root) {
+  TENSORSTORE_ASSIGN_OR_RETURN(auto encoded_nodes,
+                               encoder.Finalize(/*may_be_root=*/is_root));
+  return internal_ocdbt::WriteNodes(io_handle, flush_promise,
+                                    std::move(encoded_nodes));
+}
+
+Future<const RewrittenEntries> CompactOperation::RewriteSubtree(
+    Ptr op, const BtreeNodeReference& node_ref, BtreeNodeHeight height,
+    std::string inclusive_min_key, KeyLength subtree_common_prefix_length,
+    bool is_root) {
+  // A root node must be encoded without an implicit prefix, and is therefore
+  // memoized separately.
+  auto memo_key = node_ref.location.EncodeCacheKey();
+  if (is_root) memo_key += 'r';
+  Promise<RewrittenEntries> promise;
+  Future<const RewrittenEntries> future;
+  {
+    absl::MutexLock lock(&op->mutex);
+    auto [it, inserted] = op->rewritten_nodes.try_emplace(memo_key);
+    if (!inserted) return it->second;
+    auto pair = PromiseFuturePair<RewrittenEntries>::Make();
+    promise = std::move(pair.promise);
+    it->second = future = std::move(pair.future);
+  }
+  auto* op_ptr = op.get();
+  auto read_future = op->io_handle->GetBtreeNode(node_ref.location);
+  Link(
+      WithExecutor(
+          op_ptr->io_handle->executor,
+          [op = std::move(op), height,
+           inclusive_min_key = std::move(inclusive_min_key),
+           subtree_common_prefix_length, is_root](
+              Promise<RewrittenEntries> promise,
+              ReadyFuture<const std::shared_ptr<const BtreeNode>> future) {
+            TENSORSTORE_ASSIGN_OR_RETURN(
+                auto node, future.result(),
+                static_cast<void>(SetDeferredResult(promise, _)));
+            TENSORSTORE_RETURN_IF_ERROR(
+                ValidateBtreeNodeReference(
+                    *node, height,
+                    std::string_view(inclusive_min_key)
+                        .substr(subtree_common_prefix_length)),
+                static_cast<void>(SetDeferredResult(promise, _)));
+            auto full_prefix = tensorstore::StrCat(
+                std::string_view(inclusive_min_key)
+                    .substr(0, subtree_common_prefix_length),
+                node->key_prefix);
+
+            if (auto* entries = std::get_if<BtreeNode::LeafNodeEntries>(
+                    &node->entries)) {
+              std::vector<Future<const IndirectDataReference>> values;
+              for (const auto& entry : *entries) {
+                if (auto* ref = std::get_if<IndirectDataReference>(
+                        &entry.value_reference)) {
+                  values.push_back(RewriteValue(op, *ref));
+                }
+              }
+              auto all_values = WaitAllFuture(span(values));
+              LinkValue(
+                  [op = std::move(op), node = std::move(node),
+                   full_prefix = std::move(full_prefix),
+                   values = std::move(values), is_root](
+                      Promise<RewrittenEntries> promise,
+                      ReadyFuture<void> future) {
+                    BtreeLeafNodeEncoder encoder(op->config(), /*height=*/0,
+                                                 full_prefix);
+                    size_t value_i = 0;
+                    for (const auto& entry :
+                         std::get<BtreeNode::LeafNodeEntries>(node->entries)) {
+                      LeafNodeEntry new_entry = entry;
+                      if (std::holds_alternative<IndirectDataReference>(
+                              new_entry.value_reference)) {
+                        new_entry.value_reference = values[value_i++].value();
+                      }
+                      encoder.AddEntry(/*existing=*/true, std::move(new_entry));
+                    }
+                    promise.SetResult(WriteRewrittenNodes(
+                        *op->io_handle, op->flush_promise, encoder, is_root));
+                  },
+                  std::move(promise), std::move(all_values));
+              return;
+            }
+
+            std::vector<Future<const RewrittenEntries>> children;
+            for (const auto& entry :
+                 std::get<BtreeNode::InteriorNodeEntries>(node->entries)) {
+              children.push_back(RewriteSubtree(
+                  op, entry.node, height - 1,
+                  tensorstore::StrCat(full_prefix, entry.key),
+                  full_prefix.size() + entry.subtree_common_prefix_length,
+                  /*is_root=*/false));
+            }
+            auto all_children = WaitAllFuture(span(children));
+            LinkValue(
+                [op = std::move(op), height,
+                 full_prefix = std::move(full_prefix),
+                 children = std::move(children),
+                 is_root](Promise<RewrittenEntries> promise,
+                          ReadyFuture<void> future) {
+                  BtreeInteriorNodeEncoder encoder(op->config(), height,
+                                                   full_prefix);
+                  for (const auto& child : children) {
+                    for (const auto& new_entry : child.value()) {
+                      AddNewInteriorEntry(encoder, new_entry);
+                    }
+                  }
+                  promise.SetResult(WriteRewrittenNodes(
+                      *op->io_handle, op->flush_promise, encoder, is_root));
+                },
+                std::move(promise), std::move(all_children));
+          }),
+      std::move(promise), std::move(read_future));
+  return future;
+}
+
+Future<const IndirectDataReference> CompactOperation::RewriteValue(
+    Ptr op, const IndirectDataReference& ref) {
+  Promise<IndirectDataReference> promise;
+  Future<const IndirectDataReference> future;
+  {
+    absl::MutexLock lock(&op->mutex);
+    auto [it, inserted] =
+        op->rewritten_values.try_emplace(ref.EncodeCacheKey());
+    if (!inserted) return it->second;
+    auto pair = PromiseFuturePair<IndirectDataReference>::Make();
+    promise = std::move(pair.promise);
+    it->second = future = std::move(pair.future);
+  }
+  auto read_future = op->io_handle->ReadIndirectData(ref, {});
+  LinkValue(
+      [op = std::move(op), ref](Promise<IndirectDataReference> promise,
+                                ReadyFuture<kvstore::ReadResult> future) {
+        auto& read_result = future.value();
+        if (!read_result.has_value()) {
+          promise.SetResult(absl::DataLossError(
+              tensorstore::StrCat("Missing value at ", ref)));
+          return;
+        }
+        IndirectDataReference new_ref;
+        op->flush_promise.Link(op->io_handle->WriteData(
+            IndirectDataKind::kValue, std::move(read_result.value), new_ref));
+        promise.SetResult(std::move(new_ref));
+      },
+      std::move(promise), std::move(read_future));
+  return future;
+}
+
+void CompactOperation::RootsReady(Ptr op,
+                                  Promise<CompactionStatistics> promise) {
+  for (size_t i = 0; i < op->retained_versions.size(); ++i) {
+    auto& version = op->retained_versions[i];
+    auto& root_future = op->rewritten_roots[i];
+    if (root_future.null()) continue;
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto new_root,
+        WriteRootNode(*op->io_handle, op->flush_promise, version.root_height,
+                      root_future.value()),
+        static_cast<void>(promise.SetResult(_)));
+    version.root = new_root.root;
+    version.root_height = new_root.root_height;
+  }
+  op->rewritten_roots.clear();
+
+  TENSORSTORE_RETURN_IF_ERROR(BuildNewManifest(*op),
+                              static_cast<void>(promise.SetResult(_)));
+
+  auto flush_future = std::move(op->flush_promise).future();
+  if (flush_future.null()) {
+    WriteNewManifest(std::move(op), std::move(promise));
+    return;
+  }
+  flush_future.Force();
+  auto* op_ptr = op.get();
+  LinkValue(
+      WithExecutor(op_ptr->io_handle->executor,
+                   [op = std::move(op)](Promise<CompactionStatistics> promise,
+                                        ReadyFuture<const void> future) {
+                     WriteNewManifest(std::move(op), std::move(promise));
+                   }),
+      std::move(promise), std::move(flush_future));
+}
+
+Result<VersionNodeReference> CompactOperation::WriteVersionTreeSubtree(
+    CompactOperation& op, span<const BtreeGenerationReference> versions,
+    VersionTreeHeight height) {
+  assert(!versions.empty());
+  const auto& config = op.new_manifest->config;
+  VersionTreeNode node;
+  node.height = height;
+  node.version_tree_arity_log2 = config.version_tree_arity_log2;
+  if (height == 0) {
+    node.entries.emplace<VersionTreeNode::LeafNodeEntries>(versions.begin(),
+                                                           versions.end());
+  } else {
+    // Each child of height `height - 1` covers `2**(height *
+    // version_tree_arity_log2)` generation numbers.
+    auto& children =
+        node.entries.emplace<VersionTreeNode::InteriorNodeEntries>();
+    const int shift = height * config.version_tree_arity_log2;
+    for (size_t begin = 0, end; begin < versions.size(); begin = end) {
+      const GenerationNumber child_i =
+          (versions[begin].generation_number - 1) >> shift;
+      for (end = begin + 1;
+           end < versions.size() &&
+           ((versions[end].generation_number - 1) >> shift) == child_i;
+           ++end) {
+      }
+      TENSORSTORE_ASSIGN_OR_RETURN(
+          auto child_ref,
+          WriteVersionTreeSubtree(op, versions.subspan(begin, end - begin),
+                                  height - 1));
+      children.push_back(std::move(child_ref));
+    }
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(auto encoded,
+                               EncodeVersionTreeNode(config, node));
+  VersionNodeReference node_ref;
+  node_ref.generation_number = versions.back().generation_number;
+  node_ref.height = height;
+  node_ref.num_generations = versions.size();
+  node_ref.commit_time = versions.front().commit_time;
+  op.flush_promise.Link(op.io_handle->WriteData(
+      IndirectDataKind::kVersionNode, std::move(encoded), node_ref.location));
+  return node_ref;
+}
+
+absl::Status CompactOperation::BuildNewManifest(CompactOperation& op) {
+  auto new_manifest = std::make_shared<Manifest>();
+  op.new_manifest = new_manifest;
+  new_manifest->config = op.existing_manifest->config;
+  const auto version_tree_arity_log2 =
+      new_manifest->config.version_tree_arity_log2;
+  span<const BtreeGenerationReference> versions = op.retained_versions;
+  const GenerationNumber latest_generation =
+      versions.back().generation_number;
+
+  // Versions within the generation range of the latest version's leaf node are
+  // stored inline in the manifest.
+  const GenerationNumber min_inline_generation =
+      GetVersionTreeLeafNodeRangeContainingGeneration(version_tree_arity_log2,
+                                                      latest_generation)
+          .first;
+  auto inline_begin = FindVersionLowerBound(versions, min_inline_generation);
+  new_manifest->versions.assign(inline_begin, versions.end());
+  versions = {versions.begin(), inline_begin};
+
+  // Remaining versions are stored in the version tree nodes referenced from
+  // the manifest.  Subtrees that contain no retained versions are excluded.
+  absl::Status status;
+  ForEachManifestVersionTreeNodeRef(
+      latest_generation, version_tree_arity_log2,
+      [&](GenerationNumber min_generation_number,
+          GenerationNumber max_generation_number, VersionTreeHeight height) {
+        if (!status.ok()) return;
+        auto begin = FindVersionLowerBound(versions, min_generation_number);
+        auto end = FindVersionUpperBound(versions, max_generation_number);
+        if (begin == end) return;
+        auto node_ref = WriteVersionTreeSubtree(op, {begin, end}, height);
+        if (!node_ref.ok()) {
+          status = std::move(node_ref).status();
+          return;
+        }
+        new_manifest->version_tree_nodes.push_back(*std::move(node_ref));
+      });
+  TENSORSTORE_RETURN_IF_ERROR(status);
+  std::reverse(new_manifest->version_tree_nodes.begin(),
+               new_manifest->version_tree_nodes.end());
+  return absl::OkStatus();
+}
+
+void CompactOperation::WriteNewManifest(Ptr op,
+                                        Promise<CompactionStatistics> promise) {
+  ABSL_LOG_IF(INFO, ocdbt_logging)
+      << "Compact: writing new manifest for generation "
+      << op->new_manifest->latest_generation();
+  auto* op_ptr = op.get();
+  auto update_future = op->io_handle->TryUpdateManifest(
+      op->existing_manifest, op->new_manifest, absl::Now());
+  LinkValue(
+      WithExecutor(
+          op_ptr->io_handle->executor,
+          [op = std::move(op)](Promise<CompactionStatistics> promise,
+                               ReadyFuture<TryUpdateManifestResult> future) {
+            if (!future.value().success) {
+              if (op->options.exclusive) {
+                promise.SetResult(absl::FailedPreconditionError(
+                    "Manifest was modified concurrently with exclusive "
+                    "compaction"));
+                return;
+              }
+              // Retry with the new manifest.  Nodes and values that were
+              // already rewritten are reused.
+              ABSL_LOG_IF(INFO, ocdbt_logging)
+                  << "Compact: manifest modified concurrently, retrying";
+              StartAttempt(std::move(op), std::move(promise));
+              return;
+            }
+            DeleteDataFiles(std::move(op), std::move(promise));
+          }),
+      std::move(promise), std::move(update_future));
+}
+
+void CompactOperation::DeleteDataFiles(Ptr op,
+                                       Promise<CompactionStatistics> promise) {
+  if (!op->options.exclusive || !op->options.delete_unreferenced_files) {
+    promise.SetResult(op->stats);
+    return;
+  }
+  auto files = std::move(op->existing_data_files);
+  ABSL_LOG_IF(INFO, ocdbt_logging)
+      << "Compact: deleting " << files.size() << " data files";
+  std::vector<Future<TimestampedStorageGeneration>> delete_futures;
+  delete_futures.reserve(files.size());
+  for (const auto& file : files) {
+    delete_futures.push_back(kvstore::Delete(op->base, file));
+  }
+  op->stats.num_data_files_deleted = files.size();
+  auto all_deleted = WaitAllFuture(span(delete_futures));
+  LinkValue(
+      [op = std::move(op)](Promise<CompactionStatistics> promise,
+                           ReadyFuture<void> future) {
+        promise.SetResult(op->stats);
+      },
+      std::move(promise), std::move(all_deleted));
+}
+
+}  // namespace
+
+Future<CompactionStatistics> Compact(IoHandle::Ptr io_handle,
+                                     kvstore::KvStore base,
+                                     const DataFilePrefixes& data_file_prefixes,
+                                     const CompactOptions& options) {
+  auto op = internal::MakeIntrusivePtr<CompactOperation>();
+  op->io_handle = std::move(io_handle);
+  op->base = std::move(base);
+  op->options = options;
+  auto [promise, future] = PromiseFuturePair<CompactionStatistics>::Make();
+  CompactOperation::Start(std::move(op), std::move(promise),
+                          data_file_prefixes);
+  return std::move(future);
+}
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
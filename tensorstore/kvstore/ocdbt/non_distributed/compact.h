@@ -0,0 +1,101 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_COMPACT_H_
+#define TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_COMPACT_H_
+
+#include <stddef.h>
+
+#include <limits>
+
+#include "absl/time/time.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
+#include "tensorstore/kvstore/ocdbt/io/io_handle_impl.h"
+#include "tensorstore/kvstore/ocdbt/io_handle.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+
+struct CompactOptions {
+  // Number of most recent versions to retain.  The latest version is always
+  // retained.
+  GenerationNumber keep_last_versions =
+      std::numeric_limits<GenerationNumber>::max();
+
+  // Versions with a commit time of at least `keep_newer_than` are retained
+  // even if they are not among the `keep_last_versions` most recent versions.
+  absl::Time keep_newer_than = absl::InfiniteFuture();
+
+  // In `exclusive` mode, delete data files that are no longer referenced once
+  // the new manifest has been written.
+  bool delete_unreferenced_files = true;
+
+  // Indicates that no other writer, in this or any other process, may write
+  // to the database while the compaction is in progress ("offline"
+  // compaction).
+  //
+  // If `true`, every data file under the data file prefixes that existed when
+  // the compaction started is deleted, including files left behind by failed
+  // writers, and a concurrent modification of the manifest is an error.
+  //
+  // If `false`, the compaction is retried if the manifest is modified
+  // concurrently, and no data files are deleted: a data file referenced by the
+  // replaced manifest may also hold data of a concurrent transaction that has
+  // not yet committed.  The data files that are no longer referenced are
+  // deleted by a subsequent `exclusive` compaction.
+  bool exclusive = false;
+};
+
+struct CompactionStatistics {
+  // Number of versions referenced by the new manifest.
+  size_t num_versions_retained = 0;
+
+  // Number of versions excluded from the new manifest by the retention policy.
+  size_t num_versions_removed = 0;
+
+  // Number of data files deleted.
+  size_t num_data_files_deleted = 0;
+};
+
+// Rewrites the b+tree nodes, out-of-line values and version tree nodes
+// reachable from the retained versions into new, densely packed data files,
+// replaces the manifest, and then, in `exclusive` mode, deletes the data files
+// that are no longer referenced.
+//
+// Versions excluded by `options` are removed from the version tree.  Since the
+// retained versions always form a suffix of the version history, the version
+// tree remains valid.
+//
+// Readers that resolved a version from the replaced manifest may fail with
+// `absl::StatusCode::kNotFound` after its data files are deleted, and must
+// re-read the manifest.
+//
+// Only databases with `manifest_kind="single"` are supported.
+//
+// Args:
+//   io_handle: I/O handle for the database.
+//   base: Root of the database, relative to which data files are deleted.
+//   data_file_prefixes: Data file prefixes used by the database.
+//   options: Retention and deletion options.
+Future<CompactionStatistics> Compact(IoHandle::Ptr io_handle,
+                                     kvstore::KvStore base,
+                                     const DataFilePrefixes& data_file_prefixes,
+                                     const CompactOptions& options = {});
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_COMPACT_H_
@@ -0,0 +1,304 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/ocdbt/non_distributed/diff_versions.h"
+
+#include <stddef.h>
+
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "absl/base/attributes.h"
+#include "absl/log/absl_log.h"
+#include "absl/status/status.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/log/verbose_flag.h"
+#include "tensorstore/kvstore/key_range.h"
+#include "tensorstore/kvstore/ocdbt/format/btree.h"
+#include "tensorstore/kvstore/ocdbt/format/indirect_data_reference.h"
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
+#include "tensorstore/kvstore/ocdbt/io_handle.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/quote_string.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+namespace {
+
+ABSL_CONST_INIT internal_log::VerboseFlag ocdbt_logging("ocdbt");
+
+// Subtree or leaf entry of one of the versions that remains to be compared.
+struct DiffItem {
+  // Full key of the leaf entry, or full inclusive min key of the subtree.
+  std::string key;
+
+  // Indicates whether this is a subtree or a leaf entry.
+  bool is_subtree;
+
+  // Location of the subtree root.  Only valid if `is_subtree == true`.
+  IndirectDataReference location;
+
+  // Height of the subtree root.  Only valid if `is_subtree == true`.
+  BtreeNodeHeight height = 0;
+
+  // Length of the implicit prefix that is excluded from the encoded
+  // representation of the subtree root.  Only valid if `is_subtree == true`.
+  KeyLength subtree_common_prefix_length = 0;
+
+  // Value of the leaf entry.  Only valid if `is_subtree == false`.
+  LeafNodeValueReference value_reference;
+};
+
+// Asynchronous operation state used to implement `DiffVersions`.
+//
+// Each version is represented by a sequence of items, ordered by key, that
+// remain to be compared; initially this is just the root node.  The items at
+// the front of the two sequences are repeatedly compared:
+//
+// - Subtrees with the same location are skipped in both versions, since they
+//   necessarily have the same contents.
+//
+// - Leaf entries are merged by key.
+//
+// - Otherwise, the subtree at the front of one or both sequences is read and
+//   replaced by its children that intersect the key range.
+//
+// At most one step is in progress at any time, which means no locking is
+// required.
+struct DiffOperation : public internal::AtomicReferenceCount<DiffOperation> {
+  using Ptr = internal::IntrusivePtr<DiffOperation>;
+  using PromiseType = Promise<std::vector<VersionDiffEntry>>;
+  using NodeFuture = ReadyFuture<const std::shared_ptr<const BtreeNode>>;
+
+  ReadonlyIoHandle::Ptr io_handle;
+  KeyRange range;
+
+  // Items of the old version (index 0) and new version (index 1) that remain
+  // to be compared.
+  std::deque<DiffItem> items[2];
+
+  // Differences found so far, in key order.
+  std::vector<VersionDiffEntry> entries;
+
+  void AddVersion(size_t side, const BtreeGenerationReference& version) {
+    if (version.root.location.IsMissing()) return;
+    auto& item = items[side].emplace_back();
+    item.is_subtree = true;
+    item.location = version.root.location;
+    item.height = version.root_height;
+  }
+
+  void Emit(std::string key, VersionDiffEntry::Kind kind) {
+    entries.push_back(VersionDiffEntry{std::move(key), kind});
+  }
+
+  // Compares items until a subtree must be read, or the comparison is done.
+  static void Process(Ptr op, PromiseType promise) {
+    auto& old_items = op->items[0];
+    auto& new_items = op->items[1];
+    while (!old_items.empty() || !new_items.empty()) {
+      DiffItem* old_item = old_items.empty() ? nullptr : &old_items.front();
+      DiffItem* new_item = new_items.empty() ? nullptr : &new_items.front();
+      if (old_item && new_item && old_item->is_subtree &&
+          new_item->is_subtree && old_item->location == new_item->location &&
+          old_item->height == new_item->height) {
+        // Subtree shared by both versions.
+        old_items.pop_front();
+        new_items.pop_front();
+        continue;
+      }
+
+      // A leaf entry that precedes the min key of the front item of the other
+      // version is not present in the other version.
+      const bool old_is_leaf = old_item && !old_item->is_subtree;
+      const bool new_is_leaf = new_item && !new_item->is_subtree;
+      if (old_is_leaf && (!new_item || old_item->key < new_item->key)) {
+        op->Emit(std::move(old_item->key), VersionDiffEntry::Kind::kRemoved);
+        old_items.pop_front();
+        continue;
+      }
+      if (new_is_leaf && (!old_item || new_item->key < old_item->key)) {
+        op->Emit(std::move(new_item->key), VersionDiffEntry::Kind::kAdded);
+        new_items.pop_front();
+        continue;
+      }
+      if (old_is_leaf && new_is_leaf) {
+        // Keys are equal.
+        if (old_item->value_reference != new_item->value_reference) {
+          op->Emit(std::move(old_item->key), VersionDiffEntry::Kind::kModified);
+        }
+        old_items.pop_front();
+        new_items.pop_front();
+        continue;
+      }
+
+      // At least one of the front items is a subtree that must be read.  If
+      // both are subtrees, only the taller one is read, such that shared
+      // subtrees at the same height are matched.
+      bool expand_old = old_item && old_item->is_subtree;
+      bool expand_new = new_item && new_item->is_subtree;
+      if (expand_old && expand_new) {
+        if (old_item->height > new_item->height) {
+          expand_new = false;
+        } else if (new_item->height > old_item->height) {
+          expand_old = false;
+        }
+      }
+      Expand(std::move(op), std::move(promise), expand_old, expand_new);
+      return;
+    }
+    promise.SetResult(std::move(op->entries));
+  }
+
+  // Reads the subtrees at the front of the specified sequences, and then
+  // continues the comparison.
+  static void Expand(Ptr op, PromiseType promise, bool expand_old,
+                     bool expand_new) {
+    auto* op_ptr = op.get();
+    auto read_front = [&](size_t side) {
+      auto& item = op_ptr->items[side].front();
+      ABSL_LOG_IF(INFO, ocdbt_logging)
+          << "DiffVersions: side=" << side << ", node=" << item.location
+          << ", node_height=" << static_cast<int>(item.height)
+          << ", inclusive_min_key=" << tensorstore::QuoteString(item.key);
+      return op_ptr->io_handle->GetBtreeNode(item.location);
+    };
+    auto executor = op_ptr->io_handle->executor;
+    if (expand_old && expand_new) {
+      auto old_future = read_front(0);
+      auto new_future = read_front(1);
+      LinkValue(WithExecutor(std::move(executor),
+                             [op = std::move(op)](PromiseType promise,
+                                                  NodeFuture old_future,
+                                                  NodeFuture new_future) {
+                               TENSORSTORE_RETURN_IF_ERROR(
+                                   op->ExpandFront(0, *old_future.value()),
+                                   static_cast<void>(promise.SetResult(_)));
+                               TENSORSTORE_RETURN_IF_ERROR(
+                                   op->ExpandFront(1, *new_future.value()),
+                                   static_cast<void>(promise.SetResult(_)));
+                               Process(std::move(op), std::move(promise));
+                             }),
+                std::move(promise), std::move(old_future),
+                std::move(new_future));
+      return;
+    }
+    const size_t side = expand_old ? 0 : 1;
+    auto future = read_front(side);
+    LinkValue(
+        WithExecutor(std::move(executor),
+                     [op = std::move(op), side](PromiseType promise,
+                                                NodeFuture future) {
+                       TENSORSTORE_RETURN_IF_ERROR(
+                           op->ExpandFront(side, *future.value()),
+                           static_cast<void>(promise.SetResult(_)));
+                       Process(std::move(op), std::move(promise));
+                     }),
+        std::move(promise), std::move(future));
+  }
+
+  // Replaces the subtree at the front of `items[side]` with the children of
+  // its root `node` that intersect `range`.
+  absl::Status ExpandFront(size_t side, const BtreeNode& node) {
+    auto& side_items = items[side];
+    DiffItem item = std::move(side_items.front());
+    side_items.pop_front();
+    TENSORSTORE_RETURN_IF_ERROR(ValidateBtreeNodeReference(
+        node, item.height,
+        std::string_view(item.key).substr(item.subtree_common_prefix_length)));
+    auto& subtree_key_prefix = item.key;
+    subtree_key_prefix.resize(item.subtree_common_prefix_length);
+    subtree_key_prefix += node.key_prefix;
+    auto key_range = KeyRange::RemovePrefix(subtree_key_prefix, range);
+
+    std::vector<DiffItem> children;
+    if (node.height > 0) {
+      auto entries = FindBtreeEntryRange(
+          std::get<BtreeNode::InteriorNodeEntries>(node.entries),
+          key_range.inclusive_min, key_range.exclusive_max);
+      children.reserve(entries.size());
+      for (const auto& entry : entries) {
+        auto& child = children.emplace_back();
+        child.key = tensorstore::StrCat(subtree_key_prefix, entry.key);
+        child.is_subtree = true;
+        child.location = entry.node.location;
+        child.height = node.height - 1;
+        child.subtree_common_prefix_length =
+            subtree_key_prefix.size() + entry.subtree_common_prefix_length;
+      }
+    } else {
+      auto entries = FindBtreeEntryRange(
+          std::get<BtreeNode::LeafNodeEntries>(node.entries),
+          key_range.inclusive_min, key_range.exclusive_max);
+      children.reserve(entries.size());
+      for (const auto& entry : entries) {
+        auto& child = children.emplace_back();
+        child.key = tensorstore::StrCat(subtree_key_prefix, entry.key);
+        child.is_subtree = false;
+        child.value_reference = entry.value_reference;
+      }
+    }
+    side_items.insert(side_items.begin(),
+                      std::make_move_iterator(children.begin()),
+                      std::make_move_iterator(children.end()));
+    return absl::OkStatus();
+  }
+};
+
+}  // namespace
+
+std::ostream& operator<<(std::ostream& os, const VersionDiffEntry& x) {
+  std::string_view kind;
+  switch (x.kind) {
+    case VersionDiffEntry::Kind::kAdded:
+      kind = "added";
+      break;
+    case VersionDiffEntry::Kind::kRemoved:
+      kind = "removed";
+      break;
+    case VersionDiffEntry::Kind::kModified:
+      kind = "modified";
+      break;
+  }
+  return os << "{key=" << tensorstore::QuoteString(x.key) << ", kind=" << kind
+            << "}";
+}
+
+Future<std::vector<VersionDiffEntry>> DiffVersions(
+    ReadonlyIoHandle::Ptr io_handle,
+    const BtreeGenerationReference& old_version,
+    const BtreeGenerationReference& new_version, KeyRange range) {
+  auto op = internal::MakeIntrusivePtr<DiffOperation>();
+  op->io_handle = std::move(io_handle);
+  op->range = std::move(range);
+  op->AddVersion(0, old_version);
+  op->AddVersion(1, new_version);
+  auto [promise, future] =
+      PromiseFuturePair<std::vector<VersionDiffEntry>>::Make();
+  DiffOperation::Process(std::move(op), std::move(promise));
+  return std::move(future);
+}
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
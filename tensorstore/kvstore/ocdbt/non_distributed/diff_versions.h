@@ -0,0 +1,72 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_DIFF_VERSIONS_H_
+#define TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_DIFF_VERSIONS_H_
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "tensorstore/kvstore/key_range.h"
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
+#include "tensorstore/kvstore/ocdbt/io_handle.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+
+/// Key that differs between two versions.
+struct VersionDiffEntry {
+  enum class Kind {
+    /// Present only in the new version.
+    kAdded,
+    /// Present only in the old version.
+    kRemoved,
+    /// Present in both versions, with different values.
+    kModified,
+  };
+
+  std::string key;
+  Kind kind;
+
+  friend bool operator==(const VersionDiffEntry& a, const VersionDiffEntry& b) {
+    return a.key == b.key && a.kind == b.kind;
+  }
+  friend bool operator!=(const VersionDiffEntry& a, const VersionDiffEntry& b) {
+    return !(a == b);
+  }
+  friend std::ostream& operator<<(std::ostream& os, const VersionDiffEntry& x);
+};
+
+/// Returns the keys within `range` that differ between `old_version` and
+/// `new_version`, in key order.
+///
+/// The two B+trees are traversed together, and subtrees referenced by both
+/// versions (i.e. subtrees with the same location, which are unchanged by
+/// copy-on-write commits) are skipped without being read.  The cost is
+/// therefore proportional to the number of nodes modified between the two
+/// versions rather than to the total number of keys.
+///
+/// Values are compared by their references; a value that was rewritten with
+/// identical content to a new location is reported as modified.
+Future<std::vector<VersionDiffEntry>> DiffVersions(
+    ReadonlyIoHandle::Ptr io_handle,
+    const BtreeGenerationReference& old_version,
+    const BtreeGenerationReference& new_version, KeyRange range = {});
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_DIFF_VERSIONS_H_
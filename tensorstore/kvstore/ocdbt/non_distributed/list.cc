@@ -17,6 +17,8 @@
 #include <stddef.h>
 
 #include <algorithm>
+#include <deque>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -24,8 +26,10 @@
 #include <vector>
 
 #include "absl/base/attributes.h"
+#include "absl/base/thread_annotations.h"
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/log/verbose_flag.h"
 #include "tensorstore/kvstore/key_range.h"
@@ -60,15 +64,19 @@ using ::tensorstore::kvstore::ListReceiver;
 //
 // The list operation is implemented as follows:
 //
-// 1. Resolve the root b+tree node by reading the manifest.
+// 1. Resolve the root b+tree node by reading the manifest, unless a specific
+//    version was specified.
 //
-// 2. Recursively descend the tree in parallel, reading all nodes that
-//    intersect the key range specified in `list_options`.
+// 2. Descend the tree, reading all nodes that intersect the key range
+//    specified in `list_options`.  Nodes that remain to be visited are kept in
+//    a queue ordered by key.  Reads are issued for the first nodes in the
+//    queue, such that at most `ReadonlyIoHandle::max_in_flight_btree_nodes`
+//    nodes are being read or have been read but not yet visited.  This bounds
+//    memory usage and the number of concurrent requests, while still
+//    prefetching the siblings of the node currently being visited.
 //
-// 3. Emit matching leaf-node keys to the receiver.
-//
-// TODO(jbms): Currently memory usage is not bounded.  That needs to be
-// addressed, e.g. by limiting the number of in-flight nodes.
+// 3. Emit matching leaf-node keys to the receiver, in key order, as the leaf
+//    nodes reach the front of the queue.
 struct ListOperation
     : public internal::FlowSenderOperationState<std::string_view,
                                                 span<const LeafNodeEntry>> {
@@ -81,6 +89,43 @@ struct ListOperation
   ReadonlyIoHandle::Ptr io_handle;
   KeyRange range;
 
+  // Subtree that remains to be visited.
+  struct PendingNode {
+    IndirectDataReference location;
+
+    BtreeNodeHeight node_height;
+
+    // Full inclusive min key for the node.
+    std::string inclusive_min_key;
+
+    // Specifies the length of the implicit prefix that is excluded from the
+    // encoded representation of the node.  The prefix is equal to
+    // `inclusive_min_key.substr(subtree_common_prefix_length)`.
+    KeyLength subtree_common_prefix_length;
+
+    // Indicates that the read of the node has been issued.
+    bool started = false;
+
+    // Set once the read of the node completes.
+    std::shared_ptr<const BtreeNode> node;
+  };
+
+  absl::Mutex mutex;
+
+  // Nodes that remain to be visited, ordered by key.
+  std::deque<std::unique_ptr<PendingNode>> queue ABSL_GUARDED_BY(mutex);
+
+  // Number of nodes in `queue` for which the read has been issued.
+  size_t num_started ABSL_GUARDED_BY(mutex) = 0;
+
+  // Indicates that a thread is currently in `ProcessQueue`.  Only a single
+  // thread processes the queue at a time, which ensures that leaf entries are
+  // emitted in order.
+  bool processing ABSL_GUARDED_BY(mutex) = false;
+
+  // Indicates that `ProcessQueue` was called while `processing == true`.
+  bool process_again ABSL_GUARDED_BY(mutex) = false;
+
   // Prepares the asynchronous list operation.
   //
   // Args:
@@ -103,18 +148,26 @@ struct ListOperation
       TENSORSTORE_ASSIGN_OR_RETURN(auto manifest_with_time,
                                    read_future.result(), op->SetError(_));
       const auto* manifest = manifest_with_time.manifest.get();
-      if (!manifest || manifest->latest_version().root.location.IsMissing()) {
-        // Manifest not present or btree is empty.
+      if (!manifest) {
+        // Manifest not present.
         return;
       }
-      auto& latest_version = manifest->versions.back();
-      VisitSubtree(std::move(op), latest_version.root,
-                   latest_version.root_height,
-                   /*inclusive_min_key=*/{},
-                   /*subtree_common_prefix_length=*/0);
+      VisitVersion(std::move(op), manifest->latest_version());
     }
   };
 
+  // Emits all matches within the specified version.
+  static void VisitVersion(ListOperation::Ptr op,
+                           const BtreeGenerationReference& version) {
+    if (version.root.location.IsMissing()) {
+      // Btree is empty.
+      return;
+    }
+    VisitSubtree(std::move(op), version.root, version.root_height,
+                 /*inclusive_min_key=*/{},
+                 /*subtree_common_prefix_length=*/0);
+  }
+
   // Emit all matches within a subtree.
   //
   // Args:
@@ -129,63 +182,139 @@ struct ListOperation
                            BtreeNodeHeight node_height,
                            std::string inclusive_min_key,
                            KeyLength subtree_common_prefix_length) {
+    auto pending = std::make_unique<PendingNode>();
+    pending->location = node_ref.location;
+    pending->node_height = node_height;
+    pending->inclusive_min_key = std::move(inclusive_min_key);
+    pending->subtree_common_prefix_length = subtree_common_prefix_length;
+    {
+      absl::MutexLock lock(&op->mutex);
+      op->queue.push_back(std::move(pending));
+    }
+    ProcessQueue(std::move(op));
+  }
+
+  // Visits the nodes at the front of the queue that have been read, and then
+  // issues reads for subsequent nodes up to the in-flight limit.
+  static void ProcessQueue(ListOperation::Ptr op) {
+    const size_t max_in_flight =
+        std::max<size_t>(1, op->io_handle->max_in_flight_btree_nodes);
+    std::vector<PendingNode*> to_start;
+    op->mutex.Lock();
+    if (op->processing) {
+      op->process_again = true;
+      op->mutex.Unlock();
+      return;
+    }
+    op->processing = true;
+    do {
+      op->process_again = false;
+      while (!op->cancelled() && !op->queue.empty() &&
+             op->queue.front()->node) {
+        auto pending = std::move(op->queue.front());
+        op->queue.pop_front();
+        --op->num_started;
+        op->mutex.Unlock();
+        std::vector<std::unique_ptr<PendingNode>> children;
+        auto status = VisitNode(*op, *pending, children);
+        pending.reset();
+        op->mutex.Lock();
+        if (!status.ok()) {
+          op->SetError(std::move(status));
+          break;
+        }
+        op->queue.insert(op->queue.begin(),
+                         std::make_move_iterator(children.begin()),
+                         std::make_move_iterator(children.end()));
+      }
+      if (op->cancelled()) break;
+      for (auto& pending : op->queue) {
+        if (op->num_started >= max_in_flight) break;
+        if (pending->started) continue;
+        pending->started = true;
+        ++op->num_started;
+        to_start.push_back(pending.get());
+      }
+      if (to_start.empty()) continue;
+      op->mutex.Unlock();
+      for (auto* pending : to_start) {
+        StartRead(op, *pending);
+      }
+      to_start.clear();
+      op->mutex.Lock();
+    } while (op->process_again);
+    op->processing = false;
+    op->mutex.Unlock();
+  }
+
+  // Issues the read of a queued node.
+  static void StartRead(ListOperation::Ptr op, PendingNode& pending) {
     ABSL_LOG_IF(INFO, ocdbt_logging)
-        << "List: node=" << node_ref
-        << ", node_height=" << static_cast<int>(node_height)
-        << ", subtree_common_prefix_length=" << subtree_common_prefix_length
-        << ", inclusive_min_key=" << tensorstore::QuoteString(inclusive_min_key)
+        << "List: node=" << pending.location
+        << ", node_height=" << static_cast<int>(pending.node_height)
+        << ", subtree_common_prefix_length="
+        << pending.subtree_common_prefix_length << ", inclusive_min_key="
+        << tensorstore::QuoteString(pending.inclusive_min_key)
         << ", key_range=" << op->range;
     auto* op_ptr = op.get();
     Link(WithExecutor(op_ptr->io_handle->executor,
-                      NodeReadyCallback{std::move(op), node_height,
-                                        std::move(inclusive_min_key),
-                                        subtree_common_prefix_length}),
-         op_ptr->promise, op_ptr->io_handle->GetBtreeNode(node_ref.location));
+                      NodeReadyCallback{std::move(op), &pending}),
+         op_ptr->promise, op_ptr->io_handle->GetBtreeNode(pending.location));
   }
 
   // Called when a B+tree node lookup completes.
   struct NodeReadyCallback {
     ListOperation::Ptr op;
 
-    BtreeNodeHeight node_height;
-
-    // Full inclusive min key for `node_cache_entry`.
-    std::string inclusive_min_key;
-
-    // Specifies the length of the implicit prefix that is excluded from the
-    // encoded representation of the node specified by `node_cache_entry`.  The
-    // prefix is equal to
-    // `inclusive_min_key.substr(subtree_common_prefix_length)`.
-    KeyLength subtree_common_prefix_length;
+    // Queue entry for the node.  Remains valid until `node` is set.
+    PendingNode* pending;
 
     void operator()(
         Promise<void> promise,
         ReadyFuture<const std::shared_ptr<const BtreeNode>> read_future) {
       TENSORSTORE_ASSIGN_OR_RETURN(auto node, read_future.result(),
                                    op->SetError(_));
-      if (op->cancelled()) return;
-      TENSORSTORE_RETURN_IF_ERROR(
-          ValidateBtreeNodeReference(*node, node_height,
-                                     std::string_view(inclusive_min_key)
-                                         .substr(subtree_common_prefix_length)),
-          op->SetError(_));
-      auto& subtree_key_prefix = inclusive_min_key;
-      subtree_key_prefix.resize(subtree_common_prefix_length);
-      subtree_key_prefix += node->key_prefix;
-      auto key_range = KeyRange::RemovePrefix(subtree_key_prefix, op->range);
-
-      if (node->height > 0) {
-        VisitInteriorNode(std::move(op), *node, subtree_key_prefix, key_range);
-      } else {
-        VisitLeafNode(std::move(op), *node, subtree_key_prefix, key_range);
+      {
+        absl::MutexLock lock(&op->mutex);
+        pending->node = std::move(node);
       }
+      ProcessQueue(std::move(op));
     }
   };
 
-  // Recursively visits matching children.
-  static void VisitInteriorNode(ListOperation::Ptr op, const BtreeNode& node,
-                                std::string_view subtree_key_prefix,
-                                const KeyRange& key_range) {
+  // Visits a node that has been read.
+  //
+  // Args:
+  //   op: List operation state.
+  //   pending: Node to visit.
+  //   children: Set to the children of `pending` that intersect the key range,
+  //     in key order.
+  static absl::Status VisitNode(
+      ListOperation& op, PendingNode& pending,
+      std::vector<std::unique_ptr<PendingNode>>& children) {
+    const auto& node = *pending.node;
+    TENSORSTORE_RETURN_IF_ERROR(ValidateBtreeNodeReference(
+        node, pending.node_height,
+        std::string_view(pending.inclusive_min_key)
+            .substr(pending.subtree_common_prefix_length)));
+    auto& subtree_key_prefix = pending.inclusive_min_key;
+    subtree_key_prefix.resize(pending.subtree_common_prefix_length);
+    subtree_key_prefix += node.key_prefix;
+    auto key_range = KeyRange::RemovePrefix(subtree_key_prefix, op.range);
+
+    if (node.height > 0) {
+      VisitInteriorNode(node, subtree_key_prefix, key_range, children);
+    } else {
+      VisitLeafNode(op, node, subtree_key_prefix, key_range);
+    }
+    return absl::OkStatus();
+  }
+
+  // Returns the matching children.
+  static void VisitInteriorNode(
+      const BtreeNode& node, std::string_view subtree_key_prefix,
+      const KeyRange& key_range,
+      std::vector<std::unique_ptr<PendingNode>>& children) {
     auto& all_entries = std::get<BtreeNode::InteriorNodeEntries>(node.entries);
     auto entries = FindBtreeEntryRange(all_entries, key_range.inclusive_min,
                                        key_range.exclusive_max);
@@ -199,17 +328,20 @@ struct ListOperation
         << ", num matches=" << entries.size();
     // Note: It is safe to access `all_entries.front()` and `all_entries.back()`
     // because B+tree nodes are guaranteed to have at least one entry.
+    children.reserve(entries.size());
     for (const auto& entry : entries) {
-      VisitSubtree(op, entry.node, node.height - 1,
-                   /*inclusive_min_key=*/
-                   tensorstore::StrCat(subtree_key_prefix, entry.key),
-                   /*subtree_common_prefix_length=*/subtree_key_prefix.size() +
-                       entry.subtree_common_prefix_length);
+      auto& child = *children.emplace_back(std::make_unique<PendingNode>());
+      child.location = entry.node.location;
+      child.node_height = node.height - 1;
+      child.inclusive_min_key =
+          tensorstore::StrCat(subtree_key_prefix, entry.key);
+      child.subtree_common_prefix_length =
+          subtree_key_prefix.size() + entry.subtree_common_prefix_length;
     }
   }
 
   // Emits matches in the leaf node.
-  static void VisitLeafNode(ListOperation::Ptr op, const BtreeNode& node,
+  static void VisitLeafNode(ListOperation& op, const BtreeNode& node,
                             std::string_view subtree_key_prefix,
                             const KeyRange& key_range) {
     auto& all_entries = std::get<BtreeNode::LeafNodeEntries>(node.entries);
@@ -226,7 +358,7 @@ struct ListOperation
     // Note: It is safe to access `all_entries.front()` and `all_entries.back()`
     // because B+tree nodes are guaranteed to have at least one entry.
     if (entries.empty()) return;
-    execution::set_value(op->shared_receiver->receiver, subtree_key_prefix,
+    execution::set_value(op.shared_receiver->receiver, subtree_key_prefix,
                          entries);
   }
 };
@@ -280,7 +412,19 @@ void NonDistributedList(ReadonlyIoHandle::Ptr io_handle,
   Link(WithExecutor(op_ptr->io_handle->executor,
                     ListOperation::ManifestReadyCallback{std::move(op)}),
        op_ptr->promise,
-       op_ptr->io_handle->GetManifest(options.staleness_bound));
+       op_ptr->io_handle->GetManifest(
+           op_ptr->io_handle->GetReadManifestStalenessBound(
+               options.staleness_bound)));
+}
+
+void NonDistributedListVersion(ReadonlyIoHandle::Ptr io_handle,
+                               const BtreeGenerationReference& version,
+                               kvstore::ListOptions options,
+                               ListReceiver&& receiver) {
+  auto op = ListOperation::Initialize(
+      std::move(io_handle), std::move(options.range),
+      KeyReceiverAdapter{std::move(receiver), options.strip_prefix_length});
+  ListOperation::VisitVersion(std::move(op), version);
 }
 
 void NonDistributedListSubtree(
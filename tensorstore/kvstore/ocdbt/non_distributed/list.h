@@ -21,6 +21,7 @@
 #include "absl/status/status.h"
 #include "tensorstore/kvstore/key_range.h"
 #include "tensorstore/kvstore/ocdbt/format/btree.h"
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
 #include "tensorstore/kvstore/ocdbt/io_handle.h"
 #include "tensorstore/kvstore/operations.h"
 #include "tensorstore/util/execution/any_receiver.h"
@@ -33,6 +34,14 @@ void NonDistributedList(ReadonlyIoHandle::Ptr io_handle,
                         kvstore::ListOptions options,
                         kvstore::ListReceiver&& receiver);
 
+/// Lists the keys of the specified `version` rather than the latest version.
+///
+/// `options.staleness_bound` is ignored.
+void NonDistributedListVersion(ReadonlyIoHandle::Ptr io_handle,
+                               const BtreeGenerationReference& version,
+                               kvstore::ListOptions options,
+                               kvstore::ListReceiver&& receiver);
+
 void NonDistributedListSubtree(
     ReadonlyIoHandle::Ptr io_handle, const BtreeNodeReference& node_ref,
     BtreeNodeHeight node_height, std::string subtree_key_prefix,
@@ -34,6 +34,7 @@
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/ocdbt/format/btree.h"
 #include "tensorstore/kvstore/ocdbt/format/indirect_data_reference.h"
+#include "tensorstore/kvstore/ocdbt/format/key_filter.h"
 #include "tensorstore/kvstore/ocdbt/format/manifest.h"
 #include "tensorstore/kvstore/ocdbt/format/version_tree.h"
 #include "tensorstore/kvstore/ocdbt/io_handle.h"
@@ -57,12 +58,14 @@ ABSL_CONST_INIT internal_log::VerboseFlag ocdbt_logging("ocdbt");
 //
 // The read operation is implemented as follows:
 //
-// 1. Resolve the root b+tree node by reading the manifest.
+// 1. Resolve the root b+tree node by reading the manifest, unless a specific
+//    version was specified.
 //
 // 2. Descend the tree along the path to the requested key.
 //
 // 3. Stop and return a missing value indication as soon as the key is
-//    determined to be missing.
+//    determined to be missing, possibly from the key filter stored for a leaf
+//    node, without reading the leaf node.
 //
 // 4. Once the leaf node containing the key is reached, either return the value
 //    directly (if stored inline), or read it via
@@ -82,10 +85,21 @@ struct ReadOperation : public internal::AtomicReferenceCount<ReadOperation> {
   // Generation of indirect value.
   StorageGeneration generation;
 
-  // Initiates the asynchronous read operation.
+  // Prepares the asynchronous read operation.
+  static ReadOperation::Ptr Initialize(ReadonlyIoHandle::Ptr&& io_handle,
+                                       kvstore::Key&& key,
+                                       kvstore::ReadOptions& options) {
+    auto op = internal::MakeIntrusivePtr<ReadOperation>();
+    op->io_handle = std::move(io_handle);
+    op->generation_conditions = std::move(options.generation_conditions);
+    op->byte_range = options.byte_range;
+    op->key = std::move(key);
+    return op;
+  }
+
+  // Initiates the asynchronous read operation of the latest version.
   //
   // Args:
-  //   promise: Promise on which to set read result when ready.
   //   io_handle: I/O handle to use.
   //   key: Key to read.
   //   options: Additional read options.
@@ -95,11 +109,7 @@ struct ReadOperation : public internal::AtomicReferenceCount<ReadOperation> {
   static Future<kvstore::ReadResult> Start(ReadonlyIoHandle::Ptr io_handle,
                                            kvstore::Key&& key,
                                            kvstore::ReadOptions&& options) {
-    auto op = internal::MakeIntrusivePtr<ReadOperation>();
-    op->io_handle = std::move(io_handle);
-    op->generation_conditions = std::move(options.generation_conditions);
-    op->byte_range = options.byte_range;
-    op->key = std::move(key);
+    auto op = Initialize(std::move(io_handle), std::move(key), options);
     auto* op_ptr = op.get();
     return PromiseFuturePair<kvstore::ReadResult>::LinkValue(
                WithExecutor(
@@ -110,24 +120,51 @@ struct ReadOperation : public internal::AtomicReferenceCount<ReadOperation> {
                      ManifestReady(std::move(op), std::move(promise),
                                    future.value());
                    }),
-               op_ptr->io_handle->GetManifest(options.staleness_bound))
+               op_ptr->io_handle->GetManifest(
+                   op_ptr->io_handle->GetReadManifestStalenessBound(
+                       options.staleness_bound)))
         .future;
   }
 
+  // Initiates the asynchronous read operation of the specified version.
+  //
+  // The `staleness_bound` in `options` is ignored, since the contents of a
+  // version never change.
+  static Future<kvstore::ReadResult> StartVersion(
+      ReadonlyIoHandle::Ptr io_handle, const BtreeGenerationReference& version,
+      kvstore::Key&& key, kvstore::ReadOptions&& options) {
+    auto op = Initialize(std::move(io_handle), std::move(key), options);
+    op->time = absl::InfiniteFuture();
+    auto [promise, future] = PromiseFuturePair<kvstore::ReadResult>::Make();
+    VersionReady(std::move(op), std::move(promise), version);
+    return std::move(future);
+  }
+
   // Called when the manifest lookup has completed.
   static void ManifestReady(ReadOperation::Ptr op,
                             Promise<kvstore::ReadResult> promise,
                             const ManifestWithTime& manifest_with_time) {
     op->time = manifest_with_time.time;
     auto* manifest = manifest_with_time.manifest.get();
-    if (!manifest || manifest->latest_version().root.location.IsMissing()) {
-      // Manifest not preset or btree is empty.
+    if (!manifest) {
+      // Manifest not present.
+      op->KeyNotPresent(promise);
+      return;
+    }
+    VersionReady(std::move(op), std::move(promise), manifest->latest_version());
+  }
+
+  // Called once the version to read has been determined.
+  static void VersionReady(ReadOperation::Ptr op,
+                           Promise<kvstore::ReadResult> promise,
+                           const BtreeGenerationReference& version) {
+    if (version.root.location.IsMissing()) {
+      // Btree is empty.
       op->KeyNotPresent(promise);
       return;
     }
-    auto& latest_version = manifest->versions.back();
-    LookupNodeReference(std::move(op), std::move(promise), latest_version.root,
-                        latest_version.root_height,
+    LookupNodeReference(std::move(op), std::move(promise), version.root,
+                        version.root_height,
                         /*inclusive_min_key=*/{});
   }
 
@@ -215,6 +252,15 @@ struct ReadOperation : public internal::AtomicReferenceCount<ReadOperation> {
       op->KeyNotPresent(promise);
       return;
     }
+    if (!KeyFilterMayContain(entry->node.key_filter, op->key)) {
+      // The key filter of the child excludes the key, so the child need not be
+      // read.
+      ABSL_LOG_IF(INFO, ocdbt_logging)
+          << "Read: key=" << tensorstore::QuoteString(op->key)
+          << " excluded by key filter";
+      op->KeyNotPresent(promise);
+      return;
+    }
     ABSL_LOG_IF(INFO, ocdbt_logging)
         << "Read: key=" << tensorstore::QuoteString(op->key)
         << ", matched_length=" << op->matched_length
@@ -292,5 +338,12 @@ Future<kvstore::ReadResult> NonDistributedRead(ReadonlyIoHandle::Ptr io_handle,
                               std::move(options));
 }
 
+Future<kvstore::ReadResult> NonDistributedReadVersion(
+    ReadonlyIoHandle::Ptr io_handle, const BtreeGenerationReference& version,
+    kvstore::Key key, kvstore::ReadOptions options) {
+  return ReadOperation::StartVersion(std::move(io_handle), version,
+                                     std::move(key), std::move(options));
+}
+
 }  // namespace internal_ocdbt
 }  // namespace tensorstore
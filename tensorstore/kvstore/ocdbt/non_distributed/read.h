@@ -15,6 +15,7 @@
 #ifndef TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_READ_H_
 #define TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_READ_H_
 
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
 #include "tensorstore/kvstore/ocdbt/io_handle.h"
 #include "tensorstore/kvstore/operations.h"
 #include "tensorstore/kvstore/read_result.h"
@@ -27,6 +28,14 @@ Future<kvstore::ReadResult> NonDistributedRead(ReadonlyIoHandle::Ptr io_handle,
                                                kvstore::Key key,
                                                kvstore::ReadOptions options);
 
+/// Reads `key` from the specified `version` rather than the latest version.
+///
+/// Since the contents of a version never change, `options.staleness_bound` is
+/// ignored and the returned timestamp is `absl::InfiniteFuture()`.
+Future<kvstore::ReadResult> NonDistributedReadVersion(
+    ReadonlyIoHandle::Ptr io_handle, const BtreeGenerationReference& version,
+    kvstore::Key key, kvstore::ReadOptions options);
+
 }  // namespace internal_ocdbt
 }  // namespace tensorstore
 
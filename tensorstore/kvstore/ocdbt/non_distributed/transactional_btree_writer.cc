@@ -54,18 +54,11 @@
 // 8. If the manifest is written successfully, then the commit is done.
 //    Otherwise, return to step 2.
 //
-// TODO(jbms): Currently, B+tree nodes are never merged in response to delete
-// operations, which means that lookups are `O(log M)`, where `M` is the total
-// number of keys inserted, rather than `O(log N)`, where `N` is the current
-// number of keys.  It is expected that for most use cases, there won't be many
-// deletes, if any, and for such uses cases merging nodes is unnecessary.  To
-// avoid writing too-small nodes, any remaining elements of too-small nodes
-// could be propagated back to the parent `NodeTraversalState` and then inserted
-// into a sibling (which would require reading or re-reading the sibling first).
+// Nodes left underfull by deletions are merged with their siblings, as
+// described in `btree_writer_commit_operation.h`.
 //
-// TODO(jbms): Currently the asynchronous traversal of the tree is not bounded
-// in its memory usage.  That needs to be addressed, e.g. by limiting the number
-// of in-flight nodes.
+// The number of concurrent B+tree node reads issued by the traversal is limited
+// to `IoHandle::max_in_flight_btree_nodes`.
 
 #include "tensorstore/kvstore/ocdbt/non_distributed/transactional_btree_writer.h"
 
@@ -0,0 +1,85 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/ocdbt/non_distributed/version_snapshot.h"
+
+#include <utility>
+#include <vector>
+
+#include "absl/time/time.h"
+#include "tensorstore/kvstore/key_range.h"
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
+#include "tensorstore/kvstore/ocdbt/io_handle.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/diff_versions.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/list.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/read.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/read_version.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/util/execution/future_collecting_receiver.h"
+#include "tensorstore/util/execution/sync_flow_sender.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+
+Future<VersionSnapshot> VersionSnapshot::Open(ReadonlyIoHandle::Ptr io_handle,
+                                              VersionSpec version_spec,
+                                              absl::Time staleness_bound) {
+  auto* io_handle_ptr = io_handle.get();
+  return MapFutureValue(
+      InlineExecutor{},
+      [io_handle = std::move(io_handle)](
+          const BtreeGenerationReference& version) mutable {
+        return VersionSnapshot(std::move(io_handle), version);
+      },
+      ReadVersion(ReadonlyIoHandle::Ptr(io_handle_ptr), version_spec,
+                  staleness_bound));
+}
+
+Future<kvstore::ReadResult> VersionSnapshot::Read(
+    kvstore::Key key, kvstore::ReadOptions options) const {
+  return NonDistributedReadVersion(io_handle_, version_, std::move(key),
+                                   std::move(options));
+}
+
+void VersionSnapshot::List(kvstore::ListOptions options,
+                           kvstore::ListReceiver receiver) const {
+  NonDistributedListVersion(io_handle_, version_, std::move(options),
+                            std::move(receiver));
+}
+
+Future<std::vector<kvstore::ListEntry>> VersionSnapshot::ListFuture(
+    kvstore::ListOptions options) const {
+  struct ListSender {
+    VersionSnapshot self;
+    kvstore::ListOptions options;
+    void submit(kvstore::ListReceiver receiver) {
+      self.List(std::move(options), std::move(receiver));
+    }
+  };
+  return tensorstore::CollectFlowSenderIntoFuture<
+      std::vector<kvstore::ListEntry>>(tensorstore::MakeSyncFlowSender(
+      ListSender{*this, std::move(options)}));
+}
+
+Future<std::vector<VersionDiffEntry>> VersionSnapshot::DiffFrom(
+    const VersionSnapshot& old_snapshot, KeyRange range) const {
+  return DiffVersions(io_handle_, old_snapshot.version_, version_,
+                      std::move(range));
+}
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
@@ -0,0 +1,94 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_VERSION_SNAPSHOT_H_
+#define TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_VERSION_SNAPSHOT_H_
+
+#include <utility>
+#include <vector>
+
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/kvstore/key_range.h"
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
+#include "tensorstore/kvstore/ocdbt/io_handle.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/diff_versions.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+
+/// Read-only handle to a single version of an OCDBT database.
+///
+/// The root of the B+tree for the version is resolved from the version tree
+/// once, when the snapshot is opened; subsequent reads, lists and diffs start
+/// directly from the pinned root.  Snapshots opened from the same
+/// `ReadonlyIoHandle` share its B+tree node cache, such that nodes common to
+/// multiple versions are read and decoded only once.
+class VersionSnapshot {
+ public:
+  VersionSnapshot() = default;
+
+  /// Constructs a snapshot of an already-resolved version.
+  explicit VersionSnapshot(ReadonlyIoHandle::Ptr io_handle,
+                           const BtreeGenerationReference& version)
+      : io_handle_(std::move(io_handle)), version_(version) {}
+
+  /// Resolves `version_spec` and returns a snapshot of it.
+  ///
+  /// Fails with `absl::StatusCode::kNotFound` if the version does not exist.
+  static Future<VersionSnapshot> Open(ReadonlyIoHandle::Ptr io_handle,
+                                      VersionSpec version_spec,
+                                      absl::Time staleness_bound = absl::Now());
+
+  const ReadonlyIoHandle::Ptr& io_handle() const { return io_handle_; }
+
+  /// Returns the pinned version.
+  const BtreeGenerationReference& version() const { return version_; }
+
+  /// Reads a key from this version.
+  ///
+  /// Since the contents of a version never change, `options.staleness_bound`
+  /// is ignored and the returned timestamp is `absl::InfiniteFuture()`.
+  Future<kvstore::ReadResult> Read(kvstore::Key key,
+                                   kvstore::ReadOptions options = {}) const;
+
+  /// Lists the keys of this version.
+  void List(kvstore::ListOptions options,
+            kvstore::ListReceiver receiver) const;
+
+  /// Returns the keys of this version.
+  Future<std::vector<kvstore::ListEntry>> ListFuture(
+      kvstore::ListOptions options = {}) const;
+
+  /// Returns the keys within `range` that differ between `old_snapshot` and
+  /// this snapshot.
+  ///
+  /// Only subtrees that differ between the two versions are read.
+  ///
+  /// \pre `old_snapshot` refers to the same database as this snapshot.
+  Future<std::vector<VersionDiffEntry>> DiffFrom(
+      const VersionSnapshot& old_snapshot, KeyRange range = {}) const;
+
+ private:
+  ReadonlyIoHandle::Ptr io_handle_;
+  BtreeGenerationReference version_;
+};
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_VERSION_SNAPSHOT_H_
@@ -45,6 +45,7 @@ std::vector<InteriorNodeEntryData<std::string>> WriteNodes(
                                            new_entry.node.location));
     new_entry.key = std::move(encoded_node.info.inclusive_min_key);
     new_entry.node.statistics = encoded_node.info.statistics;
+    new_entry.node.key_filter = std::move(encoded_node.info.key_filter);
     new_entry.subtree_common_prefix_length =
         encoded_node.info.excluded_prefix_length;
   }
@@ -65,7 +66,9 @@ Result<BtreeGenerationReference> WriteRootNode(
         new_generation.root.location = IndirectDataReference::Missing();
       } else {
         new_generation.root_height = height;
-        new_generation.root = new_entries[0].node;
+        new_generation.root = std::move(new_entries[0].node);
+        // Key filters are only stored in interior nodes.
+        new_generation.root.key_filter.clear();
       }
       return new_generation;
     }
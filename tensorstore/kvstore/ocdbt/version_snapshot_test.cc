@@ -0,0 +1,200 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/ocdbt/non_distributed/version_snapshot.h"
+
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_format.h"
+#include "absl/time/time.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/kvstore/key_range.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/ocdbt/driver.h"
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/create_new_manifest.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/diff_versions.h"
+#include "tensorstore/kvstore/ocdbt/test_util.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/test_matchers.h"
+#include "tensorstore/transaction.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+namespace kvstore = ::tensorstore::kvstore;
+using ::tensorstore::KeyRange;
+using ::tensorstore::KvStore;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::internal::MatchesKvsReadResult;
+using ::tensorstore::internal::MatchesKvsReadResultNotFound;
+using ::tensorstore::internal::MatchesListEntry;
+using ::tensorstore::internal_ocdbt::EnsureExistingManifest;
+using ::tensorstore::internal_ocdbt::GenerationNumber;
+using ::tensorstore::internal_ocdbt::GetOcdbtIoHandle;
+using ::tensorstore::internal_ocdbt::OcdbtDriver;
+using ::tensorstore::internal_ocdbt::ReadManifest;
+using ::tensorstore::internal_ocdbt::VersionDiffEntry;
+using ::tensorstore::internal_ocdbt::VersionSnapshot;
+
+using Kind = VersionDiffEntry::Kind;
+
+KvStore OpenStore(::nlohmann::json config) {
+  return kvstore::Open({{"driver", "ocdbt"},
+                        {"base", "memory://"},
+                        {"config", std::move(config)}})
+      .value();
+}
+
+GenerationNumber GetLatestGeneration(KvStore& store) {
+  auto manifest = ReadManifest(static_cast<OcdbtDriver&>(*store.driver));
+  return manifest.ok() && *manifest ? (*manifest)->latest_generation() : 0;
+}
+
+VersionSnapshot OpenSnapshot(KvStore& store, GenerationNumber generation) {
+  return VersionSnapshot::Open(GetOcdbtIoHandle(*store.driver), generation)
+      .value();
+}
+
+std::string Key(size_t i) { return absl::StrFormat("key%04d", i); }
+
+TEST(VersionSnapshotTest, ReadAndList) {
+  auto store = OpenStore(::nlohmann::json::object_t{});
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord("1")));
+  const GenerationNumber generation1 = GetLatestGeneration(store);
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord("2")));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "b", absl::Cord("3")));
+  const GenerationNumber generation2 = GetLatestGeneration(store);
+
+  auto snapshot1 = OpenSnapshot(store, generation1);
+  auto snapshot2 = OpenSnapshot(store, generation2);
+  EXPECT_EQ(generation1, snapshot1.version().generation_number);
+
+  auto read_result = snapshot1.Read("a").result();
+  EXPECT_THAT(read_result, MatchesKvsReadResult(absl::Cord("1")));
+  ASSERT_TRUE(read_result.ok());
+  EXPECT_EQ(absl::InfiniteFuture(), read_result->stamp.time);
+  EXPECT_THAT(snapshot1.Read("b").result(), MatchesKvsReadResultNotFound());
+  EXPECT_THAT(snapshot2.Read("a").result(),
+              MatchesKvsReadResult(absl::Cord("2")));
+
+  EXPECT_THAT(snapshot1.ListFuture().result(),
+              ::testing::Optional(
+                  ::testing::ElementsAre(MatchesListEntry("a"))));
+  EXPECT_THAT(snapshot2.ListFuture().result(),
+              ::testing::Optional(::testing::ElementsAre(
+                  MatchesListEntry("a"), MatchesListEntry("b"))));
+
+  // The snapshot is unaffected by later writes.
+  TENSORSTORE_ASSERT_OK(kvstore::Delete(store, "a").result());
+  EXPECT_THAT(snapshot2.Read("a").result(),
+              MatchesKvsReadResult(absl::Cord("2")));
+}
+
+TEST(VersionSnapshotTest, EmptyVersion) {
+  auto store = OpenStore(::nlohmann::json::object_t{});
+  auto io_handle = GetOcdbtIoHandle(*store.driver);
+  TENSORSTORE_ASSERT_OK(EnsureExistingManifest(io_handle).result());
+  auto snapshot = OpenSnapshot(store, 1);
+  EXPECT_THAT(snapshot.Read("a").result(), MatchesKvsReadResultNotFound());
+  EXPECT_THAT(snapshot.ListFuture().result(),
+              ::testing::Optional(::testing::IsEmpty()));
+}
+
+TEST(VersionSnapshotTest, VersionNotPresent) {
+  auto store = OpenStore(::nlohmann::json::object_t{});
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord("1")));
+  EXPECT_THAT(VersionSnapshot::Open(GetOcdbtIoHandle(*store.driver),
+                                    GetLatestGeneration(store) + 1)
+                  .result(),
+              MatchesStatus(absl::StatusCode::kNotFound));
+}
+
+TEST(VersionSnapshotTest, Diff) {
+  constexpr size_t kNumKeys = 800;
+  auto store = OpenStore({{"max_decoded_node_bytes", 500}});
+  {
+    auto transaction = tensorstore::Transaction(tensorstore::atomic_isolated);
+    auto txn_store = (store | transaction).value();
+    for (size_t i = 0; i < kNumKeys; i += 2) {
+      TENSORSTORE_ASSERT_OK(kvstore::Write(txn_store, Key(i), absl::Cord("v")));
+    }
+    TENSORSTORE_ASSERT_OK(transaction.CommitAsync().result());
+  }
+  const GenerationNumber old_generation = GetLatestGeneration(store);
+  {
+    auto transaction = tensorstore::Transaction(tensorstore::atomic_isolated);
+    auto txn_store = (store | transaction).value();
+    TENSORSTORE_ASSERT_OK(kvstore::Write(txn_store, Key(0), absl::Cord("w")));
+    TENSORSTORE_ASSERT_OK(kvstore::Write(txn_store, Key(201), absl::Cord("v")));
+    TENSORSTORE_ASSERT_OK(kvstore::Delete(txn_store, Key(300)).result());
+    TENSORSTORE_ASSERT_OK(kvstore::Write(txn_store, Key(398), absl::Cord("w")));
+    TENSORSTORE_ASSERT_OK(transaction.CommitAsync().result());
+  }
+  const GenerationNumber new_generation = GetLatestGeneration(store);
+  ASSERT_EQ(old_generation + 1, new_generation);
+
+  auto old_snapshot = OpenSnapshot(store, old_generation);
+  auto new_snapshot = OpenSnapshot(store, new_generation);
+  ASSERT_GE(new_snapshot.version().root_height, 2);
+
+  EXPECT_THAT(new_snapshot.DiffFrom(old_snapshot).result(),
+              ::testing::Optional(::testing::ElementsAre(
+                  VersionDiffEntry{Key(0), Kind::kModified},
+                  VersionDiffEntry{Key(201), Kind::kAdded},
+                  VersionDiffEntry{Key(300), Kind::kRemoved},
+                  VersionDiffEntry{Key(398), Kind::kModified})));
+  EXPECT_THAT(old_snapshot.DiffFrom(new_snapshot).result(),
+              ::testing::Optional(::testing::ElementsAre(
+                  VersionDiffEntry{Key(0), Kind::kModified},
+                  VersionDiffEntry{Key(201), Kind::kRemoved},
+                  VersionDiffEntry{Key(300), Kind::kAdded},
+                  VersionDiffEntry{Key(398), Kind::kModified})));
+  EXPECT_THAT(
+      new_snapshot.DiffFrom(old_snapshot, KeyRange(Key(100), Key(300)))
+          .result(),
+      ::testing::Optional(::testing::ElementsAre(
+          VersionDiffEntry{Key(201), Kind::kAdded})));
+  EXPECT_THAT(new_snapshot.DiffFrom(new_snapshot).result(),
+              ::testing::Optional(::testing::IsEmpty()));
+}
+
+TEST(VersionSnapshotTest, DiffFromEmpty) {
+  auto store = OpenStore({{"max_decoded_node_bytes", 500}});
+  auto io_handle = GetOcdbtIoHandle(*store.driver);
+  TENSORSTORE_ASSERT_OK(EnsureExistingManifest(io_handle).result());
+  std::vector<VersionDiffEntry> expected;
+  {
+    auto transaction = tensorstore::Transaction(tensorstore::atomic_isolated);
+    auto txn_store = (store | transaction).value();
+    for (size_t i = 0; i < 100; ++i) {
+      TENSORSTORE_ASSERT_OK(kvstore::Write(txn_store, Key(i), absl::Cord("v")));
+      expected.push_back(VersionDiffEntry{Key(i), Kind::kAdded});
+    }
+    TENSORSTORE_ASSERT_OK(transaction.CommitAsync().result());
+  }
+  auto empty_snapshot = OpenSnapshot(store, 1);
+  auto snapshot = OpenSnapshot(store, GetLatestGeneration(store));
+  EXPECT_THAT(snapshot.DiffFrom(empty_snapshot).result(),
+              ::testing::Optional(::testing::ElementsAreArray(expected)));
+}
+
+}  // namespace
@@ -69,6 +69,28 @@ constexpr inline bool ReadOptions::IsOption<Batch> = true;
 template <>
 constexpr inline bool ReadOptions::IsOption<Batch::View> = true;
 
+/// Specifies whether the read-only array returned by `tensorstore::ReadConst`
+/// may reference data cached by the source TensorStore.
+///
+/// The mutable array returned by `tensorstore::Read` into a new array is always
+/// newly allocated, since modifying it must not affect the cached data.
+///
+/// \relates ReadIntoNewArrayOptions
+enum CachedDataReferencePermission {
+  /// The returned array is always newly allocated.
+  cannot_reference_cached_data = 0,
+
+  /// If the requested region is contained within a single cached chunk and no
+  /// data type conversion is required, the returned array may be a view that
+  /// shares ownership of the immutable cached chunk data rather than a copy.
+  /// In that case, the layout of the returned array is determined by the chunk
+  /// rather than by `ReadIntoNewArrayOptions::layout_order`.  If caching is
+  /// disabled, the decoded chunk thereby becomes the returned array without
+  /// any further allocation or copy, which benefits streaming reads of
+  /// chunk-aligned regions.
+  can_reference_cached_data = 1,
+};
+
 /// Options for `tensorstore::Read` into new array.
 ///
 /// \relates Read[TensorStore]
@@ -91,6 +113,11 @@ struct ReadIntoNewArrayOptions {
     return absl::OkStatus();
   }
 
+  absl::Status Set(CachedDataReferencePermission value) {
+    this->cached_data_reference_permission = value;
+    return absl::OkStatus();
+  }
+
   /// Specifies the layout order of the newly-allocated array.  Defaults to
   /// `c_order`.
   ContiguousLayoutOrder layout_order = c_order;
@@ -100,6 +127,10 @@ struct ReadIntoNewArrayOptions {
 
   /// Optional batch.
   Batch batch{no_batch};
+
+  /// Specifies whether the returned array may reference cached data.
+  CachedDataReferencePermission cached_data_reference_permission =
+      cannot_reference_cached_data;
 };
 
 template <>
@@ -116,6 +147,10 @@ constexpr inline bool ReadIntoNewArrayOptions::IsOption<Batch> = true;
 template <>
 constexpr inline bool ReadIntoNewArrayOptions::IsOption<Batch::View> = true;
 
+template <>
+constexpr inline bool
+    ReadIntoNewArrayOptions::IsOption<CachedDataReferencePermission> = true;
+
 /// Specifies restrictions on how references to the source array/source
 /// TensorStore may be used by write operations.
 ///
@@ -138,6 +173,22 @@ enum SourceDataReferenceRestriction {
   /// write is committed.  The source data must not be modified until all
   /// references are released.
   can_reference_source_data_indefinitely = 2,
+
+  /// Exclusive ownership of the source data is transferred to the write
+  /// operation, which may modify it in place to apply subsequent writes.  As
+  /// for internally allocated chunk data, writeback does not copy it: the
+  /// source data may be retained indefinitely, even after the write is
+  /// committed, e.g. as the cached data of a chunk.  The source data must not
+  /// otherwise be accessed once the write has been initiated, including after
+  /// the write is committed.  This avoids copying the source data for
+  /// chunk-aligned writes of arrays that are not otherwise referenced, e.g. a
+  /// `SharedArray` passed by `std::move`.  If, after alignment to the target
+  /// domain, the source may refer to the same element from multiple positions,
+  /// e.g. because it is broadcast, it is treated as
+  /// `can_reference_source_data_indefinitely`.
+  ///
+  /// Only supported by `tensorstore::Write`.
+  can_take_source_data = 3,
 };
 
 /// Options for `tensorstore::Write`.
@@ -202,6 +253,12 @@ struct CopyOptions {
   }
 
   absl::Status Set(SourceDataReferenceRestriction value) {
+    if (value == can_take_source_data) {
+      // The source data is read from the source TensorStore, and is never
+      // owned by the caller.
+      return absl::InvalidArgumentError(
+          "can_take_source_data is not supported by Copy");
+    }
     this->source_data_reference_restriction = value;
     return absl::OkStatus();
   }
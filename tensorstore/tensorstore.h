@@ -34,6 +34,7 @@
 #include "tensorstore/index_space/dimension_units.h"
 #include "tensorstore/index_space/index_domain.h"
 #include "tensorstore/index_space/index_transform.h"
+#include "tensorstore/index_space/transformed_array.h"
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/open_mode.h"
 #include "tensorstore/open_options.h"
@@ -702,6 +703,88 @@ Read(SourceTensorstore&& source, TargetArray&& target, Option&&... option) {
                            std::move(options));
 }
 
+/// Copies multiple regions of a `source` TensorStore to separate arrays.
+///
+/// Equivalent to calling `Read(source | source_transforms[i], targets[i])` for
+/// each region, except that all of the reads are issued as part of a single
+/// `Batch`, such that each chunk needed by one or more of the regions is
+/// fetched only once, even if the regions overlap.  This is more efficient
+/// than issuing the reads individually for many small or overlapping regions.
+///
+/// Options compatible with `ReadOptions` are specified in any order after
+/// `targets`.  The meaning of each option is determined by its type.
+///
+/// Supported option types are:
+///
+/// - `DomainAlignmentOptions`, applied to each region.
+///
+/// - `ReadProgressFunction`, invoked with the combined progress of all
+///   regions.
+///
+/// - `Batch`.  If not specified, a new batch is created and submitted once
+///   all of the reads have been issued.
+///
+/// Example::
+///
+///     TensorReader<int32_t, 2> store = ...;
+///     std::vector<IndexTransform<>> transforms;
+///     std::vector<TransformedSharedArray<void>> targets;
+///     for (Index i = 0; i < 10; ++i) {
+///       transforms.push_back(
+///           (IdentityTransform(store.domain()) |
+///            Dims(0, 1).SizedInterval({i * 5, 0}, {10, 30})).value());
+///       targets.push_back(AllocateArray<int32_t>({10, 30}));
+///     }
+///     ReadMany(store, transforms, targets).value();
+///
+/// \param source Source `TensorStore` object that supports reading.  May be
+///     `Result`-wrapped.
+/// \param source_transforms Transform for each region, applied to `source`.
+/// \param targets Destination array for each region, with the same length as
+///     `source_transforms`.  These arrays must remain valid until the returned
+///     future becomes ready.
+/// \param options Any option compatible with `ReadOptions`.
+/// \returns A future that becomes ready when all of the reads have completed
+///     successfully or any has failed.
+/// \error `absl::StatusCode::kInvalidArgument` if `source_transforms` and
+///     `targets` have different lengths.
+/// \relates TensorStore
+/// \membergroup I/O
+template <typename SourceTensorstore>
+std::enable_if_t<
+    internal::IsTensorStoreThatSupportsMode<UnwrapResultType<SourceTensorstore>,
+                                            ReadWriteMode::read>,
+    Future<void>>
+ReadMany(SourceTensorstore&& source,
+         span<const IndexTransform<>> source_transforms,
+         span<const TransformedSharedArray<void>> targets,
+         ReadOptions options) {
+  return MapResult(
+      [&](UnwrapQualifiedResultType<SourceTensorstore&&> unwrapped_source) {
+        return internal::DriverReadMany(
+            internal::TensorStoreAccess::handle(
+                std::forward<decltype(unwrapped_source)>(unwrapped_source)),
+            source_transforms, targets, std::move(options));
+      },
+      std::forward<SourceTensorstore>(source));
+}
+template <typename SourceTensorstore, typename... Option>
+std::enable_if_t<
+    (IsCompatibleOptionSequence<ReadOptions, Option...> &&
+     internal::IsTensorStoreThatSupportsMode<
+         UnwrapResultType<SourceTensorstore>, ReadWriteMode::read>),
+    Future<void>>
+ReadMany(SourceTensorstore&& source,
+         span<const IndexTransform<>> source_transforms,
+         span<const TransformedSharedArray<void>> targets,
+         Option&&... option) {
+  ReadOptions options;
+  TENSORSTORE_RETURN_IF_ERROR(
+      internal::SetAll(options, std::forward<Option>(option)...));
+  return tensorstore::ReadMany(std::forward<SourceTensorstore>(source),
+                               source_transforms, targets, std::move(options));
+}
+
 /// Copies from a `source` `TensorStore` to a newly-allocated target `Array`.
 ///
 /// Options compatible with `ReadIntoNewArrayOptions` are specified in any order
@@ -714,6 +797,10 @@ Read(SourceTensorstore&& source, TargetArray&& target, Option&&... option) {
 ///
 /// - `ReadProgressFunction`
 ///
+/// - `CachedDataReferencePermission`, which has no effect, since the returned
+///   array is mutable and therefore always newly allocated.  Use `ReadConst`
+///   to obtain a read-only array that may reference cached chunk data.
+///
 /// Example::
 ///
 ///     TensorReader<int32_t, 3> store = ...;
@@ -772,6 +859,84 @@ Read(SourceTensorstore&& source, Option&&... option) {
                                        std::move(options));
 }
 
+/// Copies from a `source` `TensorStore` to a read-only `Array`.
+///
+/// Same as `Read[TensorStore]`, except that the returned array has a ``const``
+/// element type, which permits it to share ownership of cached chunk data
+/// rather than being a copy.
+///
+/// Options compatible with `ReadIntoNewArrayOptions` are specified in any order
+/// after `source`.  The meaning of each option is determined by its type.
+///
+/// Supported option types are:
+///
+/// - `ContiguousLayoutOrder`, specifying the layout of the returned array if it
+///   is newly allocated.  If not specified, defaults to `c_order`.
+///
+/// - `ReadProgressFunction`
+///
+/// - `CachedDataReferencePermission`, specifying whether the returned array
+///   may share ownership of cached chunk data rather than being a copy.  If
+///   not specified, defaults to `cannot_reference_cached_data`.
+///
+/// Example::
+///
+///     TensorReader<int32_t, 3> store = ...;
+///     auto array = ReadConst(
+///         store | AllDims().SizedInterval({100, 200}, {25, 30}),
+///         can_reference_cached_data)
+///         .value();
+///
+/// \tparam OriginKind If equal to `offset_origin` (the default), the returned
+///     array has the same origin as `source`.  Otherwise, the returned array is
+///     translated to have an origin of zero for all dimensions.
+/// \param source Source TensorStore object that supports reading.  May be
+///     `Result`-wrapped.
+/// \param options Any option compatible with `ReadIntoNewArrayOptions`.
+/// \returns A future that becomes ready when the read has completed
+///     successfully or has failed.
+/// \relates TensorStore
+/// \membergroup I/O
+template <ArrayOriginKind OriginKind = offset_origin,
+          typename SourceTensorstore>
+std::enable_if_t<
+    internal::IsTensorStoreThatSupportsMode<UnwrapResultType<SourceTensorstore>,
+                                            ReadWriteMode::read>,
+    Future<SharedArray<
+        const typename UnwrapResultType<SourceTensorstore>::Element,
+        UnwrapResultType<SourceTensorstore>::static_rank, OriginKind>>>
+// NONITPICK: UnwrapResultType<SourceTensorstore>::Element
+// NONITPICK: UnwrapResultType<SourceTensorstore>::static_rank
+ReadConst(SourceTensorstore&& source, ReadIntoNewArrayOptions options) {
+  using Store = UnwrapResultType<SourceTensorstore>;
+  return MapResult(
+      [&](UnwrapQualifiedResultType<SourceTensorstore&&> unwrapped_source) {
+        return internal_tensorstore::MapArrayFuture<
+            const typename Store::Element, Store::static_rank, OriginKind>(
+            internal::DriverReadIntoNewConstArray(
+                internal::TensorStoreAccess::handle(
+                    std::forward<decltype(unwrapped_source)>(unwrapped_source)),
+                std::move(options)));
+      },
+      std::forward<SourceTensorstore>(source));
+}
+template <ArrayOriginKind OriginKind = offset_origin,
+          typename SourceTensorstore, typename... Option>
+std::enable_if_t<
+    (IsCompatibleOptionSequence<ReadIntoNewArrayOptions, Option...> &&
+     internal::IsTensorStoreThatSupportsMode<
+         UnwrapResultType<SourceTensorstore>, ReadWriteMode::read>),
+    Future<SharedArray<
+        const typename UnwrapResultType<SourceTensorstore>::Element,
+        UnwrapResultType<SourceTensorstore>::static_rank, OriginKind>>>
+ReadConst(SourceTensorstore&& source, Option&&... option) {
+  ReadIntoNewArrayOptions options;
+  TENSORSTORE_RETURN_IF_ERROR(
+      internal::SetAll(options, std::forward<Option>(option)...));
+  return tensorstore::ReadConst<OriginKind>(
+      std::forward<SourceTensorstore>(source), std::move(options));
+}
+
 /// Evaluates whether the constraints required for `tensorstore::Write` are
 /// satisfied.
 ///
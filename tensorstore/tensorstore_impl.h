@@ -166,12 +166,13 @@ namespace internal_tensorstore {
 
 using TensorStoreAccess = internal::TensorStoreAccess;
 
-template <typename Element, DimensionIndex Rank, ArrayOriginKind OriginKind>
+template <typename Element, DimensionIndex Rank, ArrayOriginKind OriginKind,
+          typename SourceElement>
 Future<SharedArray<Element, Rank, OriginKind>> MapArrayFuture(
-    Future<SharedOffsetArray<void>> future) {
+    Future<SharedOffsetArray<SourceElement>> future) {
   return MapFutureValue(
       InlineExecutor{},
-      [](SharedOffsetArray<void>& array)
+      [](SharedOffsetArray<SourceElement>& array)
           -> Result<SharedArray<Element, Rank, OriginKind>> {
         // StaticCast the type-erased array type returned by `DriverRead` to the
         // more strongly-typed array type.